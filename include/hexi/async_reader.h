@@ -0,0 +1,394 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/shared.h>
+#include <hexi/stream_transaction.h>
+#include <hexi/allocators/tls_block_allocator.h>
+#include <hexi/endian.h>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+namespace detail {
+
+template<std::size_t size>
+struct coroutine_frame_block {
+	alignas(std::max_align_t) std::byte data[size];
+};
+
+struct pending_read {
+	std::coroutine_handle<> handle;
+
+	virtual bool try_read() = 0;
+
+protected:
+	~pending_read() = default;
+};
+
+} // detail
+
+/**
+ * Allocates coroutine frames from a thread-local block allocator. Frames
+ * larger than the block size fall back to the global allocator.
+ *
+ * @note Frames must be released on the thread that allocated them.
+ *
+ * @tparam block_size The size of each block in the pool.
+ * @tparam blocks The number of blocks preallocated for each thread.
+ */
+template<std::size_t block_size = 512, std::size_t blocks = 64>
+struct coroutine_frame_pool final {
+	using block_type = detail::coroutine_frame_block<block_size>;
+	using allocator_type = tls_block_allocator<block_type, blocks>;
+
+	static allocator_type& allocator() {
+		static thread_local allocator_type allocator;
+		return allocator;
+	}
+
+	static void* allocate(const std::size_t size) {
+		if(size > block_size) [[unlikely]] {
+			return ::operator new(size);
+		}
+
+		return allocator().allocate();
+	}
+
+	static void deallocate(void* ptr, const std::size_t size) {
+		if(size > block_size) [[unlikely]] {
+			::operator delete(ptr, size);
+			return;
+		}
+
+		allocator().deallocate(static_cast<block_type*>(ptr));
+	}
+};
+
+namespace detail {
+
+template<typename T>
+struct task_result {
+	std::optional<T> value;
+
+	template<typename U>
+	void return_value(U&& result) {
+		value.emplace(std::forward<U>(result));
+	}
+};
+
+template<>
+struct task_result<void> {
+	void return_void() {}
+};
+
+} // detail
+
+/**
+ * Coroutine type for parsers written against async_reader. The coroutine
+ * starts running as soon as it's called and runs until it needs more data
+ * than has been buffered, at which point control returns to the caller.
+ *
+ * Coroutine frames are allocated from the pool given by frame_pool.
+ *
+ * @tparam T The coroutine's return type.
+ * @tparam frame_pool The allocator used for coroutine frames.
+ */
+template<typename T = void, typename frame_pool = coroutine_frame_pool<>>
+class async_task final {
+public:
+	struct promise_type : detail::task_result<T> {
+		std::exception_ptr exception;
+
+		static void* operator new(const std::size_t size) {
+			return frame_pool::allocate(size);
+		}
+
+		static void operator delete(void* ptr, const std::size_t size) {
+			frame_pool::deallocate(ptr, size);
+		}
+
+		async_task get_return_object() {
+			return async_task(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_never initial_suspend() noexcept {
+			return {};
+		}
+
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+
+		void unhandled_exception() {
+			exception = std::current_exception();
+		}
+	};
+
+private:
+	std::coroutine_handle<promise_type> handle_;
+
+	explicit async_task(std::coroutine_handle<promise_type> handle)
+		: handle_(handle) {}
+
+public:
+	async_task(async_task&& rhs) noexcept
+		: handle_(std::exchange(rhs.handle_, nullptr)) {}
+
+	async_task& operator=(async_task&& rhs) noexcept {
+		if(this != &rhs) {
+			if(handle_) {
+				handle_.destroy();
+			}
+
+			handle_ = std::exchange(rhs.handle_, nullptr);
+		}
+
+		return *this;
+	}
+
+	async_task(const async_task&) = delete;
+	async_task& operator=(const async_task&) = delete;
+
+	/**
+	 * @return True if the coroutine has run to completion.
+	 */
+	bool done() const {
+		return handle_ && handle_.done();
+	}
+
+	/**
+	 * @brief Retrieves the result of a completed coroutine, rethrowing any
+	 * exception that escaped it.
+	 *
+	 * @return The coroutine's return value, if it has one.
+	 */
+	decltype(auto) get() {
+		assert(done() && "Coroutine has not completed");
+
+		if(handle_.promise().exception) {
+			std::rethrow_exception(handle_.promise().exception);
+		}
+
+		if constexpr(!std::is_void_v<T>) {
+			return (*handle_.promise().value);
+		}
+	}
+
+	~async_task() {
+		if(handle_) {
+			handle_.destroy();
+		}
+	}
+};
+
+/**
+ * Awaitable reader for messages that arrive in fragments. Each read is
+ * attempted through a transaction on the buffer, so a read that runs out
+ * of data consumes nothing and suspends the awaiting coroutine. Calling
+ * notify after appending data retries the pending read and, if it can
+ * now complete, resumes the coroutine, e.g:
+ *
+ * async_task<> parse(auto& reader) {
+ *     const auto id = co_await reader.template read<std::uint32_t>();
+ *     std::string name;
+ *     co_await reader.read(hexi::prefixed(name));
+ * }
+ *
+ * buffer.write(data, size);
+ * reader.notify();
+ *
+ * Only one coroutine may be waiting on a reader at a time. Errors other
+ * than running out of data are terminal. The reader is put into the
+ * error state, pending and subsequent reads complete immediately and
+ * the coroutine is expected to check the result before continuing.
+ *
+ * @tparam buf_type The buffer type, e.g. dynamic_buffer.
+ * @tparam endianness The byte order used for reads.
+ */
+template<transactional buf_type, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class async_reader final {
+	using stream_type = binary_stream<buf_type, no_throw_t, endianness>;
+
+	stream_type stream_;
+	stream_state state_ = stream_state::ok;
+	detail::pending_read* pending_ = nullptr;
+
+	template<typename T>
+	bool try_read(T&& data) {
+		if(state_ != stream_state::ok) {
+			return true;
+		}
+
+		auto tx = stream_.begin_transaction();
+		tx >> std::forward<T>(data);
+
+		if(tx) {
+			tx.commit();
+			return true;
+		}
+
+		if(tx->state() != stream_state::buff_limit_err) {
+			state_ = tx->state();
+			return true;
+		}
+
+		return false;
+	}
+
+	void suspend(detail::pending_read* pending, std::coroutine_handle<> handle) {
+		assert(!pending_ && "A coroutine is already waiting on this reader");
+		pending->handle = handle;
+		pending_ = pending;
+	}
+
+	template<typename T>
+	class read_awaiter final : detail::pending_read {
+		async_reader& reader_;
+		T data_;
+
+		bool try_read() override {
+			return reader_.try_read(data_);
+		}
+
+	public:
+		read_awaiter(async_reader& reader, T&& data)
+			: reader_(reader), data_(std::forward<T>(data)) {}
+
+		bool await_ready() {
+			return try_read();
+		}
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			reader_.suspend(this, handle);
+		}
+
+		bool await_resume() const {
+			return reader_.good();
+		}
+	};
+
+	template<std::default_initializable T>
+	class value_awaiter final : detail::pending_read {
+		async_reader& reader_;
+		T value_{};
+
+		bool try_read() override {
+			return reader_.try_read(value_);
+		}
+
+	public:
+		explicit value_awaiter(async_reader& reader)
+			: reader_(reader) {}
+
+		bool await_ready() {
+			return try_read();
+		}
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			reader_.suspend(this, handle);
+		}
+
+		T await_resume() {
+			return std::move(value_);
+		}
+	};
+
+public:
+	using size_type = typename buf_type::size_type;
+
+	/**
+	 * @param buffer The buffer that the I/O layer appends data to.
+	 * @param read_limit The maximum number of bytes that can be read, or
+	 * zero for no limit.
+	 */
+	explicit async_reader(buf_type& buffer, const size_type read_limit = 0)
+		: stream_(buffer, read_limit) {}
+
+	async_reader(const async_reader&) = delete;
+	async_reader& operator=(const async_reader&) = delete;
+
+	/**
+	 * @brief Reads into the provided object or stream adaptor, suspending
+	 * until enough data is available.
+	 *
+	 * @param data The object or adaptor to read into, e.g. prefixed(str).
+	 *
+	 * @return An awaitable that yields true if the read succeeded.
+	 */
+	template<typename T>
+	[[nodiscard]] auto read(T&& data) {
+		return read_awaiter<T>(*this, std::forward<T>(data));
+	}
+
+	/**
+	 * @brief Reads a value of the provided type, suspending until enough
+	 * data is available.
+	 *
+	 * @tparam T The type to read.
+	 *
+	 * @return An awaitable that yields the value. The value is default
+	 * initialised if the read failed.
+	 */
+	template<std::default_initializable T>
+	[[nodiscard]] auto read() {
+		return value_awaiter<T>(*this);
+	}
+
+	/**
+	 * @brief Retries the pending read, if there is one, and resumes the
+	 * waiting coroutine if it completes. Call this after appending data
+	 * to the buffer.
+	 *
+	 * @return True if a coroutine was resumed.
+	 */
+	bool notify() {
+		if(!pending_ || !pending_->try_read()) {
+			return false;
+		}
+
+		std::exchange(pending_, nullptr)->handle.resume();
+		return true;
+	}
+
+	/**
+	 * @return True if a coroutine is waiting for more data.
+	 */
+	bool waiting() const {
+		return pending_ != nullptr;
+	}
+
+	/**
+	 * @return The total number of bytes consumed by completed reads.
+	 */
+	size_type total_read() const {
+		return stream_.total_read();
+	}
+
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
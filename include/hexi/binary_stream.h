@@ -8,16 +8,28 @@
 
 #include <hexi/shared.h>
 #include <hexi/concepts.h>
+#include <hexi/delta_packed.h>
 #include <hexi/exception.h>
 #include <hexi/endian.h>
+#include <hexi/fixed_string.h>
+#include <hexi/quantise.h>
+#include <hexi/serialised_size.h>
 #include <hexi/stream_adaptors.h>
+#include <hexi/stream_range.h>
+#include <hexi/stream_slice.h>
+#include <hexi/stream_transaction.h>
+#include <hexi/utf8.h>
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <limits>
 #include <ranges>
 #include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -44,6 +56,70 @@ using namespace detail;
 	STREAM_READ_BOUNDS_ENFORCE(read_size, ret_var)                \
 	buffer_.read(dest, read_size);
 
+namespace detail {
+
+/*
+ * Non-owning view over a buffer's free space, used to serialise objects with
+ * a known upper size bound straight into the destination once the capacity
+ * has been checked. Writes past the end are dropped and flagged, rather than
+ * checked against the underlying buffer, so the caller can discard the
+ * partial write. The bounds come from probing serialise with a handful of
+ * values rather than from a proof, so the per-write check against the
+ * window stays; it's a single pointer comparison.
+ */
+template<byte_type storage_type>
+class write_window final {
+	storage_type* const begin_;
+	storage_type* const end_;
+	storage_type* pos_;
+	bool overflow_ = false;
+
+public:
+	using size_type   = std::size_t;
+	using offset_type = std::size_t;
+	using value_type  = storage_type;
+	using contiguous  = is_contiguous;
+	using seeking     = unsupported;
+
+	write_window(storage_type* begin, const size_type length)
+		: begin_(begin),
+		  end_(begin + length),
+		  pos_(begin) {}
+
+	void write(const auto& source) {
+		write(&source, sizeof(source));
+	}
+
+	void write(const void* source, const size_type length) {
+		if(length > static_cast<size_type>(end_ - pos_)) [[unlikely]] {
+			overflow_ = true;
+			return;
+		}
+
+		std::memcpy(pos_, source, length);
+		pos_ += length;
+	}
+
+	size_type written() const {
+		return static_cast<size_type>(pos_ - begin_);
+	}
+
+	bool overflow() const {
+		return overflow_;
+	}
+
+	constexpr size_type size() const {
+		return 0;
+	}
+
+	[[nodiscard]]
+	constexpr bool empty() const {
+		return true;
+	}
+};
+
+} // detail
+
 template<
 	byte_oriented buf_type,
 	std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
@@ -56,6 +132,7 @@ public:
 	using seeking            = typename buf_type::seeking;
 	using value_type         = typename buf_type::value_type;
 	using contiguous_type    = typename buf_type::contiguous;
+	using buffer_type        = buf_type;
 	
 	static constexpr endianness byte_order{};
 
@@ -65,10 +142,16 @@ private:
 	buf_type& buffer_;
 	[[no_unique_address]] cond_size_type total_write_{};
 	size_type total_read_ = 0;
+	size_type allocated_ = 0;
+	size_type alloc_limit_ = 0;
 	stream_state state_ = stream_state::ok;
+	bool reuse_storage_ = false;
 	const size_type read_limit_;
 
-	inline void enforce_read_bounds(const size_type read_size) {
+	template<typename> friend class stream_slice;
+	template<typename, typename> friend class stream_transaction;
+
+	inline bool check_read_bounds(const size_type read_size) {
 		if(read_size > buffer_.size()) [[unlikely]] {
 			state_ = stream_state::buff_limit_err;
 
@@ -76,7 +159,7 @@ private:
 				HEXI_THROW(buffer_underrun(read_size, total_read_, buffer_.size()));
 			}
 
-			return;
+			return false;
 		}
 
 		if(read_limit_) {
@@ -89,25 +172,119 @@ private:
 					HEXI_THROW(stream_read_limit(read_size, total_read_, read_limit_));
 				}
 
-				return;
+				return false;
 			}
 		}
 
-		total_read_ += read_size;
+		return true;
+	}
+
+	inline void enforce_read_bounds(const size_type read_size) {
+		if(check_read_bounds(read_size)) [[likely]] {
+			total_read_ += read_size;
+		}
+	}
+
+	/*
+	 * Rejects element counts that the remaining data couldn't possibly
+	 * satisfy, given the minimum serialised size of each element, before
+	 * anything is allocated for them.
+	 */
+	template<typename count_type>
+	bool check_element_count(const count_type count, const std::size_t min_size) {
+		if(!min_size || !std::cmp_greater(count, read_max() / min_size)) [[likely]] {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		const auto required = std::cmp_greater(count, max_size / min_size)?
+			max_size : static_cast<size_type>(count * min_size);
+
+		return check_read_bounds(required);
+	}
+
+	/*
+	 * Accounts for an allocation of count elements against the stream's
+	 * allocation limit, if one was set. Charged before the read's bounds
+	 * are enforced, so that a rejected allocation doesn't count towards
+	 * the read limit.
+	 */
+	template<typename count_type>
+	bool charge_allocation(const count_type count, const std::size_t element_size) {
+		if(state_ != stream_state::ok) [[unlikely]] {
+			return false;
+		}
+
+		if(!alloc_limit_) {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		const auto bytes = std::cmp_greater(count, max_size / element_size)?
+			max_size : static_cast<size_type>(count * element_size);
+
+		if(allocated_ > alloc_limit_ || bytes > alloc_limit_ - allocated_) [[unlikely]] {
+			state_ = stream_state::alloc_limit_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(allocation_limit_exceeded(bytes, allocated_, alloc_limit_));
+			}
+
+			return false;
+		}
+
+		allocated_ += bytes;
+		return true;
+	}
+
+	/*
+	 * If the object's maximum serialised size fits into the buffer's free
+	 * space, serialise it directly into that space in one go rather than
+	 * going through the buffer for each field. Returns false if the object
+	 * wasn't written, either because it wasn't eligible or because it
+	 * wrote more than its bounds allowed for.
+	 */
+	template<typename T>
+	bool serialise_direct(T& object) {
+		constexpr auto bounds = serialised_size_bounds_v<T>;
+
+		if constexpr(bounds.bounded() && direct_writeable<buf_type>) {
+			if(state_ != stream_state::ok || buffer_.free() < bounds.max) {
+				return false;
+			}
+
+			using window_type = std::remove_pointer_t<decltype(buffer_.write_ptr())>;
+			write_window<window_type> window(buffer_.write_ptr(), bounds.max);
+			binary_stream<write_window<window_type>, no_throw_t, endianness> stream(window);
+			stream_write_adaptor adaptor(stream);
+			object.serialise(adaptor);
+
+			if(window.overflow()) [[unlikely]] {
+				return false;
+			}
+
+			buffer_.advance_write(static_cast<size_type>(window.written()));
+			total_write_ += static_cast<size_type>(window.written());
+			return true;
+		} else {
+			return false;
+		}
 	}
 
 	template<typename T>
-	inline void advance_write(T&& arg) {
+	constexpr void advance_write(T&& arg) {
 		total_write_ += sizeof(T);
 	}
 
 	template<typename T, typename U>
-	inline void advance_write(T&&, U&& size) {
+	constexpr void advance_write(T&&, U&& size) {
 		total_write_ += size;
 	}
 
 	template<typename... Ts>
-	inline void write(Ts&&... args) {
+	constexpr void write(Ts&&... args) {
 		HEXI_TRY {
 			if(state_ == stream_state::ok) [[likely]] {
 				buffer_.write(std::forward<Ts>(args)...);
@@ -123,14 +300,21 @@ private:
 	}
 
 	template<typename container_type>
-	void write_container(container_type& container) {
-		using cvalue_type = typename container_type::value_type;
+	constexpr void write_container(container_type& container) {
+		using cvalue_type = std::ranges::range_value_t<container_type>;
 
 		if constexpr(memcpy_write<container_type, binary_stream>) {
-			const auto bytes = container.size() * sizeof(cvalue_type);
-			write(container.data(), static_cast<size_type>(bytes));
+			if consteval {
+				for(auto& element : container) {
+					write(element);
+				}
+			} else {
+				const auto bytes = std::ranges::size(container) * sizeof(cvalue_type);
+				write(std::ranges::data(container), static_cast<size_type>(bytes));
+			}
 		} else {
-			for(auto& element : container) {
+			// elements may be prvalues when writing views
+			for(auto&& element : container) {
 				*this << element;
 			}
 		}
@@ -139,9 +323,36 @@ private:
 	template<typename container_type, typename count_type>
 	void read_container(container_type& container, const count_type count) {
 		using cvalue_type = typename container_type::value_type;
+		count_type reused = 0;
+
+		if constexpr(fixed_capacity<container_type>) {
+			if(count > container_type::capacity()) [[unlikely]] {
+				state_ = stream_state::capacity_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(capacity_exceeded(count, container_type::capacity()));
+				}
+
+				return;
+			}
+		}
+
+		if(!check_element_count(count, bounds_of<cvalue_type>().min)) [[unlikely]] {
+			return;
+		}
+
+		if constexpr(!fixed_capacity<container_type>) {
+			if(!charge_allocation(count, sizeof(cvalue_type))) [[unlikely]] {
+				return;
+			}
+		}
 
 		if constexpr(!memcpy_read<container_type, binary_stream>) {
-			container.clear();
+			if(reuse_storage_) {
+				reused = overwrite_elements(container, count);
+			} else {
+				container.clear();
+			}
 		}
 
 		if constexpr(has_reserve<container_type>) {
@@ -154,7 +365,7 @@ private:
 			const auto bytes = static_cast<size_type>(count * sizeof(cvalue_type));
 			SAFE_READ(container.data(), bytes, void());
 		} else {
-			for(count_type i = 0; i < count; ++i) {
+			for(count_type i = reused; i < count; ++i) {
 				cvalue_type value;
 				*this >> value;
 				container.emplace_back(std::move(value));
@@ -162,34 +373,147 @@ private:
 		}
 	}
 
+	/*
+	 * Deserialises into the container's existing elements so that any
+	 * storage they own (e.g. a string's capacity) is reused, then removes
+	 * any elements beyond the count. Returns the number of elements read.
+	 */
+	template<typename container_type, typename count_type>
+	count_type overwrite_elements(container_type& container, const count_type count) {
+		using reference = std::ranges::range_reference_t<container_type>;
+
+		if constexpr(std::is_lvalue_reference_v<reference>) {
+			count_type reused = 0;
+			auto it = container.begin();
+
+			for(; it != container.end() && reused < count && state_ == stream_state::ok; ++it) {
+				*this >> *it;
+				++reused;
+			}
+
+			container.erase(it, container.end());
+			return reused;
+		} else {
+			container.clear();
+			return 0;
+		}
+	}
+
+	template<std::size_t index, typename variant_type>
+	static void read_alternative(binary_stream& stream, variant_type& variant) {
+		// reuse the existing alternative if it's already active
+		if(variant.index() != index) {
+			variant.template emplace<index>();
+		}
+
+		stream >> std::get<index>(variant);
+	}
+
+	template<typename variant_type>
+	static constexpr auto make_variant_decoders() {
+		using decoder = void(*)(binary_stream&, variant_type&);
+		constexpr auto count = std::variant_size_v<variant_type>;
+
+		return []<std::size_t... indices>(std::index_sequence<indices...>) {
+			return std::array<decoder, count> {
+				&read_alternative<indices, variant_type>...
+			};
+		}(std::make_index_sequence<count>{});
+	}
+
+	/*
+	 * The quantising adaptors take their number of bits at runtime and
+	 * encoding with a number outside of the supported range is undefined,
+	 * so it's checked before anything is encoded or decoded.
+	 */
+	bool check_bit_width(const unsigned int bits, const unsigned int min_bits,
+	                     const unsigned int max_bits) {
+		if(bits >= min_bits && bits <= max_bits) [[likely]] {
+			return true;
+		}
+
+		state_ = stream_state::invalid_bit_width_err;
+
+		if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+			HEXI_THROW(invalid_bit_width(bits, max_bits));
+		}
+
+		return false;
+	}
+
+	/*
+	 * Encodes the values a chunk at a time and writes each chunk of words
+	 * out in one go, with the stream's byte order.
+	 */
+	template<std::unsigned_integral word_type, typename T, typename encode_func>
+	void write_encoded(std::span<T> values, encode_func&& encode) {
+		std::array<word_type, quantise_chunk_size> words;
+
+		for(std::size_t offset = 0; offset < values.size(); offset += words.size()) {
+			const auto in = values.subspan(offset, std::min(words.size(), values.size() - offset));
+			const auto out = std::span(words).first(in.size());
+			encode(in, out);
+
+			for(auto& word : out) {
+				word = endian::storage_in(word, byte_order);
+			}
+
+			write(out.data(), static_cast<size_type>(out.size_bytes()));
+		}
+	}
+
+	/*
+	 * Reads the encoded values a chunk at a time, converting each chunk of
+	 * words from the stream's byte order before decoding them.
+	 */
+	template<std::unsigned_integral word_type, typename T, typename decode_func>
+	void read_encoded(std::span<T> values, decode_func&& decode) {
+		std::array<word_type, quantise_chunk_size> words;
+
+		for(std::size_t offset = 0; offset < values.size(); offset += words.size()) {
+			const auto out = values.subspan(offset, std::min(words.size(), values.size() - offset));
+			const auto in = std::span(words).first(out.size());
+			SAFE_READ(in.data(), static_cast<size_type>(in.size_bytes()), void());
+
+			for(auto& word : in) {
+				endian::storage_out(word, byte_order);
+			}
+
+			decode(std::span<const word_type>(in), out);
+		}
+	}
+
 public:
-	explicit binary_stream(buf_type& source, size_type read_limit = 0)
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit = 0)
 		: buffer_(source),
 		  read_limit_(read_limit) {};
 
-	explicit binary_stream(buf_type& source, exceptions)
+	constexpr explicit binary_stream(buf_type& source, exceptions)
 		: binary_stream(source, 0) {}
 
-	explicit binary_stream(buf_type& source, endianness)
+	constexpr explicit binary_stream(buf_type& source, endianness)
 		: binary_stream(source, 0) {}
 
-	explicit binary_stream(buf_type& source, exceptions, endianness)
+	constexpr explicit binary_stream(buf_type& source, exceptions, endianness)
 		: binary_stream(source, 0) {}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, exceptions)
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, exceptions)
 		: binary_stream(source, read_limit) {}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, endianness)
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, endianness)
 		: binary_stream(source, read_limit) {}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, exceptions, endianness)
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, exceptions, endianness)
 		: binary_stream(source, read_limit) {}
 
-	binary_stream(binary_stream&& rhs) noexcept
+	constexpr binary_stream(binary_stream&& rhs) noexcept
 		: buffer_(rhs.buffer_), 
 		  total_write_(rhs.total_write_),
 		  total_read_(rhs.total_read_),
+		  allocated_(rhs.allocated_),
+		  alloc_limit_(rhs.alloc_limit_),
 		  state_(rhs.state_),
+		  reuse_storage_(rhs.reuse_storage_),
 		  read_limit_(rhs.read_limit_) {
 		rhs.total_read_ = static_cast<size_type>(-1);
 		rhs.state_ = stream_state::invalid_stream;
@@ -206,8 +530,36 @@ public:
 	 * void serialise(auto& stream);
 	 * 
 	 * @param object The object to be serialised.
+	 * 
+	 * @note If the object's serialised size bounds are known at compile-time,
+	 * the buffer's capacity is checked once up-front. If the upper bound fits,
+	 * the object is written without per-field overflow checks against the buffer.
 	 */
-	void serialise(auto&& object) requires writeable<buf_type> {
+	constexpr void serialise(auto&& object) requires writeable<buf_type> {
+		using object_type = std::remove_cvref_t<decltype(object)>;
+
+		if constexpr(has_size_bounds<object_type>) {
+			constexpr auto min_size = serialised_size_bounds_v<object_type>.min;
+
+			if constexpr(fixed_capacity<buf_type>) {
+				if(state_ == stream_state::ok && buffer_.free() < min_size) [[unlikely]] {
+					state_ = stream_state::buff_write_err;
+
+					if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+						HEXI_THROW(buffer_overflow(min_size, total_write_, buffer_.free()));
+					}
+
+					return;
+				}
+			}
+
+			if !consteval {
+				if(serialise_direct(object)) {
+					return;
+				}
+			}
+		}
+
 		stream_write_adaptor adaptor(*this);
 		object.serialise(adaptor);
 	}
@@ -222,7 +574,7 @@ public:
 	 */
 	template<typename T>
 	requires has_serialise<T, binary_stream>
-	binary_stream& operator<<(T& data) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(T& data) requires writeable<buf_type> {
 		serialise(data);
 		return *this;
 	}
@@ -235,7 +587,7 @@ public:
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator<<(const has_shl_override<binary_stream> auto& data)
+	constexpr binary_stream& operator<<(const has_shl_override<binary_stream> auto& data)
 	requires writeable<buf_type> {
 		return *this << data;
 	}
@@ -248,9 +600,9 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	binary_stream& operator<<(endian_func adaptor) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(endian_func adaptor) requires writeable<buf_type> {
 		const auto converted = adaptor.to();
-		write(&converted, sizeof(converted));
+		write(converted);
 		return *this;
 	}
 
@@ -261,9 +613,9 @@ public:
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator<<(const arithmetic auto& data) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(const arithmetic auto& data) requires writeable<buf_type> {
 		const auto converted = endian::storage_in(data, byte_order);
-		write(&converted, sizeof(converted));
+		write(converted);
 		return *this;
 	}
 
@@ -279,9 +631,10 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<pod T>
-	requires (!has_shl_override<T, binary_stream> && !arithmetic<T>)
-	binary_stream& operator<<(const T& data) requires writeable<buf_type> {
-		write(&data, sizeof(T));
+	requires (!has_shl_override<T, binary_stream> && !arithmetic<T>
+		&& !has_serialise<T, binary_stream> && !is_iterable<T>)
+	constexpr binary_stream& operator<<(const T& data) requires writeable<buf_type> {
+		write(data);
 		return *this;
 	}
 
@@ -296,7 +649,7 @@ public:
 	 */
 	template<typename T>
 	requires std::is_same_v<std::decay_t<T>, std::string_view>
-	binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
 		assert(adaptor->find_first_of('\0') == adaptor->npos);
 		write(adaptor->data(), adaptor->size());
 		write('\0');
@@ -314,12 +667,29 @@ public:
 	 */
 	template<typename T>
 	requires std::is_same_v<std::decay_t<T>, std::string>
-	binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
 		assert(adaptor->find_first_of('\0') == adaptor->npos);
 		write(adaptor->data(), adaptor->size() + 1); // yes, the standard allows this
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a fixed_string as a null terminated string.
+	 * 
+	 * @tparam T The fixed_string type.
+	 * @param adaptor null_terminated adaptor that will instruct the stream to write
+	 * a null terminated string with no prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires is_fixed_string_v<std::remove_const_t<T>>
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+		assert(adaptor->view().find_first_of('\0') == std::string_view::npos);
+		write(adaptor->data(), adaptor->size() + 1); // always null terminated
+		return *this;
+	}
+
 	/**
 	 * @brief Serialises a string, string_view or any type providing data()
 	 * and a size() member functions.
@@ -330,7 +700,7 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<typename T>
-	binary_stream& operator<<(raw<T> adaptor) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(raw<T> adaptor) requires writeable<buf_type> {
 		write(adaptor->data(), adaptor->size());
 		return *this;
 	}
@@ -342,7 +712,7 @@ public:
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator<<(std::string_view string) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(std::string_view string) requires writeable<buf_type> {
 		return *this << prefixed(string);
 	}
 
@@ -353,7 +723,19 @@ public:
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator<<(const std::string& string) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(const std::string& string) requires writeable<buf_type> {
+		return *this << prefixed(string);
+	}
+
+	/**
+	 * @brief Serialises a fixed_string with a fixed-length prefix.
+	 * 
+	 * @param string fixed_string to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	constexpr binary_stream& operator<<(const fixed_string<N>& string) requires writeable<buf_type> {
 		return *this << prefixed(string);
 	}
 
@@ -367,14 +749,26 @@ public:
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator<<(const char* data) requires writeable<buf_type> {
+	constexpr binary_stream& operator<<(const char* data) requires writeable<buf_type> {
 		assert(data);
-		const auto len = std::strlen(data);
+		const auto len = std::char_traits<char>::length(data);
 		write(data, len + 1); // include terminator
 		return *this;
 	}
 
-	binary_stream& operator<<(const is_iterable auto& data) requires writeable<buf_type> {
+	/**
+	 * @brief Serialises the elements of an iterable container or range,
+	 * without a prefix.
+	 * 
+	 * Ranges are written as their elements are produced, so views (e.g.
+	 * std::views::transform) can be written without materialising them
+	 * into a temporary container first.
+	 * 
+	 * @param data The container or range to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const is_iterable auto& data) requires writeable<buf_type> {
 		write_container(data);
 		return *this;
 	}
@@ -391,8 +785,8 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<is_iterable T>
-	binary_stream& operator<<(prefixed<T> adaptor) requires writeable<buf_type> {
-		const auto count = static_cast<std::uint32_t>(adaptor->size());
+	constexpr binary_stream& operator<<(prefixed<T> adaptor) requires writeable<buf_type> {
+		const auto count = static_cast<std::uint32_t>(std::ranges::size(adaptor.str));
 		write(endian::native_to_little(count));
 		write_container(adaptor.str);
 		return *this;
@@ -410,21 +804,197 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<is_iterable T>
-	binary_stream& operator<<(prefixed_varint<T> adaptor) requires writeable<buf_type> {
-		varint_encode(*this, adaptor->size());
+	constexpr binary_stream& operator<<(prefixed_varint<T> adaptor) requires writeable<buf_type> {
+		varint_encode(*this, std::ranges::size(adaptor.str));
 		write_container(adaptor.str);
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a string through a string table, as a reference to
+	 * an earlier occurrence where there is one.
+	 * 
+	 * @param adaptor deduplicated adaptor referencing the string and the
+	 * message's string table.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	binary_stream& operator<<(deduplicated_string<T, table_type> adaptor) requires writeable<buf_type> {
+		deduplicated_encode(*this, std::string_view(adaptor.str), adaptor.table);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a std::variant, prefixed with the index of the
+	 * active alternative.
+	 * 
+	 * @tparam tag_type The integral type used to write the index.
+	 * @param adaptor The variant to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::integral tag_type, variant_like T>
+	constexpr binary_stream& operator<<(tagged_variant<tag_type, T> adaptor)
+	requires writeable<buf_type> {
+		constexpr auto alternatives = std::variant_size_v<std::remove_cv_t<T>>;
+
+		static_assert(std::in_range<tag_type>(alternatives - 1),
+			"Tag type is too small to represent every alternative");
+
+		*this << static_cast<tag_type>(adaptor->index());
+
+		std::visit([&](auto& alternative) {
+			*this << alternative;
+		}, adaptor.value);
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a std::variant, prefixed with a std::uint8_t holding
+	 * the index of the active alternative.
+	 * 
+	 * @param data The variant to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<variant_like T>
+	constexpr binary_stream& operator<<(T& data) requires writeable<buf_type> {
+		return *this << tagged(data);
+	}
+
+	/**
+	 * @brief Serialises a container of integers as bit-packed deltas, with
+	 * a fixed-length prefix. See delta_packed for the format.
+	 * 
+	 * @tparam T The container type.
+	 * @param adaptor delta_packed adaptor referencing the container to be
+	 * serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<delta_packable T>
+	binary_stream& operator<<(delta_packed<T> adaptor) requires writeable<buf_type> {
+		using unsigned_type = std::make_unsigned_t<std::ranges::range_value_t<T>>;
+
+		const auto count = std::ranges::size(adaptor.values);
+		*this << endian::le(static_cast<std::uint32_t>(count));
+
+		if(!count) {
+			return *this;
+		}
+
+		const auto values = reinterpret_cast<const unsigned_type*>(std::ranges::data(adaptor.values));
+		const auto blocks = count / bp128_block_size;
+		*this << values[0];
+
+		bp128_seed<unsigned_type> seed;
+		seed.fill(values[0]);
+		std::array<std::uint32_t, bp128_max_words> words;
+
+		for(std::size_t i = 0; i < blocks; ++i) {
+			const auto width = bp128_encode(values + (i * bp128_block_size), seed, words.data());
+			const auto out = std::span(words).first(width * bp128_lanes);
+
+			for(auto& word : out) {
+				word = endian::storage_in(word, byte_order);
+			}
+
+			*this << static_cast<std::uint8_t>(width);
+			write(out.data(), static_cast<size_type>(out.size_bytes()));
+		}
+
+		auto prev = blocks? seed.back() : values[0];
+
+		for(auto i = blocks * bp128_block_size; i < count; ++i) {
+			varint_encode(*this, static_cast<unsigned_type>(values[i] - prev));
+			prev = values[i];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises floats as IEEE 754 binary16.
+	 * 
+	 * @param adaptor half adaptor referencing the values to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator<<(half adaptor) requires writeable<buf_type> {
+		write_encoded<std::uint16_t>(adaptor.values, [](auto in, auto out) {
+			to_half(in, out);
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises floating point values quantised to a number of bits,
+	 * each written as the smallest unsigned type that can hold them.
+	 * 
+	 * @tparam T The floating point type.
+	 * @param adaptor quantised adaptor referencing the values to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::floating_point T>
+	binary_stream& operator<<(quantised<T> adaptor) requires writeable<buf_type> {
+		if(!check_bit_width(adaptor.bits, 1, max_quantise_bits<T>)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(adaptor.bits, [&]<typename word_type>(std::type_identity<word_type>) {
+			write_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				quantise<T>(in, out, adaptor.min, adaptor.max, adaptor.bits);
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises unit quaternions with the smallest three encoding.
+	 * 
+	 * @tparam T The quaternion type.
+	 * @param adaptor smallest_three adaptor referencing the values to be
+	 * serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<quaternion T>
+	binary_stream& operator<<(smallest_three<T> adaptor) requires writeable<buf_type> {
+		if(!check_bit_width(adaptor.bits, min_smallest_three_bits, max_smallest_three_bits)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(2 + (adaptor.bits * 3), [&]<typename word_type>(std::type_identity<word_type>) {
+			write_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				for(std::size_t i = 0; i < in.size(); ++i) {
+					out[i] = static_cast<word_type>(encode_smallest_three(in[i], adaptor.bits));
+				}
+			});
+		});
+
+		return *this;
+	}
+
 	/**
 	 * @brief Writes a contiguous range to the stream.
 	 * 
 	 * @param data The contiguous range to be written to the stream.
 	 */
 	template<std::ranges::contiguous_range range>
-	void put(const range& data) requires writeable<buf_type> {
-		const auto write_size = data.size() * sizeof(typename range::value_type);
-		write(data.data(), write_size);
+	constexpr void put(const range& data) requires writeable<buf_type> {
+		if consteval {
+			for(auto& element : data) {
+				write(element);
+			}
+		} else {
+			const auto write_size = data.size() * sizeof(typename range::value_type);
+			write(data.data(), write_size);
+		}
 	}
 
 	/**
@@ -432,8 +1002,8 @@ public:
 	 * 
 	 * @param data The value to be written to the stream.
 	 */
-	void put(const arithmetic auto& data) requires writeable<buf_type> {
-		write(&data, sizeof(data));
+	constexpr void put(const arithmetic auto& data) requires writeable<buf_type> {
+		write(data);
 	}
 
 	/**
@@ -442,9 +1012,9 @@ public:
 	 * @param adaptor The element to be written to the stream.
 	 */
 	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	void put(const endian_func& adaptor) requires writeable<buf_type> {
+	constexpr void put(const endian_func& adaptor) requires writeable<buf_type> {
 		const auto swapped = adaptor.to();
-		write(&swapped, sizeof(swapped));
+		write(swapped);
 	}
 
 	/**
@@ -455,9 +1025,15 @@ public:
 	 * @param count The number of elements to write.
 	 */
 	template<pod T>
-	void put(const T* data, size_type count) requires writeable<buf_type> {
-		const auto write_size = count * sizeof(T);
-		write(data, write_size);
+	constexpr void put(const T* data, size_type count) requires writeable<buf_type> {
+		if consteval {
+			for(size_type i = 0; i < count; ++i) {
+				write(data[i]);
+			}
+		} else {
+			const auto write_size = count * sizeof(T);
+			write(data, write_size);
+		}
 	}
 
 	/**
@@ -468,7 +1044,7 @@ public:
 	 * @param end Iterator to the end of the data.
 	 */
 	template<typename It>
-	void put(It begin, const It end) requires writeable<buf_type> {
+	constexpr void put(It begin, const It end) requires writeable<buf_type> {
 		for(auto it = begin; it != end; ++it) {
 			*this << *it;
 		}
@@ -494,8 +1070,22 @@ public:
 	 * void serialise(auto& stream);
 	 * 
 	 * @param[out] object The object to be deserialised.
+	 * 
+	 * @note If the object's serialised size bounds are known at compile-time,
+	 * the stream will error before reading any fields if there is less data
+	 * available than the object's minimum size.
 	 */
 	void deserialise(auto& object) {
+		using object_type = std::remove_cvref_t<decltype(object)>;
+
+		if constexpr(has_size_bounds<object_type>) {
+			constexpr auto min_size = serialised_size_bounds_v<object_type>.min;
+
+			if(state_ != stream_state::ok || !check_read_bounds(min_size)) {
+				return;
+			}
+		}
+
 		stream_read_adaptor adaptor(*this);
 		object.serialise(adaptor);
 	}
@@ -531,9 +1121,13 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -582,9 +1176,13 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -621,11 +1219,109 @@ public:
 	 * @brief Deserialises a string that was previously written with a
 	 * null terminator.
 	 * 
-	 * @param[out] adaptor std::string to hold the result.
+	 * @param[out] adaptor std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(null_terminated<std::string> adaptor) {
+		auto pos = buffer_.find_first_of(value_type(0));
+
+		if(pos == buf_type::npos) {
+			adaptor->clear();
+			return *this;
+		}
+
+		if(!charge_allocation(pos, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, pos);
+			return pos;
+		});
+
+		// no need to enforce bounds, we know there's enough data
+		buffer_.skip(1); // skip null terminator
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten (i.e.
+	 * buffer adaptor with optimise disabled).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(null_terminated<std::string_view> adaptor) {
+		adaptor.str = view();
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten or
+	 * relocated (std::vector).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(std::string_view& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(std::string& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a fixed_string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data fixed_string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream& operator>>(fixed_string<N>& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor fixed_string to hold the result.
+	 * 
+	 * @note If the terminator is beyond the fixed_string's capacity, the
+	 * stream will be put into the capacity_err state. If no terminator is
+	 * found at all, the string is cleared and nothing is consumed, as with
+	 * std::string.
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator>>(null_terminated<std::string> adaptor) {
+	template<std::size_t N>
+	binary_stream& operator>>(null_terminated<fixed_string<N>> adaptor) {
 		auto pos = buffer_.find_first_of(value_type(0));
 
 		if(pos == buf_type::npos) {
@@ -633,11 +1329,21 @@ public:
 			return *this;
 		}
 
+		if(pos > N) [[unlikely]] {
+			state_ = stream_state::capacity_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(capacity_exceeded(pos, N));
+			}
+
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
 
-		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, pos);
-			return size;
+			return pos;
 		});
 
 		// no need to enforce bounds, we know there's enough data
@@ -646,50 +1352,127 @@ public:
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * null terminator.
+	 * @brief Deserialises a string and replaces it with the equivalent
+	 * string from an intern pool.
 	 * 
-	 * @param[out] adaptor std::string_view to hold the result.
+	 * On contiguous buffers, the string is hashed directly from the buffer
+	 * and is only copied if it has not been seen before.
 	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten (i.e.
-	 * buffer adaptor with optimise disabled).
+	 * @param[out] adaptor interned adaptor referencing the string_view to
+	 * hold the result and the pool to intern into.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the pool rather
+	 * than the underlying buffer.
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator>>(null_terminated<std::string_view> adaptor) {
-		adaptor.str = view();
+	template<template<typename> class encoding, typename pool_type>
+	binary_stream& operator>>(interned_string<encoding, pool_type> adaptor) {
+		if constexpr(std::is_same_v<contiguous_type, is_contiguous>) {
+			std::string_view view;
+			*this >> encoding<std::string_view>{ view };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.pool.intern(view);
+			}
+		} else {
+			std::string string;
+			*this >> encoding<std::string>{ string };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.pool.intern(string);
+			}
+		}
+
 		return *this;
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
+	 * @brief Deserialises a string with the wrapped adaptor and validates
+	 * that it's well-formed UTF-8.
 	 * 
-	 * @param[out] data std::string_view to hold the result.
+	 * @param[out] adaptor utf8 adaptor wrapping the string or string adaptor.
 	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten or
-	 * relocated (std::vector).
+	 * @note Invalid strings result in stream_state::invalid_utf8_err. The
+	 * string is left holding the invalid data.
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator>>(std::string_view& data) {
-		return *this >> prefixed(data);
+	template<typename T>
+	binary_stream& operator>>(utf8_validated<T> adaptor) {
+		*this >> adaptor.value;
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		const auto string = utf8_view(adaptor.value);
+
+		if(!is_valid_utf8(string)) [[unlikely]] {
+			state_ = stream_state::invalid_utf8_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(invalid_utf8(utf8_error_offset(string), string.size()));
+			}
+		}
+
+		return *this;
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
+	 * @brief Deserialises a string that was serialised through a string
+	 * table, resolving references to earlier occurrences.
 	 * 
-	 * @param[out] data std::string to hold the result.
+	 * On contiguous buffers, string_views refer to the first occurrence
+	 * within the buffer, so no copies are made.
+	 * 
+	 * @param[out] adaptor deduplicated adaptor referencing the std::string
+	 * or std::string_view to hold the result and the message's string table.
+	 * 
+	 * @note A reference to a string that isn't in the table results in
+	 * stream_state::invalid_tag_err.
 	 * 
 	 * @return Reference to the current stream.
 	 */
-	binary_stream& operator>>(std::string& data) {
-		return *this >> prefixed(data);
+	template<typename T, typename table_type>
+	requires std::same_as<T, std::string> || std::same_as<T, std::string_view>
+	binary_stream& operator>>(deduplicated_string<T, table_type> adaptor) {
+		const auto tag = varint_decode<std::size_t>(*this);
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		const auto value = tag >> 1;
+
+		if(tag & 1) {
+			if(value >= adaptor.table.size()) [[unlikely]] {
+				state_ = stream_state::invalid_tag_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(invalid_string_reference(value, adaptor.table.size()));
+				}
+
+				return *this;
+			}
+
+			adaptor.str = adaptor.table[value];
+		} else if constexpr(std::is_same_v<contiguous_type, is_contiguous>) {
+			const std::string_view view { span<char>(static_cast<size_type>(value)) };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.table.add(view);
+			}
+		} else {
+			std::string string;
+			get(string, static_cast<size_type>(value));
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.table.add(std::move(string));
+			}
+		}
+
+		return *this;
 	}
 
 	/**
@@ -743,7 +1526,8 @@ public:
 	 * @return Reference to the current stream.
 	 */
 	template<pod T>
-	requires (!has_shr_override<T, binary_stream> && !arithmetic<T>)
+	requires (!has_shr_override<T, binary_stream> && !arithmetic<T>
+		&& !has_deserialise<T, binary_stream>)
 	binary_stream& operator>>(T& data) {
 		SAFE_READ(&data, sizeof(data), *this);
 		return *this;
@@ -782,6 +1566,302 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Deserialises a std::variant that was previously written with
+	 * a tag holding the index of the active alternative.
+	 * 
+	 * The alternative is constructed in place (or reused, if it is already
+	 * active) through a table indexed by the tag. A tag that doesn't
+	 * correspond to an alternative will put the stream into an error state
+	 * and leave the variant untouched.
+	 * 
+	 * @tparam tag_type The integral type used to write the index.
+	 * @param[out] adaptor The variant to hold the result. Each alternative
+	 * must be default constructible.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::integral tag_type, variant_like T>
+	binary_stream& operator>>(tagged_variant<tag_type, T> adaptor) {
+		static constexpr auto decoders = make_variant_decoders<T>();
+
+		tag_type tag{};
+		*this >> tag;
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		if(std::cmp_less(tag, 0) || std::cmp_greater_equal(tag, decoders.size())) {
+			state_ = stream_state::invalid_tag_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(invalid_variant_tag(static_cast<std::size_t>(tag), decoders.size()));
+			}
+
+			return *this;
+		}
+
+		decoders[static_cast<std::size_t>(tag)](*this, adaptor.value);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a std::variant that was previously written with
+	 * a std::uint8_t tag holding the index of the active alternative.
+	 * 
+	 * @param[out] data The variant to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<variant_like T>
+	binary_stream& operator>>(T& data) {
+		return *this >> tagged(data);
+	}
+
+	/**
+	 * @brief Deserialises a container of integers that was serialised as
+	 * bit-packed deltas. See delta_packed for the format.
+	 * 
+	 * @tparam T The container type.
+	 * @param[out] adaptor delta_packed adaptor referencing the container to
+	 * hold the result.
+	 * 
+	 * @note A block with a bit width wider than the element type results in
+	 * stream_state::invalid_bit_width_err.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<delta_packable T>
+	requires has_resize<T> && has_clear<T>
+	binary_stream& operator>>(delta_packed<T> adaptor) {
+		using value_type = std::ranges::range_value_t<T>;
+		using unsigned_type = std::make_unsigned_t<value_type>;
+		constexpr auto max_width = std::numeric_limits<unsigned_type>::digits;
+
+		auto& container = adaptor.values;
+		container.clear();
+
+		std::uint32_t count = 0;
+		*this >> endian::le(count);
+
+		if(state_ != stream_state::ok || !count) {
+			return *this;
+		}
+
+		if(!charge_allocation(count, sizeof(value_type))) [[unlikely]] {
+			return *this;
+		}
+
+		unsigned_type base{};
+		*this >> base;
+
+		bp128_seed<unsigned_type> seed;
+		seed.fill(base);
+		std::array<std::uint32_t, bp128_max_words> words;
+		const auto blocks = count / bp128_block_size;
+
+		for(std::size_t i = 0; i < blocks; ++i) {
+			std::uint8_t width = 0;
+			*this >> width;
+
+			if(state_ != stream_state::ok) {
+				return *this;
+			}
+
+			if(width > max_width) [[unlikely]] {
+				state_ = stream_state::invalid_bit_width_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(invalid_bit_width(width, max_width));
+				}
+
+				return *this;
+			}
+
+			const auto in = std::span(words).first(width * bp128_lanes);
+			SAFE_READ(in.data(), static_cast<size_type>(in.size_bytes()), *this);
+
+			for(auto& word : in) {
+				endian::storage_out(word, byte_order);
+			}
+
+			const auto offset = i * bp128_block_size;
+			container.resize(offset + bp128_block_size);
+			const auto values = reinterpret_cast<unsigned_type*>(std::ranges::data(container));
+			bp128_decode(words.data(), width, seed, values + offset);
+		}
+
+		const auto offset = blocks * bp128_block_size;
+		container.resize(count);
+
+		const auto values = reinterpret_cast<unsigned_type*>(std::ranges::data(container));
+		auto prev = blocks? seed.back() : base;
+
+		for(auto i = offset; i < count; ++i) {
+			prev += varint_decode<unsigned_type>(*this);
+			values[i] = prev;
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises floats that were serialised as IEEE 754 binary16.
+	 * 
+	 * @param[out] adaptor half adaptor referencing the values to hold the
+	 * result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(half adaptor) {
+		read_encoded<std::uint16_t>(adaptor.values, [](auto in, auto out) {
+			from_half(in, out);
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises quantised floating point values.
+	 * 
+	 * @tparam T The floating point type.
+	 * @param[out] adaptor quantised adaptor referencing the values to hold
+	 * the result, with the same range and bits they were serialised with.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::floating_point T>
+	binary_stream& operator>>(quantised<T> adaptor) {
+		if(!check_bit_width(adaptor.bits, 1, max_quantise_bits<T>)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(adaptor.bits, [&]<typename word_type>(std::type_identity<word_type>) {
+			read_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				dequantise<T>(in, out, adaptor.min, adaptor.max, adaptor.bits);
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises unit quaternions that were serialised with the
+	 * smallest three encoding.
+	 * 
+	 * @tparam T The quaternion type.
+	 * @param[out] adaptor smallest_three adaptor referencing the values to
+	 * hold the result, with the same bits they were serialised with.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<quaternion T>
+	binary_stream& operator>>(smallest_three<T> adaptor) {
+		if(!check_bit_width(adaptor.bits, min_smallest_three_bits, max_smallest_three_bits)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(2 + (adaptor.bits * 3), [&]<typename word_type>(std::type_identity<word_type>) {
+			read_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				for(std::size_t i = 0; i < in.size(); ++i) {
+					decode_smallest_three(in[i], out[i], adaptor.bits);
+				}
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Returns an input range that deserialises elements from the
+	 * stream as it is iterated, e.g:
+	 * 
+	 * for(auto& value : stream.read_range<std::uint32_t>(count)) { ... }
+	 * 
+	 * No container is created, so elements can be folded or filtered
+	 * without the cost of reserving storage for all of them.
+	 * 
+	 * @tparam T The element type.
+	 * @param count The number of elements to read.
+	 * 
+	 * @note The stream must outlive the range and should not be read from
+	 * by anything else until iteration has finished.
+	 * 
+	 * @return An input range over the elements.
+	 */
+	template<std::default_initializable T>
+	stream_range<binary_stream, T> read_range(const size_type count) {
+		return { *this, count };
+	}
+
+	/**
+	 * @brief Creates a child stream bounded to the next length bytes of
+	 * this stream, e.g. for reading the value of a TLV element:
+	 * 
+	 * auto slice = stream.slice(length);
+	 * slice >> value;
+	 * 
+	 * The child reads directly from this stream's buffer, so no data is
+	 * copied. Once the slice is destroyed, this stream will have advanced
+	 * by exactly length bytes, even if the child read less or errored,
+	 * which makes skipping an element a constant time operation. Slices
+	 * can be nested, with each bounded by its parent.
+	 * 
+	 * @param length The number of bytes the slice covers.
+	 * 
+	 * @note This stream must not be read from while the slice is alive.
+	 * If this stream doesn't contain length bytes, the child stream will
+	 * be in the same error state as this stream.
+	 * 
+	 * @return The slice, holding the child stream.
+	 */
+	auto slice(const size_type length) {
+		using base_type = typename slice_base<buf_type>::type;
+		using child_type = binary_stream<slice_buffer<base_type>, exceptions, endianness>;
+		using slice_type = stream_slice<child_type>;
+
+		const bool valid = state_ == stream_state::ok && check_read_bounds(length);
+
+		if(valid) {
+			total_read_ += length;
+		}
+
+		if constexpr(std::is_same_v<buf_type, slice_buffer<base_type>>) {
+			return slice_type(buffer_.base(), valid? length : 0, &buffer_, state_);
+		} else {
+			return slice_type(buffer_, valid? length : 0, nullptr, state_);
+		}
+	}
+
+	/**
+	 * @brief Begins a transaction, returning a child stream that reads
+	 * from this stream's buffer without consuming anything from it, e.g:
+	 * 
+	 * auto tx = stream.begin_transaction();
+	 * tx >> header >> body;
+	 * 
+	 * if(tx) {
+	 *     tx.commit();
+	 * }
+	 * 
+	 * Until commit is called, nothing is consumed or freed from the buffer,
+	 * so if a message has only been partially received, the transaction
+	 * can simply be dropped and the parse attempted again once more data
+	 * has arrived, without having to copy the buffer beforehand.
+	 * 
+	 * @note This stream must not be used while the transaction is alive.
+	 * 
+	 * @return The transaction, holding the child stream.
+	 */
+	auto begin_transaction() requires transactional<buf_type> {
+		using tx_buffer = transaction_buffer<buf_type>;
+		using child_type = binary_stream<tx_buffer, exceptions, endianness>;
+		using tx_type = stream_transaction<child_type, binary_stream>;
+
+		return tx_type(*this, buffer_, read_limit_, total_read_, state_);
+	}
+
 	/**
 	 * @brief Read an arithmetic type from the stream.
 	 * 
@@ -846,11 +1926,15 @@ public:
 	 * @param count The number of bytes to be read.
 	 */
 	void get(std::string& dest, size_type size) {
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, void());
 
-		dest.resize_and_overwrite(size, [&](char* strbuf, size_type len) {
-			buffer_.read(strbuf, len);
-			return len;
+		dest.resize_and_overwrite(size, [&](char* strbuf, size_type) {
+			buffer_.read(strbuf, size);
+			return size;
 		});
 	}
 
@@ -991,7 +2075,7 @@ public:
 	 * 
 	 * @return The size of the underlying buffer.
 	 */
-	size_type size() const {
+	constexpr size_type size() const {
 		return buffer_.size();
 	}
 
@@ -1001,35 +2085,35 @@ public:
 	 * @return Returns true if the stream is empty (has no data to be read).
 	 */
 	[[nodiscard]]
-	bool empty() const {
+	constexpr bool empty() const {
 		return buffer_.empty();
 	}
 
 	/**
 	 * @return The total number of bytes written to the stream.
 	 */
-	size_type total_write() const requires writeable<buf_type> {
+	constexpr size_type total_write() const requires writeable<buf_type> {
 		return total_write_;
 	}
 
 	/**
 	 * @return Pointer to stream's underlying buffer.
 	 */
-	const buf_type* buffer() const {
+	constexpr const buf_type* buffer() const {
 		return &buffer_;
 	}
 
 	/**
 	 * @return Pointer to stream's underlying buffer.
 	 */
-	buf_type* buffer() {
+	constexpr buf_type* buffer() {
 		return &buffer_;
 	}
 
 	/**
 	 * @return The stream's state.
 	 */
-	stream_state state() const {
+	constexpr stream_state state() const {
 		return state_;
 	}
 
@@ -1048,6 +2132,58 @@ public:
 		return read_limit_;
 	}
 
+	/**
+	 * @brief Controls whether deserialising into a non-empty container
+	 * overwrites its existing elements in place, rather than clearing it
+	 * and constructing new elements.
+	 * 
+	 * Enabling this allows storage owned by the elements (e.g. the capacity
+	 * of each string in a std::vector<std::string>) to be reused when
+	 * repeatedly deserialising into the same objects. Element types must
+	 * overwrite all of their state when deserialised.
+	 * 
+	 * @param enable Whether existing elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @brief Sets an upper limit on the number of bytes that container and
+	 * string reads may allocate over the lifetime of the stream, guarding
+	 * against untrusted length prefixes.
+	 * 
+	 * Exceeding the limit puts the stream into an error state.
+	 * 
+	 * @param limit The allocation limit in bytes, or zero for no limit.
+	 */
+	void set_allocation_limit(const size_type limit) {
+		alloc_limit_ = limit;
+	}
+
+	/**
+	 * @return The allocation limit, or zero if no limit was set.
+	 */
+	size_type allocation_limit() const {
+		return alloc_limit_;
+	}
+
+	/**
+	 * @return The total number of bytes allocated by container and string
+	 * reads while an allocation limit was set.
+	 */
+	size_type allocated() const {
+		return allocated_;
+	}
+
 	/**
 	 * @brief Determine the maximum number of bytes that can be
 	 * safely read from this stream.
@@ -1060,8 +2196,8 @@ public:
 	 */
 	size_type read_max() const {
 		if(read_limit_) {
-			assert(total_read_ < read_limit_);
-			return read_limit_ - total_read_;
+			assert(total_read_ <= read_limit_);
+			return std::min<size_type>(read_limit_ - total_read_, buffer_.size());
 		} else {
 			return buffer_.size();
 		}
@@ -1072,7 +2208,7 @@ public:
 	 * 
 	 * @return true if no errors have occurred.
 	 */
-	bool good() const {
+	constexpr bool good() const {
 		return state_ == stream_state::ok;
 	}
 
@@ -1085,7 +2221,7 @@ public:
 		state_ = stream_state::ok;
 	}
 
-	operator bool() const {
+	constexpr operator bool() const {
 		return good();
 	}
 
@@ -0,0 +1,297 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <array>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+namespace detail {
+
+template<std::size_t bits>
+using bits_type = std::conditional_t<bits <= 8, std::uint8_t,
+	std::conditional_t<bits <= 16, std::uint16_t,
+	std::conditional_t<bits <= 32, std::uint32_t, std::uint64_t>>>;
+
+} // detail
+
+/**
+ * Reads and writes values at bit granularity, on top of a binary_stream
+ * over the given buffer. Bits are packed least significant first, both
+ * within values and within each byte, as used by update masks.
+ *
+ * Writes are gathered in a 64-bit accumulator that's written to the buffer
+ * a word at a time. Call flush once the last bits have been written to pad
+ * the final byte with zeroes and write out anything that's left.
+ *
+ * Reads refill the accumulator with all of the bytes needed to satisfy a
+ * read in one go, but never more, so byte-oriented reads can follow on
+ * from the bit-packed data once align has been called.
+ *
+ * Errors are handled by the underlying stream, with the same bounds
+ * checking and error state model as binary_stream. A failed read returns
+ * zero.
+ *
+ * @tparam buf_type The buffer type.
+ * @tparam exceptions Whether the stream should throw on errors.
+ */
+template<byte_oriented buf_type, std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG>
+class bit_stream final {
+public:
+	using stream_type = binary_stream<buf_type, exceptions, endian::as_little_t>;
+	using size_type = typename buf_type::size_type;
+
+private:
+	static constexpr std::size_t word_bits = 64;
+	static constexpr std::size_t max_op_bits = 32;
+
+	stream_type stream_;
+	std::uint64_t write_acc_ = 0;
+	std::size_t write_bits_ = 0;
+	std::uint64_t read_acc_ = 0;
+	std::size_t read_bits_ = 0;
+	size_type total_bits_written_ = 0;
+	size_type total_bits_read_ = 0;
+
+	static constexpr std::uint64_t mask(const std::size_t bits) {
+		return bits >= word_bits? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+	}
+
+	void flush_word() {
+		stream_ << write_acc_;
+		write_acc_ = 0;
+		write_bits_ = 0;
+	}
+
+	void write_bits(std::uint64_t value, const std::size_t count) {
+		assert(count <= max_op_bits);
+		value &= mask(count);
+		write_acc_ |= value << write_bits_;
+
+		const auto free_bits = word_bits - write_bits_;
+
+		if(count < free_bits) {
+			write_bits_ += count;
+			return;
+		}
+
+		flush_word();
+
+		// carry over the bits that didn't fit into the previous word
+		if(count > free_bits) {
+			write_acc_ = value >> free_bits;
+			write_bits_ = count - free_bits;
+		}
+	}
+
+	std::uint64_t read_bits(const std::size_t count) {
+		assert(count <= max_op_bits);
+
+		if(read_bits_ < count) {
+			const auto needed = (count - read_bits_ + 7) / 8;
+			std::array<std::uint8_t, 8> bytes{};
+			stream_.get(bytes.data(), needed);
+
+			if(!stream_) [[unlikely]] {
+				return 0;
+			}
+
+			for(std::size_t i = 0; i < needed; ++i) {
+				read_acc_ |= std::uint64_t(bytes[i]) << read_bits_;
+				read_bits_ += 8;
+			}
+		}
+
+		const auto value = read_acc_ & mask(count);
+		read_acc_ >>= count;
+		read_bits_ -= count;
+		return value;
+	}
+
+public:
+	explicit bit_stream(buf_type& buffer)
+		: stream_(buffer) {}
+
+	bit_stream(buf_type& buffer, exceptions)
+		: stream_(buffer) {}
+
+	bit_stream(const bit_stream&) = delete;
+	bit_stream& operator=(const bit_stream&) = delete;
+
+	~bit_stream() {
+		assert((!write_bits_ || !stream_) && "bit_stream destroyed without being flushed");
+	}
+
+	/**
+	 * @brief Writes the low bits of a value to the stream.
+	 *
+	 * @param value The value to write.
+	 * @param count The number of bits to write, up to 64.
+	 */
+	void put_bits(const std::uint64_t value, const std::size_t count) {
+		assert(count <= word_bits);
+
+		if(count > max_op_bits) {
+			write_bits(value, max_op_bits);
+			write_bits(value >> max_op_bits, count - max_op_bits);
+		} else {
+			write_bits(value, count);
+		}
+
+		total_bits_written_ += count;
+	}
+
+	/**
+	 * @brief Writes each bool as a single bit.
+	 *
+	 * @param bits The bools to write.
+	 */
+	void put_bits(std::span<const bool> bits) {
+		for(const auto bit : bits) {
+			write_bits(bit, 1);
+		}
+
+		total_bits_written_ += bits.size();
+	}
+
+	void put_bit(const bool bit) {
+		write_bits(bit, 1);
+		++total_bits_written_;
+	}
+
+	/**
+	 * @brief Reads a value of the given number of bits from the stream.
+	 *
+	 * @tparam count The number of bits to read, up to 64.
+	 *
+	 * @return The value, in the smallest unsigned type that can hold it.
+	 */
+	template<std::size_t count>
+	requires (count > 0 && count <= word_bits)
+	detail::bits_type<count> get_bits() {
+		return static_cast<detail::bits_type<count>>(get_bits(count));
+	}
+
+	/**
+	 * @brief Reads a value of the given number of bits from the stream.
+	 *
+	 * @param count The number of bits to read, up to 64.
+	 *
+	 * @return The value.
+	 */
+	std::uint64_t get_bits(const std::size_t count) {
+		assert(count <= word_bits);
+		std::uint64_t value = 0;
+
+		if(count > max_op_bits) {
+			value = read_bits(max_op_bits);
+			value |= read_bits(count - max_op_bits) << max_op_bits;
+		} else {
+			value = read_bits(count);
+		}
+
+		if(stream_) [[likely]] {
+			total_bits_read_ += count;
+		}
+
+		return stream_? value : 0;
+	}
+
+	/**
+	 * @brief Reads a single bit into each bool.
+	 *
+	 * @param[out] bits The bools to read into.
+	 */
+	void get_bits(std::span<bool> bits) {
+		for(auto& bit : bits) {
+			bit = read_bits(1);
+		}
+
+		if(stream_) [[likely]] {
+			total_bits_read_ += bits.size();
+		}
+	}
+
+	bool get_bit() {
+		return get_bits(1);
+	}
+
+	/**
+	 * @brief Pads the bits written so far to a byte boundary and writes
+	 * them out to the buffer. Must be called after the last write.
+	 */
+	void flush() {
+		const auto bytes = (write_bits_ + 7) / 8;
+
+		if(!bytes) {
+			return;
+		}
+
+		std::array<std::uint8_t, 8> out{};
+
+		for(std::size_t i = 0; i < bytes; ++i) {
+			out[i] = static_cast<std::uint8_t>(write_acc_ >> (i * 8));
+		}
+
+		stream_.put(out.data(), bytes);
+		total_bits_written_ += (bytes * 8) - write_bits_;
+		write_acc_ = 0;
+		write_bits_ = 0;
+	}
+
+	/**
+	 * @brief Skips any bits remaining in the current byte, so that the next
+	 * read starts on a byte boundary.
+	 */
+	void align() {
+		total_bits_read_ += read_bits_;
+		read_acc_ = 0;
+		read_bits_ = 0;
+	}
+
+	/**
+	 * @return The total number of bits written, including flush padding.
+	 */
+	size_type total_bits_written() const {
+		return total_bits_written_;
+	}
+
+	/**
+	 * @return The total number of bits read, including skipped bits.
+	 */
+	size_type total_bits_read() const {
+		return total_bits_read_;
+	}
+
+	stream_type& stream() {
+		return stream_;
+	}
+
+	stream_state state() const {
+		return stream_.state();
+	}
+
+	bool good() const {
+		return stream_.good();
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
@@ -0,0 +1,81 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/shared.h>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * @brief Creates a stream over the buffer with a byte order chosen at
+ * runtime and passes it to the function. This is for protocols and files
+ * that negotiate their byte order, e.g. with a byte order marker.
+ *
+ * The function is instantiated once for each byte order, so the only
+ * runtime cost is a single branch per call, rather than one per field.
+ *
+ * @tparam exceptions Whether the stream should throw on errors.
+ * @param order The byte order of the data.
+ * @param buffer The buffer to create the stream over.
+ * @param read_limit The read limit for the stream, or zero for no limit.
+ * @param func Callable accepting either stream type. It must return the
+ * same type for both.
+ *
+ * @return The result of invoking the function.
+ */
+template<std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+	byte_oriented buf_type, typename func_type>
+requires std::same_as<
+	std::invoke_result_t<func_type, binary_stream<buf_type, exceptions, endian::as_big_t>&>,
+	std::invoke_result_t<func_type, binary_stream<buf_type, exceptions, endian::as_little_t>&>
+>
+decltype(auto) with_byte_order(const std::endian order, buf_type& buffer,
+                               const std::size_t read_limit, func_type&& func) {
+	using size_type = typename buf_type::size_type;
+
+	if(order == std::endian::big) {
+		binary_stream<buf_type, exceptions, endian::as_big_t> stream(
+			buffer, static_cast<size_type>(read_limit)
+		);
+
+		return std::invoke(std::forward<func_type>(func), stream);
+	} else {
+		binary_stream<buf_type, exceptions, endian::as_little_t> stream(
+			buffer, static_cast<size_type>(read_limit)
+		);
+
+		return std::invoke(std::forward<func_type>(func), stream);
+	}
+}
+
+/**
+ * @brief Creates a stream over the buffer with a byte order chosen at
+ * runtime and passes it to the function.
+ *
+ * @tparam exceptions Whether the stream should throw on errors.
+ * @param order The byte order of the data.
+ * @param buffer The buffer to create the stream over.
+ * @param func Callable accepting either stream type. It must return the
+ * same type for both.
+ *
+ * @return The result of invoking the function.
+ */
+template<std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+	byte_oriented buf_type, typename func_type>
+decltype(auto) with_byte_order(const std::endian order, buf_type& buffer, func_type&& func) {
+	return with_byte_order<exceptions>(order, buffer, 0, std::forward<func_type>(func));
+}
+
+} // hexi
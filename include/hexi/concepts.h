@@ -11,6 +11,7 @@
 #include <concepts>
 #include <ranges>
 #include <type_traits>
+#include <variant>
 
 namespace hexi {
 
@@ -36,6 +37,28 @@ concept arithmetic = std::integral<T> || std::floating_point<T>;
 template<typename T>
 concept byte_type = sizeof(T) == 1;
 
+template<typename buf_type>
+concept direct_writeable =
+	requires(buf_type t, typename buf_type::size_type s) {
+		{ t.free() } -> std::convertible_to<typename buf_type::size_type>;
+		{ t.write_ptr() } -> std::convertible_to<const void*>;
+		t.advance_write(s);
+};
+
+template<typename buf_type>
+concept tail_writeable =
+	requires(buf_type t, typename buf_type::size_type s) {
+		{ t.back()->free() } -> std::convertible_to<typename buf_type::size_type>;
+		{ t.back()->write_ptr() } -> std::convertible_to<const void*>;
+		t.advance_write(s);
+};
+
+template<typename buf_type>
+concept fixed_capacity =
+	requires {
+		{ buf_type::capacity() } -> std::convertible_to<typename buf_type::size_type>;
+};
+
 template<typename T>
 concept byte_oriented = byte_type<typename T::value_type>;
 
@@ -66,6 +89,15 @@ concept has_clear =
 		{ t.clear() } -> std::same_as<void>;
 };
 
+template<typename T>
+constexpr bool is_variant_v = false;
+
+template<typename ...Ts>
+constexpr bool is_variant_v<std::variant<Ts...>> = true;
+
+template<typename T>
+concept variant_like = is_variant_v<std::remove_cv_t<T>>;
+
 template<typename T, typename U>
 concept has_shl_override =
 	requires(T t, U& u) {
@@ -104,8 +136,8 @@ concept memcpy_read =
 
 template<typename T, typename U>
 concept memcpy_write =
-	pod<typename T::value_type> && std::ranges::contiguous_range<T>
-		&& !has_shl_override<typename T::value_type, U>
-		&& !has_serialise<typename T::value_type, U>;
+	std::ranges::contiguous_range<T> && pod<std::ranges::range_value_t<T>>
+		&& !has_shl_override<std::ranges::range_value_t<T>, U>
+		&& !has_serialise<std::ranges::range_value_t<T>, U>;
 
 } // hexi
@@ -0,0 +1,305 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+namespace detail {
+
+struct delta_field {
+	std::size_t offset;
+	std::size_t length;
+};
+
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * Serialises each field into a scratch stream and records where each
+ * field's bytes are, so that fields can be compared between snapshots.
+ */
+template<typename stream_type>
+class delta_recorder final {
+	stream_type& stream_;
+	std::vector<delta_field>& fields_;
+
+	void record(auto&& arg) {
+		const auto offset = stream_.total_write();
+		stream_ << arg;
+		fields_.emplace_back(offset, stream_.total_write() - offset);
+	}
+
+public:
+	delta_recorder(stream_type& stream, std::vector<delta_field>& fields)
+		: stream_(stream), fields_(fields) {}
+
+	void operator&(auto&& arg) {
+		record(std::forward<decltype(arg)>(arg));
+	}
+
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		(record(std::forward<Ts>(args)), ...);
+	}
+
+	template<typename ...Ts>
+	void forward(Ts&&... args) {
+		const auto offset = stream_.total_write();
+		stream_.put(std::forward<Ts>(args)...);
+		fields_.emplace_back(offset, stream_.total_write() - offset);
+	}
+};
+
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * Only deserialises the fields that are flagged as present in the mask,
+ * leaving the others untouched. Fields beyond the end of the mask are
+ * never present, with the caller checking that the number of fields
+ * visited matches the mask.
+ */
+template<typename stream_type>
+class delta_applier final {
+	stream_type& stream_;
+	std::span<const std::uint8_t> mask_;
+	std::size_t index_ = 0;
+	std::size_t applied_ = 0;
+
+	bool present() {
+		const auto index = index_++;
+
+		if(index / 8 >= mask_.size()) [[unlikely]] {
+			return false;
+		}
+
+		if(mask_[index / 8] & (1u << (index % 8))) {
+			++applied_;
+			return true;
+		}
+
+		return false;
+	}
+
+public:
+	delta_applier(stream_type& stream, std::span<const std::uint8_t> mask)
+		: stream_(stream), mask_(mask) {}
+
+	void operator&(auto&& arg) {
+		if(present()) {
+			stream_ >> arg;
+		}
+	}
+
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		((*this & std::forward<Ts>(args)), ...);
+	}
+
+	template<typename ...Ts>
+	void forward(Ts&&... args) {
+		if(present()) {
+			stream_.get(std::forward<Ts>(args)...);
+		}
+	}
+
+	std::size_t applied() const {
+		return applied_;
+	}
+
+	std::size_t visited() const {
+		return index_;
+	}
+};
+
+struct field_counter final {
+	std::size_t count = 0;
+
+	void operator&(auto&&) {
+		++count;
+	}
+
+	template<typename ...Ts>
+	void operator()(Ts&&...) {
+		count += sizeof...(Ts);
+	}
+
+	void forward(auto&&...) {
+		++count;
+	}
+};
+
+} // detail
+
+/**
+ * The serialised fields of an object, to be used as the baseline that
+ * later states of the object are delta encoded against. Fields are split
+ * along the calls made by the object's serialise function, with a nested
+ * serialisable object being treated as a single field.
+ *
+ * Keeping a snapshot of the last state acknowledged by the peer avoids
+ * serialising the baseline again for each delta.
+ *
+ * @tparam T The object type, which must provide a serialise function that
+ * visits the same fields regardless of their values.
+ * @tparam endianness The byte order of the stream that deltas are written to.
+ */
+template<typename T, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class delta_snapshot final {
+	std::vector<std::uint8_t> data_;
+	std::vector<detail::delta_field> fields_;
+
+public:
+	explicit delta_snapshot(T& object) {
+		update(object);
+	}
+
+	/**
+	 * @brief Replaces the snapshot with the object's current state.
+	 *
+	 * @param object The object to take a snapshot of.
+	 */
+	void update(T& object) {
+		data_.clear();
+		fields_.clear();
+
+		buffer_adaptor adaptor(data_);
+		binary_stream<decltype(adaptor), no_throw_t, endianness> stream(adaptor);
+		detail::delta_recorder recorder(stream, fields_);
+		object.serialise(recorder);
+	}
+
+	/**
+	 * @return The number of fields in the snapshot.
+	 */
+	std::size_t fields() const {
+		return fields_.size();
+	}
+
+	/**
+	 * @return The serialised bytes of the given field.
+	 */
+	std::span<const std::uint8_t> field(const std::size_t index) const {
+		assert(index < fields_.size());
+		const auto& field = fields_[index];
+		return { data_.data() + field.offset, field.length };
+	}
+};
+
+/**
+ * @brief Writes the changes from a baseline to the object's current state,
+ * as a field presence bitmask followed by only the fields that changed.
+ * The mask has a bit per field, least significant first, rounded up to
+ * a whole number of bytes.
+ *
+ * If the object's serialise function visits a different number of fields
+ * than it did for the baseline, nothing is written and the stream is put
+ * into an error state.
+ *
+ * @param stream The stream to write the delta to.
+ * @param baseline A snapshot of the state that the delta is against.
+ * @param object The object's current state.
+ *
+ * @return The number of fields written.
+ */
+template<typename buf_type, typename exceptions, typename endianness, typename T>
+std::size_t write_delta(binary_stream<buf_type, exceptions, endianness>& stream,
+                        const delta_snapshot<T, endianness>& baseline, T& object) {
+	const delta_snapshot<T, endianness> current(object);
+
+	if(current.fields() != baseline.fields()) [[unlikely]] {
+		stream.set_error_state();
+		return 0;
+	}
+
+	std::vector<std::uint8_t> mask((current.fields() + 7) / 8);
+	std::size_t changed = 0;
+
+	for(std::size_t i = 0; i < current.fields(); ++i) {
+		if(!std::ranges::equal(current.field(i), baseline.field(i))) {
+			mask[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+			++changed;
+		}
+	}
+
+	stream.put(mask.data(), mask.size());
+
+	for(std::size_t i = 0; i < current.fields(); ++i) {
+		if(mask[i / 8] & (1u << (i % 8))) {
+			const auto field = current.field(i);
+			stream.put(field.data(), field.size());
+		}
+	}
+
+	return changed;
+}
+
+/**
+ * @brief Writes the changes from the baseline to the object's current
+ * state. See the overload taking a snapshot for the format.
+ *
+ * @param stream The stream to write the delta to.
+ * @param baseline The state that the delta is against.
+ * @param object The object's current state.
+ *
+ * @return The number of fields written.
+ */
+template<typename buf_type, typename exceptions, typename endianness, typename T>
+std::size_t write_delta(binary_stream<buf_type, exceptions, endianness>& stream,
+                        T& baseline, T& object) {
+	return write_delta(stream, delta_snapshot<T, endianness>(baseline), object);
+}
+
+/**
+ * @brief Reads a delta written by write_delta and applies it to the object,
+ * which must hold the same baseline state that the delta was written
+ * against. Fields that didn't change are left untouched.
+ *
+ * If the object's serialise function visits a different number of fields
+ * while the delta is applied than it did when the mask was sized, e.g.
+ * because a field it depends on changed, the stream is put into an error
+ * state.
+ *
+ * @param stream The stream to read the delta from.
+ * @param[in, out] object The baseline to apply the delta to.
+ *
+ * @return The number of fields read.
+ */
+template<typename stream_type, typename T>
+std::size_t read_delta(stream_type& stream, T& object) {
+	detail::field_counter counter;
+	object.serialise(counter);
+
+	std::vector<std::uint8_t> mask((counter.count + 7) / 8);
+	stream.get(mask.data(), mask.size());
+
+	if(!stream) [[unlikely]] {
+		return 0;
+	}
+
+	detail::delta_applier applier(stream, mask);
+	object.serialise(applier);
+
+	if(applier.visited() != counter.count) [[unlikely]] {
+		stream.set_error_state();
+	}
+
+	return applier.applied();
+}
+
+} // hexi
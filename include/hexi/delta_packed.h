@@ -0,0 +1,253 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/detail/simd.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+/**
+ * Serialises a contiguous container of integers, ideally sorted, as deltas
+ * bit-packed in blocks of 128, in the style of BP128:
+ *
+ * - std::uint32_t element count, little endian, as with prefixed
+ * - the first element, if there is one
+ * - for each complete block of 128 elements, a std::uint8_t bit width
+ *   followed by width * 4 std::uint32_t words of packed deltas
+ * - the remaining elements as varint encoded deltas
+ *
+ * Within a block, the deltas are taken against the element four places
+ * before (with the first element as the initial predecessor) and packed
+ * into four interleaved lanes, so that packing and unpacking can be done
+ * four elements at a time with SIMD.
+ *
+ * Deltas wrap around, so unsorted sequences also round trip, just without
+ * being compressed as well. Reading a block whose bit width is wider than
+ * the element type results in stream_state::invalid_bit_width_err.
+ */
+template<typename container_type>
+struct delta_packed {
+	container_type& values;
+};
+
+template<typename container_type>
+delta_packed(container_type&) -> delta_packed<container_type>;
+
+template<typename T>
+concept delta_packable = std::ranges::contiguous_range<T>
+	&& std::integral<std::ranges::range_value_t<T>>
+	&& !std::same_as<std::ranges::range_value_t<T>, bool>;
+
+namespace detail {
+
+constexpr std::size_t bp128_block_size = 128;
+constexpr std::size_t bp128_lanes = 4;
+constexpr std::size_t bp128_lane_values = bp128_block_size / bp128_lanes;
+
+// enough words for a block of 64-bit deltas
+constexpr std::size_t bp128_max_words = bp128_lanes * 64;
+
+template<std::unsigned_integral T>
+using bp128_seed = std::array<T, bp128_lanes>;
+
+constexpr std::uint32_t bp128_mask(const unsigned int bits) {
+	return bits >= 32? ~std::uint32_t(0) : (std::uint32_t(1) << bits) - 1;
+}
+
+/*
+ * Scalar fallback, which also handles elements wider than 32 bits. Each
+ * lane's deltas are packed least significant bit first into the lane's
+ * words, which are interleaved with those of the other lanes.
+ */
+template<std::unsigned_integral T>
+unsigned int bp128_encode_scalar(const T* values, bp128_seed<T>& seed, std::uint32_t* words) {
+	std::array<T, bp128_block_size> deltas;
+	T bits = 0;
+
+	for(std::size_t i = 0; i < deltas.size(); ++i) {
+		const auto prev = i < bp128_lanes? seed[i] : values[i - bp128_lanes];
+		deltas[i] = static_cast<T>(values[i] - prev);
+		bits |= deltas[i];
+	}
+
+	std::copy_n(values + bp128_block_size - bp128_lanes, bp128_lanes, seed.begin());
+	const auto width = static_cast<unsigned int>(std::bit_width(bits));
+	std::fill_n(words, width * bp128_lanes, 0);
+
+	for(std::size_t lane = 0; lane < bp128_lanes; ++lane) {
+		unsigned int pos = 0;
+
+		for(std::size_t i = 0; i < bp128_lane_values; ++i) {
+			std::uint64_t value = deltas[(i * bp128_lanes) + lane];
+
+			for(unsigned int remaining = width; remaining;) {
+				const auto offset = pos % 32;
+				const auto take = std::min(32 - offset, remaining);
+				auto& word = words[((pos / 32) * bp128_lanes) + lane];
+				word |= static_cast<std::uint32_t>(value & bp128_mask(take)) << offset;
+				value >>= take;
+				pos += take;
+				remaining -= take;
+			}
+		}
+	}
+
+	return width;
+}
+
+template<std::unsigned_integral T>
+void bp128_decode_scalar(const std::uint32_t* words, const unsigned int width,
+                         bp128_seed<T>& seed, T* values) {
+	for(std::size_t lane = 0; lane < bp128_lanes; ++lane) {
+		unsigned int pos = 0;
+		auto prev = seed[lane];
+
+		for(std::size_t i = 0; i < bp128_lane_values; ++i) {
+			std::uint64_t value = 0;
+
+			for(unsigned int got = 0; got < width;) {
+				const auto offset = pos % 32;
+				const auto take = std::min(32 - offset, width - got);
+				const auto word = words[((pos / 32) * bp128_lanes) + lane];
+				value |= std::uint64_t((word >> offset) & bp128_mask(take)) << got;
+				pos += take;
+				got += take;
+			}
+
+			prev = static_cast<T>(prev + value);
+			values[(i * bp128_lanes) + lane] = prev;
+		}
+	}
+
+	std::copy_n(values + bp128_block_size - bp128_lanes, bp128_lanes, seed.begin());
+}
+
+#ifdef HEXI_HAS_SSE2
+/*
+ * All four lanes share the same bit positions, so each step packs or
+ * unpacks one delta for every lane with a single shift.
+ */
+inline unsigned int bp128_encode_sse2(const std::uint32_t* values, bp128_seed<std::uint32_t>& seed,
+                                      std::uint32_t* words) {
+	alignas(16) std::array<std::uint32_t, bp128_block_size> deltas;
+	auto prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seed.data()));
+	auto bits = _mm_setzero_si128();
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		const auto current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+		const auto delta = _mm_sub_epi32(current, prev);
+		_mm_store_si128(reinterpret_cast<__m128i*>(deltas.data() + i), delta);
+		bits = _mm_or_si128(bits, delta);
+		prev = current;
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(seed.data()), prev);
+
+	alignas(16) std::array<std::uint32_t, bp128_lanes> lanes;
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), bits);
+	const auto width = static_cast<unsigned int>(std::bit_width(lanes[0] | lanes[1] | lanes[2] | lanes[3]));
+
+	auto out = reinterpret_cast<__m128i*>(words);
+	auto word = _mm_setzero_si128();
+	unsigned int offset = 0;
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		const auto delta = _mm_load_si128(reinterpret_cast<const __m128i*>(deltas.data() + i));
+		word = _mm_or_si128(word, _mm_sll_epi32(delta, _mm_cvtsi32_si128(static_cast<int>(offset))));
+		offset += width;
+
+		if(offset >= 32) {
+			_mm_storeu_si128(out++, word);
+			offset -= 32;
+
+			// carry over the bits that didn't fit into the previous word
+			word = offset? _mm_srl_epi32(delta, _mm_cvtsi32_si128(static_cast<int>(width - offset)))
+				: _mm_setzero_si128();
+		}
+	}
+
+	return width;
+}
+
+inline void bp128_decode_sse2(const std::uint32_t* words, const unsigned int width,
+                              bp128_seed<std::uint32_t>& seed, std::uint32_t* values) {
+	const auto in = reinterpret_cast<const __m128i*>(words);
+	const auto mask = _mm_set1_epi32(static_cast<int>(bp128_mask(width)));
+	auto prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seed.data()));
+	auto word = width? _mm_loadu_si128(in) : _mm_setzero_si128();
+	unsigned int offset = 0;
+	std::size_t index = 0;
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		auto delta = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(offset)));
+		offset += width;
+
+		if(offset >= 32) {
+			offset -= 32;
+
+			if(++index < width) {
+				word = _mm_loadu_si128(in + index);
+
+				if(offset) {
+					const auto shift = _mm_cvtsi32_si128(static_cast<int>(width - offset));
+					delta = _mm_or_si128(delta, _mm_sll_epi32(word, shift));
+				}
+			}
+		}
+
+		prev = _mm_add_epi32(prev, _mm_and_si128(delta, mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), prev);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(seed.data()), prev);
+}
+#endif
+
+/*
+ * Encodes a block of 128 values as deltas against the seed, which is
+ * updated to the last four values of the block. Returns the bit width,
+ * with width * 4 words having been written.
+ */
+template<std::unsigned_integral T>
+unsigned int bp128_encode(const T* values, bp128_seed<T>& seed, std::uint32_t* words) {
+#ifdef HEXI_HAS_SSE2
+	if constexpr(std::is_same_v<T, std::uint32_t>) {
+		return bp128_encode_sse2(values, seed, words);
+	}
+#endif
+
+	return bp128_encode_scalar(values, seed, words);
+}
+
+template<std::unsigned_integral T>
+void bp128_decode(const std::uint32_t* words, const unsigned int width,
+                  bp128_seed<T>& seed, T* values) {
+	assert(width <= std::numeric_limits<T>::digits);
+
+#ifdef HEXI_HAS_SSE2
+	if constexpr(std::is_same_v<T, std::uint32_t>) {
+		bp128_decode_sse2(words, width, seed, values);
+		return;
+	}
+#endif
+
+	bp128_decode_scalar(words, width, seed, values);
+}
+
+} // detail
+
+} // hexi
@@ -12,6 +12,7 @@
 
 #include <hexi/shared.h>
 #include <hexi/concepts.h>
+#include <hexi/detail/non_temporal_copy.h>
 #include <array>
 #include <concepts>
 #include <span>
@@ -54,6 +55,8 @@ struct intrusive_storage final {
 	 * 
 	 * If the container size is lower than requested number of bytes,
 	 * the request will be capped at the number of bytes available.
+	 * Requests of at least HEXI_NON_TEMPORAL_THRESHOLD bytes, if set, use
+	 * non-temporal stores.
 	 * 
 	 * @note The source buffer must not overlap with the underlying buffer.
 	 * 
@@ -70,7 +73,7 @@ struct intrusive_storage final {
 			write_len = length;
 		}
 
-		std::memcpy(storage.data() + write_offset, source, write_len);
+		threshold_copy(storage.data() + write_offset, source, write_len, length);
 		write_offset += static_cast<offset_type>(write_len);
 		return write_len;
 	}
@@ -81,6 +84,8 @@ struct intrusive_storage final {
 	 * 
 	 * If the container size is lower than requested number of bytes,
 	 * the request will be capped at the number of bytes available.
+	 * Requests of at least HEXI_NON_TEMPORAL_THRESHOLD bytes, if set, use
+	 * non-temporal stores.
 	 * 
 	 * @note The destination buffer must not overlap with the underlying buffer.
 	 * 
@@ -97,7 +102,7 @@ struct intrusive_storage final {
 			read_len = length;
 		}
 
-		std::memcpy(destination, storage.data() + read_offset, read_len);
+		threshold_copy(destination, storage.data() + read_offset, read_len, length);
 		return read_len;
 	}
 
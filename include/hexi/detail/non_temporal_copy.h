@@ -0,0 +1,109 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/detail/simd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Copies into and out of dynamic buffer storage that are part of an
+ * operation at least this large use non-temporal stores, so that streaming
+ * large payloads through a buffer evicts less of everything else from the
+ * cache, at the cost of copy throughput and of the data being cold when
+ * it's next read. Whether that's a win depends heavily on the cache
+ * hierarchy, so it's disabled by default (zero) and should be enabled with
+ * a value such as (1024 * 1024) only where it has been measured to help.
+ */
+#ifndef HEXI_NON_TEMPORAL_THRESHOLD
+#define HEXI_NON_TEMPORAL_THRESHOLD 0
+#endif
+
+namespace hexi::detail {
+
+constexpr std::size_t non_temporal_threshold = HEXI_NON_TEMPORAL_THRESHOLD;
+
+/**
+ * @brief Copies with non-temporal stores, prefetching the source ahead of
+ * the copy. The destination is aligned with a regular copy first and any
+ * remainder of less than a cache line is also copied regularly. Falls back
+ * to memcpy where SSE2 isn't available.
+ *
+ * @note The source and destination must not overlap.
+ *
+ * @param[out] destination The buffer to copy the data to.
+ * @param source The data to copy.
+ * @param length The number of bytes to copy.
+ */
+inline void non_temporal_copy(void* destination, const void* source, std::size_t length) {
+#ifdef HEXI_HAS_SSE2
+	constexpr std::size_t line_size = 64;
+	constexpr std::size_t prefetch_distance = line_size * 8;
+
+	auto dest = static_cast<std::byte*>(destination);
+	auto src = static_cast<const std::byte*>(source);
+
+	const auto misalignment = reinterpret_cast<std::uintptr_t>(dest) & 15;
+
+	if(misalignment) {
+		const auto head = length < 16 - misalignment? length : 16 - misalignment;
+		std::memcpy(dest, src, head);
+		dest += head;
+		src += head;
+		length -= head;
+	}
+
+	for(; length >= line_size; length -= line_size) {
+		_mm_prefetch(reinterpret_cast<const char*>(src + prefetch_distance), _MM_HINT_NTA);
+
+		const auto in = reinterpret_cast<const __m128i*>(src);
+		const auto v0 = _mm_loadu_si128(in);
+		const auto v1 = _mm_loadu_si128(in + 1);
+		const auto v2 = _mm_loadu_si128(in + 2);
+		const auto v3 = _mm_loadu_si128(in + 3);
+
+		const auto out = reinterpret_cast<__m128i*>(dest);
+		_mm_stream_si128(out, v0);
+		_mm_stream_si128(out + 1, v1);
+		_mm_stream_si128(out + 2, v2);
+		_mm_stream_si128(out + 3, v3);
+
+		src += line_size;
+		dest += line_size;
+	}
+
+	// non-temporal stores are weakly ordered, so fence before anything else can see them
+	_mm_sfence();
+	std::memcpy(dest, src, length);
+#else
+	std::memcpy(destination, source, length);
+#endif
+}
+
+/**
+ * @brief Copies part of a larger operation, choosing between memcpy and
+ * non-temporal stores based on the operation's size.
+ *
+ * @note The source and destination must not overlap.
+ *
+ * @param[out] destination The buffer to copy the data to.
+ * @param source The data to copy.
+ * @param length The number of bytes to copy.
+ * @param total The number of bytes remaining in the operation, including
+ * this copy.
+ */
+inline void threshold_copy(void* destination, const void* source, const std::size_t length,
+                           const std::size_t total) {
+	if(non_temporal_threshold && total >= non_temporal_threshold) [[unlikely]] {
+		non_temporal_copy(destination, source, length);
+	} else {
+		std::memcpy(destination, source, length);
+	}
+}
+
+} // detail, hexi
@@ -0,0 +1,28 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+/*
+ * Instruction set extensions available to the target, detected once so
+ * that headers with SIMD paths agree on what can be used. MSVC doesn't
+ * define the GCC/Clang feature macros, so the closest /arch settings that
+ * imply each extension are used instead.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HEXI_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+#define HEXI_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define HEXI_HAS_F16C
+#include <immintrin.h>
+#endif
@@ -0,0 +1,345 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/shared.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+enum class dispatch_result {
+	ok, unknown_opcode, read_error
+};
+
+/**
+ * Binds an opcode to the message type that should be deserialised and the
+ * handler it should be passed to.
+ *
+ * @tparam opcode The opcode value.
+ * @tparam message_type The message to deserialise when the opcode is seen.
+ * Must be default constructible.
+ * @tparam handler A function pointer or captureless lambda, invoked as
+ * handler(message_type&, context...).
+ * @tparam size_limit If non-zero, the maximum number of bytes the message may
+ * read from the buffer. Exceeding it results in a read_limit_err.
+ */
+template<auto opcode, std::default_initializable message_type, auto handler, std::size_t size_limit = 0>
+struct route {
+	using message = message_type;
+	static constexpr auto key = opcode;
+	static constexpr auto func = handler;
+	static constexpr std::size_t limit = size_limit;
+};
+
+namespace detail {
+
+template<typename T>
+constexpr std::uint64_t opcode_key(const T value) {
+	if constexpr(std::is_enum_v<T>) {
+		return static_cast<std::uint64_t>(std::to_underlying(value));
+	} else {
+		return static_cast<std::uint64_t>(value);
+	}
+}
+
+struct hash_params {
+	std::uint64_t multiplier;
+	std::size_t bits;
+
+	constexpr std::size_t operator()(const std::uint64_t key) const {
+		return static_cast<std::size_t>((key * multiplier) >> (64 - bits));
+	}
+};
+
+/*
+ * Searches for a multiplicative hash that maps each key to a unique slot,
+ * starting with a table just large enough to hold the keys and growing it
+ * if no suitable multiplier can be found.
+ */
+template<std::size_t count>
+consteval hash_params find_perfect_hash(const std::array<std::uint64_t, count>& keys) {
+	constexpr std::size_t min_bits = std::max<std::size_t>(std::bit_width(count - 1), 1);
+	constexpr std::size_t max_bits = min_bits + 3;
+	std::uint64_t state = 0x9E3779B97F4A7C15;
+
+	for(auto bits = min_bits; bits <= max_bits; ++bits) {
+		for(std::size_t attempt = 0; attempt < 10'000; ++attempt) {
+			// splitmix64
+			state += 0x9E3779B97F4A7C15;
+			auto multiplier = state;
+			multiplier = (multiplier ^ (multiplier >> 30)) * 0xBF58476D1CE4E5B9;
+			multiplier = (multiplier ^ (multiplier >> 27)) * 0x94D049BB133111EB;
+			multiplier = (multiplier ^ (multiplier >> 31)) | 1;
+
+			const hash_params hash { multiplier, bits };
+			std::array<bool, std::size_t(1) << max_bits> used{};
+			bool collision = false;
+
+			for(const auto key : keys) {
+				auto& slot = used[hash(key)];
+
+				if(slot) {
+					collision = true;
+					break;
+				}
+
+				slot = true;
+			}
+
+			if(!collision) {
+				return hash;
+			}
+		}
+	}
+
+	throw "unable to find a perfect hash for the provided opcodes";
+}
+
+} // detail
+
+/**
+ * Reads an opcode and deserialises the corresponding message into storage
+ * owned by the dispatcher before invoking its handler, e.g:
+ *
+ * hexi::dispatcher<
+ *     Opcode,
+ *     hexi::route<Opcode::login, Login, &on_login>,
+ *     hexi::route<Opcode::ping, Ping, [](Ping& msg, Session& s) { ... }, 8>
+ * > dispatcher;
+ *
+ * dispatcher.dispatch<hexi::endian::as_big_t>(buffer, session);
+ *
+ * The lookup is a jump table indexed by the opcode when the opcodes are
+ * reasonably dense, or a perfect hash otherwise. Both are generated at
+ * compile-time. Each message type has a single instance that's reused
+ * between calls, so handlers should not hold onto references to messages.
+ * Calling set_reuse_storage(true) allows the storage owned by any containers
+ * within them to be reused too.
+ *
+ * @tparam opcode_type An integral or enum type for the opcode.
+ * @tparam routes The opcode to message and handler mappings.
+ */
+template<typename opcode_type, typename ...routes>
+requires (std::integral<opcode_type> || std::is_enum_v<opcode_type>)
+class dispatcher final {
+	using read_type = typename std::conditional_t<
+		std::is_enum_v<opcode_type>,
+		std::underlying_type<opcode_type>,
+		std::type_identity<opcode_type>
+	>::type;
+
+	static constexpr std::size_t route_count = sizeof...(routes);
+	static constexpr std::size_t dense_threshold = 256;
+
+	static_assert(route_count > 0, "dispatcher requires at least one route");
+
+	static constexpr std::array<std::uint64_t, route_count> keys {
+		detail::opcode_key(static_cast<opcode_type>(routes::key))...
+	};
+
+	static constexpr bool unique_keys = [] {
+		auto sorted = keys;
+		std::ranges::sort(sorted);
+		return std::ranges::adjacent_find(sorted) == sorted.end();
+	}();
+
+	static_assert(unique_keys, "dispatcher routes must have unique opcodes");
+
+	static constexpr std::uint64_t min_key = std::ranges::min(keys);
+	static constexpr std::uint64_t key_range = std::ranges::max(keys) - min_key + 1;
+
+	static constexpr bool dense =
+		key_range != 0 && key_range <= std::max(route_count * 4, dense_threshold);
+
+	std::tuple<typename routes::message...> storage_;
+	bool reuse_storage_ = false;
+
+	template<typename entry>
+	struct slot {
+		std::uint64_t key;
+		entry func;
+	};
+
+	template<typename entry, typename thunks>
+	static consteval auto make_table(const thunks& funcs) {
+		if constexpr(dense) {
+			std::array<entry, key_range> table{};
+
+			for(std::size_t i = 0; i < route_count; ++i) {
+				table[keys[i] - min_key] = funcs[i];
+			}
+
+			return table;
+		} else {
+			constexpr auto hash = detail::find_perfect_hash(keys);
+			std::array<slot<entry>, std::size_t(1) << hash.bits> table{};
+
+			for(std::size_t i = 0; i < route_count; ++i) {
+				table[hash(keys[i])] = { keys[i], funcs[i] };
+			}
+
+			return table;
+		}
+	}
+
+	template<std::size_t index, typename endianness, typename exceptions,
+		typename buf_type, typename ...args>
+	static dispatch_result handle(dispatcher& self, buf_type& buffer, args&&... context) {
+		using route_type = std::tuple_element_t<index, std::tuple<routes...>>;
+
+		auto& message = std::get<index>(self.storage_);
+		binary_stream<buf_type, exceptions, endianness> stream(buffer, route_type::limit);
+
+		if(self.reuse_storage_) {
+			stream.set_reuse_storage(true);
+		}
+
+		stream >> message;
+
+		if(!stream) {
+			return dispatch_result::read_error;
+		}
+
+		route_type::func(message, std::forward<args>(context)...);
+		return dispatch_result::ok;
+	}
+
+	template<typename endianness, typename exceptions, typename buf_type, typename ...args>
+	dispatch_result lookup(const opcode_type opcode, buf_type& buffer, args&&... context) {
+		using entry = dispatch_result(*)(dispatcher&, buf_type&, args&&...);
+
+		static constexpr auto table = []<std::size_t... indices>(std::index_sequence<indices...>) {
+			constexpr std::array<entry, route_count> funcs {
+				&handle<indices, endianness, exceptions, buf_type, args...>...
+			};
+
+			return make_table<entry>(funcs);
+		}(std::make_index_sequence<route_count>{});
+
+		const auto key = detail::opcode_key(opcode);
+		entry func = nullptr;
+
+		if constexpr(dense) {
+			const auto index = key - min_key;
+
+			if(index < table.size()) {
+				func = table[index];
+			}
+		} else {
+			constexpr auto hash = detail::find_perfect_hash(keys);
+			const auto& slot = table[hash(key)];
+
+			if(slot.key == key) {
+				func = slot.func;
+			}
+		}
+
+		if(!func) {
+			return dispatch_result::unknown_opcode;
+		}
+
+		return func(*this, buffer, std::forward<args>(context)...);
+	}
+
+public:
+	/**
+	 * @brief Reads an opcode from the buffer and dispatches the message
+	 * that follows it.
+	 *
+	 * @tparam endianness The byte order of the opcode and message.
+	 * @tparam exceptions Whether stream errors should throw.
+	 * @param buffer The buffer to read from.
+	 * @param context Additional arguments to pass to the handler.
+	 *
+	 * @return The result of the dispatch. The opcode is consumed even if it
+	 * is unknown.
+	 */
+	template<std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+		std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+		byte_oriented buf_type, typename ...args>
+	dispatch_result dispatch(buf_type& buffer, args&&... context) {
+		binary_stream<buf_type, exceptions, endianness> stream(buffer);
+		read_type opcode{};
+		stream >> opcode;
+
+		if(!stream) {
+			return dispatch_result::read_error;
+		}
+
+		return lookup<endianness, exceptions>(
+			static_cast<opcode_type>(opcode), buffer, std::forward<args>(context)...
+		);
+	}
+
+	/**
+	 * @brief Dispatches the message for an opcode that has already been
+	 * read from the buffer, such as from a frame header.
+	 *
+	 * @tparam endianness The byte order of the message.
+	 * @tparam exceptions Whether stream errors should throw.
+	 * @param opcode The message's opcode.
+	 * @param buffer The buffer to read from.
+	 * @param context Additional arguments to pass to the handler.
+	 *
+	 * @return The result of the dispatch.
+	 */
+	template<std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+		std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+		byte_oriented buf_type, typename ...args>
+	dispatch_result dispatch(const opcode_type opcode, buf_type& buffer, args&&... context) {
+		return lookup<endianness, exceptions>(opcode, buffer, std::forward<args>(context)...);
+	}
+
+	/**
+	 * @brief Controls whether messages are read with the stream's
+	 * set_reuse_storage enabled, allowing the elements of any containers
+	 * within them to be overwritten in place rather than reconstructed.
+	 * 
+	 * Only enable this if every message type overwrites all of its state
+	 * when deserialised.
+	 * 
+	 * @param enable Whether existing container elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising messages.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @return Whether the dispatcher has a route for the opcode.
+	 */
+	static constexpr bool contains(const opcode_type opcode) {
+		return std::ranges::find(keys, detail::opcode_key(opcode)) != keys.end();
+	}
+
+	/**
+	 * @return Whether the lookup is a jump table (true) or a perfect hash (false).
+	 */
+	static constexpr bool is_dense() {
+		return dense;
+	}
+};
+
+} // hexi
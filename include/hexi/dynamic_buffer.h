@@ -10,16 +10,17 @@
 #include <hexi/shared.h>
 #include <hexi/allocators/default_allocator.h>
 #include <hexi/detail/intrusive_storage.h>
+#include <algorithm>
 #include <concepts>
 #include <functional>
 #include <memory>
 #include <utility>
 #ifdef HEXI_BUFFER_DEBUG
-#include <algorithm>
 #include <vector>
 #endif
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 namespace hexi {
@@ -49,6 +50,18 @@ public:
 
 	static constexpr auto npos { static_cast<size_type>(-1) };
 
+	/**
+	 * A position within the container's data, used to resume copying or
+	 * searching from where a previous operation left off without walking
+	 * the block chain from the front. A default constructed position is the
+	 * read cursor. Positions are invalidated by anything that consumes data
+	 * from the container but survive writes.
+	 */
+	struct read_position {
+		const intrusive_node* node = nullptr;
+		size_type offset = 0;
+	};
+
 	using unique_storage = std::unique_ptr<storage_type, std::function<void(storage_type*)>>;
 
 private:
@@ -72,6 +85,28 @@ private:
 			- offsetof(storage_type, node));
 	}
 
+	/*
+	 * Moves a position off the end of a fully read block, unless that
+	 * block is the tail, where later writes may still land.
+	 */
+	void normalise(read_position& position) const {
+		// unresolved, or resolved while the container was empty
+		if(!position.node || position.node == &root_) {
+			position.node = root_.next;
+		}
+
+		while(position.node->next != &root_) {
+			const auto size = buffer_from_node(position.node)->size();
+
+			if(position.offset < size) {
+				break;
+			}
+
+			position.offset -= size;
+			position.node = position.node->next;
+		}
+	}
+
 	void move(dynamic_buffer& rhs) noexcept {
 		if(this == &rhs) { // self-assignment
 			return;
@@ -270,6 +305,80 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Copies a number of bytes, starting at an offset from the read
+	 * cursor, to the provided buffer but without advancing the read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 * @param offset The offset from the read cursor to begin copying from.
+	 */
+	void copy(void* destination, const size_type length, size_type offset) const {
+		assert(length + offset <= size_ && "Chained buffer copy too large!");
+		auto dest = static_cast<value_type*>(destination);
+		size_type remaining = length;
+		auto head = root_.next;
+
+		while(remaining) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			if(offset >= data.size()) {
+				offset -= data.size();
+				continue;
+			}
+
+			const auto copy_len = std::min(data.size() - offset, remaining);
+			std::memcpy(dest, data.data() + offset, copy_len);
+			dest += copy_len;
+			remaining -= copy_len;
+			offset = 0;
+		}
+	}
+
+	/**
+	 * @brief Copies a number of bytes, starting at a position, to the
+	 * provided buffer and advances the position past them, without
+	 * advancing the read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 * @param position The position to begin copying from.
+	 */
+	void copy(void* destination, const size_type length, read_position& position) const {
+		auto dest = static_cast<value_type*>(destination);
+		size_type remaining = length;
+
+		while(remaining) {
+			normalise(position);
+			assert(position.node != &root_ && "Chained buffer copy too large!");
+			const auto data = buffer_from_node(position.node)->read_data();
+			assert(position.offset < data.size() && "Chained buffer copy too large!");
+			const auto copy_len = std::min(data.size() - position.offset, remaining);
+			std::memcpy(dest, data.data() + position.offset, copy_len);
+			dest += copy_len;
+			remaining -= copy_len;
+			position.offset += copy_len;
+		}
+	}
+
+	/**
+	 * @brief Advances a position by a number of bytes.
+	 * 
+	 * @param position The position to advance.
+	 * @param length The number of bytes to advance by.
+	 */
+	void advance(read_position& position, const size_type length) const {
+		position.offset += length;
+		normalise(position);
+	}
+
 #ifdef HEXI_BUFFER_DEBUG
 	/**
 	 * @brief Retrives underlying buffers owned by the dynamic buffer.
@@ -660,6 +769,75 @@ public:
 		return npos;
 	}
 
+	/**
+	 * @brief Attempts to locate the provided value within the container,
+	 * starting at an offset from the read cursor.
+	 * 
+	 * @param value The value to locate.
+	 * @param offset The offset from the read cursor to begin searching from.
+	 * 
+	 * @return The position of value relative to the read cursor, or npos if
+	 * not found.
+	 */
+	size_type find_first_of(value_type value, const size_type offset) const {
+		size_type index = 0;
+		auto head = root_.next;
+
+		while(head != &root_) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			if(index + data.size() <= offset) {
+				index += data.size();
+				continue;
+			}
+
+			const auto start = offset > index? offset - index : 0;
+
+			for(auto i = start; i < data.size(); ++i) {
+				if(data[i] == value) {
+					return index + i;
+				}
+			}
+
+			index += data.size();
+		}
+
+		return npos;
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container,
+	 * starting at a position.
+	 * 
+	 * @param value The value to locate.
+	 * @param position The position to begin searching from.
+	 * 
+	 * @return The distance of value from the position, or npos if not found.
+	 */
+	size_type find_first_of(value_type value, read_position position) const {
+		normalise(position);
+		size_type index = 0;
+		auto head = position.node;
+		auto start = position.offset;
+
+		while(head != &root_) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			for(auto i = start; i < data.size(); ++i) {
+				if(data[i] == value) {
+					return index + i - start;
+				}
+			}
+
+			index += data.size() > start? data.size() - start : 0;
+			start = 0;
+		}
+
+		return npos;
+	}
+
 	/**
 	 * @brief Retrieves the container's allocator.
 	 * 
@@ -138,13 +138,13 @@ template<arithmetic T>                           \
 struct name final : adaptor_tag_t {              \
 	T& value;                                    \
                                                  \
-    name(T& t) : value(t) {}                     \
-    name(T&& t) : value(t) {}                    \
+    constexpr name(T& t) : value(t) {}           \
+    constexpr name(T&& t) : value(t) {}          \
                                                  \
-	auto to() -> T {                             \
+	constexpr auto to() -> T {                   \
 		return func_to(value);                   \
 	}                                            \
-	auto from() -> T {                           \
+	constexpr auto from() -> T {                 \
 		return func_from(value);                 \
 	}                                            \
 };
@@ -161,25 +161,25 @@ struct as_native_t final : storage_tag {};
 [[maybe_unused]] constexpr static as_little_t little {};
 [[maybe_unused]] constexpr static as_native_t native {};
 
-inline auto storage_in(const arithmetic auto& value, as_native_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_native_t) {
 	return value;
 }
 
-inline auto storage_in(const arithmetic auto& value, as_little_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_little_t) {
 	return native_to_little(value);
 }
 
-inline auto storage_in(const arithmetic auto& value, as_big_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_big_t) {
 	return native_to_big(value);
 }
 
-inline void storage_out(arithmetic auto& value, as_native_t) {}
+constexpr void storage_out(arithmetic auto& value, as_native_t) {}
 
-inline void storage_out(arithmetic auto& value, as_little_t) {
+constexpr void storage_out(arithmetic auto& value, as_little_t) {
 	return little_to_native_inplace(value);
 }
 
-inline void storage_out(arithmetic auto& value, as_big_t) {
+constexpr void storage_out(arithmetic auto& value, as_big_t) {
 	return big_to_native_inplace(value);
 }
 
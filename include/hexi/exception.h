@@ -52,4 +52,70 @@ public:
 		read_limit(read_limit), read_size(read_size), total_read(total_read) {}
 };
 
+class capacity_exceeded final : public exception {
+public:
+	const std::size_t requested, capacity;
+
+	capacity_exceeded(std::size_t requested, std::size_t capacity)
+		: exception(std::format(
+			"Capacity exceeded: {} elements requested, capacity is {} elements",
+			requested, capacity)),
+		requested(requested), capacity(capacity) {}
+};
+
+class allocation_limit_exceeded final : public exception {
+public:
+	const std::size_t requested, allocated, limit;
+
+	allocation_limit_exceeded(std::size_t requested, std::size_t allocated, std::size_t limit)
+		: exception(std::format(
+			"Allocation limit exceeded: {} byte allocation requested, allocation limit was {} bytes and total bytes allocated was {}",
+			requested, limit, allocated)),
+		requested(requested), allocated(allocated), limit(limit) {}
+};
+
+class invalid_variant_tag final : public exception {
+public:
+	const std::size_t tag, alternatives;
+
+	invalid_variant_tag(std::size_t tag, std::size_t alternatives)
+		: exception(std::format(
+			"Invalid variant tag: tag was {} but the variant only has {} alternatives",
+			tag, alternatives)),
+		tag(tag), alternatives(alternatives) {}
+};
+
+class invalid_bit_width final : public exception {
+public:
+	const std::size_t width, max_width;
+
+	invalid_bit_width(std::size_t width, std::size_t max_width)
+		: exception(std::format(
+			"Invalid bit width: width was {} but the element type only has {} bits",
+			width, max_width)),
+		width(width), max_width(max_width) {}
+};
+
+class invalid_string_reference final : public exception {
+public:
+	const std::size_t index, entries;
+
+	invalid_string_reference(std::size_t index, std::size_t entries)
+		: exception(std::format(
+			"Invalid string reference: index was {} but the string table only has {} entries",
+			index, entries)),
+		index(index), entries(entries) {}
+};
+
+class invalid_utf8 final : public exception {
+public:
+	const std::size_t offset, size;
+
+	invalid_utf8(std::size_t offset, std::size_t size)
+		: exception(std::format(
+			"Invalid UTF-8: ill-formed sequence at byte {} of a {} byte string",
+			offset, size)),
+		offset(offset), size(size) {}
+};
+
 } // hexi
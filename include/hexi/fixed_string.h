@@ -0,0 +1,199 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/exception.h>
+#include <hexi/shared.h>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * String with inline storage for up to N characters, for fields with a hard
+ * maximum length. The string is always null terminated.
+ *
+ * When deserialised, a length greater than N puts the stream into an error
+ * state rather than being truncated.
+ *
+ * @tparam N The maximum number of characters, excluding the null terminator.
+ */
+template<std::size_t N>
+class fixed_string final {
+	std::array<char, N + 1> data_{};
+	std::size_t size_ = 0;
+
+	constexpr void check_capacity(const std::size_t size) const {
+		if(size > N) {
+			HEXI_THROW(capacity_exceeded(size, N));
+		}
+	}
+
+public:
+	using value_type      = char;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = char&;
+	using const_reference = const char&;
+	using pointer         = char*;
+	using const_pointer   = const char*;
+	using iterator        = char*;
+	using const_iterator  = const char*;
+
+	constexpr fixed_string() = default;
+
+	constexpr fixed_string(const std::string_view string) {
+		assign(string);
+	}
+
+	constexpr fixed_string(const char* string)
+		: fixed_string(std::string_view(string)) {}
+
+	constexpr void assign(const std::string_view string) {
+		check_capacity(string.size());
+		std::ranges::copy(string, data_.begin());
+		size_ = string.size();
+		data_[size_] = '\0';
+	}
+
+	constexpr fixed_string& operator=(const std::string_view string) {
+		assign(string);
+		return *this;
+	}
+
+	constexpr void resize(const size_type size, const char value = '\0') {
+		check_capacity(size);
+
+		if(size > size_) {
+			std::fill(data_.begin() + size_, data_.begin() + size, value);
+		}
+
+		size_ = size;
+		data_[size_] = '\0';
+	}
+
+	/**
+	 * @brief Resizes the string and invokes op to write its contents,
+	 * as with std::string::resize_and_overwrite.
+	 */
+	template<typename operation>
+	constexpr void resize_and_overwrite(const size_type size, operation op) {
+		check_capacity(size);
+		size_ = std::move(op)(data_.data(), size);
+		assert(size_ <= size);
+		data_[size_] = '\0';
+	}
+
+	constexpr void push_back(const char value) {
+		check_capacity(size_ + 1);
+		data_[size_++] = value;
+		data_[size_] = '\0';
+	}
+
+	constexpr void append(const std::string_view string) {
+		check_capacity(size_ + string.size());
+		std::ranges::copy(string, data_.begin() + size_);
+		size_ += string.size();
+		data_[size_] = '\0';
+	}
+
+	constexpr void clear() {
+		size_ = 0;
+		data_[0] = '\0';
+	}
+
+	constexpr char& operator[](const size_type index) {
+		assert(index < size_);
+		return data_[index];
+	}
+
+	constexpr const char& operator[](const size_type index) const {
+		assert(index < size_);
+		return data_[index];
+	}
+
+	constexpr char* data() {
+		return data_.data();
+	}
+
+	constexpr const char* data() const {
+		return data_.data();
+	}
+
+	constexpr const char* c_str() const {
+		return data_.data();
+	}
+
+	constexpr size_type size() const {
+		return size_;
+	}
+
+	constexpr size_type length() const {
+		return size_;
+	}
+
+	static constexpr size_type capacity() {
+		return N;
+	}
+
+	static constexpr size_type max_size() {
+		return N;
+	}
+
+	constexpr bool empty() const {
+		return size_ == 0;
+	}
+
+	constexpr bool full() const {
+		return size_ == N;
+	}
+
+	constexpr iterator begin() {
+		return data_.data();
+	}
+
+	constexpr const_iterator begin() const {
+		return data_.data();
+	}
+
+	constexpr iterator end() {
+		return data_.data() + size_;
+	}
+
+	constexpr const_iterator end() const {
+		return data_.data() + size_;
+	}
+
+	constexpr std::string_view view() const {
+		return { data_.data(), size_ };
+	}
+
+	constexpr operator std::string_view() const {
+		return view();
+	}
+
+	template<std::size_t M>
+	constexpr bool operator==(const fixed_string<M>& rhs) const {
+		return view() == rhs.view();
+	}
+
+	constexpr bool operator==(const std::string_view rhs) const {
+		return view() == rhs;
+	}
+};
+
+template<typename T>
+constexpr bool is_fixed_string_v = false;
+
+template<std::size_t N>
+constexpr bool is_fixed_string_v<fixed_string<N>> = true;
+
+} // hexi
@@ -0,0 +1,255 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/exception.h>
+#include <hexi/shared.h>
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Vector with inline storage for up to N elements, for fields with a hard
+ * maximum element count. Elements are only constructed as they're added.
+ *
+ * When deserialised, an element count greater than N puts the stream into
+ * an error state rather than being truncated.
+ *
+ * @tparam T The element type.
+ * @tparam N The maximum number of elements.
+ */
+template<typename T, std::size_t N>
+requires (N > 0)
+class fixed_vector final {
+	alignas(T) std::byte storage_[sizeof(T) * N];
+	std::size_t size_ = 0;
+
+	void check_capacity(const std::size_t size) const {
+		if(size > N) {
+			HEXI_THROW(capacity_exceeded(size, N));
+		}
+	}
+
+	T* ptr(const std::size_t index) {
+		return reinterpret_cast<T*>(storage_) + index;
+	}
+
+	const T* ptr(const std::size_t index) const {
+		return reinterpret_cast<const T*>(storage_) + index;
+	}
+
+public:
+	using value_type      = T;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = T&;
+	using const_reference = const T&;
+	using pointer         = T*;
+	using const_pointer   = const T*;
+	using iterator        = T*;
+	using const_iterator  = const T*;
+
+	fixed_vector() = default;
+
+	fixed_vector(std::initializer_list<T> values) {
+		check_capacity(values.size());
+
+		for(const auto& value : values) {
+			emplace_back(value);
+		}
+	}
+
+	fixed_vector(const fixed_vector& rhs) {
+		for(const auto& value : rhs) {
+			emplace_back(value);
+		}
+	}
+
+	fixed_vector(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		for(auto& value : rhs) {
+			emplace_back(std::move(value));
+		}
+
+		rhs.clear();
+	}
+
+	fixed_vector& operator=(const fixed_vector& rhs) {
+		if(this != &rhs) {
+			clear();
+
+			for(const auto& value : rhs) {
+				emplace_back(value);
+			}
+		}
+
+		return *this;
+	}
+
+	fixed_vector& operator=(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if(this != &rhs) {
+			clear();
+
+			for(auto& value : rhs) {
+				emplace_back(std::move(value));
+			}
+
+			rhs.clear();
+		}
+
+		return *this;
+	}
+
+	~fixed_vector() {
+		clear();
+	}
+
+	template<typename ...Args>
+	T& emplace_back(Args&&... args) {
+		check_capacity(size_ + 1);
+		auto element = std::construct_at(ptr(size_), std::forward<Args>(args)...);
+		++size_;
+		return *element;
+	}
+
+	void push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	void push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	void pop_back() {
+		assert(size_);
+		std::destroy_at(ptr(--size_));
+	}
+
+	void resize(const size_type size) {
+		check_capacity(size);
+
+		while(size_ > size) {
+			pop_back();
+		}
+
+		while(size_ < size) {
+			emplace_back();
+		}
+	}
+
+	/**
+	 * @brief Removes the elements in the range [first, last), shifting
+	 * any subsequent elements down.
+	 *
+	 * @return Iterator following the last removed element.
+	 */
+	iterator erase(const_iterator first, const_iterator last) {
+		auto dest = begin() + (first - begin());
+		auto src = begin() + (last - begin());
+		auto new_end = std::move(src, end(), dest);
+
+		while(end() != new_end) {
+			pop_back();
+		}
+
+		return dest;
+	}
+
+	iterator erase(const_iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	void clear() {
+		std::destroy(begin(), end());
+		size_ = 0;
+	}
+
+	T& operator[](const size_type index) {
+		assert(index < size_);
+		return *ptr(index);
+	}
+
+	const T& operator[](const size_type index) const {
+		assert(index < size_);
+		return *ptr(index);
+	}
+
+	T& front() {
+		assert(size_);
+		return *ptr(0);
+	}
+
+	const T& front() const {
+		assert(size_);
+		return *ptr(0);
+	}
+
+	T& back() {
+		assert(size_);
+		return *ptr(size_ - 1);
+	}
+
+	const T& back() const {
+		assert(size_);
+		return *ptr(size_ - 1);
+	}
+
+	T* data() {
+		return ptr(0);
+	}
+
+	const T* data() const {
+		return ptr(0);
+	}
+
+	size_type size() const {
+		return size_;
+	}
+
+	static constexpr size_type capacity() {
+		return N;
+	}
+
+	static constexpr size_type max_size() {
+		return N;
+	}
+
+	bool empty() const {
+		return size_ == 0;
+	}
+
+	bool full() const {
+		return size_ == N;
+	}
+
+	iterator begin() {
+		return ptr(0);
+	}
+
+	const_iterator begin() const {
+		return ptr(0);
+	}
+
+	iterator end() {
+		return ptr(size_);
+	}
+
+	const_iterator end() const {
+		return ptr(size_);
+	}
+
+	bool operator==(const fixed_vector& rhs) const {
+		return std::equal(begin(), end(), rhs.begin(), rhs.end());
+	}
+};
+
+} // hexi
@@ -0,0 +1,319 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Describes a frame header for frame_decoder. The header is deserialised
+ * from exactly header_size bytes and body_size returns the length of the
+ * body that follows it, e.g:
+ *
+ * struct codec {
+ *     using header_type = packet_header;
+ *     using endianness = hexi::endian::as_big_t; // optional
+ *     static constexpr std::size_t header_size = 6;
+ *
+ *     static std::size_t body_size(const packet_header& header) {
+ *         return header.size;
+ *     }
+ * };
+ */
+template<typename codec>
+concept header_codec = std::default_initializable<typename codec::header_type>
+	&& requires(const typename codec::header_type& header) {
+		{ codec::header_size } -> std::convertible_to<std::size_t>;
+		{ codec::body_size(header) } -> std::convertible_to<std::size_t>;
+	};
+
+namespace detail {
+
+template<typename codec>
+struct codec_endianness {
+	using type = endian::as_native_t;
+};
+
+template<typename codec>
+requires requires { typename codec::endianness; }
+struct codec_endianness<codec> {
+	using type = typename codec::endianness;
+};
+
+} // detail
+
+/**
+ * Counters for tuning a frame_decoder. The frame rate can be found by
+ * sampling frames at an interval and resetting the counters.
+ */
+struct frame_decoder_stats {
+	std::size_t frames = 0;             // complete frames passed to handlers
+	std::size_t bytes = 0;              // bytes consumed, including headers
+	std::size_t carryovers = 0;         // times processing stopped mid-frame
+	std::size_t carryover_bytes = 0;    // bytes of the current partial frame
+	std::size_t peak_carryover_bytes = 0;
+};
+
+/**
+ * Incremental, callback-driven decoder for header and body frames arriving
+ * in arbitrarily sized chunks.
+ *
+ * Data is appended to a dynamic_buffer, either by the I/O layer directly
+ * or via feed. Headers are deserialised as soon as they're complete. If
+ * the whole body has already arrived and is contiguous in the buffer (the
+ * buffer is contiguous, or the body is within the front block of a
+ * dynamic_buffer), the handler reads it in place. Otherwise, body bytes
+ * are moved into separate storage as they arrive, which grows with the
+ * data received rather than the declared length, so a hostile header
+ * can't trigger a huge allocation. Either way, once the body is complete,
+ * the handler is invoked with the header and a stream that is bounded to
+ * the body. Bytes are never examined more than once, no matter how the
+ * frames are fragmented.
+ *
+ * The decoder moves on to the next header before the handler is invoked.
+ * A body that's read in place stays in the buffer while the handler runs
+ * and is skipped over once it returns or throws, so a handler that throws
+ * won't be given the same frame again. Handlers must not hold onto views
+ * into the stream after returning, nor modify the buffer.
+ *
+ * @tparam codec The header codec.
+ * @tparam buf_type The type of the buffer that data is appended to.
+ */
+template<header_codec codec, typename buf_type = dynamic_buffer<1024>>
+class frame_decoder final {
+public:
+	using header_type = typename codec::header_type;
+	using endianness  = typename detail::codec_endianness<codec>::type;
+	using value_type  = typename buf_type::value_type;
+	using size_type   = typename buf_type::size_type;
+	using body_type   = std::vector<value_type>;
+	using view_type   = std::span<value_type>;
+	using stream_type = binary_stream<buffer_adaptor<view_type>, no_throw_t, endianness>;
+
+private:
+	static constexpr size_type header_size = codec::header_size;
+
+	enum class decode_state {
+		header, body
+	};
+
+	buf_type& buffer_;
+	size_type max_body_size_;
+	decode_state decode_state_ = decode_state::header;
+	stream_state state_ = stream_state::ok;
+	header_type header_{};
+	size_type body_size_ = 0;
+	body_type body_;
+	frame_decoder_stats stats_;
+
+	bool read_header() {
+		binary_stream<buf_type, no_throw_t, endianness> stream(buffer_, header_size);
+		stream >> header_;
+
+		if(!stream || stream.total_read() != header_size) [[unlikely]] {
+			state_ = stream? stream_state::invalid_stream : stream.state();
+			return false;
+		}
+
+		const auto body_size = static_cast<std::size_t>(codec::body_size(header_));
+
+		if(max_body_size_ && body_size > max_body_size_) [[unlikely]] {
+			state_ = stream_state::read_limit_err;
+			return false;
+		}
+
+		body_size_ = static_cast<size_type>(body_size);
+		body_.clear();
+		decode_state_ = decode_state::body;
+		stats_.bytes += header_size;
+		return true;
+	}
+
+	void read_body() {
+		const auto offset = body_.size();
+		const auto length = std::min<size_type>(body_size_ - offset, buffer_.size());
+
+		if(!length) {
+			return;
+		}
+
+		body_.resize(offset + length);
+		buffer_.read(body_.data() + offset, length);
+		stats_.bytes += length;
+	}
+
+	/*
+	 * Returns the data at the front of the buffer that can be viewed
+	 * without copying, which may be less than the buffer holds.
+	 */
+	view_type buffered_data() {
+		if constexpr(std::is_same_v<typename buf_type::contiguous, is_contiguous>) {
+			return { buffer_.read_ptr(), buffer_.size() };
+		} else if constexpr(requires { buffer_.front()->read_data(); }) {
+			const auto block = buffer_.front();
+			return block? view_type(block->read_data()) : view_type();
+		} else {
+			return {};
+		}
+	}
+
+	template<typename handler_type>
+	void dispatch(handler_type& handler, view_type body) {
+		decode_state_ = decode_state::header;
+		++stats_.frames;
+
+		buffer_adaptor<view_type> adaptor(body);
+		stream_type stream(adaptor, body_size_);
+		std::invoke(handler, std::as_const(header_), stream);
+	}
+
+	/*
+	 * Invokes the handler with a view of a body that's already in the
+	 * buffer, skipping over it afterwards even if the handler throws.
+	 */
+	template<typename handler_type>
+	void dispatch_in_place(handler_type& handler, view_type body) {
+		struct skip_on_exit {
+			buf_type& buffer;
+			size_type length;
+
+			~skip_on_exit() {
+				buffer.skip(length);
+			}
+		} skip { buffer_, body_size_ };
+
+		stats_.bytes += body_size_;
+		dispatch(handler, body.first(body_size_));
+	}
+
+	void update_carryover() {
+		if(decode_state_ == decode_state::body) {
+			stats_.carryover_bytes = body_.size();
+		} else {
+			stats_.carryover_bytes = buffer_.size();
+		}
+
+		if(stats_.carryover_bytes) {
+			++stats_.carryovers;
+			stats_.peak_carryover_bytes = std::max(stats_.peak_carryover_bytes,
+			                                       stats_.carryover_bytes);
+		}
+	}
+
+public:
+	/**
+	 * @param buffer The buffer that incoming data is appended to.
+	 * @param max_body_size The maximum permitted body length, or zero for
+	 * no limit.
+	 */
+	explicit frame_decoder(buf_type& buffer, const size_type max_body_size = 0)
+		: buffer_(buffer), max_body_size_(max_body_size) {}
+
+	frame_decoder(const frame_decoder&) = delete;
+	frame_decoder& operator=(const frame_decoder&) = delete;
+
+	/**
+	 * @brief Decodes as many frames as possible from the data appended to
+	 * the buffer so far, invoking the handler for each complete frame.
+	 *
+	 * @param handler Invoked as handler(const header_type&, stream_type&).
+	 *
+	 * @return The number of frames decoded.
+	 */
+	template<std::invocable<const header_type&, stream_type&> handler_type>
+	std::size_t process(handler_type&& handler) {
+		const auto frames = stats_.frames;
+
+		while(state_ == stream_state::ok) {
+			if(decode_state_ == decode_state::header) {
+				if(buffer_.size() < header_size || !read_header()) {
+					break;
+				}
+			}
+
+			if(body_.empty()) {
+				if(const auto data = buffered_data(); data.size() >= body_size_) {
+					dispatch_in_place(handler, data);
+					continue;
+				}
+			}
+
+			read_body();
+
+			if(body_.size() != body_size_) {
+				break;
+			}
+
+			dispatch(handler, body_);
+		}
+
+		update_carryover();
+		return stats_.frames - frames;
+	}
+
+	/**
+	 * @brief Appends a chunk of data to the buffer and decodes any frames
+	 * that it completes.
+	 *
+	 * @param data The data to append.
+	 * @param length The number of bytes to append.
+	 * @param handler Invoked as handler(const header_type&, stream_type&).
+	 *
+	 * @return The number of frames decoded.
+	 */
+	template<std::invocable<const header_type&, stream_type&> handler_type>
+	std::size_t feed(const void* data, const size_type length, handler_type&& handler) {
+		buffer_.write(data, length);
+		return process(std::forward<handler_type>(handler));
+	}
+
+	/**
+	 * @return The number of body bytes still needed to complete the current
+	 * frame, or zero if waiting on a header.
+	 */
+	size_type body_remaining() const {
+		return decode_state_ == decode_state::body? body_size_ - body_.size() : 0;
+	}
+
+	const frame_decoder_stats& stats() const {
+		return stats_;
+	}
+
+	void reset_stats() {
+		const auto carryover = stats_.carryover_bytes;
+		stats_ = {};
+		stats_.carryover_bytes = carryover;
+	}
+
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
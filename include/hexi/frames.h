@@ -0,0 +1,209 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * A single-pass input range over the complete length-prefixed frames in a
+ * buffer. Each element is a span over a frame's payload, excluding its
+ * length prefix.
+ *
+ * Frames are viewed in place where possible, which is always the case for
+ * contiguous buffers, and for dynamic_buffer when a frame doesn't straddle
+ * two blocks. Otherwise the frame is copied into storage owned by the range.
+ *
+ * A frame is only consumed from the buffer once the iterator is advanced
+ * past it, so the span is valid until then. Iteration stops when the
+ * remaining data doesn't contain a complete frame, leaving any partial
+ * frame in the buffer for when more data arrives, or when a frame's length
+ * is invalid, in which case the range is put into an error state and the
+ * offending frame is left unconsumed.
+ *
+ * @tparam buf_type The buffer type.
+ * @tparam length_type The type of the length prefix.
+ * @tparam endianness The byte order of the length prefix.
+ */
+template<byte_oriented buf_type, std::unsigned_integral length_type,
+	std::derived_from<endian::storage_tag> endianness>
+class frame_range final
+	: public std::ranges::view_interface<frame_range<buf_type, length_type, endianness>> {
+public:
+	using size_type  = typename buf_type::size_type;
+	using value_type = typename buf_type::value_type;
+	using frame_type = std::span<const value_type>;
+
+private:
+	static constexpr size_type header_size = sizeof(length_type);
+
+	buf_type* buffer_ = nullptr;
+	size_type max_length_ = 0;
+	size_type consumed_ = 0;
+	stream_state state_ = stream_state::ok;
+	bool done_ = false;
+	frame_type frame_;
+	std::vector<value_type> scratch_;
+
+	bool valid_length(const size_type length) {
+		if(max_length_ && length > max_length_) [[unlikely]] {
+			state_ = stream_state::read_limit_err;
+			return false;
+		}
+
+		// a frame that could never fit into the buffer can't be completed
+		if constexpr(fixed_capacity<buf_type>) {
+			if(length > buf_type::capacity() - header_size) [[unlikely]] {
+				state_ = stream_state::capacity_err;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void next() {
+		if(consumed_) {
+			buffer_->skip(consumed_);
+			consumed_ = 0;
+		}
+
+		if(buffer_->size() < header_size) {
+			done_ = true;
+			return;
+		}
+
+		length_type prefix = 0;
+		buffer_->copy(&prefix, header_size);
+		endian::storage_out(prefix, endianness{});
+		const auto length = static_cast<size_type>(prefix);
+
+		if(!valid_length(length) || buffer_->size() - header_size < length) {
+			done_ = true;
+			return;
+		}
+
+		consumed_ = header_size + length;
+
+		if constexpr(std::is_same_v<typename buf_type::contiguous, is_contiguous>) {
+			frame_ = { reinterpret_cast<const value_type*>(buffer_->read_ptr()) + header_size, length };
+			return;
+		} else if constexpr(requires { buffer_->front()->read_ptr(); buffer_->front()->size(); }) {
+			const auto block = buffer_->front();
+
+			if(block->size() >= consumed_) {
+				frame_ = { block->read_ptr() + header_size, length };
+				return;
+			}
+		}
+
+		// the frame straddles multiple blocks, so it has to be copied
+		buffer_->skip(header_size);
+		consumed_ = length;
+		scratch_.resize(length);
+		buffer_->copy(scratch_.data(), length);
+		frame_ = scratch_;
+	}
+
+public:
+	class iterator {
+		frame_range* range_ = nullptr;
+
+	public:
+		using value_type      = frame_type;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(frame_range* range) : range_(range) {}
+
+		frame_type operator*() const {
+			return range_->frame_;
+		}
+
+		iterator& operator++() {
+			range_->next();
+			return *this;
+		}
+
+		void operator++(int) {
+			++*this;
+		}
+
+		bool operator==(std::default_sentinel_t) const {
+			return range_->done_;
+		}
+	};
+
+	frame_range() = default;
+
+	/**
+	 * @param buffer The buffer to read frames from.
+	 * @param max_length The maximum permitted frame length, excluding the
+	 * length prefix, or zero for no limit.
+	 */
+	explicit frame_range(buf_type& buffer, const size_type max_length = 0)
+		: buffer_(&buffer), max_length_(max_length) {}
+
+	/**
+	 * @brief Finds the first complete frame and returns an iterator to it.
+	 *
+	 * @note As this is an input range, begin() must only be called once.
+	 */
+	iterator begin() {
+		next();
+		return iterator(this);
+	}
+
+	std::default_sentinel_t end() const {
+		return {};
+	}
+
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+/**
+ * @brief Creates a range over the complete length-prefixed frames in the
+ * buffer, e.g:
+ *
+ * for(auto frame : hexi::frames<std::uint16_t, hexi::endian::as_big_t>(buffer)) { ... }
+ *
+ * @tparam length_type The type of the length prefix.
+ * @tparam endianness The byte order of the length prefix.
+ * @param buffer The buffer to read frames from.
+ * @param max_length The maximum permitted frame length, excluding the
+ * length prefix, or zero for no limit.
+ *
+ * @return The frame range.
+ */
+template<std::unsigned_integral length_type,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+	byte_oriented buf_type>
+auto frames(buf_type& buffer, const typename buf_type::size_type max_length = 0) {
+	return frame_range<buf_type, length_type, endianness>(buffer, max_length);
+}
+
+} // hexi
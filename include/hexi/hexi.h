@@ -9,20 +9,45 @@
 #include <hexi/binary_stream.h>
 #include <hexi/buffer_adaptor.h>
 #include <hexi/buffer_sequence.h>
+#include <hexi/byte_order.h>
 #include <hexi/concepts.h>
+#include <hexi/dispatcher.h>
 #include <hexi/dynamic_buffer.h>
 #include <hexi/dynamic_tls_buffer.h>
 #include <hexi/exception.h>
 #include <hexi/endian.h>
 #include <hexi/file_buffer.h>
+#include <hexi/fixed_string.h>
+#include <hexi/fixed_vector.h>
+#include <hexi/frames.h>
+#include <hexi/intern_pool.h>
 #include <hexi/shared.h>
 #include <hexi/static_buffer.h>
 #include <hexi/null_buffer.h>
+#include <hexi/object_pool.h>
+#include <hexi/packet_template.h>
+#include <hexi/precomputed.h>
+#include <hexi/serialised_size.h>
 #include <hexi/stream_adaptors.h>
+#include <hexi/stream_range.h>
+#include <hexi/stream_slice.h>
+#include <hexi/stream_transaction.h>
+#include <hexi/async_reader.h>
+#include <hexi/frame_decoder.h>
+#include <hexi/message_view.h>
+#include <hexi/overlay.h>
+#include <hexi/bit_stream.h>
+#include <hexi/quantise.h>
+#include <hexi/delta.h>
+#include <hexi/delta_packed.h>
+#include <hexi/string_table.h>
+#include <hexi/utf8.h>
 #include <hexi/allocators/block_allocator.h>
 #include <hexi/allocators/default_allocator.h>
 #include <hexi/allocators/tls_block_allocator.h>
 #include <hexi/detail/intrusive_storage.h>
+#include <hexi/detail/non_temporal_copy.h>
+#include <hexi/detail/simd.h>
 #include <hexi/pmc/binary_stream.h>
 #include <hexi/pmc/binary_stream_reader.h>
 #include <hexi/pmc/binary_stream_writer.h>
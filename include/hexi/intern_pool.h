@@ -0,0 +1,163 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Thread-safe pool of interned strings.
+ *
+ * Each distinct string is stored once and the views handed out remain valid
+ * for the lifetime of the pool, so repeated strings cost a hash lookup rather
+ * than an allocation. Strings are never removed.
+ *
+ * The pool is split into shards, each with its own lock, to reduce
+ * contention when interning from multiple threads.
+ */
+class intern_pool final {
+	static constexpr std::size_t shard_bits = 4;
+	static constexpr std::size_t shard_count = std::size_t(1) << shard_bits;
+
+	// a string along with its precomputed hash, so that picking the shard
+	// and searching its set only hashes the string once
+	struct hashed_key {
+		std::string_view string;
+		std::size_t hash;
+	};
+
+	struct string_hash {
+		using is_transparent = void;
+
+		std::size_t operator()(const std::string_view string) const {
+			return std::hash<std::string_view>{}(string);
+		}
+
+		std::size_t operator()(const hashed_key& key) const {
+			return key.hash;
+		}
+	};
+
+	struct string_equal {
+		using is_transparent = void;
+
+		bool operator()(const std::string_view lhs, const std::string_view rhs) const {
+			return lhs == rhs;
+		}
+
+		bool operator()(const hashed_key& lhs, const std::string_view rhs) const {
+			return lhs.string == rhs;
+		}
+
+		bool operator()(const std::string_view lhs, const hashed_key& rhs) const {
+			return lhs == rhs.string;
+		}
+	};
+
+	using set_type = std::unordered_set<std::string, string_hash, string_equal>;
+
+	struct shard {
+		mutable std::shared_mutex lock;
+		set_type strings;
+	};
+
+	std::array<shard, shard_count> shards_;
+
+	static hashed_key make_key(const std::string_view string) {
+		return { string, string_hash{}(string) };
+	}
+
+	/*
+	 * The sets pick their buckets from the low bits of the hash, so the
+	 * shard is chosen with the high bits to keep the two independent
+	 */
+	static std::size_t shard_index(const hashed_key& key) {
+		return key.hash >> (std::numeric_limits<std::size_t>::digits - shard_bits);
+	}
+
+	shard& shard_for(const hashed_key& key) {
+		return shards_[shard_index(key)];
+	}
+
+	const shard& shard_for(const hashed_key& key) const {
+		return shards_[shard_index(key)];
+	}
+
+public:
+	intern_pool() = default;
+	intern_pool(const intern_pool&) = delete;
+	intern_pool& operator=(const intern_pool&) = delete;
+
+	/**
+	 * @brief Retrieves the interned copy of a string, adding it to the pool
+	 * if it isn't already present.
+	 *
+	 * @param string The string to intern.
+	 *
+	 * @return A view of the interned string, valid for the lifetime of the pool.
+	 */
+	std::string_view intern(const std::string_view string) {
+		const auto key = make_key(string);
+		auto& shard = shard_for(key);
+
+		{
+			std::shared_lock guard(shard.lock);
+
+			if(auto it = shard.strings.find(key); it != shard.strings.end()) {
+				return *it;
+			}
+		}
+
+		std::unique_lock guard(shard.lock);
+		return *shard.strings.emplace(string).first;
+	}
+
+	/**
+	 * @brief Looks up a string without adding it to the pool.
+	 *
+	 * @param string The string to find.
+	 *
+	 * @return A view of the interned string, if present.
+	 */
+	std::optional<std::string_view> find(const std::string_view string) const {
+		const auto key = make_key(string);
+		const auto& shard = shard_for(key);
+		std::shared_lock guard(shard.lock);
+
+		if(auto it = shard.strings.find(key); it != shard.strings.end()) {
+			return *it;
+		}
+
+		return std::nullopt;
+	}
+
+	/**
+	 * @return The number of distinct strings in the pool.
+	 */
+	std::size_t size() const {
+		std::size_t count = 0;
+
+		for(const auto& shard : shards_) {
+			std::shared_lock guard(shard.lock);
+			count += shard.strings.size();
+		}
+
+		return count;
+	}
+};
+
+} // hexi
@@ -0,0 +1,381 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/stream_transaction.h>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+namespace detail {
+
+/*
+ * Location of a serialised field, keyed by the offset of the member that
+ * it was read into within the layout object, and the byte order it was
+ * written in if it's arithmetic.
+ */
+struct view_field {
+	std::size_t member;
+	std::size_t offset;
+	std::size_t length;
+	std::endian order;
+};
+
+template<typename endianness>
+constexpr std::endian wire_order() {
+	if constexpr(std::is_same_v<endianness, endian::as_big_t>) {
+		return std::endian::big;
+	} else if constexpr(std::is_same_v<endianness, endian::as_little_t>) {
+		return std::endian::little;
+	} else {
+		return std::endian::native;
+	}
+}
+
+struct serialise_probe {
+	void operator()(auto&&...) {}
+	void operator&(auto&&) {}
+	void forward(auto&&...) {}
+};
+
+template<typename T>
+concept probe_serialisable = requires(T& object, serialise_probe& probe) {
+	object.serialise(probe);
+};
+
+template<typename T>
+concept viewable_array = std::ranges::contiguous_range<T> && pod<typename T::value_type>;
+
+template<typename T, template<typename> class adaptor>
+concept adapted_array = requires(T arg) {
+	requires viewable_array<std::remove_cvref_t<decltype(arg.str)>>;
+	requires std::same_as<T, adaptor<std::remove_cvref_t<decltype(arg.str)>>>;
+};
+
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * It validates each field against the stream and records where the
+ * field's data is. Arithmetic and other trivial fields are decoded into
+ * the object as well, so lengths and flags that later fields depend on
+ * hold the values from the message, but strings and arrays are skipped.
+ */
+template<typename stream_type, typename object_type>
+class view_indexer final {
+	using size_type = typename stream_type::size_type;
+
+	static constexpr auto stream_order
+		= wire_order<std::remove_cv_t<decltype(stream_type::byte_order)>>();
+
+	stream_type& stream_;
+	object_type& layout_;
+	std::vector<view_field>& fields_;
+
+	std::size_t member_offset(const auto& member) const {
+		return static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&member)
+			- reinterpret_cast<const std::byte*>(&layout_));
+	}
+
+	void add(const auto& member, const std::size_t offset, const std::size_t length,
+	         const std::endian order = stream_order) {
+		if(stream_) {
+			fields_.emplace_back(member_offset(member), offset, length, order);
+		}
+	}
+
+	template<typename string_type>
+	void index_string(std::string_view view, const string_type& member) {
+		const auto end = stream_.total_read();
+
+		if constexpr(std::is_same_v<string_type, null_terminated<std::string>>) {
+			add(member.str, end - view.size() - 1, view.size());
+		} else {
+			add(member.str, end - view.size(), view.size());
+		}
+	}
+
+	template<typename container_type>
+	void index_array(container_type& container, const size_type count) {
+		using element_type = typename container_type::value_type;
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		if(!stream_) {
+			return;
+		}
+
+		const auto offset = stream_.total_read();
+		const auto length = count > max_size / sizeof(element_type)?
+			max_size : count * sizeof(element_type);
+
+		stream_.skip(length);
+		add(container, offset, length);
+	}
+
+	template<typename T>
+	void index(T&& arg) {
+		using arg_type = std::remove_cvref_t<T>;
+		const auto offset = stream_.total_read();
+
+		if constexpr(arithmetic<arg_type>) {
+			stream_ >> arg;
+			add(arg, offset, sizeof(arg_type));
+		} else if constexpr(std::derived_from<arg_type, endian::adaptor_tag_t>) {
+			// the adaptor is a temporary, so the member is the one it refers to
+			using value_type = std::remove_cvref_t<decltype(arg.value)>;
+			constexpr auto order = std::is_same_v<arg_type, endian::be<value_type>>?
+				std::endian::big : std::endian::little;
+			stream_ >> arg;
+			add(arg.value, offset, sizeof(value_type), order);
+		} else if constexpr(std::is_same_v<arg_type, std::string>) {
+			index(prefixed(arg));
+		} else if constexpr(std::is_same_v<arg_type, prefixed<std::string>>) {
+			std::string_view view;
+			stream_ >> prefixed(view);
+			index_string(view, arg);
+		} else if constexpr(std::is_same_v<arg_type, prefixed_varint<std::string>>) {
+			std::string_view view;
+			stream_ >> prefixed_varint(view);
+			index_string(view, arg);
+		} else if constexpr(std::is_same_v<arg_type, null_terminated<std::string>>) {
+			std::string_view view;
+			stream_ >> null_terminated(view);
+			index_string(view, arg);
+		} else if constexpr(adapted_array<arg_type, prefixed>) {
+			std::uint32_t count = 0;
+			stream_ >> endian::le(count);
+			index_array(arg.str, count);
+		} else if constexpr(adapted_array<arg_type, prefixed_varint>) {
+			const auto count = varint_decode<size_type>(stream_);
+			index_array(arg.str, count);
+		} else if constexpr(requires(view_indexer& indexer) { arg.serialise(indexer); }) {
+			arg.serialise(*this);
+			add(arg, offset, stream_.total_read() - offset);
+		} else {
+			stream_ >> arg;
+			add(arg, offset, stream_.total_read() - offset);
+		}
+	}
+
+public:
+	view_indexer(stream_type& stream, object_type& layout, std::vector<view_field>& fields)
+		: stream_(stream), layout_(layout), fields_(fields) {}
+
+	void operator&(auto&& arg) {
+		index(std::forward<decltype(arg)>(arg));
+	}
+
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		(index(std::forward<Ts>(args)), ...);
+	}
+
+	void forward(std::string& str, const size_type length) {
+		const auto offset = stream_.total_read();
+		stream_.skip(length);
+		add(str, offset, length);
+	}
+};
+
+} // detail
+
+/**
+ * A lazily decoded view over a serialised message in a contiguous buffer.
+ *
+ * Constructing the view makes a single validation pass over the message,
+ * using the message type's serialise function, and records where each
+ * field's data is, without consuming anything from the buffer. Fields are
+ * then only decoded when they're accessed:
+ *
+ * hexi::message_view<Message> view(buffer);
+ *
+ * if(view) {
+ *     const auto id = view.get<&Message::id>();          // arithmetic, decoded
+ *     const auto name = view.get<&Message::name>();      // std::string_view
+ *     const auto values = view.get<&Message::values>();  // std::vector
+ *     buffer.skip(view.size());
+ * }
+ *
+ * This is useful where only a few fields of a large message are needed,
+ * e.g. to route or filter it. Strings are viewed in place, arithmetic
+ * types are decoded with the byte order they were written in and other
+ * trivial types are copied out, as are arrays of trivial types. Nested serialisable objects and other field types are validated but
+ * can't be accessed through the view. Conditional fields that the message
+ * doesn't contain can be detected with has.
+ *
+ * The view's lifetime is tied to that of the underlying buffer's data.
+ * The message type's serialise function is run against a default
+ * constructed instance that only has its arithmetic and trivial fields
+ * decoded, so serialise may depend on lengths and flags read earlier in
+ * the message, but not on the contents of strings or containers.
+ *
+ * @tparam T The message type. Must be default constructible.
+ * @tparam endianness The byte order of the message's arithmetic fields,
+ * other than those written through endian::be or endian::le.
+ */
+template<std::default_initializable T, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class message_view final {
+	const std::byte* data_ = nullptr;
+	std::size_t size_ = 0;
+	std::vector<detail::view_field> fields_;
+	stream_state state_ = stream_state::ok;
+
+	// only used to find the offsets of members
+	static const T& layout() {
+		static T instance{};
+		return instance;
+	}
+
+	template<auto member>
+	static std::size_t member_offset() {
+		return static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&(layout().*member))
+			- reinterpret_cast<const std::byte*>(&layout()));
+	}
+
+	template<auto member>
+	const detail::view_field* field() const {
+		const auto offset = member_offset<member>();
+
+		const auto it = std::ranges::find_if(fields_, [&](const auto& field) {
+			return field.member == offset;
+		});
+
+		return it == fields_.end()? nullptr : &*it;
+	}
+
+public:
+	/**
+	 * @brief Validates the message at the buffer's read position and builds
+	 * the view. Nothing is consumed from the buffer.
+	 *
+	 * @param buffer The buffer containing the message.
+	 */
+	template<transactional buf_type>
+	requires std::is_same_v<typename buf_type::contiguous, is_contiguous>
+	explicit message_view(buf_type& buffer) {
+		binary_stream<buf_type, no_throw_t, endianness> stream(buffer);
+		auto tx = stream.begin_transaction();
+		data_ = reinterpret_cast<const std::byte*>(buffer.read_ptr());
+
+		T message{};
+		detail::view_indexer indexer(*tx, message, fields_);
+		message.serialise(indexer);
+
+		state_ = tx->state();
+		size_ = tx->total_read();
+	}
+
+	/**
+	 * @brief Checks whether the message contains the field corresponding to
+	 * the member, which it may not if the field is conditional.
+	 *
+	 * @tparam member Pointer to the member, e.g. &Message::extra.
+	 *
+	 * @return True if the field can be accessed with get.
+	 */
+	template<auto member>
+	bool has() const {
+		return field<member>() != nullptr;
+	}
+
+	/**
+	 * @brief Decodes the field corresponding to the member.
+	 *
+	 * @tparam member Pointer to the member, e.g. &Message::name.
+	 *
+	 * @return The decoded value for arithmetic and other trivial types,
+	 * a std::string_view for strings or a copy of the elements for arrays.
+	 * If the message doesn't contain the field (see has), the result is
+	 * value-initialised.
+	 */
+	template<auto member>
+	auto get() const {
+		using member_type = std::remove_cvref_t<decltype(layout().*member)>;
+		const auto field = this->field<member>();
+
+		if constexpr(std::is_same_v<member_type, std::string>) {
+			if(!field) {
+				return std::string_view();
+			}
+
+			return std::string_view(reinterpret_cast<const char*>(data_ + field->offset), field->length);
+		} else if constexpr(detail::viewable_array<member_type>) {
+			/*
+			 * The data may not be aligned for the element type, so it's
+			 * copied out. Streams write arrays of trivial types as stored,
+			 * without byte swapping, so the elements are copied as-is to
+			 * match what deserialising the message would give.
+			 */
+			using element_type = typename member_type::value_type;
+			std::conditional_t<pod<member_type>, member_type, std::vector<element_type>> values{};
+
+			if(field) {
+				if constexpr(!pod<member_type>) {
+					values.resize(field->length / sizeof(element_type));
+				}
+
+				std::memcpy(values.data(), data_ + field->offset, values.size() * sizeof(element_type));
+			}
+
+			return values;
+		} else if constexpr(arithmetic<member_type>) {
+			member_type value{};
+
+			if(field) {
+				std::memcpy(&value, data_ + field->offset, sizeof(value));
+				endian::conditional_reverse_inplace(value, field->order, std::endian::native);
+			}
+
+			return value;
+		} else if constexpr(pod<member_type> && !detail::probe_serialisable<member_type>) {
+			member_type value{};
+
+			if(field) {
+				std::memcpy(&value, data_ + field->offset, sizeof(value));
+			}
+
+			return value;
+		} else {
+			static_assert(sizeof(member_type) == 0, "This field type can't be accessed through a view");
+		}
+	}
+
+	/**
+	 * @return The number of bytes occupied by the serialised message.
+	 */
+	std::size_t size() const {
+		return size_;
+	}
+
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
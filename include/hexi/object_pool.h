@@ -0,0 +1,179 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Pool of reusable objects for the deserialisation path.
+ *
+ * Released objects are returned to the pool as they are, rather than being
+ * destroyed, so any storage they own (strings, vectors, etc) is kept for the
+ * next message. Combined with binary_stream::set_reuse_storage, this allows
+ * steady-state decoding to avoid allocations entirely once the pool has
+ * warmed up.
+ *
+ * Not thread-safe. The pool must outlive any handles it hands out.
+ *
+ * @tparam T The pooled type.
+ */
+template<std::default_initializable T>
+class object_pool final {
+	std::vector<std::unique_ptr<T>> free_;
+	std::size_t created_ = 0;
+
+	T* take() {
+		if(free_.empty()) {
+			auto object = std::make_unique<T>();
+
+			// ensure that returning objects never needs to allocate, only
+			// counting the object once nothing else can throw. Growth is
+			// geometric so that a burst of new objects is amortised
+			if(free_.capacity() <= created_) {
+				free_.reserve(std::max<std::size_t>(created_ * 2, 8));
+			}
+
+			++created_;
+			return object.release();
+		}
+
+		auto object = std::move(free_.back());
+		free_.pop_back();
+		return object.release();
+	}
+
+	void release(T* object) {
+		assert(free_.size() < free_.capacity());
+		free_.emplace_back(object);
+	}
+
+public:
+	using size_type = std::size_t;
+
+	/**
+	 * Owning handle to a pooled object. Returns the object to the pool
+	 * when destroyed.
+	 */
+	class handle final {
+		object_pool* pool_ = nullptr;
+		T* object_ = nullptr;
+
+		friend class object_pool;
+
+		handle(object_pool* pool, T* object)
+			: pool_(pool), object_(object) {}
+
+	public:
+		handle() = default;
+
+		handle(handle&& rhs) noexcept
+			: pool_(std::exchange(rhs.pool_, nullptr)),
+			  object_(std::exchange(rhs.object_, nullptr)) {}
+
+		handle& operator=(handle&& rhs) noexcept {
+			if(this != &rhs) {
+				reset();
+				pool_ = std::exchange(rhs.pool_, nullptr);
+				object_ = std::exchange(rhs.object_, nullptr);
+			}
+
+			return *this;
+		}
+
+		handle(const handle&) = delete;
+		handle& operator=(const handle&) = delete;
+
+		~handle() {
+			reset();
+		}
+
+		/**
+		 * @brief Returns the object to the pool early.
+		 */
+		void reset() {
+			if(object_) {
+				pool_->release(object_);
+				object_ = nullptr;
+			}
+		}
+
+		T* get() const {
+			return object_;
+		}
+
+		T& operator*() const {
+			return *object_;
+		}
+
+		T* operator->() const {
+			return object_;
+		}
+
+		explicit operator bool() const {
+			return object_ != nullptr;
+		}
+	};
+
+	/**
+	 * @param count The number of objects to construct up-front.
+	 */
+	explicit object_pool(const size_type count = 0) {
+		free_.reserve(count);
+
+		for(size_type i = 0; i < count; ++i) {
+			free_.emplace_back(std::make_unique<T>());
+		}
+
+		created_ = count;
+	}
+
+	object_pool(object_pool&&) = delete;
+	object_pool& operator=(object_pool&&) = delete;
+	object_pool(const object_pool&) = delete;
+	object_pool& operator=(const object_pool&) = delete;
+
+	~object_pool() {
+		assert(free_.size() == created_ && "Pool destroyed with outstanding handles");
+	}
+
+	/**
+	 * @brief Takes an object from the pool, constructing a new one if
+	 * none are available.
+	 *
+	 * @note The object retains whatever state it had when it was last
+	 * released.
+	 *
+	 * @return A handle to the object.
+	 */
+	[[nodiscard]] handle acquire() {
+		return { this, take() };
+	}
+
+	/**
+	 * @return The number of objects currently available in the pool.
+	 */
+	size_type available() const {
+		return free_.size();
+	}
+
+	/**
+	 * @return The total number of objects created by the pool.
+	 */
+	size_type created() const {
+		return created_;
+	}
+};
+
+} // hexi
@@ -0,0 +1,109 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * An arithmetic value stored in a fixed byte order with no alignment
+ * requirement, for use as a field in wire structs. Conversions to and from
+ * the native representation happen on access.
+ *
+ * @tparam T The arithmetic type.
+ * @tparam order The byte order the value is stored in.
+ */
+template<arithmetic T, std::endian order>
+class endian_value final {
+	std::array<std::byte, sizeof(T)> bytes_;
+
+public:
+	using value_type = T;
+
+	endian_value() = default;
+
+	constexpr endian_value(const T value) {
+		set(value);
+	}
+
+	constexpr T get() const {
+		return endian::conditional_reverse<order, std::endian::native>(std::bit_cast<T>(bytes_));
+	}
+
+	constexpr void set(const T value) {
+		bytes_ = std::bit_cast<decltype(bytes_)>(
+			endian::conditional_reverse<std::endian::native, order>(value)
+		);
+	}
+
+	constexpr endian_value& operator=(const T value) {
+		set(value);
+		return *this;
+	}
+
+	constexpr operator T() const {
+		return get();
+	}
+};
+
+template<arithmetic T>
+using be = endian_value<T, std::endian::big>;
+
+template<arithmetic T>
+using le = endian_value<T, std::endian::little>;
+
+/**
+ * Types that can be overlaid directly onto buffer memory. They must be
+ * trivially copyable, standard layout, contain no padding and have no
+ * alignment requirement, which is the case for structs made up of be/le
+ * fields, single byte types and arrays thereof.
+ */
+template<typename T>
+concept overlayable = std::is_trivially_copyable_v<T>
+	&& std::is_standard_layout_v<T>
+	&& std::has_unique_object_representations_v<T>
+	&& alignof(T) == 1;
+
+/**
+ * @brief Overlays a wire struct onto the stream's buffer without copying,
+ * after a single bounds check, and advances the stream past it, e.g:
+ *
+ * struct dns_header {
+ *     hexi::be<std::uint16_t> id;
+ *     hexi::be<std::uint16_t> flags;
+ *     ...
+ * };
+ *
+ * if(auto header = hexi::overlay<dns_header>(stream)) {
+ *     const std::uint16_t id = header->id;
+ * }
+ *
+ * The pointer's lifetime is tied to that of the underlying buffer's data.
+ * On other buffers, wire structs can be read by copy with operator>>.
+ *
+ * @tparam T The wire struct type.
+ * @param stream The stream to read from.
+ *
+ * @return A pointer to the struct within the buffer, or nullptr if the
+ * stream doesn't contain enough data.
+ */
+template<overlayable T, typename stream_type>
+requires std::is_same_v<typename stream_type::contiguous_type, is_contiguous>
+const T* overlay(stream_type& stream) {
+	const auto bytes = stream.template span<const std::byte>(sizeof(T));
+	return bytes.empty()? nullptr : reinterpret_cast<const T*>(bytes.data());
+}
+
+} // hexi
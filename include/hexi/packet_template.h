@@ -0,0 +1,326 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/exception.h>
+#include <hexi/shared.h>
+#include <hexi/static_buffer.h>
+#include <array>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstring>
+
+namespace hexi {
+
+template<arithmetic T, std::derived_from<endian::storage_tag> endianness>
+struct patch_value {
+	std::size_t offset;
+	T value;
+
+	void apply(void* destination) const {
+		const auto converted = endian::storage_in(value, endianness{});
+		std::memcpy(static_cast<std::byte*>(destination) + offset, &converted, sizeof(converted));
+	}
+};
+
+namespace detail {
+
+/*
+ * Whether writing to the buffer makes room for the data, rather than
+ * failing once the buffer's free space runs out.
+ */
+template<typename buf_type>
+struct growable : std::bool_constant<!fixed_capacity<buf_type>> {};
+
+template<typename container_type, bool space_optimise>
+struct growable<buffer_adaptor<container_type, space_optimise>>
+	: std::bool_constant<has_resize<container_type> || has_resize_overwrite<container_type>> {};
+
+} // detail
+
+/**
+ * Handle to a field within a packet_template. Calling it with a value
+ * produces a patch that can be passed to stamp(). Handles for fields that
+ * couldn't be added to the template are invalid and any patches made from
+ * them will be rejected by stamp().
+ */
+template<arithmetic T, std::derived_from<endian::storage_tag> endianness>
+struct patch_point {
+	using value_type = T;
+
+	static constexpr auto npos { static_cast<std::size_t>(-1) };
+
+	std::size_t offset;
+
+	constexpr patch_value<T, endianness> operator()(const T value) const {
+		return { offset, value };
+	}
+
+	constexpr bool valid() const {
+		return offset != npos;
+	}
+};
+
+/**
+ * Serialise once, stamp many.
+ *
+ * Holds a pre-serialised packet along with the locations of any fields that
+ * need to change between sends (sequence numbers, timestamps, etc). Stamping
+ * out a copy is then a memcpy of the template plus a store for each patched
+ * field, rather than a full serialisation.
+ *
+ * @tparam capacity The maximum size of the serialised packet.
+ * @tparam endianness The default byte order for the packet's fields.
+ * @tparam storage_type The byte type used for the template's storage.
+ */
+template<std::size_t capacity,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+	byte_type storage_type = std::byte,
+	std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG>
+class packet_template final {
+	using buffer_type = static_buffer<storage_type, capacity>;
+
+	buffer_type buffer_;
+	stream_state state_ = stream_state::ok;
+
+	template<typename stream_type>
+	void update_state(const stream_type& stream) {
+		if(state_ == stream_state::ok) {
+			state_ = stream.state();
+		}
+	}
+
+	template<typename patch_type>
+	bool in_bounds(const patch_type& patch) const {
+		const auto size = buffer_.size();
+
+		if(patch.offset <= size && sizeof(patch.value) <= size - patch.offset) [[likely]] {
+			return true;
+		}
+
+		if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+			HEXI_THROW(buffer_overflow(sizeof(patch.value), patch.offset, size));
+		}
+
+		return false;
+	}
+
+	template<typename ...patches>
+	bool check_patches(const patches&... values) const {
+		return (in_bounds(values) && ...);
+	}
+
+	template<typename ...patches>
+	void stamp_into(void* destination, const patches&... values) const {
+		std::memcpy(destination, buffer_.read_ptr(), buffer_.size());
+		(values.apply(destination), ...);
+	}
+
+public:
+	using size_type  = typename buffer_type::size_type;
+	using value_type = storage_type;
+
+	/**
+	 * @brief Serialises data into the template, with the same semantics
+	 * as binary_stream.
+	 *
+	 * @param data The data to be written.
+	 *
+	 * @return Reference to the current template.
+	 */
+	template<typename T>
+	packet_template& operator<<(T&& data) {
+		binary_stream<buffer_type, exceptions, endianness> stream(buffer_);
+		stream << data;
+		update_state(stream);
+		return *this;
+	}
+
+	/**
+	 * @brief Appends a field that can be patched when stamping.
+	 *
+	 * @tparam T The field type.
+	 * @tparam field_endianness The byte order of the field, defaulting to
+	 * that of the template.
+	 * @param initial The value the field will take when it isn't patched.
+	 *
+	 * @return A handle to the field, which will be invalid if the field
+	 * couldn't be written.
+	 */
+	template<arithmetic T,
+		std::derived_from<endian::storage_tag> field_endianness = endianness>
+	patch_point<T, field_endianness> placeholder(const T initial = {}) {
+		const auto offset = buffer_.size();
+		binary_stream<buffer_type, exceptions, field_endianness> stream(buffer_);
+		stream << initial;
+		update_state(stream);
+
+		if(!stream) [[unlikely]] {
+			return { patch_point<T, field_endianness>::npos };
+		}
+
+		return { offset };
+	}
+
+	/**
+	 * @brief Marks an existing field within the template as patchable, such
+	 * as a field within a previously serialised object.
+	 *
+	 * @tparam T The field type.
+	 * @tparam field_endianness The byte order of the field, defaulting to
+	 * that of the template.
+	 * @param offset The offset of the field from the start of the template.
+	 *
+	 * @return A handle to the field, which will be invalid if the field
+	 * isn't within the template.
+	 */
+	template<arithmetic T,
+		std::derived_from<endian::storage_tag> field_endianness = endianness>
+	patch_point<T, field_endianness> patch_at(const size_type offset) const {
+		if(offset > buffer_.size() || sizeof(T) > buffer_.size() - offset) [[unlikely]] {
+			return { patch_point<T, field_endianness>::npos };
+		}
+
+		return { offset };
+	}
+
+	/**
+	 * @brief Stamps a copy of the template into the provided memory,
+	 * applying the patches.
+	 *
+	 * @param destination The memory to write the packet to. Must be
+	 * at least size() bytes.
+	 * @param values The patches to apply.
+	 *
+	 * @return True if the packet was stamped. Nothing is written if the
+	 * destination is too small or any patch lies outside of the template,
+	 * e.g. one made from an invalid patch point, in which case
+	 * buffer_overflow is thrown if exceptions are enabled.
+	 */
+	template<byte_type T, std::size_t extent, typename ...patches>
+	bool stamp(std::span<T, extent> destination, const patches&... values) const {
+		if(destination.size() < buffer_.size()) [[unlikely]] {
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(buffer_overflow(buffer_.size(), 0, destination.size()));
+			}
+
+			return false;
+		}
+
+		if(!check_patches(values...)) [[unlikely]] {
+			return false;
+		}
+
+		stamp_into(destination.data(), values...);
+		return true;
+	}
+
+	/**
+	 * @brief Stamps a copy of the template into the provided buffer,
+	 * applying the patches.
+	 *
+	 * If the buffer has enough contiguous free space (including a
+	 * dynamic_buffer's tail block), the packet is stamped directly into
+	 * that space. Otherwise, it's stamped into temporary storage and written
+	 * to the buffer, provided that the buffer can grow to fit it.
+	 *
+	 * @param buffer The buffer to write the packet to.
+	 * @param values The patches to apply.
+	 *
+	 * @return True if the packet was stamped. Nothing is written if a
+	 * buffer that can't grow doesn't have enough free space or any patch
+	 * lies outside of the template, e.g. one made from an invalid patch
+	 * point, in which case buffer_overflow is thrown if exceptions are
+	 * enabled.
+	 */
+	template<writeable buf_type, typename ...patches>
+	bool stamp(buf_type& buffer, const patches&... values) const {
+		const auto size = buffer_.size();
+
+		if(!check_patches(values...)) [[unlikely]] {
+			return false;
+		}
+
+		if constexpr(!detail::growable<buf_type>::value) {
+			if(buffer.free() < size) [[unlikely]] {
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(buffer_overflow(size, 0, buffer.free()));
+				}
+
+				return false;
+			}
+		}
+
+		if constexpr(direct_writeable<buf_type>) {
+			if(buffer.free() >= size) {
+				stamp_into(buffer.write_ptr(), values...);
+				buffer.advance_write(size);
+				return true;
+			}
+		} else if constexpr(tail_writeable<buf_type>) {
+			const auto tail = buffer.back();
+
+			if(tail && tail->free() >= size) {
+				stamp_into(tail->write_ptr(), values...);
+				buffer.advance_write(size);
+				return true;
+			}
+		}
+
+		std::array<storage_type, capacity> packet;
+		stamp_into(packet.data(), values...);
+		buffer.write(packet.data(), size);
+		return true;
+	}
+
+	/**
+	 * @return The size of the serialised packet.
+	 */
+	size_type size() const {
+		return buffer_.size();
+	}
+
+	/**
+	 * @return The unpatched packet data.
+	 */
+	std::span<const storage_type> data() const {
+		return buffer_.read_span();
+	}
+
+	/**
+	 * @brief Clears the template, invalidating any existing patch points.
+	 */
+	void clear() {
+		buffer_.clear();
+		state_ = stream_state::ok;
+	}
+
+	/**
+	 * @return The template's state. Will be in an error state if any
+	 * writes to the template have failed.
+	 */
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
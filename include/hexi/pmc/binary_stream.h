@@ -22,7 +22,7 @@ public:
 		  binary_stream_writer(source) {}
 
 	explicit binary_stream(hexi::pmc::buffer& source, hexi::no_throw_t, std::size_t read_limit = 0)
-		: stream_base(source),
+		: stream_base(source, false),
 		  binary_stream_reader(source, no_throw, read_limit),
 		  binary_stream_writer(source, no_throw) {}
 
@@ -11,10 +11,18 @@
 #include <hexi/concepts.h>
 #include <hexi/endian.h>
 #include <hexi/exception.h>
+#include <hexi/fixed_string.h>
+#include <hexi/serialised_size.h>
 #include <hexi/shared.h>
 #include <hexi/stream_adaptors.h>
+#include <hexi/utf8.h>
+#include <algorithm>
+#include <limits>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -43,7 +51,10 @@ using namespace detail;
 class binary_stream_reader : virtual public stream_base {
 	buffer_read& buffer_;
 	std::size_t total_read_;
+	std::size_t allocated_ = 0;
+	std::size_t alloc_limit_ = 0;
 	const std::size_t read_limit_;
+	bool reuse_storage_ = false;
 
 	inline void enforce_read_bounds(const std::size_t read_size) {
 		if(read_size > buffer_.size()) [[unlikely]] {
@@ -73,12 +84,94 @@ class binary_stream_reader : virtual public stream_base {
 		total_read_ += read_size;
 	}
 
+	/*
+	 * Rejects element counts that the remaining data couldn't possibly
+	 * satisfy, given the minimum serialised size of each element, before
+	 * anything is allocated for them.
+	 */
+	template<typename count_type>
+	bool check_element_count(const count_type count, const std::size_t min_size) {
+		if(!min_size || !std::cmp_greater(count, read_max() / min_size)) [[likely]] {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<std::size_t>::max();
+
+		const auto required = std::cmp_greater(count, max_size / min_size)?
+			max_size : static_cast<std::size_t>(count * min_size);
+
+		enforce_read_bounds(required);
+		return state() == stream_state::ok;
+	}
+
+	/*
+	 * Accounts for an allocation of count elements against the stream's
+	 * allocation limit, if one was set. Charged before the read's bounds
+	 * are enforced, so that a rejected allocation doesn't count towards
+	 * the read limit.
+	 */
+	template<typename count_type>
+	bool charge_allocation(const count_type count, const std::size_t element_size) {
+		if(state() != stream_state::ok) [[unlikely]] {
+			return false;
+		}
+
+		if(!alloc_limit_) {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<std::size_t>::max();
+
+		const auto bytes = std::cmp_greater(count, max_size / element_size)?
+			max_size : static_cast<std::size_t>(count * element_size);
+
+		if(allocated_ > alloc_limit_ || bytes > alloc_limit_ - allocated_) [[unlikely]] {
+			set_state(stream_state::alloc_limit_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(allocation_limit_exceeded(bytes, allocated_, alloc_limit_));
+			}
+
+			return false;
+		}
+
+		allocated_ += bytes;
+		return true;
+	}
+
 	template<typename container_type, typename count_type>
 	void read_container(container_type& container, const count_type count) {
 		using cvalue_type = typename container_type::value_type;
+		count_type reused = 0;
+
+		if constexpr(fixed_capacity<container_type>) {
+			if(count > container_type::capacity()) [[unlikely]] {
+				set_state(stream_state::capacity_err);
+
+				if(allow_throw()) {
+					HEXI_THROW(capacity_exceeded(count, container_type::capacity()));
+				}
+
+				return;
+			}
+		}
+
+		if(!check_element_count(count, bounds_of<cvalue_type>().min)) [[unlikely]] {
+			return;
+		}
+
+		if constexpr(!fixed_capacity<container_type>) {
+			if(!charge_allocation(count, sizeof(cvalue_type))) [[unlikely]] {
+				return;
+			}
+		}
 
 		if constexpr(!memcpy_read<container_type, binary_stream_reader>) {
-			container.clear();
+			if(reuse_storage_) {
+				reused = overwrite_elements(container, count);
+			} else {
+				container.clear();
+			}
 		}
 
 		if constexpr(has_reserve<container_type>) {
@@ -91,7 +184,7 @@ class binary_stream_reader : virtual public stream_base {
 			const auto bytes = count * sizeof(cvalue_type);
 			SAFE_READ(container.data(), bytes, void());
 		} else {
-			for(count_type i = 0; i < count; ++i) {
+			for(count_type i = reused; i < count; ++i) {
 				cvalue_type value;
 				*this >> value;
 				container.emplace_back(std::move(value));
@@ -99,6 +192,27 @@ class binary_stream_reader : virtual public stream_base {
 		}
 	}
 
+	template<typename container_type, typename count_type>
+	count_type overwrite_elements(container_type& container, const count_type count) {
+		using reference = std::ranges::range_reference_t<container_type>;
+
+		if constexpr(std::is_lvalue_reference_v<reference>) {
+			count_type reused = 0;
+			auto it = container.begin();
+
+			for(; it != container.end() && reused < count && state() == stream_state::ok; ++it) {
+				*this >> *it;
+				++reused;
+			}
+
+			container.erase(it, container.end());
+			return reused;
+		} else {
+			container.clear();
+			return 0;
+		}
+	}
+
 public:
 	explicit binary_stream_reader(buffer_read& source, std::size_t read_limit = 0)
 		: stream_base(source),
@@ -116,7 +230,10 @@ public:
 		: stream_base(rhs),
 		  buffer_(rhs.buffer_),
 		  total_read_(rhs.total_read_),
-		  read_limit_(rhs.read_limit_) {
+		  allocated_(rhs.allocated_),
+		  alloc_limit_(rhs.alloc_limit_),
+		  read_limit_(rhs.read_limit_),
+		  reuse_storage_(rhs.reuse_storage_) {
 		rhs.total_read_ = static_cast<std::size_t>(-1);
 		rhs.set_state(stream_state::invalid_stream);
 	}
@@ -167,9 +284,13 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -193,9 +314,13 @@ public:
 			std::unreachable();
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -203,6 +328,87 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Deserialises a string with the wrapped adaptor and validates
+	 * that it's well-formed UTF-8.
+	 * 
+	 * @param[out] adaptor utf8 adaptor wrapping the string or string adaptor.
+	 * 
+	 * @note Invalid strings result in stream_state::invalid_utf8_err. The
+	 * string is left holding the invalid data.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	binary_stream_reader& operator>>(utf8_validated<T> adaptor) {
+		*this >> adaptor.value;
+
+		if(state() != stream_state::ok) {
+			return *this;
+		}
+
+		const auto string = utf8_view(adaptor.value);
+
+		if(!is_valid_utf8(string)) [[unlikely]] {
+			set_state(stream_state::invalid_utf8_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(invalid_utf8(utf8_error_offset(string), string.size()));
+			}
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was serialised through a string
+	 * table, resolving references to earlier occurrences. Strings are
+	 * copied into the table, so string_views remain valid until it's
+	 * cleared.
+	 * 
+	 * @param[out] adaptor deduplicated adaptor referencing the std::string
+	 * or std::string_view to hold the result and the message's string table.
+	 * 
+	 * @note A reference to a string that isn't in the table results in
+	 * stream_state::invalid_tag_err.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	requires std::same_as<T, std::string> || std::same_as<T, std::string_view>
+	binary_stream_reader& operator>>(deduplicated_string<T, table_type> adaptor) {
+		const auto tag = varint_decode<std::size_t>(*this);
+
+		if(state() != stream_state::ok) {
+			return *this;
+		}
+
+		const auto value = tag >> 1;
+
+		if(tag & 1) {
+			if(value >= adaptor.table.size()) [[unlikely]] {
+				set_state(stream_state::invalid_tag_err);
+
+				if(allow_throw()) {
+					HEXI_THROW(invalid_string_reference(value, adaptor.table.size()));
+				}
+
+				return *this;
+			}
+
+			adaptor.str = adaptor.table[value];
+		} else {
+			std::string string;
+			get(string, value);
+
+			if(state() == stream_state::ok) {
+				adaptor.str = adaptor.table.add(std::move(string));
+			}
+		}
+
+		return *this;
+	}
+
 	/**
 	 * @brief Deserialises a string that was previously written with a
 	 * null terminator.
@@ -219,11 +425,15 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(pos, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
 
-		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, pos);
-			return size;
+			return pos;
 		});
 
 		buffer_.skip(1); // skip null terminator
@@ -247,6 +457,62 @@ public:
 		return *this >> prefixed(data);
 	}
 
+	/**
+	 * @brief Deserialises a fixed_string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data fixed_string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_reader& operator>>(fixed_string<N>& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor fixed_string to hold the result.
+	 * 
+	 * @note If the terminator is beyond the fixed_string's capacity, the
+	 * stream will be put into the capacity_err state. If no terminator is
+	 * found at all, the string is cleared and nothing is consumed, as with
+	 * std::string.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_reader& operator>>(null_terminated<fixed_string<N>> adaptor) {
+		auto pos = buffer_.find_first_of(std::byte{0});
+
+		if(pos == buffer_.npos) {
+			adaptor->clear();
+			return *this;
+		}
+
+		if(pos > N) [[unlikely]] {
+			set_state(stream_state::capacity_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(capacity_exceeded(pos, N));
+			}
+
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, pos);
+			return pos;
+		});
+
+		buffer_.skip(1); // skip null terminator
+		return *this;
+	}
+
 	/**
 	 * @brief Deserialises an object that provides a deserialise function:
 	 * auto& operator>>(auto& stream);
@@ -357,11 +623,15 @@ public:
 	 * @param count The number of bytes to be read.
 	 */
 	void get(std::string& dest, std::size_t size) {
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, void());
 
-		dest.resize_and_overwrite(size, [&](char* strbuf, std::size_t len) {
-			buffer_.read(strbuf, len);
-			return len;
+		dest.resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, size);
+			return size;
 		});
 	}
 
@@ -480,6 +750,53 @@ public:
 		return read_limit_;
 	}
 
+	/**
+	 * @brief Controls whether deserialising into a non-empty container
+	 * overwrites its existing elements in place, rather than clearing it
+	 * and constructing new elements.
+	 * 
+	 * @param enable Whether existing elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @brief Sets an upper limit on the number of bytes that container and
+	 * string reads may allocate over the lifetime of the stream, guarding
+	 * against untrusted length prefixes.
+	 * 
+	 * Exceeding the limit puts the stream into an error state.
+	 * 
+	 * @param limit The allocation limit in bytes, or zero for no limit.
+	 */
+	void set_allocation_limit(const std::size_t limit) {
+		alloc_limit_ = limit;
+	}
+
+	/**
+	 * @return The allocation limit, or zero if no limit was set.
+	 */
+	std::size_t allocation_limit() const {
+		return alloc_limit_;
+	}
+
+	/**
+	 * @return The total number of bytes allocated by container and string
+	 * reads while an allocation limit was set.
+	 */
+	std::size_t allocated() const {
+		return allocated_;
+	}
+
 	/**
 	 * @brief Determine the maximum number of bytes that can be
 	 * safely read from this stream.
@@ -492,8 +809,8 @@ public:
 	 */
 	std::size_t read_max() const {
 		if(read_limit_) {
-			assert(total_read_ < read_limit_);
-			return read_limit_ - total_read_;
+			assert(total_read_ <= read_limit_);
+			return std::min<std::size_t>(read_limit_ - total_read_, buffer_.size());
 		} else {
 			return buffer_.size();
 		}
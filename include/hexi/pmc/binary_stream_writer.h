@@ -10,6 +10,7 @@
 #include <hexi/pmc/buffer_write.h>
 #include <hexi/concepts.h>
 #include <hexi/endian.h>
+#include <hexi/fixed_string.h>
 #include <hexi/shared.h>
 #include <hexi/stream_adaptors.h>
 #include <algorithm>
@@ -177,6 +178,23 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a fixed_string as a null terminated string.
+	 * 
+	 * @tparam T The fixed_string type.
+	 * @param adaptor null_terminated adaptor that will instruct the stream to write
+	 * a null terminated string with no prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires is_fixed_string_v<std::remove_const_t<T>>
+	binary_stream_writer& operator<<(null_terminated<T> adaptor) {
+		assert(adaptor->view().find_first_of('\0') == std::string_view::npos);
+		write(adaptor->data(), adaptor->size() + 1); // always null terminated
+		return *this;
+	}
+
 	/**
 	 * @brief Serialises a string, string_view or any type providing data()
 	 * and a size() member functions.
@@ -214,6 +232,18 @@ public:
 		return *this << prefixed(string);
 	}
 
+	/**
+	 * @brief Serialises a fixed_string with a fixed-length prefix.
+	 * 
+	 * @param string fixed_string to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_writer& operator<<(const fixed_string<N>& string) {
+		return *this << prefixed(string);
+	}
+
 	/**
 	 * @brief Serialises a C-style string.
 	 * 
@@ -273,6 +303,21 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a string through a string table, as a reference to
+	 * an earlier occurrence where there is one.
+	 * 
+	 * @param adaptor deduplicated adaptor referencing the string and the
+	 * message's string table.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	binary_stream_writer& operator<<(deduplicated_string<T, table_type> adaptor) {
+		deduplicated_encode(*this, std::string_view(adaptor.str), adaptor.table);
+		return *this;
+	}
+
 	/**
 	 * @brief Writes a contiguous range to the stream.
 	 * 
@@ -0,0 +1,51 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/binary_stream.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/serialised_size.h>
+#include <hexi/static_buffer.h>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * @brief Serialises an object into an array of exactly the object's
+ * serialised size.
+ *
+ * Intended to be used in a constant expression, allowing packets that never
+ * change (handshake replies, keep-alives, etc) to be baked into the binary
+ * rather than being serialised on every send, e.g:
+ *
+ * constexpr auto keep_alive = hexi::precompute(KeepAlive{}, hexi::endian::big);
+ *
+ * @tparam storage_type The byte type of the resulting array.
+ * @param object The object to be serialised. Its serialise function must be
+ * constexpr.
+ * @param byte_order The byte order to serialise the object with.
+ *
+ * @return An array containing the serialised object.
+ */
+template<byte_type storage_type = std::byte,
+	fixed_serialised_size T,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+constexpr auto precompute(T object, endianness byte_order = {}) {
+	static_buffer<storage_type, serialised_size_v<T>> buffer;
+	binary_stream stream(buffer, byte_order);
+	stream << object;
+
+	std::array<storage_type, serialised_size_v<T>> packet{};
+	std::ranges::copy(buffer, packet.begin());
+	return packet;
+}
+
+} // hexi
@@ -0,0 +1,483 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/detail/simd.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+/**
+ * Types with floating point x, y, z and w members, which can be encoded
+ * as quaternions with the smallest_three adaptor.
+ */
+template<typename T>
+concept quaternion = requires(T q) {
+	requires std::floating_point<decltype(q.x)>;
+	requires std::same_as<decltype(q.x), decltype(q.y)>;
+	requires std::same_as<decltype(q.x), decltype(q.z)>;
+	requires std::same_as<decltype(q.x), decltype(q.w)>;
+};
+
+namespace detail {
+
+// number of values encoded at a time by the bulk stream adaptors
+constexpr std::size_t quantise_chunk_size = 64;
+
+template<std::floating_point T>
+constexpr unsigned int max_quantise_bits = std::min(std::numeric_limits<T>::digits, 32);
+
+constexpr unsigned int min_smallest_three_bits = 2;
+constexpr unsigned int max_smallest_three_bits = 20;
+
+/*
+ * Invokes the function with a std::type_identity of the smallest unsigned
+ * type that can hold the given number of bits.
+ */
+template<typename func_type>
+constexpr decltype(auto) with_word_type(const unsigned int bits, func_type&& func) {
+	assert(bits && bits <= 64);
+
+	if(bits <= 8) {
+		return func(std::type_identity<std::uint8_t>{});
+	} else if(bits <= 16) {
+		return func(std::type_identity<std::uint16_t>{});
+	} else if(bits <= 32) {
+		return func(std::type_identity<std::uint32_t>{});
+	} else {
+		return func(std::type_identity<std::uint64_t>{});
+	}
+}
+
+template<std::floating_point T>
+struct quantise_params {
+	using int_type = std::conditional_t<sizeof(T) <= sizeof(std::int32_t), std::int32_t, std::int64_t>;
+
+	T min;
+	T max;
+	T scale;
+	T step;
+	int_type max_code;
+
+	// bits is clamped to the supported range, streams reject it beforehand
+	constexpr quantise_params(const T min, const T max, const unsigned int bits)
+		: min(min), max(max) {
+		assert(bits && bits <= max_quantise_bits<T>);
+		assert(min < max);
+		const auto width = std::clamp(bits, 1u, max_quantise_bits<T>);
+		max_code = static_cast<int_type>((std::uint64_t(1) << width) - 1);
+		scale = static_cast<T>(max_code) / (max - min);
+		step = (max - min) / static_cast<T>(max_code);
+	}
+
+	/*
+	 * Branchless, so that loops over these can be vectorised. The result is
+	 * clamped as the scaling can round up to one past the largest code when
+	 * the number of bits is close to the precision of T.
+	 */
+	constexpr std::uint64_t encode(T value) const {
+		value = value > max? max : value;
+		value = value >= min? value : min; // also catches NaN
+		const auto code = static_cast<int_type>((value - min) * scale + T(0.5));
+		return static_cast<std::uint64_t>(code < max_code? code : max_code);
+	}
+
+	constexpr T decode(const std::uint64_t code) const {
+		return min + static_cast<T>(static_cast<int_type>(code)) * step;
+	}
+};
+
+template<std::floating_point T>
+constexpr T smallest_three_bound = T(0.70710678118654752440); // 1 / sqrt(2)
+
+} // detail
+
+/**
+ * @brief Converts a float to IEEE 754 binary16, rounding to nearest even.
+ * Values too large to be represented become infinity and NaNs are quieted.
+ * Uses F16C where it's available.
+ *
+ * @param value The value to convert.
+ *
+ * @return The binary16 representation of the value.
+ */
+inline std::uint16_t to_half(const float value) {
+#ifdef HEXI_HAS_F16C
+	return static_cast<std::uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+	const auto bits = std::bit_cast<std::uint32_t>(value);
+	const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+	const auto abs = bits & 0x7fffffff;
+
+	// infinity or NaN, keeping the top bits of the payload
+	if(abs >= 0x7f800000) {
+		const auto nan = abs > 0x7f800000? 0x200 | ((abs >> 13) & 0x3ff) : 0;
+		return static_cast<std::uint16_t>(sign | 0x7c00 | nan);
+	}
+
+	// rounds to 65520 or above, which is past the largest finite half
+	if(abs >= 0x477ff000) {
+		return static_cast<std::uint16_t>(sign | 0x7c00);
+	}
+
+	// too small to be a normal half, becomes subnormal or zero
+	if(abs < 0x38800000) {
+		if(abs < 0x33000000) {
+			return sign;
+		}
+
+		const auto shift = 126 - (abs >> 23);
+		const auto mantissa = (abs & 0x7fffff) | 0x800000;
+		const auto halfway = std::uint32_t(1) << (shift - 1);
+		const auto remainder = mantissa & ((std::uint32_t(1) << shift) - 1);
+		auto result = mantissa >> shift;
+
+		if(remainder > halfway || (remainder == halfway && (result & 1))) {
+			++result; // may carry into the smallest normal, which is correct
+		}
+
+		return static_cast<std::uint16_t>(sign | result);
+	}
+
+	auto result = (abs - 0x38000000) >> 13;
+	const auto remainder = abs & 0x1fff;
+
+	if(remainder > 0x1000 || (remainder == 0x1000 && (result & 1))) {
+		++result;
+	}
+
+	return static_cast<std::uint16_t>(sign | result);
+#endif
+}
+
+/**
+ * @brief Converts an IEEE 754 binary16 value to a float. The conversion
+ * is exact. Uses F16C where it's available.
+ *
+ * @param value The binary16 value.
+ *
+ * @return The value as a float.
+ */
+inline float from_half(const std::uint16_t value) {
+#ifdef HEXI_HAS_F16C
+	return _cvtsh_ss(value);
+#else
+	const auto sign = std::uint32_t(value & 0x8000) << 16;
+	const auto exponent = (value >> 10) & 0x1f;
+	const auto mantissa = std::uint32_t(value & 0x3ff);
+
+	// infinity or NaN, which is quieted
+	if(exponent == 0x1f) {
+		const auto nan = mantissa? 0x400000 | (mantissa << 13) : 0;
+		return std::bit_cast<float>(sign | 0x7f800000 | nan);
+	}
+
+	if(exponent == 0) {
+		const auto result = static_cast<float>(mantissa) * 0x1p-24f;
+		return sign? -result : result;
+	}
+
+	return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+#endif
+}
+
+/**
+ * @brief Converts floats to IEEE 754 binary16, eight at a time where F16C
+ * is available.
+ *
+ * @param in The values to convert.
+ * @param[out] out The converted values. Must be the same size as in.
+ */
+inline void to_half(std::span<const float> in, std::span<std::uint16_t> out) {
+	assert(in.size() == out.size());
+	std::size_t i = 0;
+
+#ifdef HEXI_HAS_F16C
+	for(; i + 8 <= in.size(); i += 8) {
+		const auto values = _mm256_loadu_ps(in.data() + i);
+		const auto halves = _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), halves);
+	}
+#endif
+
+	for(; i < in.size(); ++i) {
+		out[i] = to_half(in[i]);
+	}
+}
+
+/**
+ * @brief Converts IEEE 754 binary16 values to floats, eight at a time where
+ * F16C is available.
+ *
+ * @param in The values to convert.
+ * @param[out] out The converted values. Must be the same size as in.
+ */
+inline void from_half(std::span<const std::uint16_t> in, std::span<float> out) {
+	assert(in.size() == out.size());
+	std::size_t i = 0;
+
+#ifdef HEXI_HAS_F16C
+	for(; i + 8 <= in.size(); i += 8) {
+		const auto halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+		_mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(halves));
+	}
+#endif
+
+	for(; i < in.size(); ++i) {
+		out[i] = from_half(in[i]);
+	}
+}
+
+/**
+ * @brief Maps a value in [min, max] onto an unsigned integer of the given
+ * number of bits, rounding to the nearest step. Values outside of the range
+ * are clamped and NaN becomes min.
+ *
+ * The error when dequantising is at most (max - min) / (2 * (2^bits - 1)),
+ * plus the rounding error of T.
+ *
+ * @param value The value to quantise.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits, up to 32 or the precision of T.
+ *
+ * @return The quantised value.
+ */
+template<std::floating_point T>
+constexpr std::uint32_t quantise(const T value, const std::type_identity_t<T> min,
+                                 const std::type_identity_t<T> max, const unsigned int bits) {
+	return static_cast<std::uint32_t>(detail::quantise_params<T>(min, max, bits).encode(value));
+}
+
+/**
+ * @brief Maps a quantised value back onto [min, max].
+ *
+ * @param value The quantised value.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits the value was quantised to.
+ *
+ * @return The dequantised value.
+ */
+template<std::floating_point T>
+constexpr T dequantise(const std::uint32_t value, const std::type_identity_t<T> min,
+                       const std::type_identity_t<T> max, const unsigned int bits) {
+	return detail::quantise_params<T>(min, max, bits).decode(value);
+}
+
+/**
+ * @brief Quantises an array of values. The loop is branchless, so that
+ * the compiler can vectorise it.
+ *
+ * @param in The values to quantise.
+ * @param[out] out The quantised values. Must be the same size as in and
+ * its type must be able to hold the given number of bits.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits, up to 32 or the precision of T.
+ */
+template<std::floating_point T, std::unsigned_integral word_type>
+constexpr void quantise(std::span<const std::type_identity_t<T>> in, std::span<word_type> out,
+                        const T min, const T max, const unsigned int bits) {
+	assert(in.size() == out.size());
+	assert(bits <= std::numeric_limits<word_type>::digits);
+	const detail::quantise_params<T> params(min, max, bits);
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		out[i] = static_cast<word_type>(params.encode(in[i]));
+	}
+}
+
+/**
+ * @brief Dequantises an array of values. The loop is branchless, so that
+ * the compiler can vectorise it.
+ *
+ * @param in The quantised values.
+ * @param[out] out The dequantised values. Must be the same size as in.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits the values were quantised to.
+ */
+template<std::floating_point T, std::unsigned_integral word_type>
+constexpr void dequantise(std::span<const word_type> in, std::span<std::type_identity_t<T>> out,
+                          const T min, const T max, const unsigned int bits) {
+	assert(in.size() == out.size());
+	const detail::quantise_params<T> params(min, max, bits);
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		out[i] = params.decode(in[i]);
+	}
+}
+
+/**
+ * @brief Encodes a unit quaternion as the index of its largest component,
+ * in the low two bits, followed by the other three components quantised to
+ * the given number of bits each. The largest component is recovered from
+ * the others, relying on q and -q being the same rotation.
+ *
+ * Each of the three components has an error of at most
+ * 1 / (sqrt(2) * (2^bits - 1)), e.g. 0.0007 with 10 bits.
+ *
+ * @param value The quaternion to encode. Must be normalised.
+ * @param bits The number of bits per component, from 2 to 20.
+ *
+ * @return The encoded quaternion, occupying 2 + (3 * bits) bits.
+ */
+template<quaternion T>
+constexpr std::uint64_t encode_smallest_three(const T& value, const unsigned int bits) {
+	using value_type = decltype(value.x);
+	assert(bits >= detail::min_smallest_three_bits && bits <= detail::max_smallest_three_bits);
+
+	constexpr auto bound = detail::smallest_three_bound<value_type>;
+	const detail::quantise_params<value_type> params(-bound, bound, bits);
+	const std::array components { value.x, value.y, value.z, value.w };
+	std::size_t largest = 0;
+
+	for(std::size_t i = 1; i < components.size(); ++i) {
+		if(std::abs(components[i]) > std::abs(components[largest])) {
+			largest = i;
+		}
+	}
+
+	const value_type sign = components[largest] < 0? -1 : 1;
+	std::uint64_t result = largest;
+	unsigned int shift = 2;
+
+	for(std::size_t i = 0; i < components.size(); ++i) {
+		if(i != largest) {
+			result |= params.encode(components[i] * sign) << shift;
+			shift += bits;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @brief Decodes a quaternion encoded with encode_smallest_three.
+ *
+ * @param encoded The encoded quaternion.
+ * @param[out] value The decoded quaternion.
+ * @param bits The number of bits per component that it was encoded with.
+ */
+template<quaternion T>
+constexpr void decode_smallest_three(const std::uint64_t encoded, T& value, const unsigned int bits) {
+	using value_type = decltype(value.x);
+	assert(bits >= detail::min_smallest_three_bits && bits <= detail::max_smallest_three_bits);
+
+	constexpr auto bound = detail::smallest_three_bound<value_type>;
+	const detail::quantise_params<value_type> params(-bound, bound, bits);
+	const auto mask = (std::uint64_t(1) << bits) - 1;
+	const auto largest = static_cast<std::size_t>(encoded & 0x03);
+
+	std::array<value_type, 4> components{};
+	value_type sum = 0;
+	unsigned int shift = 2;
+
+	for(std::size_t i = 0; i < components.size(); ++i) {
+		if(i != largest) {
+			components[i] = params.decode((encoded >> shift) & mask);
+			sum += components[i] * components[i];
+			shift += bits;
+		}
+	}
+
+	components[largest] = std::sqrt(std::max(value_type(0), value_type(1) - sum));
+	value.x = components[0];
+	value.y = components[1];
+	value.z = components[2];
+	value.w = components[3];
+}
+
+/**
+ * Serialises floats as IEEE 754 binary16 (half precision), e.g.
+ * stream << hexi::half(velocity). Halves have 11 significant bits, giving
+ * a relative error of at most 2^-11 for values between 2^-14 and 65504.
+ * Larger values become infinity.
+ *
+ * Arrays of floats are converted in bulk, e.g. stream >> hexi::half(values),
+ * where the destination must already have the correct size.
+ */
+struct half final {
+	std::span<float> values;
+
+	half(float& value) : values(&value, 1) {}
+	half(float&& value) : values(&value, 1) {}
+	half(std::span<float> values) : values(values) {}
+};
+
+/**
+ * Serialises floating point values quantised to the given number of bits
+ * within [min, max], e.g. stream << hexi::quantised(x, -512.0f, 512.0f, 16).
+ * Each value is written as the smallest unsigned type that can hold the
+ * bits, with the stream's byte order. Values outside of the range are
+ * clamped. See quantise for the error bound. A number of bits outside of
+ * 1 to 32 or the precision of T results in
+ * stream_state::invalid_bit_width_err.
+ *
+ * Arrays of values are quantised in bulk, in the same way as half.
+ */
+template<std::floating_point T>
+struct quantised final {
+	std::span<T> values;
+	T min;
+	T max;
+	unsigned int bits;
+
+	quantised(T& value, const T min, const T max, const unsigned int bits)
+		: values(&value, 1), min(min), max(max), bits(bits) {}
+
+	quantised(T&& value, const T min, const T max, const unsigned int bits)
+		: values(&value, 1), min(min), max(max), bits(bits) {}
+
+	quantised(std::span<T> values, const T min, const T max, const unsigned int bits)
+		: values(values), min(min), max(max), bits(bits) {}
+};
+
+/**
+ * Serialises unit quaternions using the smallest three encoding, e.g.
+ * stream << hexi::smallest_three(rotation). With the default of 10 bits
+ * per component, each quaternion fits into a std::uint32_t. See
+ * encode_smallest_three for the error bound. A number of bits outside of
+ * 2 to 20 results in stream_state::invalid_bit_width_err.
+ */
+template<quaternion T>
+struct smallest_three final {
+	std::span<T> values;
+	unsigned int bits;
+
+	smallest_three(T& value, const unsigned int bits = 10)
+		: values(&value, 1), bits(bits) {}
+
+	smallest_three(T&& value, const unsigned int bits = 10)
+		: values(&value, 1), bits(bits) {}
+
+	smallest_three(std::span<T> values, const unsigned int bits = 10)
+		: values(values), bits(bits) {}
+};
+
+template<std::ranges::contiguous_range range>
+quantised(range&, std::ranges::range_value_t<range>, std::ranges::range_value_t<range>, unsigned int)
+	-> quantised<std::ranges::range_value_t<range>>;
+
+template<std::ranges::contiguous_range range>
+requires quaternion<std::ranges::range_value_t<range>>
+smallest_three(range&, unsigned int = 10) -> smallest_three<std::ranges::range_value_t<range>>;
+
+} // hexi
@@ -0,0 +1,345 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/shared.h>
+#include <hexi/concepts.h>
+#include <hexi/endian.h>
+#include <hexi/fixed_string.h>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+constexpr static std::size_t unbounded_size = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Inclusive lower and upper bounds on the number of bytes an object will
+ * occupy once serialised. A max of unbounded_size indicates that no upper
+ * bound could be determined (e.g. std::string or std::vector fields).
+ */
+struct size_bounds {
+	std::size_t min = 0;
+	std::size_t max = 0;
+
+	constexpr bool fixed() const {
+		return min == max;
+	}
+
+	constexpr bool bounded() const {
+		return max != unbounded_size;
+	}
+
+	constexpr size_bounds operator+(const size_bounds& rhs) const {
+		return {
+			saturating_add(min, rhs.min),
+			saturating_add(max, rhs.max)
+		};
+	}
+
+	constexpr size_bounds operator*(const std::size_t count) const {
+		return { saturating_mul(min, count), saturating_mul(max, count) };
+	}
+
+	constexpr bool operator==(const size_bounds&) const = default;
+
+private:
+	constexpr static std::size_t saturating_add(std::size_t lhs, std::size_t rhs) {
+		return (lhs > unbounded_size - rhs)? unbounded_size : lhs + rhs;
+	}
+
+	constexpr static std::size_t saturating_mul(std::size_t lhs, std::size_t rhs) {
+		if(lhs == 0 || rhs == 0) {
+			return 0;
+		}
+
+		return (lhs > unbounded_size / rhs)? unbounded_size : lhs * rhs;
+	}
+};
+
+/**
+ * Compile-time serialised size bounds for T. Defined for any type that
+ * provides a constexpr serialise function (see below) and can be specialised
+ * for types that use custom operator<< overloads, e.g:
+ *
+ * template<>
+ * struct hexi::serialised_size_bounds<my_type> {
+ *     static constexpr hexi::size_bounds value { 4, 36 };
+ * };
+ *
+ * The bounds for types using serialise are found by running serialise at
+ * compile-time, filling each arithmetic field with zero, one and all bits
+ * set as it's visited, as a read would. Bounds are only provided if every
+ * pass agrees, so types whose fields depend on the values of others (e.g.
+ * a field only written when a flag is set) get no bounds, and no up-front
+ * size checks, unless they provide a specialisation.
+ */
+template<typename T>
+struct serialised_size_bounds {};
+
+template<typename T>
+concept has_size_bounds = requires {
+	{ serialised_size_bounds<std::remove_cvref_t<T>>::value } -> std::convertible_to<size_bounds>;
+};
+
+template<typename T>
+requires has_size_bounds<T>
+constexpr static size_bounds serialised_size_bounds_v
+	= serialised_size_bounds<std::remove_cvref_t<T>>::value;
+
+template<typename T>
+concept fixed_serialised_size = has_size_bounds<T> && serialised_size_bounds_v<T>.fixed();
+
+template<typename T>
+concept bounded_serialised_size = has_size_bounds<T> && serialised_size_bounds_v<T>.bounded();
+
+template<fixed_serialised_size T>
+constexpr static std::size_t serialised_size_v = serialised_size_bounds_v<T>.max;
+
+namespace detail {
+
+template<typename T, template<typename> class adaptor>
+constexpr bool is_adaptor_v = false;
+
+template<typename T, template<typename> class adaptor>
+constexpr bool is_adaptor_v<adaptor<T>, adaptor> = true;
+
+template<typename T>
+constexpr bool is_std_array_v = false;
+
+template<typename T, std::size_t N>
+constexpr bool is_std_array_v<std::array<T, N>> = true;
+
+template<typename T>
+constexpr bool is_tagged_variant_v = false;
+
+template<typename tag_type, typename variant_type>
+constexpr bool is_tagged_variant_v<tagged_variant<tag_type, variant_type>> = true;
+
+template<typename T>
+constexpr size_bounds bounds_of();
+
+// Bounds on a variant's tag plus the smallest and largest alternatives
+template<typename tag_type, typename variant_type>
+constexpr size_bounds variant_bounds() {
+	constexpr auto count = std::variant_size_v<variant_type>;
+
+	const auto alternatives = []<std::size_t... indices>(std::index_sequence<indices...>) {
+		return std::array<size_bounds, count> {
+			bounds_of<std::remove_cv_t<std::variant_alternative_t<indices, variant_type>>>()...
+		};
+	}(std::make_index_sequence<count>{});
+
+	size_bounds bounds { unbounded_size, 0 };
+
+	for(const auto& alternative : alternatives) {
+		bounds.min = std::min(bounds.min, alternative.min);
+		bounds.max = std::max(bounds.max, alternative.max);
+	}
+
+	return size_bounds { sizeof(tag_type), sizeof(tag_type) } + bounds;
+}
+
+// Bounds on the bytes written for a container's elements, excluding any prefix
+template<typename T>
+constexpr size_bounds element_bounds() {
+	if constexpr(is_std_array_v<T>) {
+		return bounds_of<typename T::value_type>() * std::tuple_size_v<T>;
+	} else if constexpr(fixed_capacity<T>) {
+		const auto element = bounds_of<typename T::value_type>();
+		return size_bounds { 0, element.max } * T::capacity();
+	} else {
+		return { 0, unbounded_size };
+	}
+}
+
+enum class probe_fill {
+	zero, one, all_set
+};
+
+/*
+ * Stand-in for stream_write_adaptor that tallies the size of each field
+ * rather than writing it. Anything it doesn't understand is treated as
+ * having no upper bound. Arithmetic fields are overwritten with the fill
+ * value as they're visited, as they would be by a read, so that any
+ * fields that depend on them are found.
+ */
+class size_probe final {
+	size_bounds bounds_{};
+	probe_fill fill_;
+
+	template<typename T>
+	constexpr void fill(T& field) {
+		using type = std::remove_cvref_t<T>;
+
+		if constexpr(std::is_const_v<std::remove_reference_t<T>>) {
+			return;
+		} else if constexpr(std::is_same_v<type, bool>) {
+			field = fill_ != probe_fill::zero;
+		} else if constexpr(std::integral<type>) {
+			switch(fill_) {
+				case probe_fill::zero:
+					field = 0;
+					break;
+				case probe_fill::one:
+					field = 1;
+					break;
+				case probe_fill::all_set:
+					field = static_cast<type>(~std::make_unsigned_t<type>(0));
+					break;
+			}
+		} else if constexpr(arithmetic<type>) {
+			field = fill_ == probe_fill::zero? type(0) : type(1);
+		} else if constexpr(std::is_enum_v<type>) {
+			std::underlying_type_t<type> value{};
+			fill(value);
+			field = static_cast<type>(value);
+		} else if constexpr(std::derived_from<type, endian::adaptor_tag_t>) {
+			fill(field.value);
+		}
+	}
+
+	template<typename T>
+	constexpr void add(T&& arg) {
+		fill(arg);
+		bounds_ = bounds_ + bounds_of<std::remove_cvref_t<T>>();
+	}
+
+public:
+	constexpr explicit size_probe(const probe_fill fill)
+		: fill_(fill) {}
+
+	constexpr void operator&(auto&& arg) {
+		add(arg);
+	}
+
+	template<typename ...Ts>
+	constexpr void operator()(Ts&&... args) {
+		(add(args), ...);
+	}
+
+	template<typename T>
+	constexpr void forward(T&& arg) {
+		using type = std::remove_cvref_t<T>;
+
+		if constexpr(arithmetic<type> || std::derived_from<type, endian::adaptor_tag_t>) {
+			add(arg);
+		} else {
+			bounds_ = bounds_ + element_bounds<type>();
+		}
+	}
+
+	template<typename ...Ts>
+	constexpr void forward(Ts&&...) {
+		bounds_ = bounds_ + size_bounds{ 0, unbounded_size };
+	}
+
+	constexpr size_bounds bounds() const {
+		return bounds_;
+	}
+};
+
+template<typename T>
+constexpr size_bounds probe_bounds(const probe_fill fill = probe_fill::zero) {
+	T object{};
+	size_probe probe(fill);
+	object.serialise(probe);
+	return probe.bounds();
+}
+
+// True if the bounds don't depend on the values read into the fields
+template<typename T>
+constexpr bool probe_consistent() {
+	const auto bounds = probe_bounds<T>();
+	return bounds == probe_bounds<T>(probe_fill::one)
+		&& bounds == probe_bounds<T>(probe_fill::all_set);
+}
+
+template<typename T>
+concept size_probeable =
+	std::is_class_v<T>
+	&& requires(T t, size_probe& probe) {
+		{ t.serialise(probe) } -> std::same_as<void>;
+	}
+	&& requires {
+		typename std::bool_constant<probe_consistent<T>()>;
+	}
+	&& probe_consistent<T>();
+
+template<typename T>
+constexpr size_bounds bounds_of() {
+	constexpr size_bounds unknown { 0, unbounded_size };
+	constexpr size_bounds prefix { sizeof(std::uint32_t), sizeof(std::uint32_t) };
+	constexpr size_bounds varint_prefix { 1, (sizeof(std::size_t) * 8 + 6) / 7 };
+
+	if constexpr(arithmetic<T>) {
+		return { sizeof(T), sizeof(T) };
+	} else if constexpr(std::derived_from<T, endian::adaptor_tag_t>) {
+		using value_type = std::remove_cvref_t<decltype(std::declval<T&>().value)>;
+		return { sizeof(value_type), sizeof(value_type) };
+	} else if constexpr(std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+		return prefix + unknown;
+	} else if constexpr(is_fixed_string_v<T>) {
+		return prefix + element_bounds<T>();
+	} else if constexpr(std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+		return { 1, unbounded_size };
+	} else if constexpr(is_adaptor_v<T, prefixed>) {
+		return prefix + element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, prefixed_varint>) {
+		return varint_prefix + element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, raw>) {
+		return element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, null_terminated>) {
+		using string_type = std::remove_cvref_t<decltype(T::str)>;
+
+		if constexpr(is_fixed_string_v<string_type>) {
+			return { 1, string_type::capacity() + 1 };
+		} else {
+			return { 1, unbounded_size };
+		}
+	} else if constexpr(is_std_array_v<T>) {
+		return element_bounds<T>();
+	} else if constexpr(is_tagged_variant_v<T>) {
+		using variant_type = std::remove_cvref_t<decltype(T::value)>;
+		return variant_bounds<typename T::tag_type, variant_type>();
+	} else if constexpr(has_size_bounds<T>) {
+		return serialised_size_bounds<T>::value;
+	} else if constexpr(pod<T> && !is_iterable<T> && !requires(T t, size_probe& probe) { t.serialise(probe); }) {
+		// trivial types with a serialise function don't necessarily write every member
+		return { sizeof(T), sizeof(T) };
+	} else {
+		return unknown;
+	}
+}
+
+} // detail
+
+template<arithmetic T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value { sizeof(T), sizeof(T) };
+};
+
+template<variant_like T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value = detail::variant_bounds<std::uint8_t, T>();
+};
+
+template<detail::size_probeable T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value = detail::probe_bounds<T>();
+};
+
+} // hexi
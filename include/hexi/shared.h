@@ -10,7 +10,9 @@
 #include <array>
 #include <bit>
 #include <concepts>
+#include <string_view>
 #include <type_traits>
+#include <variant>
 #include <cstddef>
 #include <cstdint>
 
@@ -47,7 +49,7 @@ constexpr static init_empty_t init_empty {};
 template<typename string_type>                            \
 struct adaptor_name {                                     \
     string_type& str;                                     \
-    string_type* operator->() { return &str; }            \
+    constexpr string_type* operator->() { return &str; }  \
 };                                                        \
 /* deduction guide required for clang 17 support */       \
 template<typename string_type>                            \
@@ -58,6 +60,57 @@ STRING_ADAPTOR(prefixed)
 STRING_ADAPTOR(prefixed_varint)
 STRING_ADAPTOR(null_terminated)
 
+/**
+ * Serialises a std::variant as an integral tag holding the index of the
+ * active alternative, followed by the alternative itself.
+ */
+template<std::integral T, typename variant_type>
+struct tagged_variant {
+	using tag_type = T;
+
+	variant_type& value;
+	constexpr variant_type* operator->() { return &value; }
+};
+
+template<std::integral tag_type = std::uint8_t, typename variant_type>
+constexpr auto tagged(variant_type& value) {
+	return tagged_variant<tag_type, variant_type> { value };
+}
+
+/**
+ * Deserialises a string and replaces it with the equivalent string from an
+ * intern pool, such that repeated strings share storage. The string is
+ * read with the given encoding (prefixed by default).
+ */
+template<template<typename> class encoding, typename pool_type>
+struct interned_string {
+	std::string_view& str;
+	pool_type& pool;
+};
+
+template<template<typename> class encoding = prefixed, typename pool_type>
+constexpr auto interned(std::string_view& str, pool_type& pool) {
+	return interned_string<encoding, pool_type> { str, pool };
+}
+
+/**
+ * Serialises a string through a message-scoped string table. The first
+ * occurrence of a string is written inline and later occurrences as a
+ * reference to it, each preceded by a varint tag: the length shifted left
+ * by one for an inline string, or the index of the earlier occurrence
+ * shifted left by one with the low bit set for a reference.
+ */
+template<typename string_type, typename table_type>
+struct deduplicated_string {
+	string_type& str;
+	table_type& table;
+};
+
+template<typename string_type, typename table_type>
+constexpr auto deduplicated(string_type& str, table_type& table) {
+	return deduplicated_string<string_type, table_type> { str, table };
+}
+
 enum class buffer_seek {
 	sk_absolute, sk_backward, sk_forward
 };
@@ -77,6 +130,11 @@ enum class stream_state {
 	buff_limit_err,
 	buff_write_err,
 	invalid_stream,
+	invalid_tag_err,
+	capacity_err,
+	alloc_limit_err,
+	invalid_utf8_err,
+	invalid_bit_width_err,
 	user_defined_err
 };
 
@@ -114,6 +172,16 @@ constexpr auto varint_encode(stream_type& stream, size_type value) -> size_type
 	return ++written;
 }
 
+template<typename stream_type, typename table_type>
+constexpr void deduplicated_encode(stream_type& stream, const std::string_view str, table_type& table) {
+	if(const auto index = table.find_or_insert(str)) {
+		varint_encode(stream, (*index << 1) | 1);
+	} else {
+		varint_encode(stream, str.size() << 1);
+		stream.put(str.data(), str.size());
+	}
+}
+
 template<decltype(auto) size>
 static constexpr auto generate_filled(const std::uint8_t value) {
 	std::array<std::uint8_t, size> target{};
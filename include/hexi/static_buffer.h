@@ -10,6 +10,7 @@
 #include <hexi/shared.h>
 #include <hexi/concepts.h>
 #include <array>
+#include <bit>
 #include <span>
 #include <utility>
 #include <cassert>
@@ -35,17 +36,17 @@ public:
 
 	static constexpr auto npos { static_cast<size_type>(-1) };
 	
-	static_buffer() = default;
+	constexpr static_buffer() = default;
 
 	template<typename... T> 
-	static_buffer(T&&... vals) : buffer_{ std::forward<T>(vals)... } {
+	constexpr static_buffer(T&&... vals) : buffer_{ std::forward<T>(vals)... } {
 		write_ = sizeof... (vals);
 	}
 
-	static_buffer(static_buffer&& rhs) = default;
-	static_buffer& operator=(static_buffer&&) = default;
-	static_buffer& operator=(const static_buffer&) = default;
-	static_buffer(const static_buffer&) = default;
+	constexpr static_buffer(static_buffer&& rhs) = default;
+	constexpr static_buffer& operator=(static_buffer&&) = default;
+	constexpr static_buffer& operator=(const static_buffer&) = default;
+	constexpr static_buffer(const static_buffer&) = default;
 
 	/**
 	 * @brief Reads a number of bytes to the provided buffer.
@@ -109,7 +110,7 @@ public:
 	 * 
 	 * @return The position of value or npos if not found.
 	 */
-	size_type find_first_of(value_type val) const noexcept {
+	constexpr size_type find_first_of(value_type val) const noexcept {
 		const auto data = read_ptr();
 
 		for(size_type i = 0, j = size(); i < j; ++i) {
@@ -130,7 +131,7 @@ public:
 	 * 
 	 * @param length The number of bytes to skip.
 	 */
-	void skip(const size_type length) {
+	constexpr void skip(const size_type length) {
 		read_ += length;
 
 		if(read_ == write_) {
@@ -143,7 +144,7 @@ public:
 	 * 
 	 * @param size The number of bytes by which to advance the write cursor.
 	 */
-	void advance_write(size_type bytes) {
+	constexpr void advance_write(size_type bytes) {
 		assert(free() >= bytes);
 		write_ += bytes;
 	}
@@ -154,7 +155,7 @@ public:
 	 * @param size The new size of the buffer.
 	 * 
 	 */
-	void resize(size_type size) {
+	constexpr void resize(size_type size) {
 		if(size > buffer_.size()) {
 			HEXI_THROW(exception("attempted to resize static_buffer to larger than capacity"));
 		}
@@ -165,7 +166,7 @@ public:
 	/**
 	 * @brief Clears the container.
 	 */
-	void clear() {
+	constexpr void clear() {
 		read_ = write_ = 0;
 	}
 
@@ -195,7 +196,7 @@ public:
 	 * 
 	 * @return A reference to the value at the specified index.
 	 */
-	value_type& operator[](const size_type index) {
+	constexpr value_type& operator[](const size_type index) {
 		return read_ptr()[index];
 	}
 
@@ -206,7 +207,7 @@ public:
 	 * 
 	 * @return A reference to the value at the specified index.
 	 */
-	const value_type& operator[](const size_type index) const {
+	constexpr const value_type& operator[](const size_type index) const {
 		return read_ptr()[index];
 	}
 
@@ -216,14 +217,14 @@ public:
 	 * @return Returns true if the container is empty (has no data to be read).
 	 */
 	[[nodiscard]]
-	bool empty() const {
+	constexpr bool empty() const {
 		return write_ == read_;
 	}
 
 	/**
 	 * @return Whether the container is full and cannot be further written to.
 	 */
-	bool full() const {
+	constexpr bool full() const {
 		return write_ == capacity();
 	}
 
@@ -244,8 +245,41 @@ public:
 	 * 
 	 * @param source Pointer to the data to be written.
 	 */
-	void write(const auto& source) {
-		write(&source, sizeof(source));
+	constexpr void write(const auto& source) {
+		if consteval {
+			const auto bytes = std::bit_cast<std::array<value_type, sizeof(source)>>(source);
+			write(bytes.data(), bytes.size());
+		} else {
+			write(&source, sizeof(source));
+		}
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * Equivalent to write(const void*, size_type) but also usable in a
+	 * constant expression.
+	 * 
+	 * @note The source buffer address must not belong to the static_buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 */
+	template<byte_type T>
+	constexpr void write(const T* source, size_type length) {
+		if consteval {
+			if(free() < length) {
+				HEXI_THROW(buffer_overflow(length, write_, free()));
+			}
+
+			for(size_type i = 0; i < length; ++i) {
+				buffer_[write_ + i] = static_cast<value_type>(source[i]);
+			}
+
+			write_ += length;
+		} else {
+			write(static_cast<const void*>(source), length);
+		}
 	}
 
 	/**
@@ -274,7 +308,7 @@ public:
 	 * @param offset The offset relative to the seek direction or the absolute value
 	 * when using absolute seeking.
 	 */
-	void write_seek(const buffer_seek direction, const size_type offset) {
+	constexpr void write_seek(const buffer_seek direction, const size_type offset) {
 		switch(direction) {
 			case buffer_seek::sk_backward:
 				write_ -= offset;
@@ -290,28 +324,28 @@ public:
 	/**
 	 * @return An iterator to the beginning of data available for reading.
 	 */
-	auto begin() {
+	constexpr auto begin() {
 		return buffer_.begin() + read_;
 	}
 
 	/**
 	 * @return An iterator to the beginning of data available for reading.
 	 */
-	auto begin() const {
+	constexpr auto begin() const {
 		return buffer_.begin() + read_;
 	}
 
 	/**
 	 * @return An iterator to the end of data available for reading.
 	 */
-	auto end() {
+	constexpr auto end() {
 		return buffer_.begin() + write_;
 	}
 
 	/**
 	 * @return An iterator to the end of data available for reading.
 	 */
-	auto end() const {
+	constexpr auto end() const {
 		return buffer_.begin() + write_;
 	}
 
@@ -329,7 +363,7 @@ public:
 	 * 
 	 * @return The number of bytes of data available to read within the container.
 	 */
-	size_type size() const {
+	constexpr size_type size() const {
 		return write_ - read_;
 	}
 
@@ -338,35 +372,35 @@ public:
 	 * 
 	 * @return The number of bytes of free space within the container.
 	 */
-	size_type free() const {
+	constexpr size_type free() const {
 		return buf_size - write_;
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	const value_type* data() const {
+	constexpr const value_type* data() const {
 		return read_ptr();
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	value_type* data() {
+	constexpr value_type* data() {
 		return read_ptr();
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	const value_type* read_ptr() const {
+	constexpr const value_type* read_ptr() const {
 		return buffer_.data() + read_;
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	value_type* read_ptr() {
+	constexpr value_type* read_ptr() {
 		return buffer_.data() + read_;
 	}
 
@@ -374,7 +408,7 @@ public:
 	 * @return Pointer to the location within the buffer where the next write
 	 * will be made.
 	 */
-	const value_type* write_ptr() const {
+	constexpr const value_type* write_ptr() const {
 		return buffer_.data() + write_;
 	}
 
@@ -382,21 +416,21 @@ public:
 	 * @return Pointer to the location within the buffer where the next write
 	 * will be made.
 	 */
-	value_type* write_ptr() {
+	constexpr value_type* write_ptr() {
 		return buffer_.data() + write_;
 	}
 
 	/**
 	 * @return Pointer to the underlying storage.
 	 */
-	value_type* storage() {
+	constexpr value_type* storage() {
 		return buffer_.data();
 	}
 
 	/**
 	 * @return Pointer to the underlying storage.
 	 */
-	const value_type* storage() const {
+	constexpr const value_type* storage() const {
 		return buffer_.data();
 	}
 
@@ -406,7 +440,7 @@ public:
 	 * 
 	 * @return A span over the data waiting to be read from the container.
 	 */
-	std::span<const value_type> read_span() const {
+	constexpr std::span<const value_type> read_span() const {
 		return { read_ptr(), size() };
 	}
 
@@ -415,7 +449,7 @@ public:
 	 * 
 	 * @return A span over the container's free space.
 	 */
-	std::span<value_type> write_span() {
+	constexpr std::span<value_type> write_span() {
 		return { write_ptr(), free() };
 	}
 };
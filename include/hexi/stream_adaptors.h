@@ -15,20 +15,20 @@ class stream_read_adaptor final {
 	stream_type& _stream;
 
 public:
-	stream_read_adaptor(stream_type& stream) 
+	constexpr stream_read_adaptor(stream_type& stream) 
 		: _stream(stream) {}
 
-	void operator&(auto&& arg) {
+	constexpr void operator&(auto&& arg) {
 		_stream >> arg;
 	}
 
 	template<typename ...Ts>
-	void operator()(Ts&&... args) {
+	constexpr void operator()(Ts&&... args) {
 		(_stream >> ... >> args);
 	}
 
 	template<typename ...Ts>
-	void forward(Ts&&... args) {
+	constexpr void forward(Ts&&... args) {
 		_stream.get(std::forward<Ts>(args)...);
 	}
 };
@@ -38,20 +38,20 @@ class stream_write_adaptor final {
 	stream_type& _stream;
 
 public:
-	stream_write_adaptor(stream_type& stream) 
+	constexpr stream_write_adaptor(stream_type& stream) 
 		: _stream(stream) {}
 
-	void operator&(auto&& arg) {
+	constexpr void operator&(auto&& arg) {
 		_stream << arg;
 	}
 
 	template<typename ...Ts>
-	void operator()(Ts&&... args) {
+	constexpr void operator()(Ts&&... args) {
 		(_stream << ... << args);
 	}
 
 	template<typename ...Ts>
-	void forward(Ts&&... args) {
+	constexpr void forward(Ts&&... args) {
 		_stream.put(std::forward<Ts>(args)...);
 	}
 };
@@ -0,0 +1,97 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * A single-pass input range that deserialises elements from a stream as the
+ * range is iterated, rather than materialising them into a container.
+ *
+ * Each element is read into the same storage, so a reference obtained
+ * through the iterator is only valid until the iterator is incremented.
+ * Iteration stops early if the stream enters an error state.
+ *
+ * @tparam stream_type The stream to read from.
+ * @tparam T The element type.
+ */
+template<typename stream_type, std::default_initializable T>
+class stream_range final : public std::ranges::view_interface<stream_range<stream_type, T>> {
+	stream_type* stream_ = nullptr;
+	std::size_t remaining_ = 0;
+	bool done_ = false;
+	T value_{};
+
+	void next() {
+		if(remaining_ == 0 || !*stream_) {
+			done_ = true;
+			return;
+		}
+
+		*stream_ >> value_;
+		--remaining_;
+
+		if(!*stream_) {
+			done_ = true;
+		}
+	}
+
+public:
+	class iterator {
+		stream_range* range_ = nullptr;
+
+	public:
+		using value_type      = T;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(stream_range* range) : range_(range) {}
+
+		T& operator*() const {
+			return range_->value_;
+		}
+
+		iterator& operator++() {
+			range_->next();
+			return *this;
+		}
+
+		void operator++(int) {
+			++*this;
+		}
+
+		bool operator==(std::default_sentinel_t) const {
+			return range_->done_;
+		}
+	};
+
+	stream_range() = default;
+
+	stream_range(stream_type& stream, const std::size_t count)
+		: stream_(&stream), remaining_(count) {}
+
+	/**
+	 * @brief Reads the first element and returns an iterator to it.
+	 *
+	 * @note As this is an input range, begin() must only be called once.
+	 */
+	iterator begin() {
+		next();
+		return iterator(this);
+	}
+
+	std::default_sentinel_t end() const {
+		return {};
+	}
+};
+
+} // hexi
@@ -0,0 +1,188 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/shared.h>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Read-only view over the next length bytes of another buffer, used as the
+ * buffer for streams created with binary_stream::slice. Reads go straight
+ * to the underlying buffer, so no data is copied, and views and spans can
+ * be taken from the slice if the underlying buffer is contiguous.
+ *
+ * Slices of slices refer to the same underlying buffer and report how much
+ * they consume to their parent, so nested limits compose.
+ *
+ * @tparam buf_type The underlying buffer type.
+ */
+template<typename buf_type>
+class slice_buffer final {
+	buf_type& buffer_;
+	slice_buffer* parent_;
+	typename buf_type::size_type remaining_;
+
+	void consume(const typename buf_type::size_type length) {
+		remaining_ -= length;
+
+		if(parent_) {
+			parent_->consume(length);
+		}
+	}
+
+public:
+	using base_type   = buf_type;
+	using size_type   = typename buf_type::size_type;
+	using offset_type = typename buf_type::offset_type;
+	using value_type  = typename buf_type::value_type;
+	using contiguous  = typename buf_type::contiguous;
+	using seeking     = unsupported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+	/**
+	 * @param buffer The underlying buffer.
+	 * @param length The number of bytes the slice covers. This must not
+	 * exceed the amount of data in the underlying buffer.
+	 * @param parent The slice this slice was taken from, if any.
+	 */
+	slice_buffer(buf_type& buffer, const size_type length, slice_buffer* parent = nullptr)
+		: buffer_(buffer),
+		  parent_(parent),
+		  remaining_(length) {}
+
+	slice_buffer(const slice_buffer&) = delete;
+	slice_buffer& operator=(const slice_buffer&) = delete;
+
+	void read(void* destination, const size_type length) {
+		buffer_.read(destination, length);
+		consume(length);
+	}
+
+	void skip(const size_type length) {
+		buffer_.skip(length);
+		consume(length);
+	}
+
+	/**
+	 * @brief Skips any data in the slice that hasn't been read.
+	 */
+	void finish() {
+		if(remaining_) {
+			skip(remaining_);
+		}
+	}
+
+	size_type find_first_of(const value_type value) const {
+		const auto pos = buffer_.find_first_of(value);
+		return pos < remaining_? pos : npos;
+	}
+
+	auto read_ptr() requires requires(buf_type& buffer) { buffer.read_ptr(); } {
+		return buffer_.read_ptr();
+	}
+
+	auto read_ptr() const requires requires(const buf_type& buffer) { buffer.read_ptr(); } {
+		return buffer_.read_ptr();
+	}
+
+	size_type size() const {
+		return std::min<size_type>(remaining_, buffer_.size());
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size() == 0;
+	}
+
+	buf_type& base() {
+		return buffer_;
+	}
+};
+
+namespace detail {
+
+template<typename buf_type>
+struct slice_base {
+	using type = buf_type;
+};
+
+template<typename buf_type>
+struct slice_base<slice_buffer<buf_type>> {
+	using type = buf_type;
+};
+
+} // detail
+
+/**
+ * Owns a child stream created by binary_stream::slice. When the slice is
+ * destroyed, any of its data that wasn't read is skipped, so the parent
+ * always advances by exactly the slice's length, regardless of how much
+ * the child read or whether it encountered an error.
+ *
+ * The parent stream must not be read from while the slice is alive.
+ *
+ * @tparam stream_type The child stream type.
+ */
+template<typename stream_type>
+class stream_slice final {
+	using buffer_type = typename stream_type::buffer_type;
+	using size_type   = typename stream_type::size_type;
+
+	buffer_type buffer_;
+	stream_type stream_;
+
+public:
+	stream_slice(typename buffer_type::base_type& buffer, const size_type length,
+	             buffer_type* parent = nullptr, const stream_state state = stream_state::ok)
+		: buffer_(buffer, length, parent),
+		  stream_(buffer_) {
+		stream_.state_ = state;
+	}
+
+	stream_slice(const stream_slice&) = delete;
+	stream_slice& operator=(const stream_slice&) = delete;
+
+	~stream_slice() {
+		buffer_.finish();
+	}
+
+	template<typename T>
+	stream_slice& operator>>(T&& data) {
+		stream_ >> std::forward<T>(data);
+		return *this;
+	}
+
+	stream_type& stream() {
+		return stream_;
+	}
+
+	stream_type& operator*() {
+		return stream_;
+	}
+
+	stream_type* operator->() {
+		return &stream_;
+	}
+
+	/**
+	 * @return The number of bytes in the slice that haven't been read.
+	 */
+	size_type remaining() const {
+		return buffer_.size();
+	}
+
+	operator bool() const {
+		return stream_.good();
+	}
+};
+
+} // hexi
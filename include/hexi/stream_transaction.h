@@ -0,0 +1,269 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/shared.h>
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <cstddef>
+#include <cstring>
+
+namespace hexi {
+
+/**
+ * Buffers that can be read from an offset without consuming any data,
+ * either directly (contiguous buffers) or via copy and find_first_of
+ * overloads that take an offset (e.g. dynamic_buffer).
+ */
+template<typename buf_type>
+concept transactional =
+	(std::is_same_v<typename buf_type::contiguous, is_contiguous>
+		&& requires(buf_type& buffer) { buffer.read_ptr(); })
+	|| requires(const buf_type& buffer, void* dest, typename buf_type::size_type size,
+	            typename buf_type::value_type value) {
+		buffer.copy(dest, size, size);
+		{ buffer.find_first_of(value, size) } -> std::convertible_to<typename buf_type::size_type>;
+	};
+
+/**
+ * Non-contiguous buffers that can resume copies and searches from a saved
+ * position, rather than locating an offset from the read cursor each time.
+ */
+template<typename buf_type>
+concept positionable = requires(const buf_type& buffer, void* dest,
+                                typename buf_type::read_position& position,
+                                typename buf_type::size_type size,
+                                typename buf_type::value_type value) {
+	buffer.copy(dest, size, position);
+	buffer.advance(position, size);
+	{ buffer.find_first_of(value, position) } -> std::convertible_to<typename buf_type::size_type>;
+};
+
+namespace detail {
+
+template<typename buf_type>
+struct position_type {
+	using type = std::monostate;
+};
+
+template<positionable buf_type>
+struct position_type<buf_type> {
+	using type = typename buf_type::read_position;
+};
+
+} // detail
+
+/**
+ * Non-destructive cursor over another buffer, used as the buffer for
+ * streams created with binary_stream::begin_transaction. Reads advance the
+ * cursor but leave the underlying buffer untouched until the transaction
+ * is committed.
+ *
+ * @tparam buf_type The underlying buffer type.
+ */
+template<transactional buf_type>
+class transaction_buffer final {
+	static constexpr bool is_contiguous_buffer
+		= std::is_same_v<typename buf_type::contiguous, is_contiguous>;
+
+	buf_type& buffer_;
+	typename buf_type::size_type offset_ = 0;
+	[[no_unique_address]] typename detail::position_type<buf_type>::type position_{};
+
+public:
+	using base_type   = buf_type;
+	using size_type   = typename buf_type::size_type;
+	using offset_type = typename buf_type::offset_type;
+	using value_type  = typename buf_type::value_type;
+	using contiguous  = typename buf_type::contiguous;
+	using seeking     = unsupported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+	/**
+	 * @param buffer The underlying buffer.
+	 */
+	explicit transaction_buffer(buf_type& buffer)
+		: buffer_(buffer) {}
+
+	transaction_buffer(const transaction_buffer&) = delete;
+	transaction_buffer& operator=(const transaction_buffer&) = delete;
+
+	void read(void* destination, const size_type length) {
+		if constexpr(is_contiguous_buffer) {
+			std::memcpy(destination, read_ptr(), length);
+		} else if constexpr(positionable<buf_type>) {
+			buffer_.copy(destination, length, position_);
+		} else {
+			buffer_.copy(destination, length, offset_);
+		}
+
+		offset_ += length;
+	}
+
+	void skip(const size_type length) {
+		if constexpr(positionable<buf_type>) {
+			buffer_.advance(position_, length);
+		}
+
+		offset_ += length;
+	}
+
+	size_type find_first_of(const value_type value) const {
+		if constexpr(is_contiguous_buffer) {
+			const auto data = reinterpret_cast<const value_type*>(read_ptr());
+			const auto end = data + size();
+			const auto it = std::find(data, end, value);
+			return it == end? npos : static_cast<size_type>(it - data);
+		} else if constexpr(positionable<buf_type>) {
+			const auto pos = buffer_.find_first_of(value, position_);
+			return (pos == npos || pos >= size())? npos : pos;
+		} else {
+			const auto pos = buffer_.find_first_of(value, offset_);
+			return (pos == npos || pos - offset_ >= size())? npos : pos - offset_;
+		}
+	}
+
+	auto read_ptr() requires is_contiguous_buffer {
+		return buffer_.read_ptr() + offset_;
+	}
+
+	auto read_ptr() const requires is_contiguous_buffer {
+		return buffer_.read_ptr() + offset_;
+	}
+
+	size_type size() const {
+		return buffer_.size() - offset_;
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size() == 0;
+	}
+
+	/**
+	 * @return The number of bytes read through the cursor.
+	 */
+	size_type offset() const {
+		return offset_;
+	}
+
+	/**
+	 * @brief Moves the cursor back to the start of the underlying buffer.
+	 */
+	void rewind() {
+		offset_ = 0;
+		position_ = {};
+	}
+
+	/**
+	 * @brief Consumes everything read through the cursor from the
+	 * underlying buffer.
+	 */
+	void consume() {
+		buffer_.skip(offset_);
+		offset_ = 0;
+		position_ = {};
+	}
+};
+
+/**
+ * Owns a child stream created by binary_stream::begin_transaction. Reads
+ * through the child don't consume anything from the parent's buffer until
+ * commit is called, so a message that turns out to be incomplete can be
+ * abandoned, leaving the buffer as it was, and parsed again once more data
+ * has arrived. Destroying the transaction without committing it is a
+ * rollback.
+ *
+ * The parent stream must not be used while the transaction is alive.
+ *
+ * @tparam stream_type The child stream type.
+ * @tparam parent_type The parent stream type.
+ */
+template<typename stream_type, typename parent_type>
+class stream_transaction final {
+	using buffer_type = typename stream_type::buffer_type;
+	using size_type   = typename stream_type::size_type;
+
+	parent_type& parent_;
+	buffer_type buffer_;
+	stream_type stream_;
+	size_type committed_ = 0;
+
+public:
+	/**
+	 * The child stream takes on the parent's read limit and total bytes
+	 * read, so limits are enforced exactly as they would be by the parent.
+	 */
+	stream_transaction(parent_type& parent, typename buffer_type::base_type& buffer,
+	                   const size_type read_limit, const size_type total_read,
+	                   const stream_state state = stream_state::ok)
+		: parent_(parent),
+		  buffer_(buffer),
+		  stream_(buffer_, read_limit),
+		  committed_(total_read) {
+		stream_.total_read_ = total_read;
+		stream_.state_ = state;
+	}
+
+	stream_transaction(const stream_transaction&) = delete;
+	stream_transaction& operator=(const stream_transaction&) = delete;
+
+	template<typename T>
+	stream_transaction& operator>>(T&& data) {
+		stream_ >> std::forward<T>(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Consumes the data read so far from the parent stream. The
+	 * transaction can continue to be used afterwards.
+	 */
+	void commit() {
+		parent_.total_read_ += buffer_.offset();
+		committed_ = stream_.total_read_;
+		buffer_.consume();
+	}
+
+	/**
+	 * @brief Discards the reads made since the last commit, allowing the
+	 * data to be read again, and clears any error state.
+	 */
+	void rollback() {
+		stream_.total_read_ = committed_;
+		stream_.state_ = stream_state::ok;
+		buffer_.rewind();
+	}
+
+	stream_type& stream() {
+		return stream_;
+	}
+
+	stream_type& operator*() {
+		return stream_;
+	}
+
+	stream_type* operator->() {
+		return &stream_;
+	}
+
+	/**
+	 * @return The number of bytes read since the last commit.
+	 */
+	size_type pending() const {
+		return buffer_.offset();
+	}
+
+	operator bool() const {
+		return stream_.good();
+	}
+};
+
+} // hexi
@@ -0,0 +1,106 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Message-scoped table of the strings written or read with the deduplicated
+ * adaptor. Use one table per message and clear it, or use a new one,
+ * before the next.
+ *
+ * When writing, the table holds views of the strings that have been
+ * written, so they must outlive the table's use. When reading, the table
+ * holds views into the buffer for contiguous buffers, which are therefore
+ * tied to the lifetime of the buffer's data. Strings read from other
+ * buffers are copied into the table.
+ */
+class string_table final {
+	std::unordered_map<std::string_view, std::size_t> indices_;
+	std::vector<std::string_view> entries_;
+	std::deque<std::string> storage_;
+
+public:
+	string_table() = default;
+	string_table(const string_table&) = delete;
+	string_table& operator=(const string_table&) = delete;
+
+	/**
+	 * @brief Looks up a string that's about to be written, adding it to the
+	 * table if it hasn't been written before.
+	 *
+	 * @param string The string to look up.
+	 *
+	 * @return The index of the earlier occurrence, if there is one.
+	 */
+	std::optional<std::size_t> find_or_insert(const std::string_view string) {
+		const auto [it, inserted] = indices_.try_emplace(string, entries_.size());
+
+		if(!inserted) {
+			return it->second;
+		}
+
+		entries_.emplace_back(string);
+		return std::nullopt;
+	}
+
+	/**
+	 * @brief Adds a string that has been read. The view must remain valid
+	 * for as long as the table is used.
+	 *
+	 * @param string The string to add.
+	 *
+	 * @return The string.
+	 */
+	std::string_view add(const std::string_view string) {
+		entries_.emplace_back(string);
+		return string;
+	}
+
+	/**
+	 * @brief Adds a string that has been read, taking ownership of it.
+	 *
+	 * @param string The string to add.
+	 *
+	 * @return A view of the string, valid until the table is cleared.
+	 */
+	std::string_view add(std::string&& string) {
+		return add(std::string_view(storage_.emplace_back(std::move(string))));
+	}
+
+	/**
+	 * @return The string with the given index.
+	 */
+	std::string_view operator[](const std::size_t index) const {
+		assert(index < entries_.size());
+		return entries_[index];
+	}
+
+	/**
+	 * @return The number of strings in the table.
+	 */
+	std::size_t size() const {
+		return entries_.size();
+	}
+
+	void clear() {
+		indices_.clear();
+		entries_.clear();
+		storage_.clear();
+	}
+};
+
+} // hexi
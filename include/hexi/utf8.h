@@ -0,0 +1,291 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#pragma once
+
+#include <hexi/detail/simd.h>
+#include <array>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+/**
+ * Validates that a string is well-formed UTF-8 once it has been
+ * deserialised, e.g. stream >> hexi::utf8(hexi::prefixed(str)). Wraps any
+ * string or string adaptor that reads into a std::string, std::string_view
+ * or fixed_string. Invalid strings result in stream_state::invalid_utf8_err.
+ *
+ * Overlong encodings, surrogates and code points above U+10FFFF are
+ * rejected.
+ */
+template<typename T>
+struct utf8_validated {
+	T value;
+};
+
+template<typename T>
+constexpr auto utf8(T&& value) {
+	return utf8_validated<T> { std::forward<T>(value) };
+}
+
+namespace detail {
+
+template<typename T>
+constexpr std::string_view utf8_view(const T& value) {
+	if constexpr(requires { value.str; }) {
+		return { value.str.data(), value.str.size() };
+	} else {
+		return { value.data(), value.size() };
+	}
+}
+
+/*
+ * Returns the length of the well-formed sequence starting at the offset,
+ * or zero if it's invalid or truncated.
+ */
+inline std::size_t utf8_sequence_length(const std::uint8_t* data, const std::size_t size,
+                                        const std::size_t offset) {
+	const auto lead = data[offset];
+
+	if(lead < 0x80) {
+		return 1;
+	}
+
+	std::size_t length = 0;
+	std::uint8_t min = 0x80, max = 0xbf;
+
+	if(lead >= 0xc2 && lead <= 0xdf) {
+		length = 2;
+	} else if(lead >= 0xe0 && lead <= 0xef) {
+		length = 3;
+		min = lead == 0xe0? 0xa0 : min; // overlong
+		max = lead == 0xed? 0x9f : max; // surrogates
+	} else if(lead >= 0xf0 && lead <= 0xf4) {
+		length = 4;
+		min = lead == 0xf0? 0x90 : min; // overlong
+		max = lead == 0xf4? 0x8f : max; // above U+10FFFF
+	} else {
+		return 0;
+	}
+
+	if(size - offset < length || data[offset + 1] < min || data[offset + 1] > max) {
+		return 0;
+	}
+
+	for(std::size_t i = 2; i < length; ++i) {
+		if((data[offset + i] & 0xc0) != 0x80) {
+			return 0;
+		}
+	}
+
+	return length;
+}
+
+/*
+ * Returns the offset of the first invalid sequence, or the size if there
+ * isn't one.
+ */
+inline std::size_t utf8_error_offset(const std::string_view string, std::size_t offset = 0) {
+	const auto data = reinterpret_cast<const std::uint8_t*>(string.data());
+
+	while(offset < string.size()) {
+		const auto length = utf8_sequence_length(data, string.size(), offset);
+
+		if(!length) {
+			return offset;
+		}
+
+		offset += length;
+	}
+
+	return string.size();
+}
+
+#ifdef HEXI_HAS_SSSE3
+/*
+ * Lookup table based validation, after Keiser and Lemire, "Validating
+ * UTF-8 In Less Than One Instruction Per Byte". Each byte is classified
+ * by its high nibble and the high and low nibbles of the byte before it,
+ * with the three lookups being ANDed together to find any errors in two
+ * byte sequences. Three and four byte sequences are checked by requiring
+ * continuation bytes where the bytes two and three places back are leads.
+ */
+class utf8_checker final {
+	static constexpr std::uint8_t too_short      = 1 << 0;
+	static constexpr std::uint8_t too_long       = 1 << 1;
+	static constexpr std::uint8_t overlong_3     = 1 << 2;
+	static constexpr std::uint8_t too_large      = 1 << 3;
+	static constexpr std::uint8_t surrogate      = 1 << 4;
+	static constexpr std::uint8_t overlong_2     = 1 << 5;
+	static constexpr std::uint8_t too_large_1000 = 1 << 6;
+	static constexpr std::uint8_t overlong_4     = 1 << 6;
+	static constexpr std::uint8_t two_conts      = 1 << 7;
+	static constexpr std::uint8_t carry          = too_short | too_long | two_conts;
+
+	__m128i error_ = _mm_setzero_si128();
+	__m128i prev_input_ = _mm_setzero_si128();
+	__m128i prev_incomplete_ = _mm_setzero_si128();
+
+	static __m128i table(const std::array<std::uint8_t, 16>& values) {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+	}
+
+	static __m128i high_nibbles(const __m128i input) {
+		return _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0f));
+	}
+
+	__m128i special_cases(const __m128i input, const __m128i prev1) const {
+		static const auto byte_1_high_table = table({
+			too_long, too_long, too_long, too_long,
+			too_long, too_long, too_long, too_long,
+			two_conts, two_conts, two_conts, two_conts,
+			too_short | overlong_2,
+			too_short,
+			too_short | overlong_3 | surrogate,
+			too_short | too_large | too_large_1000 | overlong_4
+		});
+
+		static const auto byte_1_low_table = table({
+			carry | overlong_3 | overlong_2 | overlong_4,
+			carry | overlong_2,
+			carry,
+			carry,
+			carry | too_large,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000 | surrogate,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000
+		});
+
+		static const auto byte_2_high_table = table({
+			too_short, too_short, too_short, too_short,
+			too_short, too_short, too_short, too_short,
+			too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+			too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			too_long | overlong_2 | two_conts | surrogate  | too_large,
+			too_long | overlong_2 | two_conts | surrogate  | too_large,
+			too_short, too_short, too_short, too_short
+		});
+
+		const auto byte_1_high = _mm_shuffle_epi8(byte_1_high_table, high_nibbles(prev1));
+		const auto byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, _mm_set1_epi8(0x0f)));
+		const auto byte_2_high = _mm_shuffle_epi8(byte_2_high_table, high_nibbles(input));
+		return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+	}
+
+	void check_block(const __m128i input) {
+		const auto prev1 = _mm_alignr_epi8(input, prev_input_, 15);
+		const auto prev2 = _mm_alignr_epi8(input, prev_input_, 14);
+		const auto prev3 = _mm_alignr_epi8(input, prev_input_, 13);
+
+		// only bytes following 111_____ or 1111____ leads end up with the top bit set
+		const auto is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+		const auto is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+		const auto must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte),
+		                                                _mm_set1_epi8(static_cast<char>(0x80)));
+
+		const auto errors = _mm_xor_si128(must_be_continuation, special_cases(input, prev1));
+		error_ = _mm_or_si128(error_, errors);
+
+		// leads in the last three bytes that need more bytes than remain
+		const auto max_values = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+		prev_incomplete_ = _mm_subs_epu8(input, max_values);
+	}
+
+public:
+	void next(const __m128i input) {
+		if(!_mm_movemask_epi8(input)) {
+			// all ASCII, so only a sequence left incomplete by the previous block can fail
+			error_ = _mm_or_si128(error_, prev_incomplete_);
+			prev_incomplete_ = _mm_setzero_si128();
+			prev_input_ = input;
+			return;
+		}
+
+		check_block(input);
+		prev_input_ = input;
+	}
+
+	bool valid() const {
+		const auto errors = _mm_or_si128(error_, prev_incomplete_);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) == 0xffff;
+	}
+};
+#endif
+
+} // detail
+
+/**
+ * @brief Checks whether a string is well-formed UTF-8. Uses SSSE3 lookup
+ * tables to check 16 bytes at a time where available, otherwise skips
+ * over runs of ASCII 16 bytes at a time with SSE2 and checks the rest
+ * one sequence at a time.
+ *
+ * @param string The string to validate.
+ *
+ * @return True if the string is valid.
+ */
+inline bool is_valid_utf8(const std::string_view string) {
+	const auto data = reinterpret_cast<const std::uint8_t*>(string.data());
+	const auto size = string.size();
+	std::size_t offset = 0;
+
+#if defined(HEXI_HAS_SSSE3)
+	detail::utf8_checker checker;
+
+	for(; offset + 16 <= size; offset += 16) {
+		checker.next(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset)));
+	}
+
+	if(offset < size) {
+		// padding with ASCII catches any sequence truncated by the end
+		std::array<std::uint8_t, 16> tail{};
+		std::memcpy(tail.data(), data + offset, size - offset);
+		checker.next(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail.data())));
+	}
+
+	return checker.valid();
+#else
+#ifdef HEXI_HAS_SSE2
+	while(offset + 16 <= size) {
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+
+		if(!_mm_movemask_epi8(block)) {
+			offset += 16;
+			continue;
+		}
+
+		// check the block's sequences, including any that cross into the next
+		for(const auto end = offset + 16; offset < end;) {
+			const auto length = detail::utf8_sequence_length(data, size, offset);
+
+			if(!length) {
+				return false;
+			}
+
+			offset += length;
+		}
+	}
+#endif
+
+	return detail::utf8_error_offset(string, offset) == size;
+#endif
+}
+
+} // hexi
@@ -28,7 +28,9 @@
 #include <array>
 #include <bit>
 #include <concepts>
+#include <string_view>
 #include <type_traits>
+#include <variant>
 #include <cstddef>
 #include <cstdint>
 
@@ -65,7 +67,7 @@ constexpr static init_empty_t init_empty {};
 template<typename string_type>                            \
 struct adaptor_name {                                     \
     string_type& str;                                     \
-    string_type* operator->() { return &str; }            \
+    constexpr string_type* operator->() { return &str; }  \
 };                                                        \
 /* deduction guide required for clang 17 support */       \
 template<typename string_type>                            \
@@ -76,6 +78,57 @@ STRING_ADAPTOR(prefixed)
 STRING_ADAPTOR(prefixed_varint)
 STRING_ADAPTOR(null_terminated)
 
+/**
+ * Serialises a std::variant as an integral tag holding the index of the
+ * active alternative, followed by the alternative itself.
+ */
+template<std::integral T, typename variant_type>
+struct tagged_variant {
+	using tag_type = T;
+
+	variant_type& value;
+	constexpr variant_type* operator->() { return &value; }
+};
+
+template<std::integral tag_type = std::uint8_t, typename variant_type>
+constexpr auto tagged(variant_type& value) {
+	return tagged_variant<tag_type, variant_type> { value };
+}
+
+/**
+ * Deserialises a string and replaces it with the equivalent string from an
+ * intern pool, such that repeated strings share storage. The string is
+ * read with the given encoding (prefixed by default).
+ */
+template<template<typename> class encoding, typename pool_type>
+struct interned_string {
+	std::string_view& str;
+	pool_type& pool;
+};
+
+template<template<typename> class encoding = prefixed, typename pool_type>
+constexpr auto interned(std::string_view& str, pool_type& pool) {
+	return interned_string<encoding, pool_type> { str, pool };
+}
+
+/**
+ * Serialises a string through a message-scoped string table. The first
+ * occurrence of a string is written inline and later occurrences as a
+ * reference to it, each preceded by a varint tag: the length shifted left
+ * by one for an inline string, or the index of the earlier occurrence
+ * shifted left by one with the low bit set for a reference.
+ */
+template<typename string_type, typename table_type>
+struct deduplicated_string {
+	string_type& str;
+	table_type& table;
+};
+
+template<typename string_type, typename table_type>
+constexpr auto deduplicated(string_type& str, table_type& table) {
+	return deduplicated_string<string_type, table_type> { str, table };
+}
+
 enum class buffer_seek {
 	sk_absolute, sk_backward, sk_forward
 };
@@ -95,6 +148,11 @@ enum class stream_state {
 	buff_limit_err,
 	buff_write_err,
 	invalid_stream,
+	invalid_tag_err,
+	capacity_err,
+	alloc_limit_err,
+	invalid_utf8_err,
+	invalid_bit_width_err,
 	user_defined_err
 };
 
@@ -132,6 +190,16 @@ constexpr auto varint_encode(stream_type& stream, size_type value) -> size_type
 	return ++written;
 }
 
+template<typename stream_type, typename table_type>
+constexpr void deduplicated_encode(stream_type& stream, const std::string_view str, table_type& table) {
+	if(const auto index = table.find_or_insert(str)) {
+		varint_encode(stream, (*index << 1) | 1);
+	} else {
+		varint_encode(stream, str.size() << 1);
+		stream.put(str.data(), str.size());
+	}
+}
+
 template<decltype(auto) size>
 static constexpr auto generate_filled(const std::uint8_t value) {
 	std::array<std::uint8_t, size> target{};
@@ -181,20 +249,20 @@ class stream_read_adaptor final {
 	stream_type& _stream;
 
 public:
-	stream_read_adaptor(stream_type& stream) 
+	constexpr stream_read_adaptor(stream_type& stream) 
 		: _stream(stream) {}
 
-	void operator&(auto&& arg) {
+	constexpr void operator&(auto&& arg) {
 		_stream >> arg;
 	}
 
 	template<typename ...Ts>
-	void operator()(Ts&&... args) {
+	constexpr void operator()(Ts&&... args) {
 		(_stream >> ... >> args);
 	}
 
 	template<typename ...Ts>
-	void forward(Ts&&... args) {
+	constexpr void forward(Ts&&... args) {
 		_stream.get(std::forward<Ts>(args)...);
 	}
 };
@@ -204,20 +272,20 @@ class stream_write_adaptor final {
 	stream_type& _stream;
 
 public:
-	stream_write_adaptor(stream_type& stream) 
+	constexpr stream_write_adaptor(stream_type& stream) 
 		: _stream(stream) {}
 
-	void operator&(auto&& arg) {
+	constexpr void operator&(auto&& arg) {
 		_stream << arg;
 	}
 
 	template<typename ...Ts>
-	void operator()(Ts&&... args) {
+	constexpr void operator()(Ts&&... args) {
 		(_stream << ... << args);
 	}
 
 	template<typename ...Ts>
-	void forward(Ts&&... args) {
+	constexpr void forward(Ts&&... args) {
 		_stream.put(std::forward<Ts>(args)...);
 	}
 };
@@ -227,6 +295,7 @@ public:
 #include <concepts>
 #include <ranges>
 #include <type_traits>
+#include <variant>
 
 namespace hexi {
 
@@ -252,6 +321,28 @@ concept arithmetic = std::integral<T> || std::floating_point<T>;
 template<typename T>
 concept byte_type = sizeof(T) == 1;
 
+template<typename buf_type>
+concept direct_writeable =
+	requires(buf_type t, typename buf_type::size_type s) {
+		{ t.free() } -> std::convertible_to<typename buf_type::size_type>;
+		{ t.write_ptr() } -> std::convertible_to<const void*>;
+		t.advance_write(s);
+};
+
+template<typename buf_type>
+concept tail_writeable =
+	requires(buf_type t, typename buf_type::size_type s) {
+		{ t.back()->free() } -> std::convertible_to<typename buf_type::size_type>;
+		{ t.back()->write_ptr() } -> std::convertible_to<const void*>;
+		t.advance_write(s);
+};
+
+template<typename buf_type>
+concept fixed_capacity =
+	requires {
+		{ buf_type::capacity() } -> std::convertible_to<typename buf_type::size_type>;
+};
+
 template<typename T>
 concept byte_oriented = byte_type<typename T::value_type>;
 
@@ -282,6 +373,15 @@ concept has_clear =
 		{ t.clear() } -> std::same_as<void>;
 };
 
+template<typename T>
+constexpr bool is_variant_v = false;
+
+template<typename ...Ts>
+constexpr bool is_variant_v<std::variant<Ts...>> = true;
+
+template<typename T>
+concept variant_like = is_variant_v<std::remove_cv_t<T>>;
+
 template<typename T, typename U>
 concept has_shl_override =
 	requires(T t, U& u) {
@@ -320,9 +420,293 @@ concept memcpy_read =
 
 template<typename T, typename U>
 concept memcpy_write =
-	pod<typename T::value_type> && std::ranges::contiguous_range<T>
-		&& !has_shl_override<typename T::value_type, U>
-		&& !has_serialise<typename T::value_type, U>;
+	std::ranges::contiguous_range<T> && pod<std::ranges::range_value_t<T>>
+		&& !has_shl_override<std::ranges::range_value_t<T>, U>
+		&& !has_serialise<std::ranges::range_value_t<T>, U>;
+
+} // hexi
+
+// #include <hexi/delta_packed.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/detail/simd.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+/*
+ * Instruction set extensions available to the target, detected once so
+ * that headers with SIMD paths agree on what can be used. MSVC doesn't
+ * define the GCC/Clang feature macros, so the closest /arch settings that
+ * imply each extension are used instead.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HEXI_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+#define HEXI_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define HEXI_HAS_F16C
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+/**
+ * Serialises a contiguous container of integers, ideally sorted, as deltas
+ * bit-packed in blocks of 128, in the style of BP128:
+ *
+ * - std::uint32_t element count, little endian, as with prefixed
+ * - the first element, if there is one
+ * - for each complete block of 128 elements, a std::uint8_t bit width
+ *   followed by width * 4 std::uint32_t words of packed deltas
+ * - the remaining elements as varint encoded deltas
+ *
+ * Within a block, the deltas are taken against the element four places
+ * before (with the first element as the initial predecessor) and packed
+ * into four interleaved lanes, so that packing and unpacking can be done
+ * four elements at a time with SIMD.
+ *
+ * Deltas wrap around, so unsorted sequences also round trip, just without
+ * being compressed as well. Reading a block whose bit width is wider than
+ * the element type results in stream_state::invalid_bit_width_err.
+ */
+template<typename container_type>
+struct delta_packed {
+	container_type& values;
+};
+
+template<typename container_type>
+delta_packed(container_type&) -> delta_packed<container_type>;
+
+template<typename T>
+concept delta_packable = std::ranges::contiguous_range<T>
+	&& std::integral<std::ranges::range_value_t<T>>
+	&& !std::same_as<std::ranges::range_value_t<T>, bool>;
+
+namespace detail {
+
+constexpr std::size_t bp128_block_size = 128;
+constexpr std::size_t bp128_lanes = 4;
+constexpr std::size_t bp128_lane_values = bp128_block_size / bp128_lanes;
+
+// enough words for a block of 64-bit deltas
+constexpr std::size_t bp128_max_words = bp128_lanes * 64;
+
+template<std::unsigned_integral T>
+using bp128_seed = std::array<T, bp128_lanes>;
+
+constexpr std::uint32_t bp128_mask(const unsigned int bits) {
+	return bits >= 32? ~std::uint32_t(0) : (std::uint32_t(1) << bits) - 1;
+}
+
+/*
+ * Scalar fallback, which also handles elements wider than 32 bits. Each
+ * lane's deltas are packed least significant bit first into the lane's
+ * words, which are interleaved with those of the other lanes.
+ */
+template<std::unsigned_integral T>
+unsigned int bp128_encode_scalar(const T* values, bp128_seed<T>& seed, std::uint32_t* words) {
+	std::array<T, bp128_block_size> deltas;
+	T bits = 0;
+
+	for(std::size_t i = 0; i < deltas.size(); ++i) {
+		const auto prev = i < bp128_lanes? seed[i] : values[i - bp128_lanes];
+		deltas[i] = static_cast<T>(values[i] - prev);
+		bits |= deltas[i];
+	}
+
+	std::copy_n(values + bp128_block_size - bp128_lanes, bp128_lanes, seed.begin());
+	const auto width = static_cast<unsigned int>(std::bit_width(bits));
+	std::fill_n(words, width * bp128_lanes, 0);
+
+	for(std::size_t lane = 0; lane < bp128_lanes; ++lane) {
+		unsigned int pos = 0;
+
+		for(std::size_t i = 0; i < bp128_lane_values; ++i) {
+			std::uint64_t value = deltas[(i * bp128_lanes) + lane];
+
+			for(unsigned int remaining = width; remaining;) {
+				const auto offset = pos % 32;
+				const auto take = std::min(32 - offset, remaining);
+				auto& word = words[((pos / 32) * bp128_lanes) + lane];
+				word |= static_cast<std::uint32_t>(value & bp128_mask(take)) << offset;
+				value >>= take;
+				pos += take;
+				remaining -= take;
+			}
+		}
+	}
+
+	return width;
+}
+
+template<std::unsigned_integral T>
+void bp128_decode_scalar(const std::uint32_t* words, const unsigned int width,
+                         bp128_seed<T>& seed, T* values) {
+	for(std::size_t lane = 0; lane < bp128_lanes; ++lane) {
+		unsigned int pos = 0;
+		auto prev = seed[lane];
+
+		for(std::size_t i = 0; i < bp128_lane_values; ++i) {
+			std::uint64_t value = 0;
+
+			for(unsigned int got = 0; got < width;) {
+				const auto offset = pos % 32;
+				const auto take = std::min(32 - offset, width - got);
+				const auto word = words[((pos / 32) * bp128_lanes) + lane];
+				value |= std::uint64_t((word >> offset) & bp128_mask(take)) << got;
+				pos += take;
+				got += take;
+			}
+
+			prev = static_cast<T>(prev + value);
+			values[(i * bp128_lanes) + lane] = prev;
+		}
+	}
+
+	std::copy_n(values + bp128_block_size - bp128_lanes, bp128_lanes, seed.begin());
+}
+
+#ifdef HEXI_HAS_SSE2
+/*
+ * All four lanes share the same bit positions, so each step packs or
+ * unpacks one delta for every lane with a single shift.
+ */
+inline unsigned int bp128_encode_sse2(const std::uint32_t* values, bp128_seed<std::uint32_t>& seed,
+                                      std::uint32_t* words) {
+	alignas(16) std::array<std::uint32_t, bp128_block_size> deltas;
+	auto prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seed.data()));
+	auto bits = _mm_setzero_si128();
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		const auto current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+		const auto delta = _mm_sub_epi32(current, prev);
+		_mm_store_si128(reinterpret_cast<__m128i*>(deltas.data() + i), delta);
+		bits = _mm_or_si128(bits, delta);
+		prev = current;
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(seed.data()), prev);
+
+	alignas(16) std::array<std::uint32_t, bp128_lanes> lanes;
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), bits);
+	const auto width = static_cast<unsigned int>(std::bit_width(lanes[0] | lanes[1] | lanes[2] | lanes[3]));
+
+	auto out = reinterpret_cast<__m128i*>(words);
+	auto word = _mm_setzero_si128();
+	unsigned int offset = 0;
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		const auto delta = _mm_load_si128(reinterpret_cast<const __m128i*>(deltas.data() + i));
+		word = _mm_or_si128(word, _mm_sll_epi32(delta, _mm_cvtsi32_si128(static_cast<int>(offset))));
+		offset += width;
+
+		if(offset >= 32) {
+			_mm_storeu_si128(out++, word);
+			offset -= 32;
+
+			// carry over the bits that didn't fit into the previous word
+			word = offset? _mm_srl_epi32(delta, _mm_cvtsi32_si128(static_cast<int>(width - offset)))
+				: _mm_setzero_si128();
+		}
+	}
+
+	return width;
+}
+
+inline void bp128_decode_sse2(const std::uint32_t* words, const unsigned int width,
+                              bp128_seed<std::uint32_t>& seed, std::uint32_t* values) {
+	const auto in = reinterpret_cast<const __m128i*>(words);
+	const auto mask = _mm_set1_epi32(static_cast<int>(bp128_mask(width)));
+	auto prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seed.data()));
+	auto word = width? _mm_loadu_si128(in) : _mm_setzero_si128();
+	unsigned int offset = 0;
+	std::size_t index = 0;
+
+	for(std::size_t i = 0; i < bp128_block_size; i += bp128_lanes) {
+		auto delta = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(offset)));
+		offset += width;
+
+		if(offset >= 32) {
+			offset -= 32;
+
+			if(++index < width) {
+				word = _mm_loadu_si128(in + index);
+
+				if(offset) {
+					const auto shift = _mm_cvtsi32_si128(static_cast<int>(width - offset));
+					delta = _mm_or_si128(delta, _mm_sll_epi32(word, shift));
+				}
+			}
+		}
+
+		prev = _mm_add_epi32(prev, _mm_and_si128(delta, mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), prev);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(seed.data()), prev);
+}
+#endif
+
+/*
+ * Encodes a block of 128 values as deltas against the seed, which is
+ * updated to the last four values of the block. Returns the bit width,
+ * with width * 4 words having been written.
+ */
+template<std::unsigned_integral T>
+unsigned int bp128_encode(const T* values, bp128_seed<T>& seed, std::uint32_t* words) {
+#ifdef HEXI_HAS_SSE2
+	if constexpr(std::is_same_v<T, std::uint32_t>) {
+		return bp128_encode_sse2(values, seed, words);
+	}
+#endif
+
+	return bp128_encode_scalar(values, seed, words);
+}
+
+template<std::unsigned_integral T>
+void bp128_decode(const std::uint32_t* words, const unsigned int width,
+                  bp128_seed<T>& seed, T* values) {
+	assert(width <= std::numeric_limits<T>::digits);
+
+#ifdef HEXI_HAS_SSE2
+	if constexpr(std::is_same_v<T, std::uint32_t>) {
+		bp128_decode_sse2(words, width, seed, values);
+		return;
+	}
+#endif
+
+	bp128_decode_scalar(words, width, seed, values);
+}
+
+} // detail
 
 } // hexi
 
@@ -381,6 +765,72 @@ public:
 		read_limit(read_limit), read_size(read_size), total_read(total_read) {}
 };
 
+class capacity_exceeded final : public exception {
+public:
+	const std::size_t requested, capacity;
+
+	capacity_exceeded(std::size_t requested, std::size_t capacity)
+		: exception(std::format(
+			"Capacity exceeded: {} elements requested, capacity is {} elements",
+			requested, capacity)),
+		requested(requested), capacity(capacity) {}
+};
+
+class allocation_limit_exceeded final : public exception {
+public:
+	const std::size_t requested, allocated, limit;
+
+	allocation_limit_exceeded(std::size_t requested, std::size_t allocated, std::size_t limit)
+		: exception(std::format(
+			"Allocation limit exceeded: {} byte allocation requested, allocation limit was {} bytes and total bytes allocated was {}",
+			requested, limit, allocated)),
+		requested(requested), allocated(allocated), limit(limit) {}
+};
+
+class invalid_variant_tag final : public exception {
+public:
+	const std::size_t tag, alternatives;
+
+	invalid_variant_tag(std::size_t tag, std::size_t alternatives)
+		: exception(std::format(
+			"Invalid variant tag: tag was {} but the variant only has {} alternatives",
+			tag, alternatives)),
+		tag(tag), alternatives(alternatives) {}
+};
+
+class invalid_bit_width final : public exception {
+public:
+	const std::size_t width, max_width;
+
+	invalid_bit_width(std::size_t width, std::size_t max_width)
+		: exception(std::format(
+			"Invalid bit width: width was {} but the element type only has {} bits",
+			width, max_width)),
+		width(width), max_width(max_width) {}
+};
+
+class invalid_string_reference final : public exception {
+public:
+	const std::size_t index, entries;
+
+	invalid_string_reference(std::size_t index, std::size_t entries)
+		: exception(std::format(
+			"Invalid string reference: index was {} but the string table only has {} entries",
+			index, entries)),
+		index(index), entries(entries) {}
+};
+
+class invalid_utf8 final : public exception {
+public:
+	const std::size_t offset, size;
+
+	invalid_utf8(std::size_t offset, std::size_t size)
+		: exception(std::format(
+			"Invalid UTF-8: ill-formed sequence at byte {} of a {} byte string",
+			offset, size)),
+		offset(offset), size(size) {}
+};
+
 } // hexi
 
 // #include <hexi/endian.h>
@@ -525,13 +975,13 @@ template<arithmetic T>                           \
 struct name final : adaptor_tag_t {              \
 	T& value;                                    \
                                                  \
-    name(T& t) : value(t) {}                     \
-    name(T&& t) : value(t) {}                    \
+    constexpr name(T& t) : value(t) {}           \
+    constexpr name(T&& t) : value(t) {}          \
                                                  \
-	auto to() -> T {                             \
+	constexpr auto to() -> T {                   \
 		return func_to(value);                   \
 	}                                            \
-	auto from() -> T {                           \
+	constexpr auto from() -> T {                 \
 		return func_from(value);                 \
 	}                                            \
 };
@@ -548,1124 +998,7875 @@ struct as_native_t final : storage_tag {};
 [[maybe_unused]] constexpr static as_little_t little {};
 [[maybe_unused]] constexpr static as_native_t native {};
 
-inline auto storage_in(const arithmetic auto& value, as_native_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_native_t) {
 	return value;
 }
 
-inline auto storage_in(const arithmetic auto& value, as_little_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_little_t) {
 	return native_to_little(value);
 }
 
-inline auto storage_in(const arithmetic auto& value, as_big_t) {
+constexpr auto storage_in(const arithmetic auto& value, as_big_t) {
 	return native_to_big(value);
 }
 
-inline void storage_out(arithmetic auto& value, as_native_t) {}
+constexpr void storage_out(arithmetic auto& value, as_native_t) {}
 
-inline void storage_out(arithmetic auto& value, as_little_t) {
+constexpr void storage_out(arithmetic auto& value, as_little_t) {
 	return little_to_native_inplace(value);
 }
 
-inline void storage_out(arithmetic auto& value, as_big_t) {
+constexpr void storage_out(arithmetic auto& value, as_big_t) {
 	return big_to_native_inplace(value);
 }
 
 
 } // endian, hexi
-// #include <hexi/stream_adaptors.h>
+// #include <hexi/fixed_string.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-#include <concepts>
-#include <ranges>
-#include <span>
-#include <string>
+
+
+// #include <hexi/exception.h>
+
+// #include <hexi/shared.h>
+
+#include <algorithm>
+#include <array>
 #include <string_view>
-#include <type_traits>
 #include <utility>
 #include <cassert>
 #include <cstddef>
-#include <cstdint>
-#include <cstring>
 
 namespace hexi {
 
-using namespace detail;
-
-#define STREAM_READ_BOUNDS_ENFORCE(read_size, ret_var)            \
-	if(state_ != stream_state::ok) [[unlikely]] {                 \
-		return ret_var;                                           \
-	}                                                             \
-                                                                  \
-	enforce_read_bounds(read_size);                               \
-	                                                              \
-	if constexpr(std::is_same_v<exceptions, no_throw_t>) {        \
-		if(state_ != stream_state::ok) [[unlikely]] {             \
-			return ret_var;                                       \
-		}                                                         \
+/**
+ * String with inline storage for up to N characters, for fields with a hard
+ * maximum length. The string is always null terminated.
+ *
+ * When deserialised, a length greater than N puts the stream into an error
+ * state rather than being truncated.
+ *
+ * @tparam N The maximum number of characters, excluding the null terminator.
+ */
+template<std::size_t N>
+class fixed_string final {
+	std::array<char, N + 1> data_{};
+	std::size_t size_ = 0;
+
+	constexpr void check_capacity(const std::size_t size) const {
+		if(size > N) {
+			HEXI_THROW(capacity_exceeded(size, N));
+		}
 	}
 
-#define SAFE_READ(dest, read_size, ret_var)                       \
-	STREAM_READ_BOUNDS_ENFORCE(read_size, ret_var)                \
-	buffer_.read(dest, read_size);
-
-template<
-	byte_oriented buf_type,
-	std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
-	std::derived_from<endian::storage_tag> endianness = endian::as_native_t
->
-class binary_stream final {
 public:
-	using size_type          = typename buf_type::size_type;
-	using offset_type        = typename buf_type::offset_type;
-	using seeking            = typename buf_type::seeking;
-	using value_type         = typename buf_type::value_type;
-	using contiguous_type    = typename buf_type::contiguous;
-	
-	static constexpr endianness byte_order{};
+	using value_type      = char;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = char&;
+	using const_reference = const char&;
+	using pointer         = char*;
+	using const_pointer   = const char*;
+	using iterator        = char*;
+	using const_iterator  = const char*;
 
-private:
-	using cond_size_type = std::conditional_t<writeable<buf_type>, size_type, std::monostate>;
+	constexpr fixed_string() = default;
 
-	buf_type& buffer_;
-	[[no_unique_address]] cond_size_type total_write_{};
-	size_type total_read_ = 0;
-	stream_state state_ = stream_state::ok;
-	const size_type read_limit_;
+	constexpr fixed_string(const std::string_view string) {
+		assign(string);
+	}
 
-	inline void enforce_read_bounds(const size_type read_size) {
-		if(read_size > buffer_.size()) [[unlikely]] {
-			state_ = stream_state::buff_limit_err;
+	constexpr fixed_string(const char* string)
+		: fixed_string(std::string_view(string)) {}
 
-			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
-				HEXI_THROW(buffer_underrun(read_size, total_read_, buffer_.size()));
-			}
+	constexpr void assign(const std::string_view string) {
+		check_capacity(string.size());
+		std::ranges::copy(string, data_.begin());
+		size_ = string.size();
+		data_[size_] = '\0';
+	}
 
-			return;
+	constexpr fixed_string& operator=(const std::string_view string) {
+		assign(string);
+		return *this;
+	}
+
+	constexpr void resize(const size_type size, const char value = '\0') {
+		check_capacity(size);
+
+		if(size > size_) {
+			std::fill(data_.begin() + size_, data_.begin() + size, value);
 		}
 
-		if(read_limit_) {
-			const auto max_read_remaining = read_limit_ - total_read_;
+		size_ = size;
+		data_[size_] = '\0';
+	}
 
-			if(read_size > max_read_remaining) [[unlikely]] {
-				state_ = stream_state::read_limit_err;
+	/**
+	 * @brief Resizes the string and invokes op to write its contents,
+	 * as with std::string::resize_and_overwrite.
+	 */
+	template<typename operation>
+	constexpr void resize_and_overwrite(const size_type size, operation op) {
+		check_capacity(size);
+		size_ = std::move(op)(data_.data(), size);
+		assert(size_ <= size);
+		data_[size_] = '\0';
+	}
 
-				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
-					HEXI_THROW(stream_read_limit(read_size, total_read_, read_limit_));
-				}
+	constexpr void push_back(const char value) {
+		check_capacity(size_ + 1);
+		data_[size_++] = value;
+		data_[size_] = '\0';
+	}
 
-				return;
-			}
-		}
+	constexpr void append(const std::string_view string) {
+		check_capacity(size_ + string.size());
+		std::ranges::copy(string, data_.begin() + size_);
+		size_ += string.size();
+		data_[size_] = '\0';
+	}
 
-		total_read_ += read_size;
+	constexpr void clear() {
+		size_ = 0;
+		data_[0] = '\0';
 	}
 
-	template<typename T>
-	inline void advance_write(T&& arg) {
-		total_write_ += sizeof(T);
+	constexpr char& operator[](const size_type index) {
+		assert(index < size_);
+		return data_[index];
 	}
 
-	template<typename T, typename U>
-	inline void advance_write(T&&, U&& size) {
-		total_write_ += size;
+	constexpr const char& operator[](const size_type index) const {
+		assert(index < size_);
+		return data_[index];
 	}
 
-	template<typename... Ts>
-	inline void write(Ts&&... args) {
-		HEXI_TRY {
-			if(state_ == stream_state::ok) [[likely]] {
-				buffer_.write(std::forward<Ts>(args)...);
-				advance_write(std::forward<Ts>(args)...);                            
-			}
-		} HEXI_CATCH(...) {
-			state_ = stream_state::buff_write_err;
+	constexpr char* data() {
+		return data_.data();
+	}
 
-			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
-				HEXI_THROW();
-			}
-		}
+	constexpr const char* data() const {
+		return data_.data();
 	}
 
-	template<typename container_type>
-	void write_container(container_type& container) {
-		using cvalue_type = typename container_type::value_type;
+	constexpr const char* c_str() const {
+		return data_.data();
+	}
 
-		if constexpr(memcpy_write<container_type, binary_stream>) {
-			const auto bytes = container.size() * sizeof(cvalue_type);
-			write(container.data(), static_cast<size_type>(bytes));
-		} else {
-			for(auto& element : container) {
-				*this << element;
-			}
-		}
+	constexpr size_type size() const {
+		return size_;
 	}
 
-	template<typename container_type, typename count_type>
-	void read_container(container_type& container, const count_type count) {
-		using cvalue_type = typename container_type::value_type;
+	constexpr size_type length() const {
+		return size_;
+	}
 
-		if constexpr(!memcpy_read<container_type, binary_stream>) {
-			container.clear();
-		}
+	static constexpr size_type capacity() {
+		return N;
+	}
 
-		if constexpr(has_reserve<container_type>) {
-			container.reserve(count);
-		}
+	static constexpr size_type max_size() {
+		return N;
+	}
 
-		if constexpr(memcpy_read<container_type, binary_stream>) {
-			container.resize(count);
+	constexpr bool empty() const {
+		return size_ == 0;
+	}
 
-			const auto bytes = static_cast<size_type>(count * sizeof(cvalue_type));
-			SAFE_READ(container.data(), bytes, void());
-		} else {
-			for(count_type i = 0; i < count; ++i) {
-				cvalue_type value;
-				*this >> value;
-				container.emplace_back(std::move(value));
-			}
-		}
+	constexpr bool full() const {
+		return size_ == N;
 	}
 
-public:
-	explicit binary_stream(buf_type& source, size_type read_limit = 0)
-		: buffer_(source),
-		  read_limit_(read_limit) {};
+	constexpr iterator begin() {
+		return data_.data();
+	}
 
-	explicit binary_stream(buf_type& source, exceptions)
-		: binary_stream(source, 0) {}
+	constexpr const_iterator begin() const {
+		return data_.data();
+	}
 
-	explicit binary_stream(buf_type& source, endianness)
-		: binary_stream(source, 0) {}
+	constexpr iterator end() {
+		return data_.data() + size_;
+	}
 
-	explicit binary_stream(buf_type& source, exceptions, endianness)
-		: binary_stream(source, 0) {}
+	constexpr const_iterator end() const {
+		return data_.data() + size_;
+	}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, exceptions)
-		: binary_stream(source, read_limit) {}
+	constexpr std::string_view view() const {
+		return { data_.data(), size_ };
+	}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, endianness)
-		: binary_stream(source, read_limit) {}
+	constexpr operator std::string_view() const {
+		return view();
+	}
 
-	explicit binary_stream(buf_type& source, size_type read_limit, exceptions, endianness)
-		: binary_stream(source, read_limit) {}
+	template<std::size_t M>
+	constexpr bool operator==(const fixed_string<M>& rhs) const {
+		return view() == rhs.view();
+	}
 
-	binary_stream(binary_stream&& rhs) noexcept
-		: buffer_(rhs.buffer_), 
-		  total_write_(rhs.total_write_),
-		  total_read_(rhs.total_read_),
-		  state_(rhs.state_),
-		  read_limit_(rhs.read_limit_) {
-		rhs.total_read_ = static_cast<size_type>(-1);
-		rhs.state_ = stream_state::invalid_stream;
+	constexpr bool operator==(const std::string_view rhs) const {
+		return view() == rhs;
 	}
+};
 
-	binary_stream& operator=(binary_stream&&) = delete;
-	binary_stream& operator=(binary_stream&) = delete;
-	binary_stream(binary_stream&) = delete;
+template<typename T>
+constexpr bool is_fixed_string_v = false;
 
-	/*** Write ***/
+template<std::size_t N>
+constexpr bool is_fixed_string_v<fixed_string<N>> = true;
 
-	/**
-	 * @brief Serialises an object that provides a serialise function:
-	 * void serialise(auto& stream);
-	 * 
-	 * @param object The object to be serialised.
-	 */
-	void serialise(auto&& object) requires writeable<buf_type> {
-		stream_write_adaptor adaptor(*this);
-		object.serialise(adaptor);
-	}
+} // hexi
 
-	/**
-	 * @brief Serialises an object that provides a serialise function:
-	 * void serialise(auto& stream);
-	 * 
-	 * @param data The object to be serialised.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<typename T>
-	requires has_serialise<T, binary_stream>
-	binary_stream& operator<<(T& data) requires writeable<buf_type> {
-		serialise(data);
-		return *this;
-	}
+// #include <hexi/quantise.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-	/**
-	 * @brief Serialises an object that provides a serialise function:
-	 * auto& operator<<(auto& stream);
-	 * 
-	 * @param data The object to be serialised.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	binary_stream& operator<<(const has_shl_override<binary_stream> auto& data)
-	requires writeable<buf_type> {
-		return *this << data;
+
+
+// #include <hexi/detail/simd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+/**
+ * Types with floating point x, y, z and w members, which can be encoded
+ * as quaternions with the smallest_three adaptor.
+ */
+template<typename T>
+concept quaternion = requires(T q) {
+	requires std::floating_point<decltype(q.x)>;
+	requires std::same_as<decltype(q.x), decltype(q.y)>;
+	requires std::same_as<decltype(q.x), decltype(q.z)>;
+	requires std::same_as<decltype(q.x), decltype(q.w)>;
+};
+
+namespace detail {
+
+// number of values encoded at a time by the bulk stream adaptors
+constexpr std::size_t quantise_chunk_size = 64;
+
+template<std::floating_point T>
+constexpr unsigned int max_quantise_bits = std::min(std::numeric_limits<T>::digits, 32);
+
+constexpr unsigned int min_smallest_three_bits = 2;
+constexpr unsigned int max_smallest_three_bits = 20;
+
+/*
+ * Invokes the function with a std::type_identity of the smallest unsigned
+ * type that can hold the given number of bits.
+ */
+template<typename func_type>
+constexpr decltype(auto) with_word_type(const unsigned int bits, func_type&& func) {
+	assert(bits && bits <= 64);
+
+	if(bits <= 8) {
+		return func(std::type_identity<std::uint8_t>{});
+	} else if(bits <= 16) {
+		return func(std::type_identity<std::uint16_t>{});
+	} else if(bits <= 32) {
+		return func(std::type_identity<std::uint32_t>{});
+	} else {
+		return func(std::type_identity<std::uint64_t>{});
 	}
+}
 
-	/**
-	 * @brief Serialises an arithmetic type with the requested byte order.
-	 * 
-	 * @param adaptor An endian adaptor.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	binary_stream& operator<<(endian_func adaptor) requires writeable<buf_type> {
-		const auto converted = adaptor.to();
-		write(&converted, sizeof(converted));
-		return *this;
+template<std::floating_point T>
+struct quantise_params {
+	using int_type = std::conditional_t<sizeof(T) <= sizeof(std::int32_t), std::int32_t, std::int64_t>;
+
+	T min;
+	T max;
+	T scale;
+	T step;
+	int_type max_code;
+
+	// bits is clamped to the supported range, streams reject it beforehand
+	constexpr quantise_params(const T min, const T max, const unsigned int bits)
+		: min(min), max(max) {
+		assert(bits && bits <= max_quantise_bits<T>);
+		assert(min < max);
+		const auto width = std::clamp(bits, 1u, max_quantise_bits<T>);
+		max_code = static_cast<int_type>((std::uint64_t(1) << width) - 1);
+		scale = static_cast<T>(max_code) / (max - min);
+		step = (max - min) / static_cast<T>(max_code);
 	}
 
-	/**
-	 * @brief Serialises an arithmetic type with the default byte order.
-	 * 
-	 * @param data Reference to the type to be serialised.
-	 * 
-	 * @return Reference to the current stream.
+	/*
+	 * Branchless, so that loops over these can be vectorised. The result is
+	 * clamped as the scaling can round up to one past the largest code when
+	 * the number of bits is close to the precision of T.
 	 */
-	binary_stream& operator<<(const arithmetic auto& data) requires writeable<buf_type> {
-		const auto converted = endian::storage_in(data, byte_order);
-		write(&converted, sizeof(converted));
-		return *this;
+	constexpr std::uint64_t encode(T value) const {
+		value = value > max? max : value;
+		value = value >= min? value : min; // also catches NaN
+		const auto code = static_cast<int_type>((value - min) * scale + T(0.5));
+		return static_cast<std::uint64_t>(code < max_code? code : max_code);
 	}
 
-	/**
-	 * @brief Serialises a POD type.
-	 * 
-	 * @tparam T The type of the POD object.
-	 * @param data Reference to the object to be serialised.
-	 * 
-	 * @note Will not be used for types with user-defined serialisation
-	 * functions.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<pod T>
-	requires (!has_shl_override<T, binary_stream> && !arithmetic<T>)
-	binary_stream& operator<<(const T& data) requires writeable<buf_type> {
-		write(&data, sizeof(T));
-		return *this;
+	constexpr T decode(const std::uint64_t code) const {
+		return min + static_cast<T>(static_cast<int_type>(code)) * step;
 	}
+};
 
-	/**
-	 * @brief Serialises a string or string_view with a fixed-length prefix
-	 * 
-	 * @tparam T The string type.
-	 * @param adaptor prefixed adaptor that will instruct the stream to write a length
-	 * prefix before serialising the string.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<typename T>
-	requires std::is_same_v<std::decay_t<T>, std::string_view>
-	binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
-		assert(adaptor->find_first_of('\0') == adaptor->npos);
-		write(adaptor->data(), adaptor->size());
-		write('\0');
-		return *this;
+template<std::floating_point T>
+constexpr T smallest_three_bound = T(0.70710678118654752440); // 1 / sqrt(2)
+
+} // detail
+
+/**
+ * @brief Converts a float to IEEE 754 binary16, rounding to nearest even.
+ * Values too large to be represented become infinity and NaNs are quieted.
+ * Uses F16C where it's available.
+ *
+ * @param value The value to convert.
+ *
+ * @return The binary16 representation of the value.
+ */
+inline std::uint16_t to_half(const float value) {
+#ifdef HEXI_HAS_F16C
+	return static_cast<std::uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+	const auto bits = std::bit_cast<std::uint32_t>(value);
+	const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+	const auto abs = bits & 0x7fffffff;
+
+	// infinity or NaN, keeping the top bits of the payload
+	if(abs >= 0x7f800000) {
+		const auto nan = abs > 0x7f800000? 0x200 | ((abs >> 13) & 0x3ff) : 0;
+		return static_cast<std::uint16_t>(sign | 0x7c00 | nan);
 	}
 
-	/**
-	 * @brief Serialises a string_view as a null terminated string.
-	 * 
-	 * @tparam T The string type.
-	 * @param adaptor null_terminated adaptor that will instruct the stream to write
-	 * a null terminated string with no prefix.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<typename T>
-	requires std::is_same_v<std::decay_t<T>, std::string>
-	binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
-		assert(adaptor->find_first_of('\0') == adaptor->npos);
-		write(adaptor->data(), adaptor->size() + 1); // yes, the standard allows this
-		return *this;
+	// rounds to 65520 or above, which is past the largest finite half
+	if(abs >= 0x477ff000) {
+		return static_cast<std::uint16_t>(sign | 0x7c00);
 	}
 
-	/**
-	 * @brief Serialises a string, string_view or any type providing data()
-	 * and a size() member functions.
-	 * 
-	 * @tparam T The type.
-	 * @param adaptor raw adaptor referencing the type to be serialised.
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	template<typename T>
-	binary_stream& operator<<(raw<T> adaptor) requires writeable<buf_type> {
-		write(adaptor->data(), adaptor->size());
-		return *this;
+	// too small to be a normal half, becomes subnormal or zero
+	if(abs < 0x38800000) {
+		if(abs < 0x33000000) {
+			return sign;
+		}
+
+		const auto shift = 126 - (abs >> 23);
+		const auto mantissa = (abs & 0x7fffff) | 0x800000;
+		const auto halfway = std::uint32_t(1) << (shift - 1);
+		const auto remainder = mantissa & ((std::uint32_t(1) << shift) - 1);
+		auto result = mantissa >> shift;
+
+		if(remainder > halfway || (remainder == halfway && (result & 1))) {
+			++result; // may carry into the smallest normal, which is correct
+		}
+
+		return static_cast<std::uint16_t>(sign | result);
+	}
+
+	auto result = (abs - 0x38000000) >> 13;
+	const auto remainder = abs & 0x1fff;
+
+	if(remainder > 0x1000 || (remainder == 0x1000 && (result & 1))) {
+		++result;
+	}
+
+	return static_cast<std::uint16_t>(sign | result);
+#endif
+}
+
+/**
+ * @brief Converts an IEEE 754 binary16 value to a float. The conversion
+ * is exact. Uses F16C where it's available.
+ *
+ * @param value The binary16 value.
+ *
+ * @return The value as a float.
+ */
+inline float from_half(const std::uint16_t value) {
+#ifdef HEXI_HAS_F16C
+	return _cvtsh_ss(value);
+#else
+	const auto sign = std::uint32_t(value & 0x8000) << 16;
+	const auto exponent = (value >> 10) & 0x1f;
+	const auto mantissa = std::uint32_t(value & 0x3ff);
+
+	// infinity or NaN, which is quieted
+	if(exponent == 0x1f) {
+		const auto nan = mantissa? 0x400000 | (mantissa << 13) : 0;
+		return std::bit_cast<float>(sign | 0x7f800000 | nan);
+	}
+
+	if(exponent == 0) {
+		const auto result = static_cast<float>(mantissa) * 0x1p-24f;
+		return sign? -result : result;
+	}
+
+	return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+#endif
+}
+
+/**
+ * @brief Converts floats to IEEE 754 binary16, eight at a time where F16C
+ * is available.
+ *
+ * @param in The values to convert.
+ * @param[out] out The converted values. Must be the same size as in.
+ */
+inline void to_half(std::span<const float> in, std::span<std::uint16_t> out) {
+	assert(in.size() == out.size());
+	std::size_t i = 0;
+
+#ifdef HEXI_HAS_F16C
+	for(; i + 8 <= in.size(); i += 8) {
+		const auto values = _mm256_loadu_ps(in.data() + i);
+		const auto halves = _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), halves);
+	}
+#endif
+
+	for(; i < in.size(); ++i) {
+		out[i] = to_half(in[i]);
+	}
+}
+
+/**
+ * @brief Converts IEEE 754 binary16 values to floats, eight at a time where
+ * F16C is available.
+ *
+ * @param in The values to convert.
+ * @param[out] out The converted values. Must be the same size as in.
+ */
+inline void from_half(std::span<const std::uint16_t> in, std::span<float> out) {
+	assert(in.size() == out.size());
+	std::size_t i = 0;
+
+#ifdef HEXI_HAS_F16C
+	for(; i + 8 <= in.size(); i += 8) {
+		const auto halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+		_mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(halves));
+	}
+#endif
+
+	for(; i < in.size(); ++i) {
+		out[i] = from_half(in[i]);
+	}
+}
+
+/**
+ * @brief Maps a value in [min, max] onto an unsigned integer of the given
+ * number of bits, rounding to the nearest step. Values outside of the range
+ * are clamped and NaN becomes min.
+ *
+ * The error when dequantising is at most (max - min) / (2 * (2^bits - 1)),
+ * plus the rounding error of T.
+ *
+ * @param value The value to quantise.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits, up to 32 or the precision of T.
+ *
+ * @return The quantised value.
+ */
+template<std::floating_point T>
+constexpr std::uint32_t quantise(const T value, const std::type_identity_t<T> min,
+                                 const std::type_identity_t<T> max, const unsigned int bits) {
+	return static_cast<std::uint32_t>(detail::quantise_params<T>(min, max, bits).encode(value));
+}
+
+/**
+ * @brief Maps a quantised value back onto [min, max].
+ *
+ * @param value The quantised value.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits the value was quantised to.
+ *
+ * @return The dequantised value.
+ */
+template<std::floating_point T>
+constexpr T dequantise(const std::uint32_t value, const std::type_identity_t<T> min,
+                       const std::type_identity_t<T> max, const unsigned int bits) {
+	return detail::quantise_params<T>(min, max, bits).decode(value);
+}
+
+/**
+ * @brief Quantises an array of values. The loop is branchless, so that
+ * the compiler can vectorise it.
+ *
+ * @param in The values to quantise.
+ * @param[out] out The quantised values. Must be the same size as in and
+ * its type must be able to hold the given number of bits.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits, up to 32 or the precision of T.
+ */
+template<std::floating_point T, std::unsigned_integral word_type>
+constexpr void quantise(std::span<const std::type_identity_t<T>> in, std::span<word_type> out,
+                        const T min, const T max, const unsigned int bits) {
+	assert(in.size() == out.size());
+	assert(bits <= std::numeric_limits<word_type>::digits);
+	const detail::quantise_params<T> params(min, max, bits);
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		out[i] = static_cast<word_type>(params.encode(in[i]));
+	}
+}
+
+/**
+ * @brief Dequantises an array of values. The loop is branchless, so that
+ * the compiler can vectorise it.
+ *
+ * @param in The quantised values.
+ * @param[out] out The dequantised values. Must be the same size as in.
+ * @param min The lower bound of the range.
+ * @param max The upper bound of the range.
+ * @param bits The number of bits the values were quantised to.
+ */
+template<std::floating_point T, std::unsigned_integral word_type>
+constexpr void dequantise(std::span<const word_type> in, std::span<std::type_identity_t<T>> out,
+                          const T min, const T max, const unsigned int bits) {
+	assert(in.size() == out.size());
+	const detail::quantise_params<T> params(min, max, bits);
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		out[i] = params.decode(in[i]);
+	}
+}
+
+/**
+ * @brief Encodes a unit quaternion as the index of its largest component,
+ * in the low two bits, followed by the other three components quantised to
+ * the given number of bits each. The largest component is recovered from
+ * the others, relying on q and -q being the same rotation.
+ *
+ * Each of the three components has an error of at most
+ * 1 / (sqrt(2) * (2^bits - 1)), e.g. 0.0007 with 10 bits.
+ *
+ * @param value The quaternion to encode. Must be normalised.
+ * @param bits The number of bits per component, from 2 to 20.
+ *
+ * @return The encoded quaternion, occupying 2 + (3 * bits) bits.
+ */
+template<quaternion T>
+constexpr std::uint64_t encode_smallest_three(const T& value, const unsigned int bits) {
+	using value_type = decltype(value.x);
+	assert(bits >= detail::min_smallest_three_bits && bits <= detail::max_smallest_three_bits);
+
+	constexpr auto bound = detail::smallest_three_bound<value_type>;
+	const detail::quantise_params<value_type> params(-bound, bound, bits);
+	const std::array components { value.x, value.y, value.z, value.w };
+	std::size_t largest = 0;
+
+	for(std::size_t i = 1; i < components.size(); ++i) {
+		if(std::abs(components[i]) > std::abs(components[largest])) {
+			largest = i;
+		}
+	}
+
+	const value_type sign = components[largest] < 0? -1 : 1;
+	std::uint64_t result = largest;
+	unsigned int shift = 2;
+
+	for(std::size_t i = 0; i < components.size(); ++i) {
+		if(i != largest) {
+			result |= params.encode(components[i] * sign) << shift;
+			shift += bits;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @brief Decodes a quaternion encoded with encode_smallest_three.
+ *
+ * @param encoded The encoded quaternion.
+ * @param[out] value The decoded quaternion.
+ * @param bits The number of bits per component that it was encoded with.
+ */
+template<quaternion T>
+constexpr void decode_smallest_three(const std::uint64_t encoded, T& value, const unsigned int bits) {
+	using value_type = decltype(value.x);
+	assert(bits >= detail::min_smallest_three_bits && bits <= detail::max_smallest_three_bits);
+
+	constexpr auto bound = detail::smallest_three_bound<value_type>;
+	const detail::quantise_params<value_type> params(-bound, bound, bits);
+	const auto mask = (std::uint64_t(1) << bits) - 1;
+	const auto largest = static_cast<std::size_t>(encoded & 0x03);
+
+	std::array<value_type, 4> components{};
+	value_type sum = 0;
+	unsigned int shift = 2;
+
+	for(std::size_t i = 0; i < components.size(); ++i) {
+		if(i != largest) {
+			components[i] = params.decode((encoded >> shift) & mask);
+			sum += components[i] * components[i];
+			shift += bits;
+		}
+	}
+
+	components[largest] = std::sqrt(std::max(value_type(0), value_type(1) - sum));
+	value.x = components[0];
+	value.y = components[1];
+	value.z = components[2];
+	value.w = components[3];
+}
+
+/**
+ * Serialises floats as IEEE 754 binary16 (half precision), e.g.
+ * stream << hexi::half(velocity). Halves have 11 significant bits, giving
+ * a relative error of at most 2^-11 for values between 2^-14 and 65504.
+ * Larger values become infinity.
+ *
+ * Arrays of floats are converted in bulk, e.g. stream >> hexi::half(values),
+ * where the destination must already have the correct size.
+ */
+struct half final {
+	std::span<float> values;
+
+	half(float& value) : values(&value, 1) {}
+	half(float&& value) : values(&value, 1) {}
+	half(std::span<float> values) : values(values) {}
+};
+
+/**
+ * Serialises floating point values quantised to the given number of bits
+ * within [min, max], e.g. stream << hexi::quantised(x, -512.0f, 512.0f, 16).
+ * Each value is written as the smallest unsigned type that can hold the
+ * bits, with the stream's byte order. Values outside of the range are
+ * clamped. See quantise for the error bound. A number of bits outside of
+ * 1 to 32 or the precision of T results in
+ * stream_state::invalid_bit_width_err.
+ *
+ * Arrays of values are quantised in bulk, in the same way as half.
+ */
+template<std::floating_point T>
+struct quantised final {
+	std::span<T> values;
+	T min;
+	T max;
+	unsigned int bits;
+
+	quantised(T& value, const T min, const T max, const unsigned int bits)
+		: values(&value, 1), min(min), max(max), bits(bits) {}
+
+	quantised(T&& value, const T min, const T max, const unsigned int bits)
+		: values(&value, 1), min(min), max(max), bits(bits) {}
+
+	quantised(std::span<T> values, const T min, const T max, const unsigned int bits)
+		: values(values), min(min), max(max), bits(bits) {}
+};
+
+/**
+ * Serialises unit quaternions using the smallest three encoding, e.g.
+ * stream << hexi::smallest_three(rotation). With the default of 10 bits
+ * per component, each quaternion fits into a std::uint32_t. See
+ * encode_smallest_three for the error bound. A number of bits outside of
+ * 2 to 20 results in stream_state::invalid_bit_width_err.
+ */
+template<quaternion T>
+struct smallest_three final {
+	std::span<T> values;
+	unsigned int bits;
+
+	smallest_three(T& value, const unsigned int bits = 10)
+		: values(&value, 1), bits(bits) {}
+
+	smallest_three(T&& value, const unsigned int bits = 10)
+		: values(&value, 1), bits(bits) {}
+
+	smallest_three(std::span<T> values, const unsigned int bits = 10)
+		: values(values), bits(bits) {}
+};
+
+template<std::ranges::contiguous_range range>
+quantised(range&, std::ranges::range_value_t<range>, std::ranges::range_value_t<range>, unsigned int)
+	-> quantised<std::ranges::range_value_t<range>>;
+
+template<std::ranges::contiguous_range range>
+requires quaternion<std::ranges::range_value_t<range>>
+smallest_three(range&, unsigned int = 10) -> smallest_three<std::ranges::range_value_t<range>>;
+
+} // hexi
+
+// #include <hexi/serialised_size.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+// #include <hexi/fixed_string.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+constexpr static std::size_t unbounded_size = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Inclusive lower and upper bounds on the number of bytes an object will
+ * occupy once serialised. A max of unbounded_size indicates that no upper
+ * bound could be determined (e.g. std::string or std::vector fields).
+ */
+struct size_bounds {
+	std::size_t min = 0;
+	std::size_t max = 0;
+
+	constexpr bool fixed() const {
+		return min == max;
+	}
+
+	constexpr bool bounded() const {
+		return max != unbounded_size;
+	}
+
+	constexpr size_bounds operator+(const size_bounds& rhs) const {
+		return {
+			saturating_add(min, rhs.min),
+			saturating_add(max, rhs.max)
+		};
+	}
+
+	constexpr size_bounds operator*(const std::size_t count) const {
+		return { saturating_mul(min, count), saturating_mul(max, count) };
+	}
+
+	constexpr bool operator==(const size_bounds&) const = default;
+
+private:
+	constexpr static std::size_t saturating_add(std::size_t lhs, std::size_t rhs) {
+		return (lhs > unbounded_size - rhs)? unbounded_size : lhs + rhs;
+	}
+
+	constexpr static std::size_t saturating_mul(std::size_t lhs, std::size_t rhs) {
+		if(lhs == 0 || rhs == 0) {
+			return 0;
+		}
+
+		return (lhs > unbounded_size / rhs)? unbounded_size : lhs * rhs;
+	}
+};
+
+/**
+ * Compile-time serialised size bounds for T. Defined for any type that
+ * provides a constexpr serialise function (see below) and can be specialised
+ * for types that use custom operator<< overloads, e.g:
+ *
+ * template<>
+ * struct hexi::serialised_size_bounds<my_type> {
+ *     static constexpr hexi::size_bounds value { 4, 36 };
+ * };
+ *
+ * The bounds for types using serialise are found by running serialise at
+ * compile-time, filling each arithmetic field with zero, one and all bits
+ * set as it's visited, as a read would. Bounds are only provided if every
+ * pass agrees, so types whose fields depend on the values of others (e.g.
+ * a field only written when a flag is set) get no bounds, and no up-front
+ * size checks, unless they provide a specialisation.
+ */
+template<typename T>
+struct serialised_size_bounds {};
+
+template<typename T>
+concept has_size_bounds = requires {
+	{ serialised_size_bounds<std::remove_cvref_t<T>>::value } -> std::convertible_to<size_bounds>;
+};
+
+template<typename T>
+requires has_size_bounds<T>
+constexpr static size_bounds serialised_size_bounds_v
+	= serialised_size_bounds<std::remove_cvref_t<T>>::value;
+
+template<typename T>
+concept fixed_serialised_size = has_size_bounds<T> && serialised_size_bounds_v<T>.fixed();
+
+template<typename T>
+concept bounded_serialised_size = has_size_bounds<T> && serialised_size_bounds_v<T>.bounded();
+
+template<fixed_serialised_size T>
+constexpr static std::size_t serialised_size_v = serialised_size_bounds_v<T>.max;
+
+namespace detail {
+
+template<typename T, template<typename> class adaptor>
+constexpr bool is_adaptor_v = false;
+
+template<typename T, template<typename> class adaptor>
+constexpr bool is_adaptor_v<adaptor<T>, adaptor> = true;
+
+template<typename T>
+constexpr bool is_std_array_v = false;
+
+template<typename T, std::size_t N>
+constexpr bool is_std_array_v<std::array<T, N>> = true;
+
+template<typename T>
+constexpr bool is_tagged_variant_v = false;
+
+template<typename tag_type, typename variant_type>
+constexpr bool is_tagged_variant_v<tagged_variant<tag_type, variant_type>> = true;
+
+template<typename T>
+constexpr size_bounds bounds_of();
+
+// Bounds on a variant's tag plus the smallest and largest alternatives
+template<typename tag_type, typename variant_type>
+constexpr size_bounds variant_bounds() {
+	constexpr auto count = std::variant_size_v<variant_type>;
+
+	const auto alternatives = []<std::size_t... indices>(std::index_sequence<indices...>) {
+		return std::array<size_bounds, count> {
+			bounds_of<std::remove_cv_t<std::variant_alternative_t<indices, variant_type>>>()...
+		};
+	}(std::make_index_sequence<count>{});
+
+	size_bounds bounds { unbounded_size, 0 };
+
+	for(const auto& alternative : alternatives) {
+		bounds.min = std::min(bounds.min, alternative.min);
+		bounds.max = std::max(bounds.max, alternative.max);
+	}
+
+	return size_bounds { sizeof(tag_type), sizeof(tag_type) } + bounds;
+}
+
+// Bounds on the bytes written for a container's elements, excluding any prefix
+template<typename T>
+constexpr size_bounds element_bounds() {
+	if constexpr(is_std_array_v<T>) {
+		return bounds_of<typename T::value_type>() * std::tuple_size_v<T>;
+	} else if constexpr(fixed_capacity<T>) {
+		const auto element = bounds_of<typename T::value_type>();
+		return size_bounds { 0, element.max } * T::capacity();
+	} else {
+		return { 0, unbounded_size };
+	}
+}
+
+enum class probe_fill {
+	zero, one, all_set
+};
+
+/*
+ * Stand-in for stream_write_adaptor that tallies the size of each field
+ * rather than writing it. Anything it doesn't understand is treated as
+ * having no upper bound. Arithmetic fields are overwritten with the fill
+ * value as they're visited, as they would be by a read, so that any
+ * fields that depend on them are found.
+ */
+class size_probe final {
+	size_bounds bounds_{};
+	probe_fill fill_;
+
+	template<typename T>
+	constexpr void fill(T& field) {
+		using type = std::remove_cvref_t<T>;
+
+		if constexpr(std::is_const_v<std::remove_reference_t<T>>) {
+			return;
+		} else if constexpr(std::is_same_v<type, bool>) {
+			field = fill_ != probe_fill::zero;
+		} else if constexpr(std::integral<type>) {
+			switch(fill_) {
+				case probe_fill::zero:
+					field = 0;
+					break;
+				case probe_fill::one:
+					field = 1;
+					break;
+				case probe_fill::all_set:
+					field = static_cast<type>(~std::make_unsigned_t<type>(0));
+					break;
+			}
+		} else if constexpr(arithmetic<type>) {
+			field = fill_ == probe_fill::zero? type(0) : type(1);
+		} else if constexpr(std::is_enum_v<type>) {
+			std::underlying_type_t<type> value{};
+			fill(value);
+			field = static_cast<type>(value);
+		} else if constexpr(std::derived_from<type, endian::adaptor_tag_t>) {
+			fill(field.value);
+		}
+	}
+
+	template<typename T>
+	constexpr void add(T&& arg) {
+		fill(arg);
+		bounds_ = bounds_ + bounds_of<std::remove_cvref_t<T>>();
+	}
+
+public:
+	constexpr explicit size_probe(const probe_fill fill)
+		: fill_(fill) {}
+
+	constexpr void operator&(auto&& arg) {
+		add(arg);
+	}
+
+	template<typename ...Ts>
+	constexpr void operator()(Ts&&... args) {
+		(add(args), ...);
+	}
+
+	template<typename T>
+	constexpr void forward(T&& arg) {
+		using type = std::remove_cvref_t<T>;
+
+		if constexpr(arithmetic<type> || std::derived_from<type, endian::adaptor_tag_t>) {
+			add(arg);
+		} else {
+			bounds_ = bounds_ + element_bounds<type>();
+		}
+	}
+
+	template<typename ...Ts>
+	constexpr void forward(Ts&&...) {
+		bounds_ = bounds_ + size_bounds{ 0, unbounded_size };
+	}
+
+	constexpr size_bounds bounds() const {
+		return bounds_;
+	}
+};
+
+template<typename T>
+constexpr size_bounds probe_bounds(const probe_fill fill = probe_fill::zero) {
+	T object{};
+	size_probe probe(fill);
+	object.serialise(probe);
+	return probe.bounds();
+}
+
+// True if the bounds don't depend on the values read into the fields
+template<typename T>
+constexpr bool probe_consistent() {
+	const auto bounds = probe_bounds<T>();
+	return bounds == probe_bounds<T>(probe_fill::one)
+		&& bounds == probe_bounds<T>(probe_fill::all_set);
+}
+
+template<typename T>
+concept size_probeable =
+	std::is_class_v<T>
+	&& requires(T t, size_probe& probe) {
+		{ t.serialise(probe) } -> std::same_as<void>;
+	}
+	&& requires {
+		typename std::bool_constant<probe_consistent<T>()>;
+	}
+	&& probe_consistent<T>();
+
+template<typename T>
+constexpr size_bounds bounds_of() {
+	constexpr size_bounds unknown { 0, unbounded_size };
+	constexpr size_bounds prefix { sizeof(std::uint32_t), sizeof(std::uint32_t) };
+	constexpr size_bounds varint_prefix { 1, (sizeof(std::size_t) * 8 + 6) / 7 };
+
+	if constexpr(arithmetic<T>) {
+		return { sizeof(T), sizeof(T) };
+	} else if constexpr(std::derived_from<T, endian::adaptor_tag_t>) {
+		using value_type = std::remove_cvref_t<decltype(std::declval<T&>().value)>;
+		return { sizeof(value_type), sizeof(value_type) };
+	} else if constexpr(std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+		return prefix + unknown;
+	} else if constexpr(is_fixed_string_v<T>) {
+		return prefix + element_bounds<T>();
+	} else if constexpr(std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+		return { 1, unbounded_size };
+	} else if constexpr(is_adaptor_v<T, prefixed>) {
+		return prefix + element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, prefixed_varint>) {
+		return varint_prefix + element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, raw>) {
+		return element_bounds<std::remove_cvref_t<decltype(T::str)>>();
+	} else if constexpr(is_adaptor_v<T, null_terminated>) {
+		using string_type = std::remove_cvref_t<decltype(T::str)>;
+
+		if constexpr(is_fixed_string_v<string_type>) {
+			return { 1, string_type::capacity() + 1 };
+		} else {
+			return { 1, unbounded_size };
+		}
+	} else if constexpr(is_std_array_v<T>) {
+		return element_bounds<T>();
+	} else if constexpr(is_tagged_variant_v<T>) {
+		using variant_type = std::remove_cvref_t<decltype(T::value)>;
+		return variant_bounds<typename T::tag_type, variant_type>();
+	} else if constexpr(has_size_bounds<T>) {
+		return serialised_size_bounds<T>::value;
+	} else if constexpr(pod<T> && !is_iterable<T> && !requires(T t, size_probe& probe) { t.serialise(probe); }) {
+		// trivial types with a serialise function don't necessarily write every member
+		return { sizeof(T), sizeof(T) };
+	} else {
+		return unknown;
+	}
+}
+
+} // detail
+
+template<arithmetic T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value { sizeof(T), sizeof(T) };
+};
+
+template<variant_like T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value = detail::variant_bounds<std::uint8_t, T>();
+};
+
+template<detail::size_probeable T>
+struct serialised_size_bounds<T> {
+	static constexpr size_bounds value = detail::probe_bounds<T>();
+};
+
+} // hexi
+
+// #include <hexi/stream_adaptors.h>
+
+// #include <hexi/stream_range.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * A single-pass input range that deserialises elements from a stream as the
+ * range is iterated, rather than materialising them into a container.
+ *
+ * Each element is read into the same storage, so a reference obtained
+ * through the iterator is only valid until the iterator is incremented.
+ * Iteration stops early if the stream enters an error state.
+ *
+ * @tparam stream_type The stream to read from.
+ * @tparam T The element type.
+ */
+template<typename stream_type, std::default_initializable T>
+class stream_range final : public std::ranges::view_interface<stream_range<stream_type, T>> {
+	stream_type* stream_ = nullptr;
+	std::size_t remaining_ = 0;
+	bool done_ = false;
+	T value_{};
+
+	void next() {
+		if(remaining_ == 0 || !*stream_) {
+			done_ = true;
+			return;
+		}
+
+		*stream_ >> value_;
+		--remaining_;
+
+		if(!*stream_) {
+			done_ = true;
+		}
+	}
+
+public:
+	class iterator {
+		stream_range* range_ = nullptr;
+
+	public:
+		using value_type      = T;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(stream_range* range) : range_(range) {}
+
+		T& operator*() const {
+			return range_->value_;
+		}
+
+		iterator& operator++() {
+			range_->next();
+			return *this;
+		}
+
+		void operator++(int) {
+			++*this;
+		}
+
+		bool operator==(std::default_sentinel_t) const {
+			return range_->done_;
+		}
+	};
+
+	stream_range() = default;
+
+	stream_range(stream_type& stream, const std::size_t count)
+		: stream_(&stream), remaining_(count) {}
+
+	/**
+	 * @brief Reads the first element and returns an iterator to it.
+	 *
+	 * @note As this is an input range, begin() must only be called once.
+	 */
+	iterator begin() {
+		next();
+		return iterator(this);
+	}
+
+	std::default_sentinel_t end() const {
+		return {};
+	}
+};
+
+} // hexi
+
+// #include <hexi/stream_slice.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/shared.h>
+
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Read-only view over the next length bytes of another buffer, used as the
+ * buffer for streams created with binary_stream::slice. Reads go straight
+ * to the underlying buffer, so no data is copied, and views and spans can
+ * be taken from the slice if the underlying buffer is contiguous.
+ *
+ * Slices of slices refer to the same underlying buffer and report how much
+ * they consume to their parent, so nested limits compose.
+ *
+ * @tparam buf_type The underlying buffer type.
+ */
+template<typename buf_type>
+class slice_buffer final {
+	buf_type& buffer_;
+	slice_buffer* parent_;
+	typename buf_type::size_type remaining_;
+
+	void consume(const typename buf_type::size_type length) {
+		remaining_ -= length;
+
+		if(parent_) {
+			parent_->consume(length);
+		}
+	}
+
+public:
+	using base_type   = buf_type;
+	using size_type   = typename buf_type::size_type;
+	using offset_type = typename buf_type::offset_type;
+	using value_type  = typename buf_type::value_type;
+	using contiguous  = typename buf_type::contiguous;
+	using seeking     = unsupported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+	/**
+	 * @param buffer The underlying buffer.
+	 * @param length The number of bytes the slice covers. This must not
+	 * exceed the amount of data in the underlying buffer.
+	 * @param parent The slice this slice was taken from, if any.
+	 */
+	slice_buffer(buf_type& buffer, const size_type length, slice_buffer* parent = nullptr)
+		: buffer_(buffer),
+		  parent_(parent),
+		  remaining_(length) {}
+
+	slice_buffer(const slice_buffer&) = delete;
+	slice_buffer& operator=(const slice_buffer&) = delete;
+
+	void read(void* destination, const size_type length) {
+		buffer_.read(destination, length);
+		consume(length);
+	}
+
+	void skip(const size_type length) {
+		buffer_.skip(length);
+		consume(length);
+	}
+
+	/**
+	 * @brief Skips any data in the slice that hasn't been read.
+	 */
+	void finish() {
+		if(remaining_) {
+			skip(remaining_);
+		}
+	}
+
+	size_type find_first_of(const value_type value) const {
+		const auto pos = buffer_.find_first_of(value);
+		return pos < remaining_? pos : npos;
+	}
+
+	auto read_ptr() requires requires(buf_type& buffer) { buffer.read_ptr(); } {
+		return buffer_.read_ptr();
+	}
+
+	auto read_ptr() const requires requires(const buf_type& buffer) { buffer.read_ptr(); } {
+		return buffer_.read_ptr();
+	}
+
+	size_type size() const {
+		return std::min<size_type>(remaining_, buffer_.size());
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size() == 0;
+	}
+
+	buf_type& base() {
+		return buffer_;
+	}
+};
+
+namespace detail {
+
+template<typename buf_type>
+struct slice_base {
+	using type = buf_type;
+};
+
+template<typename buf_type>
+struct slice_base<slice_buffer<buf_type>> {
+	using type = buf_type;
+};
+
+} // detail
+
+/**
+ * Owns a child stream created by binary_stream::slice. When the slice is
+ * destroyed, any of its data that wasn't read is skipped, so the parent
+ * always advances by exactly the slice's length, regardless of how much
+ * the child read or whether it encountered an error.
+ *
+ * The parent stream must not be read from while the slice is alive.
+ *
+ * @tparam stream_type The child stream type.
+ */
+template<typename stream_type>
+class stream_slice final {
+	using buffer_type = typename stream_type::buffer_type;
+	using size_type   = typename stream_type::size_type;
+
+	buffer_type buffer_;
+	stream_type stream_;
+
+public:
+	stream_slice(typename buffer_type::base_type& buffer, const size_type length,
+	             buffer_type* parent = nullptr, const stream_state state = stream_state::ok)
+		: buffer_(buffer, length, parent),
+		  stream_(buffer_) {
+		stream_.state_ = state;
+	}
+
+	stream_slice(const stream_slice&) = delete;
+	stream_slice& operator=(const stream_slice&) = delete;
+
+	~stream_slice() {
+		buffer_.finish();
+	}
+
+	template<typename T>
+	stream_slice& operator>>(T&& data) {
+		stream_ >> std::forward<T>(data);
+		return *this;
+	}
+
+	stream_type& stream() {
+		return stream_;
+	}
+
+	stream_type& operator*() {
+		return stream_;
+	}
+
+	stream_type* operator->() {
+		return &stream_;
+	}
+
+	/**
+	 * @return The number of bytes in the slice that haven't been read.
+	 */
+	size_type remaining() const {
+		return buffer_.size();
+	}
+
+	operator bool() const {
+		return stream_.good();
+	}
+};
+
+} // hexi
+
+// #include <hexi/stream_transaction.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/shared.h>
+
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <cstddef>
+#include <cstring>
+
+namespace hexi {
+
+/**
+ * Buffers that can be read from an offset without consuming any data,
+ * either directly (contiguous buffers) or via copy and find_first_of
+ * overloads that take an offset (e.g. dynamic_buffer).
+ */
+template<typename buf_type>
+concept transactional =
+	(std::is_same_v<typename buf_type::contiguous, is_contiguous>
+		&& requires(buf_type& buffer) { buffer.read_ptr(); })
+	|| requires(const buf_type& buffer, void* dest, typename buf_type::size_type size,
+	            typename buf_type::value_type value) {
+		buffer.copy(dest, size, size);
+		{ buffer.find_first_of(value, size) } -> std::convertible_to<typename buf_type::size_type>;
+	};
+
+/**
+ * Non-contiguous buffers that can resume copies and searches from a saved
+ * position, rather than locating an offset from the read cursor each time.
+ */
+template<typename buf_type>
+concept positionable = requires(const buf_type& buffer, void* dest,
+                                typename buf_type::read_position& position,
+                                typename buf_type::size_type size,
+                                typename buf_type::value_type value) {
+	buffer.copy(dest, size, position);
+	buffer.advance(position, size);
+	{ buffer.find_first_of(value, position) } -> std::convertible_to<typename buf_type::size_type>;
+};
+
+namespace detail {
+
+template<typename buf_type>
+struct position_type {
+	using type = std::monostate;
+};
+
+template<positionable buf_type>
+struct position_type<buf_type> {
+	using type = typename buf_type::read_position;
+};
+
+} // detail
+
+/**
+ * Non-destructive cursor over another buffer, used as the buffer for
+ * streams created with binary_stream::begin_transaction. Reads advance the
+ * cursor but leave the underlying buffer untouched until the transaction
+ * is committed.
+ *
+ * @tparam buf_type The underlying buffer type.
+ */
+template<transactional buf_type>
+class transaction_buffer final {
+	static constexpr bool is_contiguous_buffer
+		= std::is_same_v<typename buf_type::contiguous, is_contiguous>;
+
+	buf_type& buffer_;
+	typename buf_type::size_type offset_ = 0;
+	[[no_unique_address]] typename detail::position_type<buf_type>::type position_{};
+
+public:
+	using base_type   = buf_type;
+	using size_type   = typename buf_type::size_type;
+	using offset_type = typename buf_type::offset_type;
+	using value_type  = typename buf_type::value_type;
+	using contiguous  = typename buf_type::contiguous;
+	using seeking     = unsupported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+	/**
+	 * @param buffer The underlying buffer.
+	 */
+	explicit transaction_buffer(buf_type& buffer)
+		: buffer_(buffer) {}
+
+	transaction_buffer(const transaction_buffer&) = delete;
+	transaction_buffer& operator=(const transaction_buffer&) = delete;
+
+	void read(void* destination, const size_type length) {
+		if constexpr(is_contiguous_buffer) {
+			std::memcpy(destination, read_ptr(), length);
+		} else if constexpr(positionable<buf_type>) {
+			buffer_.copy(destination, length, position_);
+		} else {
+			buffer_.copy(destination, length, offset_);
+		}
+
+		offset_ += length;
+	}
+
+	void skip(const size_type length) {
+		if constexpr(positionable<buf_type>) {
+			buffer_.advance(position_, length);
+		}
+
+		offset_ += length;
+	}
+
+	size_type find_first_of(const value_type value) const {
+		if constexpr(is_contiguous_buffer) {
+			const auto data = reinterpret_cast<const value_type*>(read_ptr());
+			const auto end = data + size();
+			const auto it = std::find(data, end, value);
+			return it == end? npos : static_cast<size_type>(it - data);
+		} else if constexpr(positionable<buf_type>) {
+			const auto pos = buffer_.find_first_of(value, position_);
+			return (pos == npos || pos >= size())? npos : pos;
+		} else {
+			const auto pos = buffer_.find_first_of(value, offset_);
+			return (pos == npos || pos - offset_ >= size())? npos : pos - offset_;
+		}
+	}
+
+	auto read_ptr() requires is_contiguous_buffer {
+		return buffer_.read_ptr() + offset_;
+	}
+
+	auto read_ptr() const requires is_contiguous_buffer {
+		return buffer_.read_ptr() + offset_;
+	}
+
+	size_type size() const {
+		return buffer_.size() - offset_;
+	}
+
+	[[nodiscard]]
+	bool empty() const {
+		return size() == 0;
+	}
+
+	/**
+	 * @return The number of bytes read through the cursor.
+	 */
+	size_type offset() const {
+		return offset_;
+	}
+
+	/**
+	 * @brief Moves the cursor back to the start of the underlying buffer.
+	 */
+	void rewind() {
+		offset_ = 0;
+		position_ = {};
+	}
+
+	/**
+	 * @brief Consumes everything read through the cursor from the
+	 * underlying buffer.
+	 */
+	void consume() {
+		buffer_.skip(offset_);
+		offset_ = 0;
+		position_ = {};
+	}
+};
+
+/**
+ * Owns a child stream created by binary_stream::begin_transaction. Reads
+ * through the child don't consume anything from the parent's buffer until
+ * commit is called, so a message that turns out to be incomplete can be
+ * abandoned, leaving the buffer as it was, and parsed again once more data
+ * has arrived. Destroying the transaction without committing it is a
+ * rollback.
+ *
+ * The parent stream must not be used while the transaction is alive.
+ *
+ * @tparam stream_type The child stream type.
+ * @tparam parent_type The parent stream type.
+ */
+template<typename stream_type, typename parent_type>
+class stream_transaction final {
+	using buffer_type = typename stream_type::buffer_type;
+	using size_type   = typename stream_type::size_type;
+
+	parent_type& parent_;
+	buffer_type buffer_;
+	stream_type stream_;
+	size_type committed_ = 0;
+
+public:
+	/**
+	 * The child stream takes on the parent's read limit and total bytes
+	 * read, so limits are enforced exactly as they would be by the parent.
+	 */
+	stream_transaction(parent_type& parent, typename buffer_type::base_type& buffer,
+	                   const size_type read_limit, const size_type total_read,
+	                   const stream_state state = stream_state::ok)
+		: parent_(parent),
+		  buffer_(buffer),
+		  stream_(buffer_, read_limit),
+		  committed_(total_read) {
+		stream_.total_read_ = total_read;
+		stream_.state_ = state;
+	}
+
+	stream_transaction(const stream_transaction&) = delete;
+	stream_transaction& operator=(const stream_transaction&) = delete;
+
+	template<typename T>
+	stream_transaction& operator>>(T&& data) {
+		stream_ >> std::forward<T>(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Consumes the data read so far from the parent stream. The
+	 * transaction can continue to be used afterwards.
+	 */
+	void commit() {
+		parent_.total_read_ += buffer_.offset();
+		committed_ = stream_.total_read_;
+		buffer_.consume();
+	}
+
+	/**
+	 * @brief Discards the reads made since the last commit, allowing the
+	 * data to be read again, and clears any error state.
+	 */
+	void rollback() {
+		stream_.total_read_ = committed_;
+		stream_.state_ = stream_state::ok;
+		buffer_.rewind();
+	}
+
+	stream_type& stream() {
+		return stream_;
+	}
+
+	stream_type& operator*() {
+		return stream_;
+	}
+
+	stream_type* operator->() {
+		return &stream_;
+	}
+
+	/**
+	 * @return The number of bytes read since the last commit.
+	 */
+	size_type pending() const {
+		return buffer_.offset();
+	}
+
+	operator bool() const {
+		return stream_.good();
+	}
+};
+
+} // hexi
+
+// #include <hexi/utf8.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/detail/simd.h>
+
+#include <array>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+/**
+ * Validates that a string is well-formed UTF-8 once it has been
+ * deserialised, e.g. stream >> hexi::utf8(hexi::prefixed(str)). Wraps any
+ * string or string adaptor that reads into a std::string, std::string_view
+ * or fixed_string. Invalid strings result in stream_state::invalid_utf8_err.
+ *
+ * Overlong encodings, surrogates and code points above U+10FFFF are
+ * rejected.
+ */
+template<typename T>
+struct utf8_validated {
+	T value;
+};
+
+template<typename T>
+constexpr auto utf8(T&& value) {
+	return utf8_validated<T> { std::forward<T>(value) };
+}
+
+namespace detail {
+
+template<typename T>
+constexpr std::string_view utf8_view(const T& value) {
+	if constexpr(requires { value.str; }) {
+		return { value.str.data(), value.str.size() };
+	} else {
+		return { value.data(), value.size() };
+	}
+}
+
+/*
+ * Returns the length of the well-formed sequence starting at the offset,
+ * or zero if it's invalid or truncated.
+ */
+inline std::size_t utf8_sequence_length(const std::uint8_t* data, const std::size_t size,
+                                        const std::size_t offset) {
+	const auto lead = data[offset];
+
+	if(lead < 0x80) {
+		return 1;
+	}
+
+	std::size_t length = 0;
+	std::uint8_t min = 0x80, max = 0xbf;
+
+	if(lead >= 0xc2 && lead <= 0xdf) {
+		length = 2;
+	} else if(lead >= 0xe0 && lead <= 0xef) {
+		length = 3;
+		min = lead == 0xe0? 0xa0 : min; // overlong
+		max = lead == 0xed? 0x9f : max; // surrogates
+	} else if(lead >= 0xf0 && lead <= 0xf4) {
+		length = 4;
+		min = lead == 0xf0? 0x90 : min; // overlong
+		max = lead == 0xf4? 0x8f : max; // above U+10FFFF
+	} else {
+		return 0;
+	}
+
+	if(size - offset < length || data[offset + 1] < min || data[offset + 1] > max) {
+		return 0;
+	}
+
+	for(std::size_t i = 2; i < length; ++i) {
+		if((data[offset + i] & 0xc0) != 0x80) {
+			return 0;
+		}
+	}
+
+	return length;
+}
+
+/*
+ * Returns the offset of the first invalid sequence, or the size if there
+ * isn't one.
+ */
+inline std::size_t utf8_error_offset(const std::string_view string, std::size_t offset = 0) {
+	const auto data = reinterpret_cast<const std::uint8_t*>(string.data());
+
+	while(offset < string.size()) {
+		const auto length = utf8_sequence_length(data, string.size(), offset);
+
+		if(!length) {
+			return offset;
+		}
+
+		offset += length;
+	}
+
+	return string.size();
+}
+
+#ifdef HEXI_HAS_SSSE3
+/*
+ * Lookup table based validation, after Keiser and Lemire, "Validating
+ * UTF-8 In Less Than One Instruction Per Byte". Each byte is classified
+ * by its high nibble and the high and low nibbles of the byte before it,
+ * with the three lookups being ANDed together to find any errors in two
+ * byte sequences. Three and four byte sequences are checked by requiring
+ * continuation bytes where the bytes two and three places back are leads.
+ */
+class utf8_checker final {
+	static constexpr std::uint8_t too_short      = 1 << 0;
+	static constexpr std::uint8_t too_long       = 1 << 1;
+	static constexpr std::uint8_t overlong_3     = 1 << 2;
+	static constexpr std::uint8_t too_large      = 1 << 3;
+	static constexpr std::uint8_t surrogate      = 1 << 4;
+	static constexpr std::uint8_t overlong_2     = 1 << 5;
+	static constexpr std::uint8_t too_large_1000 = 1 << 6;
+	static constexpr std::uint8_t overlong_4     = 1 << 6;
+	static constexpr std::uint8_t two_conts      = 1 << 7;
+	static constexpr std::uint8_t carry          = too_short | too_long | two_conts;
+
+	__m128i error_ = _mm_setzero_si128();
+	__m128i prev_input_ = _mm_setzero_si128();
+	__m128i prev_incomplete_ = _mm_setzero_si128();
+
+	static __m128i table(const std::array<std::uint8_t, 16>& values) {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+	}
+
+	static __m128i high_nibbles(const __m128i input) {
+		return _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0f));
+	}
+
+	__m128i special_cases(const __m128i input, const __m128i prev1) const {
+		static const auto byte_1_high_table = table({
+			too_long, too_long, too_long, too_long,
+			too_long, too_long, too_long, too_long,
+			two_conts, two_conts, two_conts, two_conts,
+			too_short | overlong_2,
+			too_short,
+			too_short | overlong_3 | surrogate,
+			too_short | too_large | too_large_1000 | overlong_4
+		});
+
+		static const auto byte_1_low_table = table({
+			carry | overlong_3 | overlong_2 | overlong_4,
+			carry | overlong_2,
+			carry,
+			carry,
+			carry | too_large,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000 | surrogate,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000
+		});
+
+		static const auto byte_2_high_table = table({
+			too_short, too_short, too_short, too_short,
+			too_short, too_short, too_short, too_short,
+			too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+			too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			too_long | overlong_2 | two_conts | surrogate  | too_large,
+			too_long | overlong_2 | two_conts | surrogate  | too_large,
+			too_short, too_short, too_short, too_short
+		});
+
+		const auto byte_1_high = _mm_shuffle_epi8(byte_1_high_table, high_nibbles(prev1));
+		const auto byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, _mm_set1_epi8(0x0f)));
+		const auto byte_2_high = _mm_shuffle_epi8(byte_2_high_table, high_nibbles(input));
+		return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+	}
+
+	void check_block(const __m128i input) {
+		const auto prev1 = _mm_alignr_epi8(input, prev_input_, 15);
+		const auto prev2 = _mm_alignr_epi8(input, prev_input_, 14);
+		const auto prev3 = _mm_alignr_epi8(input, prev_input_, 13);
+
+		// only bytes following 111_____ or 1111____ leads end up with the top bit set
+		const auto is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+		const auto is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+		const auto must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte),
+		                                                _mm_set1_epi8(static_cast<char>(0x80)));
+
+		const auto errors = _mm_xor_si128(must_be_continuation, special_cases(input, prev1));
+		error_ = _mm_or_si128(error_, errors);
+
+		// leads in the last three bytes that need more bytes than remain
+		const auto max_values = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+		prev_incomplete_ = _mm_subs_epu8(input, max_values);
+	}
+
+public:
+	void next(const __m128i input) {
+		if(!_mm_movemask_epi8(input)) {
+			// all ASCII, so only a sequence left incomplete by the previous block can fail
+			error_ = _mm_or_si128(error_, prev_incomplete_);
+			prev_incomplete_ = _mm_setzero_si128();
+			prev_input_ = input;
+			return;
+		}
+
+		check_block(input);
+		prev_input_ = input;
+	}
+
+	bool valid() const {
+		const auto errors = _mm_or_si128(error_, prev_incomplete_);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) == 0xffff;
+	}
+};
+#endif
+
+} // detail
+
+/**
+ * @brief Checks whether a string is well-formed UTF-8. Uses SSSE3 lookup
+ * tables to check 16 bytes at a time where available, otherwise skips
+ * over runs of ASCII 16 bytes at a time with SSE2 and checks the rest
+ * one sequence at a time.
+ *
+ * @param string The string to validate.
+ *
+ * @return True if the string is valid.
+ */
+inline bool is_valid_utf8(const std::string_view string) {
+	const auto data = reinterpret_cast<const std::uint8_t*>(string.data());
+	const auto size = string.size();
+	std::size_t offset = 0;
+
+#if defined(HEXI_HAS_SSSE3)
+	detail::utf8_checker checker;
+
+	for(; offset + 16 <= size; offset += 16) {
+		checker.next(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset)));
+	}
+
+	if(offset < size) {
+		// padding with ASCII catches any sequence truncated by the end
+		std::array<std::uint8_t, 16> tail{};
+		std::memcpy(tail.data(), data + offset, size - offset);
+		checker.next(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail.data())));
+	}
+
+	return checker.valid();
+#else
+#ifdef HEXI_HAS_SSE2
+	while(offset + 16 <= size) {
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+
+		if(!_mm_movemask_epi8(block)) {
+			offset += 16;
+			continue;
+		}
+
+		// check the block's sequences, including any that cross into the next
+		for(const auto end = offset + 16; offset < end;) {
+			const auto length = detail::utf8_sequence_length(data, size, offset);
+
+			if(!length) {
+				return false;
+			}
+
+			offset += length;
+		}
+	}
+#endif
+
+	return detail::utf8_error_offset(string, offset) == size;
+#endif
+}
+
+} // hexi
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+using namespace detail;
+
+#define STREAM_READ_BOUNDS_ENFORCE(read_size, ret_var)            \
+	if(state_ != stream_state::ok) [[unlikely]] {                 \
+		return ret_var;                                           \
+	}                                                             \
+                                                                  \
+	enforce_read_bounds(read_size);                               \
+	                                                              \
+	if constexpr(std::is_same_v<exceptions, no_throw_t>) {        \
+		if(state_ != stream_state::ok) [[unlikely]] {             \
+			return ret_var;                                       \
+		}                                                         \
+	}
+
+#define SAFE_READ(dest, read_size, ret_var)                       \
+	STREAM_READ_BOUNDS_ENFORCE(read_size, ret_var)                \
+	buffer_.read(dest, read_size);
+
+namespace detail {
+
+/*
+ * Non-owning view over a buffer's free space, used to serialise objects with
+ * a known upper size bound straight into the destination once the capacity
+ * has been checked. Writes past the end are dropped and flagged, rather than
+ * checked against the underlying buffer, so the caller can discard the
+ * partial write. The bounds come from probing serialise with a handful of
+ * values rather than from a proof, so the per-write check against the
+ * window stays; it's a single pointer comparison.
+ */
+template<byte_type storage_type>
+class write_window final {
+	storage_type* const begin_;
+	storage_type* const end_;
+	storage_type* pos_;
+	bool overflow_ = false;
+
+public:
+	using size_type   = std::size_t;
+	using offset_type = std::size_t;
+	using value_type  = storage_type;
+	using contiguous  = is_contiguous;
+	using seeking     = unsupported;
+
+	write_window(storage_type* begin, const size_type length)
+		: begin_(begin),
+		  end_(begin + length),
+		  pos_(begin) {}
+
+	void write(const auto& source) {
+		write(&source, sizeof(source));
+	}
+
+	void write(const void* source, const size_type length) {
+		if(length > static_cast<size_type>(end_ - pos_)) [[unlikely]] {
+			overflow_ = true;
+			return;
+		}
+
+		std::memcpy(pos_, source, length);
+		pos_ += length;
+	}
+
+	size_type written() const {
+		return static_cast<size_type>(pos_ - begin_);
+	}
+
+	bool overflow() const {
+		return overflow_;
+	}
+
+	constexpr size_type size() const {
+		return 0;
+	}
+
+	[[nodiscard]]
+	constexpr bool empty() const {
+		return true;
+	}
+};
+
+} // detail
+
+template<
+	byte_oriented buf_type,
+	std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t
+>
+class binary_stream final {
+public:
+	using size_type          = typename buf_type::size_type;
+	using offset_type        = typename buf_type::offset_type;
+	using seeking            = typename buf_type::seeking;
+	using value_type         = typename buf_type::value_type;
+	using contiguous_type    = typename buf_type::contiguous;
+	using buffer_type        = buf_type;
+	
+	static constexpr endianness byte_order{};
+
+private:
+	using cond_size_type = std::conditional_t<writeable<buf_type>, size_type, std::monostate>;
+
+	buf_type& buffer_;
+	[[no_unique_address]] cond_size_type total_write_{};
+	size_type total_read_ = 0;
+	size_type allocated_ = 0;
+	size_type alloc_limit_ = 0;
+	stream_state state_ = stream_state::ok;
+	bool reuse_storage_ = false;
+	const size_type read_limit_;
+
+	template<typename> friend class stream_slice;
+	template<typename, typename> friend class stream_transaction;
+
+	inline bool check_read_bounds(const size_type read_size) {
+		if(read_size > buffer_.size()) [[unlikely]] {
+			state_ = stream_state::buff_limit_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(buffer_underrun(read_size, total_read_, buffer_.size()));
+			}
+
+			return false;
+		}
+
+		if(read_limit_) {
+			const auto max_read_remaining = read_limit_ - total_read_;
+
+			if(read_size > max_read_remaining) [[unlikely]] {
+				state_ = stream_state::read_limit_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(stream_read_limit(read_size, total_read_, read_limit_));
+				}
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline void enforce_read_bounds(const size_type read_size) {
+		if(check_read_bounds(read_size)) [[likely]] {
+			total_read_ += read_size;
+		}
+	}
+
+	/*
+	 * Rejects element counts that the remaining data couldn't possibly
+	 * satisfy, given the minimum serialised size of each element, before
+	 * anything is allocated for them.
+	 */
+	template<typename count_type>
+	bool check_element_count(const count_type count, const std::size_t min_size) {
+		if(!min_size || !std::cmp_greater(count, read_max() / min_size)) [[likely]] {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		const auto required = std::cmp_greater(count, max_size / min_size)?
+			max_size : static_cast<size_type>(count * min_size);
+
+		return check_read_bounds(required);
+	}
+
+	/*
+	 * Accounts for an allocation of count elements against the stream's
+	 * allocation limit, if one was set. Charged before the read's bounds
+	 * are enforced, so that a rejected allocation doesn't count towards
+	 * the read limit.
+	 */
+	template<typename count_type>
+	bool charge_allocation(const count_type count, const std::size_t element_size) {
+		if(state_ != stream_state::ok) [[unlikely]] {
+			return false;
+		}
+
+		if(!alloc_limit_) {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		const auto bytes = std::cmp_greater(count, max_size / element_size)?
+			max_size : static_cast<size_type>(count * element_size);
+
+		if(allocated_ > alloc_limit_ || bytes > alloc_limit_ - allocated_) [[unlikely]] {
+			state_ = stream_state::alloc_limit_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(allocation_limit_exceeded(bytes, allocated_, alloc_limit_));
+			}
+
+			return false;
+		}
+
+		allocated_ += bytes;
+		return true;
+	}
+
+	/*
+	 * If the object's maximum serialised size fits into the buffer's free
+	 * space, serialise it directly into that space in one go rather than
+	 * going through the buffer for each field. Returns false if the object
+	 * wasn't written, either because it wasn't eligible or because it
+	 * wrote more than its bounds allowed for.
+	 */
+	template<typename T>
+	bool serialise_direct(T& object) {
+		constexpr auto bounds = serialised_size_bounds_v<T>;
+
+		if constexpr(bounds.bounded() && direct_writeable<buf_type>) {
+			if(state_ != stream_state::ok || buffer_.free() < bounds.max) {
+				return false;
+			}
+
+			using window_type = std::remove_pointer_t<decltype(buffer_.write_ptr())>;
+			write_window<window_type> window(buffer_.write_ptr(), bounds.max);
+			binary_stream<write_window<window_type>, no_throw_t, endianness> stream(window);
+			stream_write_adaptor adaptor(stream);
+			object.serialise(adaptor);
+
+			if(window.overflow()) [[unlikely]] {
+				return false;
+			}
+
+			buffer_.advance_write(static_cast<size_type>(window.written()));
+			total_write_ += static_cast<size_type>(window.written());
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename T>
+	constexpr void advance_write(T&& arg) {
+		total_write_ += sizeof(T);
+	}
+
+	template<typename T, typename U>
+	constexpr void advance_write(T&&, U&& size) {
+		total_write_ += size;
+	}
+
+	template<typename... Ts>
+	constexpr void write(Ts&&... args) {
+		HEXI_TRY {
+			if(state_ == stream_state::ok) [[likely]] {
+				buffer_.write(std::forward<Ts>(args)...);
+				advance_write(std::forward<Ts>(args)...);                            
+			}
+		} HEXI_CATCH(...) {
+			state_ = stream_state::buff_write_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW();
+			}
+		}
+	}
+
+	template<typename container_type>
+	constexpr void write_container(container_type& container) {
+		using cvalue_type = std::ranges::range_value_t<container_type>;
+
+		if constexpr(memcpy_write<container_type, binary_stream>) {
+			if consteval {
+				for(auto& element : container) {
+					write(element);
+				}
+			} else {
+				const auto bytes = std::ranges::size(container) * sizeof(cvalue_type);
+				write(std::ranges::data(container), static_cast<size_type>(bytes));
+			}
+		} else {
+			// elements may be prvalues when writing views
+			for(auto&& element : container) {
+				*this << element;
+			}
+		}
+	}
+
+	template<typename container_type, typename count_type>
+	void read_container(container_type& container, const count_type count) {
+		using cvalue_type = typename container_type::value_type;
+		count_type reused = 0;
+
+		if constexpr(fixed_capacity<container_type>) {
+			if(count > container_type::capacity()) [[unlikely]] {
+				state_ = stream_state::capacity_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(capacity_exceeded(count, container_type::capacity()));
+				}
+
+				return;
+			}
+		}
+
+		if(!check_element_count(count, bounds_of<cvalue_type>().min)) [[unlikely]] {
+			return;
+		}
+
+		if constexpr(!fixed_capacity<container_type>) {
+			if(!charge_allocation(count, sizeof(cvalue_type))) [[unlikely]] {
+				return;
+			}
+		}
+
+		if constexpr(!memcpy_read<container_type, binary_stream>) {
+			if(reuse_storage_) {
+				reused = overwrite_elements(container, count);
+			} else {
+				container.clear();
+			}
+		}
+
+		if constexpr(has_reserve<container_type>) {
+			container.reserve(count);
+		}
+
+		if constexpr(memcpy_read<container_type, binary_stream>) {
+			container.resize(count);
+
+			const auto bytes = static_cast<size_type>(count * sizeof(cvalue_type));
+			SAFE_READ(container.data(), bytes, void());
+		} else {
+			for(count_type i = reused; i < count; ++i) {
+				cvalue_type value;
+				*this >> value;
+				container.emplace_back(std::move(value));
+			}
+		}
+	}
+
+	/*
+	 * Deserialises into the container's existing elements so that any
+	 * storage they own (e.g. a string's capacity) is reused, then removes
+	 * any elements beyond the count. Returns the number of elements read.
+	 */
+	template<typename container_type, typename count_type>
+	count_type overwrite_elements(container_type& container, const count_type count) {
+		using reference = std::ranges::range_reference_t<container_type>;
+
+		if constexpr(std::is_lvalue_reference_v<reference>) {
+			count_type reused = 0;
+			auto it = container.begin();
+
+			for(; it != container.end() && reused < count && state_ == stream_state::ok; ++it) {
+				*this >> *it;
+				++reused;
+			}
+
+			container.erase(it, container.end());
+			return reused;
+		} else {
+			container.clear();
+			return 0;
+		}
+	}
+
+	template<std::size_t index, typename variant_type>
+	static void read_alternative(binary_stream& stream, variant_type& variant) {
+		// reuse the existing alternative if it's already active
+		if(variant.index() != index) {
+			variant.template emplace<index>();
+		}
+
+		stream >> std::get<index>(variant);
+	}
+
+	template<typename variant_type>
+	static constexpr auto make_variant_decoders() {
+		using decoder = void(*)(binary_stream&, variant_type&);
+		constexpr auto count = std::variant_size_v<variant_type>;
+
+		return []<std::size_t... indices>(std::index_sequence<indices...>) {
+			return std::array<decoder, count> {
+				&read_alternative<indices, variant_type>...
+			};
+		}(std::make_index_sequence<count>{});
+	}
+
+	/*
+	 * The quantising adaptors take their number of bits at runtime and
+	 * encoding with a number outside of the supported range is undefined,
+	 * so it's checked before anything is encoded or decoded.
+	 */
+	bool check_bit_width(const unsigned int bits, const unsigned int min_bits,
+	                     const unsigned int max_bits) {
+		if(bits >= min_bits && bits <= max_bits) [[likely]] {
+			return true;
+		}
+
+		state_ = stream_state::invalid_bit_width_err;
+
+		if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+			HEXI_THROW(invalid_bit_width(bits, max_bits));
+		}
+
+		return false;
+	}
+
+	/*
+	 * Encodes the values a chunk at a time and writes each chunk of words
+	 * out in one go, with the stream's byte order.
+	 */
+	template<std::unsigned_integral word_type, typename T, typename encode_func>
+	void write_encoded(std::span<T> values, encode_func&& encode) {
+		std::array<word_type, quantise_chunk_size> words;
+
+		for(std::size_t offset = 0; offset < values.size(); offset += words.size()) {
+			const auto in = values.subspan(offset, std::min(words.size(), values.size() - offset));
+			const auto out = std::span(words).first(in.size());
+			encode(in, out);
+
+			for(auto& word : out) {
+				word = endian::storage_in(word, byte_order);
+			}
+
+			write(out.data(), static_cast<size_type>(out.size_bytes()));
+		}
+	}
+
+	/*
+	 * Reads the encoded values a chunk at a time, converting each chunk of
+	 * words from the stream's byte order before decoding them.
+	 */
+	template<std::unsigned_integral word_type, typename T, typename decode_func>
+	void read_encoded(std::span<T> values, decode_func&& decode) {
+		std::array<word_type, quantise_chunk_size> words;
+
+		for(std::size_t offset = 0; offset < values.size(); offset += words.size()) {
+			const auto out = values.subspan(offset, std::min(words.size(), values.size() - offset));
+			const auto in = std::span(words).first(out.size());
+			SAFE_READ(in.data(), static_cast<size_type>(in.size_bytes()), void());
+
+			for(auto& word : in) {
+				endian::storage_out(word, byte_order);
+			}
+
+			decode(std::span<const word_type>(in), out);
+		}
+	}
+
+public:
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit = 0)
+		: buffer_(source),
+		  read_limit_(read_limit) {};
+
+	constexpr explicit binary_stream(buf_type& source, exceptions)
+		: binary_stream(source, 0) {}
+
+	constexpr explicit binary_stream(buf_type& source, endianness)
+		: binary_stream(source, 0) {}
+
+	constexpr explicit binary_stream(buf_type& source, exceptions, endianness)
+		: binary_stream(source, 0) {}
+
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, exceptions)
+		: binary_stream(source, read_limit) {}
+
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, endianness)
+		: binary_stream(source, read_limit) {}
+
+	constexpr explicit binary_stream(buf_type& source, size_type read_limit, exceptions, endianness)
+		: binary_stream(source, read_limit) {}
+
+	constexpr binary_stream(binary_stream&& rhs) noexcept
+		: buffer_(rhs.buffer_), 
+		  total_write_(rhs.total_write_),
+		  total_read_(rhs.total_read_),
+		  allocated_(rhs.allocated_),
+		  alloc_limit_(rhs.alloc_limit_),
+		  state_(rhs.state_),
+		  reuse_storage_(rhs.reuse_storage_),
+		  read_limit_(rhs.read_limit_) {
+		rhs.total_read_ = static_cast<size_type>(-1);
+		rhs.state_ = stream_state::invalid_stream;
+	}
+
+	binary_stream& operator=(binary_stream&&) = delete;
+	binary_stream& operator=(binary_stream&) = delete;
+	binary_stream(binary_stream&) = delete;
+
+	/*** Write ***/
+
+	/**
+	 * @brief Serialises an object that provides a serialise function:
+	 * void serialise(auto& stream);
+	 * 
+	 * @param object The object to be serialised.
+	 * 
+	 * @note If the object's serialised size bounds are known at compile-time,
+	 * the buffer's capacity is checked once up-front. If the upper bound fits,
+	 * the object is written without per-field overflow checks against the buffer.
+	 */
+	constexpr void serialise(auto&& object) requires writeable<buf_type> {
+		using object_type = std::remove_cvref_t<decltype(object)>;
+
+		if constexpr(has_size_bounds<object_type>) {
+			constexpr auto min_size = serialised_size_bounds_v<object_type>.min;
+
+			if constexpr(fixed_capacity<buf_type>) {
+				if(state_ == stream_state::ok && buffer_.free() < min_size) [[unlikely]] {
+					state_ = stream_state::buff_write_err;
+
+					if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+						HEXI_THROW(buffer_overflow(min_size, total_write_, buffer_.free()));
+					}
+
+					return;
+				}
+			}
+
+			if !consteval {
+				if(serialise_direct(object)) {
+					return;
+				}
+			}
+		}
+
+		stream_write_adaptor adaptor(*this);
+		object.serialise(adaptor);
+	}
+
+	/**
+	 * @brief Serialises an object that provides a serialise function:
+	 * void serialise(auto& stream);
+	 * 
+	 * @param data The object to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires has_serialise<T, binary_stream>
+	constexpr binary_stream& operator<<(T& data) requires writeable<buf_type> {
+		serialise(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises an object that provides a serialise function:
+	 * auto& operator<<(auto& stream);
+	 * 
+	 * @param data The object to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const has_shl_override<binary_stream> auto& data)
+	requires writeable<buf_type> {
+		return *this << data;
+	}
+
+	/**
+	 * @brief Serialises an arithmetic type with the requested byte order.
+	 * 
+	 * @param adaptor An endian adaptor.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::derived_from<endian::adaptor_tag_t> endian_func>
+	constexpr binary_stream& operator<<(endian_func adaptor) requires writeable<buf_type> {
+		const auto converted = adaptor.to();
+		write(converted);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises an arithmetic type with the default byte order.
+	 * 
+	 * @param data Reference to the type to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const arithmetic auto& data) requires writeable<buf_type> {
+		const auto converted = endian::storage_in(data, byte_order);
+		write(converted);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a POD type.
+	 * 
+	 * @tparam T The type of the POD object.
+	 * @param data Reference to the object to be serialised.
+	 * 
+	 * @note Will not be used for types with user-defined serialisation
+	 * functions.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<pod T>
+	requires (!has_shl_override<T, binary_stream> && !arithmetic<T>
+		&& !has_serialise<T, binary_stream> && !is_iterable<T>)
+	constexpr binary_stream& operator<<(const T& data) requires writeable<buf_type> {
+		write(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a string or string_view with a fixed-length prefix
+	 * 
+	 * @tparam T The string type.
+	 * @param adaptor prefixed adaptor that will instruct the stream to write a length
+	 * prefix before serialising the string.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires std::is_same_v<std::decay_t<T>, std::string_view>
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+		assert(adaptor->find_first_of('\0') == adaptor->npos);
+		write(adaptor->data(), adaptor->size());
+		write('\0');
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a string_view as a null terminated string.
+	 * 
+	 * @tparam T The string type.
+	 * @param adaptor null_terminated adaptor that will instruct the stream to write
+	 * a null terminated string with no prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires std::is_same_v<std::decay_t<T>, std::string>
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+		assert(adaptor->find_first_of('\0') == adaptor->npos);
+		write(adaptor->data(), adaptor->size() + 1); // yes, the standard allows this
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a fixed_string as a null terminated string.
+	 * 
+	 * @tparam T The fixed_string type.
+	 * @param adaptor null_terminated adaptor that will instruct the stream to write
+	 * a null terminated string with no prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires is_fixed_string_v<std::remove_const_t<T>>
+	constexpr binary_stream& operator<<(null_terminated<T> adaptor) requires writeable<buf_type> {
+		assert(adaptor->view().find_first_of('\0') == std::string_view::npos);
+		write(adaptor->data(), adaptor->size() + 1); // always null terminated
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a string, string_view or any type providing data()
+	 * and a size() member functions.
+	 * 
+	 * @tparam T The type.
+	 * @param adaptor raw adaptor referencing the type to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	constexpr binary_stream& operator<<(raw<T> adaptor) requires writeable<buf_type> {
+		write(adaptor->data(), adaptor->size());
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises an std::string_view with a fixed-length prefix.
+	 * 
+	 * @param string std::string_view to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(std::string_view string) requires writeable<buf_type> {
+		return *this << prefixed(string);
+	}
+
+	/**
+	 * @brief Serialises an std::string with a fixed-length prefix.
+	 * 
+	 * @param string std::string to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const std::string& string) requires writeable<buf_type> {
+		return *this << prefixed(string);
+	}
+
+	/**
+	 * @brief Serialises a fixed_string with a fixed-length prefix.
+	 * 
+	 * @param string fixed_string to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	constexpr binary_stream& operator<<(const fixed_string<N>& string) requires writeable<buf_type> {
+		return *this << prefixed(string);
+	}
+
+	/**
+	 * @brief Serialises a C-style string.
+	 * 
+	 * @param data string to be serialised.
+	 * 
+	 * @note The null terminator for this string will also be written. It will
+	 * not be prefixed.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const char* data) requires writeable<buf_type> {
+		assert(data);
+		const auto len = std::char_traits<char>::length(data);
+		write(data, len + 1); // include terminator
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises the elements of an iterable container or range,
+	 * without a prefix.
+	 * 
+	 * Ranges are written as their elements are produced, so views (e.g.
+	 * std::views::transform) can be written without materialising them
+	 * into a temporary container first.
+	 * 
+	 * @param data The container or range to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	constexpr binary_stream& operator<<(const is_iterable auto& data) requires writeable<buf_type> {
+		write_container(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises an iterable container.
+	 * 
+	 * @tparam T The iterable container type.
+	 * @param adaptor The container to be serialised.
+	 * 
+	 * @note A fixed-length prefix representing the number of elements in the
+	 * container will be written before the elements.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<is_iterable T>
+	constexpr binary_stream& operator<<(prefixed<T> adaptor) requires writeable<buf_type> {
+		const auto count = static_cast<std::uint32_t>(std::ranges::size(adaptor.str));
+		write(endian::native_to_little(count));
+		write_container(adaptor.str);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises an iterable container.
+	 * 
+	 * @tparam T The iterable container type.
+	 * @param adaptor The container to be serialised.
+	 * 
+	 * @note A variable-length prefix representing the number of elements in the
+	 * container will be written before the elements.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<is_iterable T>
+	constexpr binary_stream& operator<<(prefixed_varint<T> adaptor) requires writeable<buf_type> {
+		varint_encode(*this, std::ranges::size(adaptor.str));
+		write_container(adaptor.str);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a string through a string table, as a reference to
+	 * an earlier occurrence where there is one.
+	 * 
+	 * @param adaptor deduplicated adaptor referencing the string and the
+	 * message's string table.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	binary_stream& operator<<(deduplicated_string<T, table_type> adaptor) requires writeable<buf_type> {
+		deduplicated_encode(*this, std::string_view(adaptor.str), adaptor.table);
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a std::variant, prefixed with the index of the
+	 * active alternative.
+	 * 
+	 * @tparam tag_type The integral type used to write the index.
+	 * @param adaptor The variant to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::integral tag_type, variant_like T>
+	constexpr binary_stream& operator<<(tagged_variant<tag_type, T> adaptor)
+	requires writeable<buf_type> {
+		constexpr auto alternatives = std::variant_size_v<std::remove_cv_t<T>>;
+
+		static_assert(std::in_range<tag_type>(alternatives - 1),
+			"Tag type is too small to represent every alternative");
+
+		*this << static_cast<tag_type>(adaptor->index());
+
+		std::visit([&](auto& alternative) {
+			*this << alternative;
+		}, adaptor.value);
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises a std::variant, prefixed with a std::uint8_t holding
+	 * the index of the active alternative.
+	 * 
+	 * @param data The variant to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<variant_like T>
+	constexpr binary_stream& operator<<(T& data) requires writeable<buf_type> {
+		return *this << tagged(data);
+	}
+
+	/**
+	 * @brief Serialises a container of integers as bit-packed deltas, with
+	 * a fixed-length prefix. See delta_packed for the format.
+	 * 
+	 * @tparam T The container type.
+	 * @param adaptor delta_packed adaptor referencing the container to be
+	 * serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<delta_packable T>
+	binary_stream& operator<<(delta_packed<T> adaptor) requires writeable<buf_type> {
+		using unsigned_type = std::make_unsigned_t<std::ranges::range_value_t<T>>;
+
+		const auto count = std::ranges::size(adaptor.values);
+		*this << endian::le(static_cast<std::uint32_t>(count));
+
+		if(!count) {
+			return *this;
+		}
+
+		const auto values = reinterpret_cast<const unsigned_type*>(std::ranges::data(adaptor.values));
+		const auto blocks = count / bp128_block_size;
+		*this << values[0];
+
+		bp128_seed<unsigned_type> seed;
+		seed.fill(values[0]);
+		std::array<std::uint32_t, bp128_max_words> words;
+
+		for(std::size_t i = 0; i < blocks; ++i) {
+			const auto width = bp128_encode(values + (i * bp128_block_size), seed, words.data());
+			const auto out = std::span(words).first(width * bp128_lanes);
+
+			for(auto& word : out) {
+				word = endian::storage_in(word, byte_order);
+			}
+
+			*this << static_cast<std::uint8_t>(width);
+			write(out.data(), static_cast<size_type>(out.size_bytes()));
+		}
+
+		auto prev = blocks? seed.back() : values[0];
+
+		for(auto i = blocks * bp128_block_size; i < count; ++i) {
+			varint_encode(*this, static_cast<unsigned_type>(values[i] - prev));
+			prev = values[i];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises floats as IEEE 754 binary16.
+	 * 
+	 * @param adaptor half adaptor referencing the values to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator<<(half adaptor) requires writeable<buf_type> {
+		write_encoded<std::uint16_t>(adaptor.values, [](auto in, auto out) {
+			to_half(in, out);
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises floating point values quantised to a number of bits,
+	 * each written as the smallest unsigned type that can hold them.
+	 * 
+	 * @tparam T The floating point type.
+	 * @param adaptor quantised adaptor referencing the values to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::floating_point T>
+	binary_stream& operator<<(quantised<T> adaptor) requires writeable<buf_type> {
+		if(!check_bit_width(adaptor.bits, 1, max_quantise_bits<T>)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(adaptor.bits, [&]<typename word_type>(std::type_identity<word_type>) {
+			write_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				quantise<T>(in, out, adaptor.min, adaptor.max, adaptor.bits);
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Serialises unit quaternions with the smallest three encoding.
+	 * 
+	 * @tparam T The quaternion type.
+	 * @param adaptor smallest_three adaptor referencing the values to be
+	 * serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<quaternion T>
+	binary_stream& operator<<(smallest_three<T> adaptor) requires writeable<buf_type> {
+		if(!check_bit_width(adaptor.bits, min_smallest_three_bits, max_smallest_three_bits)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(2 + (adaptor.bits * 3), [&]<typename word_type>(std::type_identity<word_type>) {
+			write_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				for(std::size_t i = 0; i < in.size(); ++i) {
+					out[i] = static_cast<word_type>(encode_smallest_three(in[i], adaptor.bits));
+				}
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Writes a contiguous range to the stream.
+	 * 
+	 * @param data The contiguous range to be written to the stream.
+	 */
+	template<std::ranges::contiguous_range range>
+	constexpr void put(const range& data) requires writeable<buf_type> {
+		if consteval {
+			for(auto& element : data) {
+				write(element);
+			}
+		} else {
+			const auto write_size = data.size() * sizeof(typename range::value_type);
+			write(data.data(), write_size);
+		}
+	}
+
+	/**
+	 * @brief Writes a the provided value to the stream.
+	 * 
+	 * @param data The value to be written to the stream.
+	 */
+	constexpr void put(const arithmetic auto& data) requires writeable<buf_type> {
+		write(data);
+	}
+
+	/**
+	 * @brief Writes data to the stream.
+	 * 
+	 * @param adaptor The element to be written to the stream.
+	 */
+	template<std::derived_from<endian::adaptor_tag_t> endian_func>
+	constexpr void put(const endian_func& adaptor) requires writeable<buf_type> {
+		const auto swapped = adaptor.to();
+		write(swapped);
+	}
+
+	/**
+	 * @brief Writes count elements from the provided buffer to the stream.
+	 * 
+	 * @tparam T POD type.
+	 * @param data Pointer to the buffer from which data will be copied to the stream.
+	 * @param count The number of elements to write.
+	 */
+	template<pod T>
+	constexpr void put(const T* data, size_type count) requires writeable<buf_type> {
+		if consteval {
+			for(size_type i = 0; i < count; ++i) {
+				write(data[i]);
+			}
+		} else {
+			const auto write_size = count * sizeof(T);
+			write(data, write_size);
+		}
+	}
+
+	/**
+	 * @brief Writes the data from the iterator range to the stream.
+	 * 
+	 * @tparam It The iterator type.
+	 * @param begin Iterator to the beginning of the data.
+	 * @param end Iterator to the end of the data.
+	 */
+	template<typename It>
+	constexpr void put(It begin, const It end) requires writeable<buf_type> {
+		for(auto it = begin; it != end; ++it) {
+			*this << *it;
+		}
+	}
+
+	/**
+	 * @brief Allows for writing a provided byte value a specified number of times to
+	 * the stream.
+	 * 
+	 * @tparam size The number of bytes to generate.
+	 * @param value The byte value that will fill the specified number of bytes.
+	 */
+	template<size_type size>
+	constexpr void fill(const std::uint8_t value) requires writeable<buf_type> {
+		const auto filled = generate_filled<size>(value);
+		write(filled.data(), filled.size());
+	}
+
+	/*** Read ***/
+
+	/**
+	 * @brief Deserialises an object that provides a deserialise function:
+	 * void serialise(auto& stream);
+	 * 
+	 * @param[out] object The object to be deserialised.
+	 * 
+	 * @note If the object's serialised size bounds are known at compile-time,
+	 * the stream will error before reading any fields if there is less data
+	 * available than the object's minimum size.
+	 */
+	void deserialise(auto& object) {
+		using object_type = std::remove_cvref_t<decltype(object)>;
+
+		if constexpr(has_size_bounds<object_type>) {
+			constexpr auto min_size = serialised_size_bounds_v<object_type>.min;
+
+			if(state_ != stream_state::ok || !check_read_bounds(min_size)) {
+				return;
+			}
+		}
+
+		stream_read_adaptor adaptor(*this);
+		object.serialise(adaptor);
+	}
+
+	/**
+	 * @brief Deserialises an object that provides a deserialise function:
+	 * void serialise(auto& stream);
+	 * 
+	 * @param[out] data The object to be serialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires has_deserialise<T, binary_stream>
+	binary_stream& operator>>(T& data) {
+		deserialise(data);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] adaptor std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(prefixed<std::string> adaptor) {
+		std::uint32_t size = 0;
+		*this >> endian::le(size);
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(size, *this);
+
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, size);
+			return size;
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] adaptor std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten or
+	 * relocated (std::vector).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(prefixed<std::string_view> adaptor) {
+		std::uint32_t size = 0;
+		*this >> endian::le(size);
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		adaptor.str = std::string_view { span<char>(size) };
+		return *this;
+	}
+	
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * variable-length prefix.
+	 * 
+	 * @param[out] adaptor std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(prefixed_varint<std::string> adaptor) {
+		const auto size = varint_decode<size_type>(*this);
+
+		// if an error was triggered during decode
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(size, *this);
+
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, size);
+			return size;
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * variable-length prefix.
+	 * 
+	 * @param[out] adaptor std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten or
+	 * relocated (std::vector).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(prefixed_varint<std::string_view> adaptor) {
+		const auto size = varint_decode<size_type>(*this);
+
+		// if an error was triggered during decode
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+		
+		adaptor.str = std::string_view { span<char>(size) };
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(null_terminated<std::string> adaptor) {
+		auto pos = buffer_.find_first_of(value_type(0));
+
+		if(pos == buf_type::npos) {
+			adaptor->clear();
+			return *this;
+		}
+
+		if(!charge_allocation(pos, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, pos);
+			return pos;
+		});
+
+		// no need to enforce bounds, we know there's enough data
+		buffer_.skip(1); // skip null terminator
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten (i.e.
+	 * buffer adaptor with optimise disabled).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(null_terminated<std::string_view> adaptor) {
+		adaptor.str = view();
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data std::string_view to hold the result.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the underlying
+	 * buffer. You should not make any further writes to the buffer
+	 * unless you know it will not cause the data to be overwritten or
+	 * relocated (std::vector).
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(std::string_view& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data std::string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(std::string& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a fixed_string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data fixed_string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream& operator>>(fixed_string<N>& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor fixed_string to hold the result.
+	 * 
+	 * @note If the terminator is beyond the fixed_string's capacity, the
+	 * stream will be put into the capacity_err state. If no terminator is
+	 * found at all, the string is cleared and nothing is consumed, as with
+	 * std::string.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream& operator>>(null_terminated<fixed_string<N>> adaptor) {
+		auto pos = buffer_.find_first_of(value_type(0));
+
+		if(pos == buf_type::npos) {
+			adaptor->clear();
+			return *this;
+		}
+
+		if(pos > N) [[unlikely]] {
+			state_ = stream_state::capacity_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(capacity_exceeded(pos, N));
+			}
+
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, pos);
+			return pos;
+		});
+
+		// no need to enforce bounds, we know there's enough data
+		buffer_.skip(1); // skip null terminator
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string and replaces it with the equivalent
+	 * string from an intern pool.
+	 * 
+	 * On contiguous buffers, the string is hashed directly from the buffer
+	 * and is only copied if it has not been seen before.
+	 * 
+	 * @param[out] adaptor interned adaptor referencing the string_view to
+	 * hold the result and the pool to intern into.
+	 * 
+	 * @note The string_view's lifetime is tied to that of the pool rather
+	 * than the underlying buffer.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<template<typename> class encoding, typename pool_type>
+	binary_stream& operator>>(interned_string<encoding, pool_type> adaptor) {
+		if constexpr(std::is_same_v<contiguous_type, is_contiguous>) {
+			std::string_view view;
+			*this >> encoding<std::string_view>{ view };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.pool.intern(view);
+			}
+		} else {
+			std::string string;
+			*this >> encoding<std::string>{ string };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.pool.intern(string);
+			}
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string with the wrapped adaptor and validates
+	 * that it's well-formed UTF-8.
+	 * 
+	 * @param[out] adaptor utf8 adaptor wrapping the string or string adaptor.
+	 * 
+	 * @note Invalid strings result in stream_state::invalid_utf8_err. The
+	 * string is left holding the invalid data.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	binary_stream& operator>>(utf8_validated<T> adaptor) {
+		*this >> adaptor.value;
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		const auto string = utf8_view(adaptor.value);
+
+		if(!is_valid_utf8(string)) [[unlikely]] {
+			state_ = stream_state::invalid_utf8_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(invalid_utf8(utf8_error_offset(string), string.size()));
+			}
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was serialised through a string
+	 * table, resolving references to earlier occurrences.
+	 * 
+	 * On contiguous buffers, string_views refer to the first occurrence
+	 * within the buffer, so no copies are made.
+	 * 
+	 * @param[out] adaptor deduplicated adaptor referencing the std::string
+	 * or std::string_view to hold the result and the message's string table.
+	 * 
+	 * @note A reference to a string that isn't in the table results in
+	 * stream_state::invalid_tag_err.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	requires std::same_as<T, std::string> || std::same_as<T, std::string_view>
+	binary_stream& operator>>(deduplicated_string<T, table_type> adaptor) {
+		const auto tag = varint_decode<std::size_t>(*this);
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		const auto value = tag >> 1;
+
+		if(tag & 1) {
+			if(value >= adaptor.table.size()) [[unlikely]] {
+				state_ = stream_state::invalid_tag_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(invalid_string_reference(value, adaptor.table.size()));
+				}
+
+				return *this;
+			}
+
+			adaptor.str = adaptor.table[value];
+		} else if constexpr(std::is_same_v<contiguous_type, is_contiguous>) {
+			const std::string_view view { span<char>(static_cast<size_type>(value)) };
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.table.add(view);
+			}
+		} else {
+			std::string string;
+			get(string, static_cast<size_type>(value));
+
+			if(state_ == stream_state::ok) {
+				adaptor.str = adaptor.table.add(std::move(string));
+			}
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises an object that provides a deserialise function:
+	 * auto& operator>>(auto& stream);
+	 * 
+	 * @param[out] data The object to be deserialised.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(has_shr_override<binary_stream> auto&& data) {
+		return *this >> data;
+	}
+
+	/**
+	 * @brief Deserialises an arithmetic type with the requested byte order.
+	 * 
+	 * @param[out] endian_func The arithmetic type wrapped by the adaptor.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::derived_from<endian::adaptor_tag_t> endian_func>
+	binary_stream& operator>>(endian_func adaptor) {
+		SAFE_READ(&adaptor.value, sizeof(adaptor.value), *this);
+		adaptor.value = adaptor.from();
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises an arithmetic point type with the default byte order.
+	 * 
+	 * @param[out] data The arithmetic type.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(arithmetic auto& data) {
+		SAFE_READ(&data, sizeof(data), *this);
+		endian::storage_out(data, byte_order);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a POD type.
+	 * 
+	 * @tparam T The type of the POD object.
+	 * @param[out] data The object to hold the result.
+	 * 
+	 * @note Will not be used for types with user-defined serialisation
+	 * functions.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<pod T>
+	requires (!has_shr_override<T, binary_stream> && !arithmetic<T>
+		&& !has_deserialise<T, binary_stream>)
+	binary_stream& operator>>(T& data) {
+		SAFE_READ(&data, sizeof(data), *this);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises an iterable container that was previously written
+	 * with a fixed-length prefix.
+	 * 
+	 * @tparam T The iterable container type.
+	 * @param[out] adaptor The container to hold the result.
+	 *
+	 * @return Reference to the current stream.
+	 */
+	template<is_iterable T>
+	binary_stream& operator>>(prefixed<T> adaptor) {
+		std::uint32_t count = 0;
+		*this >> endian::le(count);
+		read_container(adaptor.str, count);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises an iterable container that was previously written
+	 * with a variable-length prefix.
+	 * 
+	 * @tparam T The iterable container type.
+	 * @param[out] adaptor The container to hold the result.
+	 *  
+	 * @return Reference to the current stream.
+	 */
+	template<is_iterable T>
+	binary_stream& operator>>(prefixed_varint<T> adaptor) {
+		const auto count = varint_decode<size_type>(*this);
+		read_container(adaptor.str, count);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a std::variant that was previously written with
+	 * a tag holding the index of the active alternative.
+	 * 
+	 * The alternative is constructed in place (or reused, if it is already
+	 * active) through a table indexed by the tag. A tag that doesn't
+	 * correspond to an alternative will put the stream into an error state
+	 * and leave the variant untouched.
+	 * 
+	 * @tparam tag_type The integral type used to write the index.
+	 * @param[out] adaptor The variant to hold the result. Each alternative
+	 * must be default constructible.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::integral tag_type, variant_like T>
+	binary_stream& operator>>(tagged_variant<tag_type, T> adaptor) {
+		static constexpr auto decoders = make_variant_decoders<T>();
+
+		tag_type tag{};
+		*this >> tag;
+
+		if(state_ != stream_state::ok) {
+			return *this;
+		}
+
+		if(std::cmp_less(tag, 0) || std::cmp_greater_equal(tag, decoders.size())) {
+			state_ = stream_state::invalid_tag_err;
+
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(invalid_variant_tag(static_cast<std::size_t>(tag), decoders.size()));
+			}
+
+			return *this;
+		}
+
+		decoders[static_cast<std::size_t>(tag)](*this, adaptor.value);
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a std::variant that was previously written with
+	 * a std::uint8_t tag holding the index of the active alternative.
+	 * 
+	 * @param[out] data The variant to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<variant_like T>
+	binary_stream& operator>>(T& data) {
+		return *this >> tagged(data);
+	}
+
+	/**
+	 * @brief Deserialises a container of integers that was serialised as
+	 * bit-packed deltas. See delta_packed for the format.
+	 * 
+	 * @tparam T The container type.
+	 * @param[out] adaptor delta_packed adaptor referencing the container to
+	 * hold the result.
+	 * 
+	 * @note A block with a bit width wider than the element type results in
+	 * stream_state::invalid_bit_width_err.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<delta_packable T>
+	requires has_resize<T> && has_clear<T>
+	binary_stream& operator>>(delta_packed<T> adaptor) {
+		using value_type = std::ranges::range_value_t<T>;
+		using unsigned_type = std::make_unsigned_t<value_type>;
+		constexpr auto max_width = std::numeric_limits<unsigned_type>::digits;
+
+		auto& container = adaptor.values;
+		container.clear();
+
+		std::uint32_t count = 0;
+		*this >> endian::le(count);
+
+		if(state_ != stream_state::ok || !count) {
+			return *this;
+		}
+
+		if(!charge_allocation(count, sizeof(value_type))) [[unlikely]] {
+			return *this;
+		}
+
+		unsigned_type base{};
+		*this >> base;
+
+		bp128_seed<unsigned_type> seed;
+		seed.fill(base);
+		std::array<std::uint32_t, bp128_max_words> words;
+		const auto blocks = count / bp128_block_size;
+
+		for(std::size_t i = 0; i < blocks; ++i) {
+			std::uint8_t width = 0;
+			*this >> width;
+
+			if(state_ != stream_state::ok) {
+				return *this;
+			}
+
+			if(width > max_width) [[unlikely]] {
+				state_ = stream_state::invalid_bit_width_err;
+
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(invalid_bit_width(width, max_width));
+				}
+
+				return *this;
+			}
+
+			const auto in = std::span(words).first(width * bp128_lanes);
+			SAFE_READ(in.data(), static_cast<size_type>(in.size_bytes()), *this);
+
+			for(auto& word : in) {
+				endian::storage_out(word, byte_order);
+			}
+
+			const auto offset = i * bp128_block_size;
+			container.resize(offset + bp128_block_size);
+			const auto values = reinterpret_cast<unsigned_type*>(std::ranges::data(container));
+			bp128_decode(words.data(), width, seed, values + offset);
+		}
+
+		const auto offset = blocks * bp128_block_size;
+		container.resize(count);
+
+		const auto values = reinterpret_cast<unsigned_type*>(std::ranges::data(container));
+		auto prev = blocks? seed.back() : base;
+
+		for(auto i = offset; i < count; ++i) {
+			prev += varint_decode<unsigned_type>(*this);
+			values[i] = prev;
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises floats that were serialised as IEEE 754 binary16.
+	 * 
+	 * @param[out] adaptor half adaptor referencing the values to hold the
+	 * result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	binary_stream& operator>>(half adaptor) {
+		read_encoded<std::uint16_t>(adaptor.values, [](auto in, auto out) {
+			from_half(in, out);
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises quantised floating point values.
+	 * 
+	 * @tparam T The floating point type.
+	 * @param[out] adaptor quantised adaptor referencing the values to hold
+	 * the result, with the same range and bits they were serialised with.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::floating_point T>
+	binary_stream& operator>>(quantised<T> adaptor) {
+		if(!check_bit_width(adaptor.bits, 1, max_quantise_bits<T>)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(adaptor.bits, [&]<typename word_type>(std::type_identity<word_type>) {
+			read_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				dequantise<T>(in, out, adaptor.min, adaptor.max, adaptor.bits);
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises unit quaternions that were serialised with the
+	 * smallest three encoding.
+	 * 
+	 * @tparam T The quaternion type.
+	 * @param[out] adaptor smallest_three adaptor referencing the values to
+	 * hold the result, with the same bits they were serialised with.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<quaternion T>
+	binary_stream& operator>>(smallest_three<T> adaptor) {
+		if(!check_bit_width(adaptor.bits, min_smallest_three_bits, max_smallest_three_bits)) [[unlikely]] {
+			return *this;
+		}
+
+		with_word_type(2 + (adaptor.bits * 3), [&]<typename word_type>(std::type_identity<word_type>) {
+			read_encoded<word_type>(adaptor.values, [&](auto in, auto out) {
+				for(std::size_t i = 0; i < in.size(); ++i) {
+					decode_smallest_three(in[i], out[i], adaptor.bits);
+				}
+			});
+		});
+
+		return *this;
+	}
+
+	/**
+	 * @brief Returns an input range that deserialises elements from the
+	 * stream as it is iterated, e.g:
+	 * 
+	 * for(auto& value : stream.read_range<std::uint32_t>(count)) { ... }
+	 * 
+	 * No container is created, so elements can be folded or filtered
+	 * without the cost of reserving storage for all of them.
+	 * 
+	 * @tparam T The element type.
+	 * @param count The number of elements to read.
+	 * 
+	 * @note The stream must outlive the range and should not be read from
+	 * by anything else until iteration has finished.
+	 * 
+	 * @return An input range over the elements.
+	 */
+	template<std::default_initializable T>
+	stream_range<binary_stream, T> read_range(const size_type count) {
+		return { *this, count };
+	}
+
+	/**
+	 * @brief Creates a child stream bounded to the next length bytes of
+	 * this stream, e.g. for reading the value of a TLV element:
+	 * 
+	 * auto slice = stream.slice(length);
+	 * slice >> value;
+	 * 
+	 * The child reads directly from this stream's buffer, so no data is
+	 * copied. Once the slice is destroyed, this stream will have advanced
+	 * by exactly length bytes, even if the child read less or errored,
+	 * which makes skipping an element a constant time operation. Slices
+	 * can be nested, with each bounded by its parent.
+	 * 
+	 * @param length The number of bytes the slice covers.
+	 * 
+	 * @note This stream must not be read from while the slice is alive.
+	 * If this stream doesn't contain length bytes, the child stream will
+	 * be in the same error state as this stream.
+	 * 
+	 * @return The slice, holding the child stream.
+	 */
+	auto slice(const size_type length) {
+		using base_type = typename slice_base<buf_type>::type;
+		using child_type = binary_stream<slice_buffer<base_type>, exceptions, endianness>;
+		using slice_type = stream_slice<child_type>;
+
+		const bool valid = state_ == stream_state::ok && check_read_bounds(length);
+
+		if(valid) {
+			total_read_ += length;
+		}
+
+		if constexpr(std::is_same_v<buf_type, slice_buffer<base_type>>) {
+			return slice_type(buffer_.base(), valid? length : 0, &buffer_, state_);
+		} else {
+			return slice_type(buffer_, valid? length : 0, nullptr, state_);
+		}
+	}
+
+	/**
+	 * @brief Begins a transaction, returning a child stream that reads
+	 * from this stream's buffer without consuming anything from it, e.g:
+	 * 
+	 * auto tx = stream.begin_transaction();
+	 * tx >> header >> body;
+	 * 
+	 * if(tx) {
+	 *     tx.commit();
+	 * }
+	 * 
+	 * Until commit is called, nothing is consumed or freed from the buffer,
+	 * so if a message has only been partially received, the transaction
+	 * can simply be dropped and the parse attempted again once more data
+	 * has arrived, without having to copy the buffer beforehand.
+	 * 
+	 * @note This stream must not be used while the transaction is alive.
+	 * 
+	 * @return The transaction, holding the child stream.
+	 */
+	auto begin_transaction() requires transactional<buf_type> {
+		using tx_buffer = transaction_buffer<buf_type>;
+		using child_type = binary_stream<tx_buffer, exceptions, endianness>;
+		using tx_type = stream_transaction<child_type, binary_stream>;
+
+		return tx_type(*this, buffer_, read_limit_, total_read_, state_);
+	}
+
+	/**
+	 * @brief Read an arithmetic type from the stream.
+	 * 
+	 * @param[out] dest The variable to hold the result.
+	 */
+	void get(arithmetic auto& dest) {
+		SAFE_READ(&dest, sizeof(dest), void());
+	}
+
+	/**
+	 * @brief Read an arithmetic type from the stream.
+	 * 
+	 * @return The arithmetic value.
+	 */
+	template<arithmetic T>
+	T get() {
+		T t{};
+		SAFE_READ(&t, sizeof(T), t);
+		return t;
+	}
+
+	/**
+	 * @brief Read an arithmetic type from the stream, allowing for endian
+	 * conversion.
+	 * 
+	 * @param[out] adaptor The destination for the read value.
+	 */
+	template<std::derived_from<endian::adaptor_tag_t> endian_func>
+	void get(endian_func& adaptor) {
+		SAFE_READ(&adaptor.value, sizeof(adaptor), void());
+		adaptor.value = adaptor.from();
+	}
+
+	/**
+	 * @brief Read an arithmetic type from the stream, allowing for endian
+	 * conversion.
+	 * 
+	 * @return The arithmetic value.
+	 */
+	template<arithmetic T, endian::conversion conversion>
+	T get() {
+		T t{};
+		SAFE_READ(&t, sizeof(T), t);
+		return endian::convert<conversion>(t);
+	}
+
+	/**
+	 * @brief Reads a string from the stream.
+	 * 
+	 * @param[out] dest The std::string to hold the result.
+	 * 
+	 * @param dest The destination string.
+	 */
+	void get(std::string& dest) {
+		*this >> dest;
+	}
+
+	/**
+	 * @brief Reads a fixed-length string from the stream.
+	 * 
+	 * @param[out] dest The std::string to hold the result.
+	 * @param count The number of bytes to be read.
+	 */
+	void get(std::string& dest, size_type size) {
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(size, void());
+
+		dest.resize_and_overwrite(size, [&](char* strbuf, size_type) {
+			buffer_.read(strbuf, size);
+			return size;
+		});
+	}
+
+	/**
+	 * @brief Read data from the stream into the provided destination argument.
+	 * 
+	 * @param[out] dest The destination buffer.
+	 * @param count The number of elements to be read to the destination.
+	 */
+	template<typename T>
+	void get(T* dest, size_type count) {
+		assert(dest);
+		const auto read_size = count * sizeof(T);
+		SAFE_READ(dest, read_size, void());
+	}
+
+	/**
+	 * @brief Read data from the stream to the destination represented by the iterators.
+	 * 
+	 * @param[out] begin The beginning iterator.
+	 * @param end The end iterator.
+	 */
+	template<typename It>
+	void get(It begin, const It end) {
+		for(; begin != end; ++begin) {
+			*this >> *begin;
+		}
+	}
+
+	/**
+	 * @brief Read data from the stream into the provided destination argument.
+	 * 
+	 * @param[out] dest A contiguous range into which the data should be read.
+	 */
+	template<std::ranges::contiguous_range range>
+	void get(range& dest) {
+		const auto read_size = dest.size() * sizeof(typename range::value_type);
+		SAFE_READ(dest.data(), read_size, void());
+	}
+
+	/**
+	 * @brief Skip over a number of bytes.
+	 *
+	 * Skips over a number of bytes from the stream. This should be used
+	 * if the stream holds data that you don't care about but don't want
+	 * to have to read it to another buffer to access data beyond it.
+	 * 
+	 * @param length The number of bytes to skip.
+	 */
+	void skip(const size_type length) {
+		STREAM_READ_BOUNDS_ENFORCE(length, void());
+		buffer_.skip(length);
+	}
+
+	/**
+	 * @brief Provides a string_view over the stream's data, up to the terminator value.
+	 * 
+	 * @param terminator An optional terminating/sentinel value.
+	 * 
+	 * @return A string view over data up to the provided terminator.
+	 * An empty string_view if a terminator is not found
+	 */
+	std::string_view view(value_type terminator = value_type(0)) requires contiguous<buf_type> {
+		const auto pos = buffer_.find_first_of(terminator);
+
+		if(pos == buf_type::npos) {
+			return {};
+		}
+
+		std::string_view view { reinterpret_cast<char*>(buffer_.read_ptr()), pos };
+
+		// no need to enforce bounds, we know there's enough data
+		buffer_.skip(pos + 1);
+		total_read_ += (pos + 1);
+		return view;
+	}
+
+	/**
+	 * @brief Provides a span over the specified number of elements in the stream.
+	 * 
+	 * @param count The number of elements the span will provide a view over.
+	 * 
+	 * @return A span representing a view over the requested number of elements
+	 * in the stream.
+	 * 
+	 * @note The stream will error if the stream does not contain the requested amount of data.
+	 */
+	template<typename out_type = value_type>
+	std::span<out_type> span(size_type count) requires contiguous<buf_type> {
+		std::span view { reinterpret_cast<out_type*>(buffer_.read_ptr()), count };
+		skip(sizeof(out_type) * count);
+		return (state_ == stream_state::ok? view : std::span<out_type>());
+	}
+
+	/**  Misc functions **/
+
+	/**
+	 * @brief Determine whether the adaptor supports write seeking.
+	 * 
+	 * This is determined at compile-time and does not need to checked at
+	 * run-time.
+	 * 
+	 * @return True if write seeking is supported, otherwise false.
+	 */
+	constexpr static bool can_write_seek() requires writeable<buf_type> {
+		return std::is_same_v<seeking, supported>;
+	}
+
+	/**
+	 * @brief Performs write seeking within the stream.
+	 * 
+	 * @param direction Specify whether to seek in a given direction or to absolute seek.
+	 * @param offset The offset relative to the seek direction or the absolute value
+	 * when using absolute seeking.
+	 */
+	void write_seek(const stream_seek direction, const offset_type offset)
+	requires(seekable<buf_type> && writeable<buf_type>) {
+		if(direction == stream_seek::sk_stream_absolute) {
+			if(offset >= total_write_) {
+				buffer_.write_seek(buffer_seek::sk_forward, offset - total_write_);
+			} else {
+				buffer_.write_seek(buffer_seek::sk_backward, total_write_ - offset);
+			}
+
+			total_write_ = offset;
+		} else {
+			buffer_.write_seek(static_cast<buffer_seek>(direction), offset);
+		}
+	}
+
+	/**
+	 * @brief Returns the size of the underlying buffer.
+	 * 
+	 * @note The value returned may be higher than the total number of bytes
+	 * that can be read from this stream, if a read limit was set during
+	 * construction. Use read_max() to determine how many bytes can be
+	 * read from this stream.
+	 * 
+	 * @return The size of the underlying buffer.
+	 */
+	constexpr size_type size() const {
+		return buffer_.size();
+	}
+
+	/**
+	 * @brief Whether the stream is empty.
+	 * 
+	 * @return Returns true if the stream is empty (has no data to be read).
+	 */
+	[[nodiscard]]
+	constexpr bool empty() const {
+		return buffer_.empty();
+	}
+
+	/**
+	 * @return The total number of bytes written to the stream.
+	 */
+	constexpr size_type total_write() const requires writeable<buf_type> {
+		return total_write_;
+	}
+
+	/**
+	 * @return Pointer to stream's underlying buffer.
+	 */
+	constexpr const buf_type* buffer() const {
+		return &buffer_;
+	}
+
+	/**
+	 * @return Pointer to stream's underlying buffer.
+	 */
+	constexpr buf_type* buffer() {
+		return &buffer_;
+	}
+
+	/**
+	 * @return The stream's state.
+	 */
+	constexpr stream_state state() const {
+		return state_;
+	}
+
+	/**
+	 * @return The total number of bytes read from the stream.
+	 */
+	size_type total_read() const {
+		return total_read_;
+	}
+
+	/**
+	 * @return If provided to the constructor, the upper limit on how much data
+	 * can be read from this stream before an error is triggers.
+	 */
+	size_type read_limit() const {
+		return read_limit_;
+	}
+
+	/**
+	 * @brief Controls whether deserialising into a non-empty container
+	 * overwrites its existing elements in place, rather than clearing it
+	 * and constructing new elements.
+	 * 
+	 * Enabling this allows storage owned by the elements (e.g. the capacity
+	 * of each string in a std::vector<std::string>) to be reused when
+	 * repeatedly deserialising into the same objects. Element types must
+	 * overwrite all of their state when deserialised.
+	 * 
+	 * @param enable Whether existing elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @brief Sets an upper limit on the number of bytes that container and
+	 * string reads may allocate over the lifetime of the stream, guarding
+	 * against untrusted length prefixes.
+	 * 
+	 * Exceeding the limit puts the stream into an error state.
+	 * 
+	 * @param limit The allocation limit in bytes, or zero for no limit.
+	 */
+	void set_allocation_limit(const size_type limit) {
+		alloc_limit_ = limit;
+	}
+
+	/**
+	 * @return The allocation limit, or zero if no limit was set.
+	 */
+	size_type allocation_limit() const {
+		return alloc_limit_;
+	}
+
+	/**
+	 * @return The total number of bytes allocated by container and string
+	 * reads while an allocation limit was set.
+	 */
+	size_type allocated() const {
+		return allocated_;
+	}
+
+	/**
+	 * @brief Determine the maximum number of bytes that can be
+	 * safely read from this stream.
+	 * 
+	 * The value returned may be lower than the amount of data
+	 * available in the buffer if a read limit was set during
+	 * the stream's construction.
+	 * 
+	 * @return The number of bytes available for reading.
+	 */
+	size_type read_max() const {
+		if(read_limit_) {
+			assert(total_read_ <= read_limit_);
+			return std::min<size_type>(read_limit_ - total_read_, buffer_.size());
+		} else {
+			return buffer_.size();
+		}
+	}
+
+	/**
+	 * @brief Determine whether the stream is in a usable state.
+	 * 
+	 * @return true if no errors have occurred.
+	 */
+	constexpr bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	/**
+	 * @brief Resets the stream state back to a good state, allowing
+	 * it to be used for streaming operations again. Has no effect
+	 * if the stream has not errored.
+	 */
+	void clear_error_state() {
+		state_ = stream_state::ok;
+	}
+
+	constexpr operator bool() const {
+		return good();
+	}
+
+	/**
+	 * @brief Set the stream to an error state.
+	 */
+	void set_error_state() {
+		state_ = stream_state::user_defined_err;
+	}
+};
+
+#undef SAFE_READ
+#undef STREAM_READ_BOUNDS_ENFORCE
+
+} // hexi
+
+// #include <hexi/buffer_adaptor.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/exception.h>
+
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace hexi {
+
+using namespace detail;
+
+template<byte_oriented buf_type, bool space_optimise = true>
+requires std::ranges::contiguous_range<buf_type>
+class buffer_adaptor final {
+public:
+	using value_type  = typename buf_type::value_type;
+	using size_type   = typename buf_type::size_type;
+	using offset_type = typename buf_type::size_type;
+	using contiguous  = is_contiguous;
+	using seeking     = supported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+private:
+	buf_type& buffer_;
+	size_type read_;
+	size_type write_;
+
+public:
+	buffer_adaptor(buf_type& buffer)
+		: buffer_(buffer),
+		  read_(0),
+		  write_(buffer.size()) {}
+
+	buffer_adaptor(buf_type& buffer, init_empty_t)
+		: buffer_(buffer),
+		  read_(0),
+		  write_(0) {}
+
+	buffer_adaptor(buffer_adaptor&& rhs) = delete;
+	buffer_adaptor& operator=(buffer_adaptor&&) = delete;
+	buffer_adaptor& operator=(const buffer_adaptor&) = delete;
+	buffer_adaptor(const buffer_adaptor&) = delete;
+
+	/**
+	 * @brief Reads a number of bytes to the provided buffer.
+	 * 
+	 * @note The destination buffer must not overlap with the underlying buffer
+	 * being used by the buffer_adaptor.
+	 * 
+	 * @tparam T The destination type.
+	 * @param[out] destination The buffer to copy the data to.
+	 */
+	template<typename T>
+	void read(T* destination) {
+		read(destination, sizeof(T));
+	}
+
+	/**
+	 * @brief Reads a number of bytes to the provided buffer.
+	 * 
+	 * @note The destination buffer must not overlap with the underlying buffer
+	 * being used by the buffer_adaptor.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to read into the buffer.
+	 */
+	void read(void* destination, size_type length) {
+		assert(destination);
+		copy(destination, length);
+		read_ += length;
+
+		if constexpr(space_optimise) {
+			if(read_ == write_) {
+				read_ = write_ = 0;
+			}
+		}
+	}
+
+	/**
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the read cursor.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 */
+	template<typename T>
+	void copy(T* destination) const {
+		copy(destination, sizeof(T));
+	}
+
+	/**
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with the underlying buffer
+	 * being used by the buffer_adaptor.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 */
+	void copy(void* destination, size_type length) const {
+		assert(destination && !region_overlap(buffer_.data(), buffer_.size(), destination, length));
+		std::memcpy(destination, read_ptr(), length);
+	}
+
+	/**
+	 * @brief Skip over a number of bytes.
+	 * 
+	 * Skips over a number of bytes from the container. This should be used
+	 * if the container holds data that you don't care about but don't want
+	 * to have to read it to another buffer to access data beyond it.
+	 * 
+	 * @param length The number of bytes to skip.
+	 */
+	void skip(size_type length) {
+		read_ += length;
+
+		if constexpr(space_optimise) {
+			if(read_ == write_) {
+				read_ = write_ = 0;
+			}
+		}
+	}
+
+	/**
+	 * @brief Write data to the container.
+	 * 
+	 * @note The source buffer must not overlap with the underlying buffer
+	 * being used by the buffer_adaptor.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 */
+	void write(const auto& source) {
+		write(&source, sizeof(source));
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * @note The source buffer must not overlap with the underlying buffer
+	 * being used by the buffer_adaptor.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 */
+	void write(const void* source, size_type length) {
+		assert(source && !region_overlap(source, length, buffer_.data(), buffer_.size()));
+		const auto min_req_size = write_ + length;
+
+		if(buffer_.size() < min_req_size) [[likely]] {
+			if constexpr(has_resize_overwrite<buf_type>) {
+				buffer_.resize_and_overwrite(min_req_size, [](char*, size_type size) {
+					return size;
+				});
+			} else if constexpr(has_resize<buf_type>) {
+				buffer_.resize(min_req_size);
+			} else {
+				HEXI_THROW(buffer_overflow(length, write_, free()));
+			}
+		}
+
+		std::memcpy(write_ptr(), source, length);
+		write_ += length;
+	}
+
+	/**
+	 * @brief Reserves a number of bytes within the container for future use.
+	 * 
+	 * @note This is a non-binding request, meaning the buffer may not reserve
+	 * any additional space, such as in the case where it is not supported.
+	 *
+	 * @param length The number of bytes that the container should reserve.
+	 */
+	void reserve(const size_type length) {
+		if constexpr(has_reserve<buf_type>) {
+			buffer_.reserve(length);
+		}
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container.
+	 * 
+	 * @param value The value to locate.
+	 * 
+	 * @return The position of value or npos if not found.
+	 */
+	size_type find_first_of(value_type val) const {
+		const auto data = read_ptr();
+
+		for(size_type i = 0, j = size(); i < j; ++i) {
+			if(data[i] == val) {
+				return i;
+			}
+		}
+
+		return npos;
+	}
+	
+	/**
+	 * @brief Returns the size of the container.
+	 * 
+	 * @return The number of bytes of data available to read within the container.
+	 */
+	size_type size() const {
+		return write_ - read_;
+	}
+
+	/**
+	 * @brief Whether the container is empty.
+	 * 
+	 * @return Returns true if the container is empty (has no data to be read).
+	 */
+	[[nodiscard]]
+	bool empty() const {
+		return read_ == write_;
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	value_type& operator[](const size_type index) {
+		return read_ptr()[index];
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	const value_type& operator[](const size_type index) const {
+		return read_ptr()[index];
+	}
+
+	/**
+	 * @brief Determine whether the adaptor supports write seeking.
+	 * 
+	 * This is determined at compile-time and does not need to checked at
+	 * run-time.
+	 * 
+	 * @return True if write seeking is supported, otherwise false.
+	 */
+	constexpr static bool can_write_seek() {
+		return std::is_same_v<seeking, supported>;
+	}
+
+	/**
+	 * @brief Performs write seeking within the container.
+	 * 
+	 * @param direction Specify whether to seek in a given direction or to absolute seek.
+	 * @param offset The offset relative to the seek direction or the absolute value
+	 * when using absolute seeking.
+	 */
+	void write_seek(const buffer_seek direction, const offset_type offset) {
+		switch(direction) {
+			case buffer_seek::sk_backward:
+				write_ -= offset;
+				break;
+			case buffer_seek::sk_forward:
+				write_ += offset;
+				break;
+			case buffer_seek::sk_absolute:
+				write_ = offset;
+		}
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	auto read_ptr() const {
+		return buffer_.data() + read_;
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	auto read_ptr() {
+		return buffer_.data() + read_;
+	}
+
+	/**
+	 * @return Pointer to the location within the buffer where the next write
+	 * will be made.
+	 */
+	auto write_ptr() const {
+		return buffer_.data() + write_;
+	}
+
+	/**
+	 * @return Pointer to the location within the buffer where the next write
+	 * will be made.
+	 */
+	auto write_ptr() {
+		return buffer_.data() + write_;
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	auto data() const {
+		return buffer_.data() + read_;
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	auto data() {
+		return buffer_.data() + read_;
+	}
+
+	/**
+	 * @return Pointer to the underlying storage.
+	 */
+	auto storage() const {
+		return buffer_.data();
+	}
+
+	/**
+	 * @return Pointer to the underlying storage.
+	 */
+	auto storage() {
+		return buffer_.data();
+	}
+
+	/**
+	 * @brief Advances the write cursor.
+	 * 
+	 * @param size The number of bytes by which to advance the write cursor.
+	 */
+	void advance_write(size_type bytes) {
+		assert(buffer_.size() >= (write_ + bytes));
+		write_ += bytes;
+	}
+
+	/**
+	 * @brief The amount of space left in the container.
+	 * 
+	 * @return The number of free bytes.
+	 */
+	auto free() const {
+		return buffer_.size() - write_;
+	}
+	
+	/*
+	 * @brief Resets both the read and write cursors back to the beginning
+	 * of the buffer.
+	 * 
+	 * @note The underlying buffer will not be cleared but should be treated
+	 * as thought it has been.
+	 */
+	void clear() {
+		read_ = write_ = 0;
+	}
+};
+
+} // hexi
+
+// #include <hexi/buffer_sequence.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#if defined HEXI_WITH_ASIO || defined HEXI_WITH_BOOST_ASIO
+
+#ifdef HEXI_WITH_ASIO
+#include <asio/buffer.hpp>
+#elif defined HEXI_WITH_BOOST_ASIO
+#include <boost/asio/buffer.hpp>
+#endif
+
+#ifdef HEXI_BUFFER_DEBUG
+#include <span>
+#endif
+
+namespace hexi {
+
+#ifdef HEXI_WITH_BOOST_ASIO
+namespace asio = boost::asio;
+#endif
+
+template<typename buffer_type>
+class buffer_sequence {
+	const buffer_type& buffer_;
+
+public:
+	buffer_sequence(const buffer_type& buffer)
+		: buffer_(buffer) { }
+
+	class const_iterator {
+		using node = typename buffer_type::node_type;
+
+	public:
+		const_iterator(const buffer_type& buffer, const node* curr_node)
+			: buffer_(buffer),
+			  curr_node_(curr_node) {}
+
+		const_iterator& operator++() {
+			curr_node_ = curr_node_->next;
+			return *this;
+		}
+
+		const_iterator operator++(int) {
+			const_iterator current(*this);
+			curr_node_ = curr_node_->next;
+			return current;
+		}
+
+		asio::const_buffer operator*() const {
+			const auto buffer = buffer_.buffer_from_node(curr_node_);
+			return buffer->read_data();
+		}
+
+		bool operator==(const const_iterator& rhs) const {
+			return curr_node_ == rhs.curr_node_;
+		}
+
+		bool operator!=(const const_iterator& rhs) const {
+			return curr_node_ != rhs.curr_node_;
+		}
+
+		const_iterator& operator=(const_iterator&) = delete;
+
+	#ifdef HEXI_BUFFER_DEBUG
+		std::span<const char> get_buffer() {
+			auto buffer = buffer_.buffer_from_node(curr_node_);
+			return {
+				reinterpret_cast<const char*>(buffer->read_ptr()), buffer->size()
+			};
+		}
+	#endif
+
+	private:
+		const buffer_type& buffer_;
+		const node* curr_node_;
+	};
+
+const_iterator begin() const {
+	return const_iterator(buffer_, buffer_.root_.next);
+}
+
+const_iterator end() const {
+	return const_iterator(buffer_, &buffer_.root_);
+}
+
+friend class const_iterator;
+};
+
+} // hexi
+
+#endif // #if defined HEXI_WITH_ASIO || defined HEXI_WITH_BOOST_ASIO
+// #include <hexi/byte_order.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/binary_stream.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+// #include <hexi/shared.h>
+
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * @brief Creates a stream over the buffer with a byte order chosen at
+ * runtime and passes it to the function. This is for protocols and files
+ * that negotiate their byte order, e.g. with a byte order marker.
+ *
+ * The function is instantiated once for each byte order, so the only
+ * runtime cost is a single branch per call, rather than one per field.
+ *
+ * @tparam exceptions Whether the stream should throw on errors.
+ * @param order The byte order of the data.
+ * @param buffer The buffer to create the stream over.
+ * @param read_limit The read limit for the stream, or zero for no limit.
+ * @param func Callable accepting either stream type. It must return the
+ * same type for both.
+ *
+ * @return The result of invoking the function.
+ */
+template<std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+	byte_oriented buf_type, typename func_type>
+requires std::same_as<
+	std::invoke_result_t<func_type, binary_stream<buf_type, exceptions, endian::as_big_t>&>,
+	std::invoke_result_t<func_type, binary_stream<buf_type, exceptions, endian::as_little_t>&>
+>
+decltype(auto) with_byte_order(const std::endian order, buf_type& buffer,
+                               const std::size_t read_limit, func_type&& func) {
+	using size_type = typename buf_type::size_type;
+
+	if(order == std::endian::big) {
+		binary_stream<buf_type, exceptions, endian::as_big_t> stream(
+			buffer, static_cast<size_type>(read_limit)
+		);
+
+		return std::invoke(std::forward<func_type>(func), stream);
+	} else {
+		binary_stream<buf_type, exceptions, endian::as_little_t> stream(
+			buffer, static_cast<size_type>(read_limit)
+		);
+
+		return std::invoke(std::forward<func_type>(func), stream);
+	}
+}
+
+/**
+ * @brief Creates a stream over the buffer with a byte order chosen at
+ * runtime and passes it to the function.
+ *
+ * @tparam exceptions Whether the stream should throw on errors.
+ * @param order The byte order of the data.
+ * @param buffer The buffer to create the stream over.
+ * @param func Callable accepting either stream type. It must return the
+ * same type for both.
+ *
+ * @return The result of invoking the function.
+ */
+template<std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+	byte_oriented buf_type, typename func_type>
+decltype(auto) with_byte_order(const std::endian order, buf_type& buffer, func_type&& func) {
+	return with_byte_order<exceptions>(order, buffer, 0, std::forward<func_type>(func));
+}
+
+} // hexi
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/dispatcher.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/binary_stream.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+// #include <hexi/shared.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace hexi {
+
+enum class dispatch_result {
+	ok, unknown_opcode, read_error
+};
+
+/**
+ * Binds an opcode to the message type that should be deserialised and the
+ * handler it should be passed to.
+ *
+ * @tparam opcode The opcode value.
+ * @tparam message_type The message to deserialise when the opcode is seen.
+ * Must be default constructible.
+ * @tparam handler A function pointer or captureless lambda, invoked as
+ * handler(message_type&, context...).
+ * @tparam size_limit If non-zero, the maximum number of bytes the message may
+ * read from the buffer. Exceeding it results in a read_limit_err.
+ */
+template<auto opcode, std::default_initializable message_type, auto handler, std::size_t size_limit = 0>
+struct route {
+	using message = message_type;
+	static constexpr auto key = opcode;
+	static constexpr auto func = handler;
+	static constexpr std::size_t limit = size_limit;
+};
+
+namespace detail {
+
+template<typename T>
+constexpr std::uint64_t opcode_key(const T value) {
+	if constexpr(std::is_enum_v<T>) {
+		return static_cast<std::uint64_t>(std::to_underlying(value));
+	} else {
+		return static_cast<std::uint64_t>(value);
+	}
+}
+
+struct hash_params {
+	std::uint64_t multiplier;
+	std::size_t bits;
+
+	constexpr std::size_t operator()(const std::uint64_t key) const {
+		return static_cast<std::size_t>((key * multiplier) >> (64 - bits));
+	}
+};
+
+/*
+ * Searches for a multiplicative hash that maps each key to a unique slot,
+ * starting with a table just large enough to hold the keys and growing it
+ * if no suitable multiplier can be found.
+ */
+template<std::size_t count>
+consteval hash_params find_perfect_hash(const std::array<std::uint64_t, count>& keys) {
+	constexpr std::size_t min_bits = std::max<std::size_t>(std::bit_width(count - 1), 1);
+	constexpr std::size_t max_bits = min_bits + 3;
+	std::uint64_t state = 0x9E3779B97F4A7C15;
+
+	for(auto bits = min_bits; bits <= max_bits; ++bits) {
+		for(std::size_t attempt = 0; attempt < 10'000; ++attempt) {
+			// splitmix64
+			state += 0x9E3779B97F4A7C15;
+			auto multiplier = state;
+			multiplier = (multiplier ^ (multiplier >> 30)) * 0xBF58476D1CE4E5B9;
+			multiplier = (multiplier ^ (multiplier >> 27)) * 0x94D049BB133111EB;
+			multiplier = (multiplier ^ (multiplier >> 31)) | 1;
+
+			const hash_params hash { multiplier, bits };
+			std::array<bool, std::size_t(1) << max_bits> used{};
+			bool collision = false;
+
+			for(const auto key : keys) {
+				auto& slot = used[hash(key)];
+
+				if(slot) {
+					collision = true;
+					break;
+				}
+
+				slot = true;
+			}
+
+			if(!collision) {
+				return hash;
+			}
+		}
+	}
+
+	throw "unable to find a perfect hash for the provided opcodes";
+}
+
+} // detail
+
+/**
+ * Reads an opcode and deserialises the corresponding message into storage
+ * owned by the dispatcher before invoking its handler, e.g:
+ *
+ * hexi::dispatcher<
+ *     Opcode,
+ *     hexi::route<Opcode::login, Login, &on_login>,
+ *     hexi::route<Opcode::ping, Ping, [](Ping& msg, Session& s) { ... }, 8>
+ * > dispatcher;
+ *
+ * dispatcher.dispatch<hexi::endian::as_big_t>(buffer, session);
+ *
+ * The lookup is a jump table indexed by the opcode when the opcodes are
+ * reasonably dense, or a perfect hash otherwise. Both are generated at
+ * compile-time. Each message type has a single instance that's reused
+ * between calls, so handlers should not hold onto references to messages.
+ * Calling set_reuse_storage(true) allows the storage owned by any containers
+ * within them to be reused too.
+ *
+ * @tparam opcode_type An integral or enum type for the opcode.
+ * @tparam routes The opcode to message and handler mappings.
+ */
+template<typename opcode_type, typename ...routes>
+requires (std::integral<opcode_type> || std::is_enum_v<opcode_type>)
+class dispatcher final {
+	using read_type = typename std::conditional_t<
+		std::is_enum_v<opcode_type>,
+		std::underlying_type<opcode_type>,
+		std::type_identity<opcode_type>
+	>::type;
+
+	static constexpr std::size_t route_count = sizeof...(routes);
+	static constexpr std::size_t dense_threshold = 256;
+
+	static_assert(route_count > 0, "dispatcher requires at least one route");
+
+	static constexpr std::array<std::uint64_t, route_count> keys {
+		detail::opcode_key(static_cast<opcode_type>(routes::key))...
+	};
+
+	static constexpr bool unique_keys = [] {
+		auto sorted = keys;
+		std::ranges::sort(sorted);
+		return std::ranges::adjacent_find(sorted) == sorted.end();
+	}();
+
+	static_assert(unique_keys, "dispatcher routes must have unique opcodes");
+
+	static constexpr std::uint64_t min_key = std::ranges::min(keys);
+	static constexpr std::uint64_t key_range = std::ranges::max(keys) - min_key + 1;
+
+	static constexpr bool dense =
+		key_range != 0 && key_range <= std::max(route_count * 4, dense_threshold);
+
+	std::tuple<typename routes::message...> storage_;
+	bool reuse_storage_ = false;
+
+	template<typename entry>
+	struct slot {
+		std::uint64_t key;
+		entry func;
+	};
+
+	template<typename entry, typename thunks>
+	static consteval auto make_table(const thunks& funcs) {
+		if constexpr(dense) {
+			std::array<entry, key_range> table{};
+
+			for(std::size_t i = 0; i < route_count; ++i) {
+				table[keys[i] - min_key] = funcs[i];
+			}
+
+			return table;
+		} else {
+			constexpr auto hash = detail::find_perfect_hash(keys);
+			std::array<slot<entry>, std::size_t(1) << hash.bits> table{};
+
+			for(std::size_t i = 0; i < route_count; ++i) {
+				table[hash(keys[i])] = { keys[i], funcs[i] };
+			}
+
+			return table;
+		}
+	}
+
+	template<std::size_t index, typename endianness, typename exceptions,
+		typename buf_type, typename ...args>
+	static dispatch_result handle(dispatcher& self, buf_type& buffer, args&&... context) {
+		using route_type = std::tuple_element_t<index, std::tuple<routes...>>;
+
+		auto& message = std::get<index>(self.storage_);
+		binary_stream<buf_type, exceptions, endianness> stream(buffer, route_type::limit);
+
+		if(self.reuse_storage_) {
+			stream.set_reuse_storage(true);
+		}
+
+		stream >> message;
+
+		if(!stream) {
+			return dispatch_result::read_error;
+		}
+
+		route_type::func(message, std::forward<args>(context)...);
+		return dispatch_result::ok;
+	}
+
+	template<typename endianness, typename exceptions, typename buf_type, typename ...args>
+	dispatch_result lookup(const opcode_type opcode, buf_type& buffer, args&&... context) {
+		using entry = dispatch_result(*)(dispatcher&, buf_type&, args&&...);
+
+		static constexpr auto table = []<std::size_t... indices>(std::index_sequence<indices...>) {
+			constexpr std::array<entry, route_count> funcs {
+				&handle<indices, endianness, exceptions, buf_type, args...>...
+			};
+
+			return make_table<entry>(funcs);
+		}(std::make_index_sequence<route_count>{});
+
+		const auto key = detail::opcode_key(opcode);
+		entry func = nullptr;
+
+		if constexpr(dense) {
+			const auto index = key - min_key;
+
+			if(index < table.size()) {
+				func = table[index];
+			}
+		} else {
+			constexpr auto hash = detail::find_perfect_hash(keys);
+			const auto& slot = table[hash(key)];
+
+			if(slot.key == key) {
+				func = slot.func;
+			}
+		}
+
+		if(!func) {
+			return dispatch_result::unknown_opcode;
+		}
+
+		return func(*this, buffer, std::forward<args>(context)...);
+	}
+
+public:
+	/**
+	 * @brief Reads an opcode from the buffer and dispatches the message
+	 * that follows it.
+	 *
+	 * @tparam endianness The byte order of the opcode and message.
+	 * @tparam exceptions Whether stream errors should throw.
+	 * @param buffer The buffer to read from.
+	 * @param context Additional arguments to pass to the handler.
+	 *
+	 * @return The result of the dispatch. The opcode is consumed even if it
+	 * is unknown.
+	 */
+	template<std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+		std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+		byte_oriented buf_type, typename ...args>
+	dispatch_result dispatch(buf_type& buffer, args&&... context) {
+		binary_stream<buf_type, exceptions, endianness> stream(buffer);
+		read_type opcode{};
+		stream >> opcode;
+
+		if(!stream) {
+			return dispatch_result::read_error;
+		}
+
+		return lookup<endianness, exceptions>(
+			static_cast<opcode_type>(opcode), buffer, std::forward<args>(context)...
+		);
+	}
+
+	/**
+	 * @brief Dispatches the message for an opcode that has already been
+	 * read from the buffer, such as from a frame header.
+	 *
+	 * @tparam endianness The byte order of the message.
+	 * @tparam exceptions Whether stream errors should throw.
+	 * @param opcode The message's opcode.
+	 * @param buffer The buffer to read from.
+	 * @param context Additional arguments to pass to the handler.
+	 *
+	 * @return The result of the dispatch.
+	 */
+	template<std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+		std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG,
+		byte_oriented buf_type, typename ...args>
+	dispatch_result dispatch(const opcode_type opcode, buf_type& buffer, args&&... context) {
+		return lookup<endianness, exceptions>(opcode, buffer, std::forward<args>(context)...);
+	}
+
+	/**
+	 * @brief Controls whether messages are read with the stream's
+	 * set_reuse_storage enabled, allowing the elements of any containers
+	 * within them to be overwritten in place rather than reconstructed.
+	 * 
+	 * Only enable this if every message type overwrites all of its state
+	 * when deserialised.
+	 * 
+	 * @param enable Whether existing container elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising messages.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @return Whether the dispatcher has a route for the opcode.
+	 */
+	static constexpr bool contains(const opcode_type opcode) {
+		return std::ranges::find(keys, detail::opcode_key(opcode)) != keys.end();
+	}
+
+	/**
+	 * @return Whether the lookup is a jump table (true) or a perfect hash (false).
+	 */
+	static constexpr bool is_dense() {
+		return dense;
+	}
+};
+
+} // hexi
+
+// #include <hexi/dynamic_buffer.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/pmc/buffer.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/pmc/buffer_read.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/pmc/buffer_base.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#include <cstddef>
+
+namespace hexi::pmc {
+
+class buffer_base {
+protected:
+	std::size_t read_ = 0;
+	std::size_t write_ = 0;
+
+public:
+	virtual std::size_t size() const = 0;
+	virtual bool empty() const = 0;
+	virtual ~buffer_base() = default;
+};
+
+} // pmc, hexi
+
+#include <cstddef>
+
+namespace hexi::pmc {
+
+class buffer_read : virtual public buffer_base {
+public:
+	using value_type = std::byte;
+
+	static constexpr auto npos { static_cast<std::size_t>(-1) };
+
+	virtual ~buffer_read() = default;
+	virtual void read(void* destination, std::size_t length) = 0;
+	virtual void copy(void* destination, std::size_t length) const = 0;
+	virtual	void skip(std::size_t length) = 0;
+	virtual const std::byte& operator[](const std::size_t index) const = 0;
+	virtual std::size_t find_first_of(std::byte val) const = 0;
+};
+
+} // pmc, hexi
+
+// #include <hexi/pmc/buffer_write.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/pmc/buffer_base.h>
+
+// #include <hexi/shared.h>
+
+#include <cstddef>
+
+namespace hexi::pmc {
+
+class buffer_write : virtual public buffer_base {
+public:
+	using value_type = std::byte;
+
+	virtual ~buffer_write() = default;
+	virtual void write(const void* source, std::size_t length) = 0;
+	virtual void reserve(std::size_t length) = 0;
+	virtual bool can_write_seek() const = 0;
+	virtual void write_seek(buffer_seek direction, std::size_t offset) = 0;
+};
+
+} // pmc, hexi
+
+
+namespace hexi::pmc {
+
+class buffer : public buffer_read, public buffer_write {
+public:
+	using value_type = std::byte;
+
+	using buffer_read::operator[];
+
+	virtual std::byte& operator[](const std::size_t index) = 0;
+	virtual ~buffer() = default;
+};
+
+} // pmc, hexi
+
+// #include <hexi/shared.h>
+
+// #include <hexi/allocators/default_allocator.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#include <utility>
+
+namespace hexi {
+
+template<typename T>
+struct default_allocator final {
+	template<typename ...Args>
+	[[nodiscard]] inline T* allocate(Args&&... args) const {
+		return new T(std::forward<Args>(args)...);
+	}
+
+	inline void deallocate(T* t) const {
+		delete t;
+	}
+};
+
+} // hexi
+
+// #include <hexi/detail/intrusive_storage.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#if _MSC_VER
+#pragma warning(disable : 4996)
+#endif
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/detail/non_temporal_copy.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/detail/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Copies into and out of dynamic buffer storage that are part of an
+ * operation at least this large use non-temporal stores, so that streaming
+ * large payloads through a buffer evicts less of everything else from the
+ * cache, at the cost of copy throughput and of the data being cold when
+ * it's next read. Whether that's a win depends heavily on the cache
+ * hierarchy, so it's disabled by default (zero) and should be enabled with
+ * a value such as (1024 * 1024) only where it has been measured to help.
+ */
+#ifndef HEXI_NON_TEMPORAL_THRESHOLD
+#define HEXI_NON_TEMPORAL_THRESHOLD 0
+#endif
+
+namespace hexi::detail {
+
+constexpr std::size_t non_temporal_threshold = HEXI_NON_TEMPORAL_THRESHOLD;
+
+/**
+ * @brief Copies with non-temporal stores, prefetching the source ahead of
+ * the copy. The destination is aligned with a regular copy first and any
+ * remainder of less than a cache line is also copied regularly. Falls back
+ * to memcpy where SSE2 isn't available.
+ *
+ * @note The source and destination must not overlap.
+ *
+ * @param[out] destination The buffer to copy the data to.
+ * @param source The data to copy.
+ * @param length The number of bytes to copy.
+ */
+inline void non_temporal_copy(void* destination, const void* source, std::size_t length) {
+#ifdef HEXI_HAS_SSE2
+	constexpr std::size_t line_size = 64;
+	constexpr std::size_t prefetch_distance = line_size * 8;
+
+	auto dest = static_cast<std::byte*>(destination);
+	auto src = static_cast<const std::byte*>(source);
+
+	const auto misalignment = reinterpret_cast<std::uintptr_t>(dest) & 15;
+
+	if(misalignment) {
+		const auto head = length < 16 - misalignment? length : 16 - misalignment;
+		std::memcpy(dest, src, head);
+		dest += head;
+		src += head;
+		length -= head;
+	}
+
+	for(; length >= line_size; length -= line_size) {
+		_mm_prefetch(reinterpret_cast<const char*>(src + prefetch_distance), _MM_HINT_NTA);
+
+		const auto in = reinterpret_cast<const __m128i*>(src);
+		const auto v0 = _mm_loadu_si128(in);
+		const auto v1 = _mm_loadu_si128(in + 1);
+		const auto v2 = _mm_loadu_si128(in + 2);
+		const auto v3 = _mm_loadu_si128(in + 3);
+
+		const auto out = reinterpret_cast<__m128i*>(dest);
+		_mm_stream_si128(out, v0);
+		_mm_stream_si128(out + 1, v1);
+		_mm_stream_si128(out + 2, v2);
+		_mm_stream_si128(out + 3, v3);
+
+		src += line_size;
+		dest += line_size;
+	}
+
+	// non-temporal stores are weakly ordered, so fence before anything else can see them
+	_mm_sfence();
+	std::memcpy(dest, src, length);
+#else
+	std::memcpy(destination, source, length);
+#endif
+}
+
+/**
+ * @brief Copies part of a larger operation, choosing between memcpy and
+ * non-temporal stores based on the operation's size.
+ *
+ * @note The source and destination must not overlap.
+ *
+ * @param[out] destination The buffer to copy the data to.
+ * @param source The data to copy.
+ * @param length The number of bytes to copy.
+ * @param total The number of bytes remaining in the operation, including
+ * this copy.
+ */
+inline void threshold_copy(void* destination, const void* source, const std::size_t length,
+                           const std::size_t total) {
+	if(non_temporal_threshold && total >= non_temporal_threshold) [[unlikely]] {
+		non_temporal_copy(destination, source, length);
+	} else {
+		std::memcpy(destination, source, length);
+	}
+}
+
+} // detail, hexi
+
+#include <array>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <cassert>
+#include <cstring>
+#include <cstddef>
+
+namespace hexi::detail {
+
+struct intrusive_node {
+	intrusive_node* next;
+	intrusive_node* prev;
+};
+
+template<std::size_t block_size, byte_type storage_type = std::byte>
+struct intrusive_storage final {
+	using value_type = storage_type;
+	using offset_type = std::remove_const_t<decltype(block_size)>;
+
+	offset_type read_offset = 0;
+	offset_type write_offset = 0;
+	intrusive_node node {};
+	std::array<value_type, block_size> storage;
+
+	/**
+	 * @brief Clear the container.
+	 * 
+	 * Resets the read and write offsets, does not explicitly
+	 * erase the data contained within the buffer but should
+	 * be treated as such.
+	 */
+	void clear() {
+		read_offset = 0;
+		write_offset = 0;
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * If the container size is lower than requested number of bytes,
+	 * the request will be capped at the number of bytes available.
+	 * Requests of at least HEXI_NON_TEMPORAL_THRESHOLD bytes, if set, use
+	 * non-temporal stores.
+	 * 
+	 * @note The source buffer must not overlap with the underlying buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 * 
+	 * @return The number of bytes copied, which may be less than requested.
+	 */
+	std::size_t write(const auto source, std::size_t length) {
+		assert(!region_overlap(source, length, storage.data(), storage.size()));
+		std::size_t write_len = block_size - write_offset;
+
+		if(write_len > length) {
+			write_len = length;
+		}
+
+		threshold_copy(storage.data() + write_offset, source, write_len, length);
+		write_offset += static_cast<offset_type>(write_len);
+		return write_len;
+	}
+
+	/**
+	 * @brief Copies a number of bytes to the provided buffer but without
+	 * advancing the read cursor.
+	 * 
+	 * If the container size is lower than requested number of bytes,
+	 * the request will be capped at the number of bytes available.
+	 * Requests of at least HEXI_NON_TEMPORAL_THRESHOLD bytes, if set, use
+	 * non-temporal stores.
+	 * 
+	 * @note The destination buffer must not overlap with the underlying buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 * 
+	 * @return The number of bytes copied, which may be less than requested.
+	 */
+	std::size_t copy(auto destination, const std::size_t length) const {
+		assert(!region_overlap(storage.data(), storage.size(), destination, length));
+		std::size_t read_len = block_size - read_offset;
+
+		if(read_len > length) {
+			read_len = length;
+		}
+
+		threshold_copy(destination, storage.data() + read_offset, read_len, length);
+		return read_len;
+	}
+
+	/**
+	 * @brief Reads a number of bytes to the provided buffer.
+	 * 
+	 * If the container size is lower than requested number of bytes,
+	 * the request will be capped at the number of bytes available.
+	 * 
+	 * @note The destination buffer must not overlap with the underlying buffer.
+	 * 
+	 * @param length The number of bytes to skip.
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param allow_optimise Whether the buffer can reuse its space where possible.
+	 * 
+	 * @return The number of bytes read, which may be less than requested.
+	 */
+	std::size_t read(auto destination, const std::size_t length, const bool allow_optimise = false) {
+		std::size_t read_len = copy(destination, length);
+		read_offset += static_cast<offset_type>(read_len);
+
+		if(read_offset == write_offset && allow_optimise) {
+			clear();
+		}
+
+		return read_len;
+	}
+
+	/**
+	 * @brief Skip over a number of bytes.
+	 *
+	 * Skips over a number of bytes in the container. This should be used
+	 * if the container holds data that you don't care about but don't want
+	 * to have to read it to another buffer to access data beyond it.
+	 * 
+	 * If the container size is lower than requested number of bytes,
+	 * the request will be capped at the number of bytes available.
+	 * 
+	 * @param length The number of bytes to skip.
+	 * @param allow_optimise Whether the buffer can reuse its space where possible.
+	 * 
+	 * @return The number of bytes skipped, which may be less than requested.
+	 */
+	std::size_t skip(const std::size_t length, const bool allow_optimise = false) {
+		std::size_t skip_len = block_size - read_offset;
+
+		if(skip_len > length) {
+			skip_len = length;
+		}
+
+		read_offset += static_cast<offset_type>(skip_len);
+
+		if(read_offset == write_offset && allow_optimise) {
+			clear();
+		}
+
+		return skip_len;
+	}
+
+	/**
+	 * @brief Returns the size of the container.
+	 * 
+	 * @return The number of bytes available to read within the container.
+	 */
+	std::size_t size() const {
+		return write_offset - read_offset;
+	}
+
+	/**
+	 * @brief The amount of free space.
+	 * 
+	 * @return The number of bytes of free space within the container.
+	 */
+	std::size_t free() const {
+		return block_size - write_offset;
+	}
+
+	/**
+	 * @brief Performs write seeking within the container.
+	 * 
+	 * @param direction Specify whether to seek in a given direction or to absolute seek.
+	 * @param offset The offset relative to the seek direction or the absolute value
+	 * when using absolute seeking.
+	 */
+	void write_seek(const buffer_seek direction, const std::size_t offset) {
+		switch(direction) {
+			case buffer_seek::sk_absolute:
+				write_offset = offset;
+				break;
+			case buffer_seek::sk_backward:
+				write_offset -= static_cast<offset_type>(offset);
+				break;
+			case buffer_seek::sk_forward:
+				write_offset += static_cast<offset_type>(offset);
+				break;
+		}
+	}
+
+	/**
+	 * @brief Advances the write cursor.
+	 * 
+	 * If the requested number of bytes exceeds the free space, the
+	 * request will be capped at the amount of free space.
+	 * 
+	 * @param size The number of bytes by which to advance the write cursor.
+	 * 
+	 * @return The number of bytes the write cursor was advanced by, which
+	 * may be less than requested.
+	 */
+	std::size_t advance_write(std::size_t size) {
+		const auto remaining = free();
+
+		if(remaining < size) {
+			size = remaining;
+		}
+
+		write_offset += static_cast<offset_type>(size);
+		return size;
+	}
+
+	/**
+	 * @brief Retrieve a pointer to the readable portion of the buffer.
+	 * 
+	 * @return Pointer to the readable portion of the buffer.
+	 */
+	const value_type* read_ptr() const {
+		return storage.data() + read_offset;
+	}
+
+	/**
+	 * @brief Retrieve a pointer to the readable portion of the buffer.
+	 * 
+	 * @return Pointer to the readable portion of the buffer.
+	 */
+	value_type* read_ptr() {
+		return storage.data() + read_offset;
+	}
+
+	/**
+	 * @brief Retrieve a pointer to the writeable portion of the buffer.
+	 * 
+	 * @return Pointer to the writeable portion of the buffer.
+	 */
+	const value_type* write_ptr () const {
+		return storage.data() + write_offset;
+	}
+
+	/**
+	 * @brief Retrieve a pointer to the writeable portion of the buffer.
+	 * 
+	 * @return Pointer to the writeable portion of the buffer.
+	 */
+	value_type* write_ptr() {
+		return storage.data() + write_offset;
+	}
+
+	/**
+	 * @brief Retrieve a span to the readable portion of the buffer.
+	 * 
+	 * @return Span to the readable portion of the buffer.
+	 */
+	std::span<const value_type> read_data() const {
+		return { storage.data() + read_offset, size() };
+	}
+
+	/**
+	 * @brief Retrieve a span to the readable portion of the buffer.
+	 * 
+	 * @return Span to the readable portion of the buffer.
+	 */
+	std::span<value_type> read_data() {
+		return { storage.data() + read_offset, size() } ;
+	}
+
+	/**
+	 * @brief Retrieve a span to the writeable portion of the buffer.
+	 * 
+	 * @return Span to the writeable portion of the buffer.
+	 */
+	std::span<const value_type> write_data() const {
+		return { storage.data() + write_offset, free() } ;
+	}
+
+	/**
+	 * @brief Retrieve a span to the writeable portion of the buffer.
+	 * 
+	 * @return Span to the writeable portion of the buffer.
+	 */
+	std::span<value_type> write_data() {
+		return { storage.data() + write_offset, free() } ;
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	value_type& operator[](const std::size_t index) {
+		return *(storage.data() + index);
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	const value_type& operator[](const std::size_t index) const {
+		return *(storage.data() + index);
+	}
+};
+
+} // detail, hexi
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <utility>
+#ifdef HEXI_BUFFER_DEBUG
+#include <vector>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+namespace hexi {
+
+using namespace detail;
+
+template<typename buffer_type>
+class buffer_sequence;
+
+template<decltype(auto) block_sz>
+concept int_gt_zero = std::integral<decltype(block_sz)> && block_sz > 0;
+
+template<decltype(auto) block_sz,
+	byte_type storage_value_type = std::byte,
+	typename allocator = default_allocator<detail::intrusive_storage<block_sz, storage_value_type>>
+>
+requires int_gt_zero<block_sz>
+class dynamic_buffer final : public pmc::buffer {
+public:
+	using storage_type = intrusive_storage<block_sz, storage_value_type>;
+	using value_type   = storage_value_type;
+	using node_type    = intrusive_node;
+	using size_type    = std::size_t;
+	using offset_type  = std::size_t;
+	using contiguous   = is_non_contiguous;
+	using seeking      = supported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+	/**
+	 * A position within the container's data, used to resume copying or
+	 * searching from where a previous operation left off without walking
+	 * the block chain from the front. A default constructed position is the
+	 * read cursor. Positions are invalidated by anything that consumes data
+	 * from the container but survive writes.
+	 */
+	struct read_position {
+		const intrusive_node* node = nullptr;
+		size_type offset = 0;
+	};
+
+	using unique_storage = std::unique_ptr<storage_type, std::function<void(storage_type*)>>;
+
+private:
+	intrusive_node root_;
+	size_type size_;
+	[[no_unique_address]] allocator allocator_;
+
+	void link_tail_node(intrusive_node* node) {
+		node->next = &root_;
+		node->prev = root_.prev;
+		root_.prev = root_.prev->next = node;
+	}
+
+	void unlink_node(intrusive_node* node) {
+		node->next->prev = node->prev;
+		node->prev->next = node->next;
+	}
+
+	inline storage_type* buffer_from_node(const intrusive_node* node) const {
+		return reinterpret_cast<storage_type*>(std::uintptr_t(node)
+			- offsetof(storage_type, node));
+	}
+
+	/*
+	 * Moves a position off the end of a fully read block, unless that
+	 * block is the tail, where later writes may still land.
+	 */
+	void normalise(read_position& position) const {
+		// unresolved, or resolved while the container was empty
+		if(!position.node || position.node == &root_) {
+			position.node = root_.next;
+		}
+
+		while(position.node->next != &root_) {
+			const auto size = buffer_from_node(position.node)->size();
+
+			if(position.offset < size) {
+				break;
+			}
+
+			position.offset -= size;
+			position.node = position.node->next;
+		}
+	}
+
+	void move(dynamic_buffer& rhs) noexcept {
+		if(this == &rhs) { // self-assignment
+			return;
+		}
+
+		clear(); // clear our current blocks rather than swapping them
+
+		size_ = rhs.size_;
+		root_ = rhs.root_;
+		root_.next->prev = &root_;
+		root_.prev->next = &root_;
+		rhs.size_ = 0;
+		rhs.root_.next = &rhs.root_;
+		rhs.root_.prev = &rhs.root_;
+	}
+
+	void copy(const dynamic_buffer& rhs) {
+		if(this == &rhs) { // self-assignment
+			return;
+		}
+
+		const intrusive_node* head = rhs.root_.next;
+		root_.next = &root_;
+		root_.prev = &root_;
+		size_ = 0;
+
+		while(head != &rhs.root_) {
+			auto buffer = allocate();
+			*buffer = *buffer_from_node(head);
+			link_tail_node(&buffer->node);
+			size_ += buffer->write_offset;
+			head = head->next;
+		}
+	}
+	
+#ifdef HEXI_BUFFER_DEBUG
+	void offset_buffers(std::vector<storage_type*>& buffers, size_type offset) {
+		std::erase_if(buffers, [&](auto block) {
+			if(block->size() > offset) {
+				block->read_offset += offset;
+				block->write_offset -= offset;
+				return false;
+			} else {
+				return true;
+			}
+		});
+	}
+#endif
+
+	value_type& byte_at_index(const size_type index) const {
+		assert(index < size_ && "buffer subscript index out of range");
+
+		auto head = root_.next;
+		auto buffer = buffer_from_node(head);
+		const auto offset_index = index + buffer->read_offset;
+		const auto node_index = offset_index / block_sz;
+
+		for(size_type i = 0; i < node_index; ++i) {
+			head = head->next;
+		}
+
+		buffer = buffer_from_node(head);
+		return (*buffer)[offset_index % block_sz];
+	}
+
+	size_type abs_seek_offset(size_type offset) {
+		if(offset < size_) {
+			return size_ - offset;
+		} else if(offset > size_) {
+			return offset - size_;
+		} else {
+			return 0;
+		}
+	}
+
+	[[nodiscard]] storage_type* allocate() {
+		return allocator_.allocate();
+	}
+
+	void deallocate(storage_type* buffer) {
+		allocator_.deallocate(buffer);
+	}
+
+public:
+	dynamic_buffer()
+		: root_{ .next = &root_, .prev = &root_ },
+		  size_(0) {}
+
+	~dynamic_buffer() {
+		clear();
+	}
+
+	dynamic_buffer& operator=(dynamic_buffer&& rhs) noexcept {
+		move(rhs);
+		return *this;
+	}
+
+	dynamic_buffer(dynamic_buffer&& rhs) noexcept {
+		move(rhs);
+	}
+
+	dynamic_buffer(const dynamic_buffer& rhs) {
+		copy(rhs);
+	}
+
+	dynamic_buffer& operator=(const dynamic_buffer& rhs) {
+		clear();
+		copy(rhs);
+		return *this;
+	}
+
+	/**
+	 * @brief Reads a number of bytes to the provided buffer.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 */
+	template<typename T>
+	void read(T* destination) {
+		read(destination, sizeof(T));
+	}
+
+	/**
+	 * @brief Reads a number of bytes to the provided buffer.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to read into the buffer.
+	 */
+	void read(void* destination, size_type length) override {
+		assert(length <= size_ && "Chained buffer read too large!");
+		size_type remaining = length;
+
+		while(true) {
+			auto buffer = buffer_from_node(root_.next);
+			remaining -= buffer->read(
+				static_cast<value_type*>(destination) + length - remaining, remaining,
+				                         root_.next == root_.prev
+			);
+
+			if(remaining) [[unlikely]] {
+				unlink_node(root_.next);
+				deallocate(buffer);
+			} else {
+				break;
+			}
+		}
+
+		size_ -= length;
+	}
+
+	/**
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the container's read cursor.
+	 * 
+	 * @note The source buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 */
+	template<typename T>
+	void copy(T* destination) const {
+		copy(destination, sizeof(T));
+	}
+
+	/**
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the container's read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 */
+	void copy(void* destination, const size_type length) const override {
+		assert(length <= size_ && "Chained buffer copy too large!");
+		size_type remaining = length;
+		auto head = root_.next;
+
+		while(true) {
+			const auto buffer = buffer_from_node(head);
+			remaining -= buffer->copy(
+				static_cast<value_type*>(destination) + length - remaining, remaining
+			);
+
+			if(remaining) [[unlikely]] {
+				head = head->next;
+			} else {
+				break;
+			}
+		}
+	}
+
+	/**
+	 * @brief Copies a number of bytes, starting at an offset from the read
+	 * cursor, to the provided buffer but without advancing the read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 * @param offset The offset from the read cursor to begin copying from.
+	 */
+	void copy(void* destination, const size_type length, size_type offset) const {
+		assert(length + offset <= size_ && "Chained buffer copy too large!");
+		auto dest = static_cast<value_type*>(destination);
+		size_type remaining = length;
+		auto head = root_.next;
+
+		while(remaining) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			if(offset >= data.size()) {
+				offset -= data.size();
+				continue;
+			}
+
+			const auto copy_len = std::min(data.size() - offset, remaining);
+			std::memcpy(dest, data.data() + offset, copy_len);
+			dest += copy_len;
+			remaining -= copy_len;
+			offset = 0;
+		}
+	}
+
+	/**
+	 * @brief Copies a number of bytes, starting at a position, to the
+	 * provided buffer and advances the position past them, without
+	 * advancing the read cursor.
+	 * 
+	 * @note The destination buffer must not overlap with any of the underlying
+	 * buffers being used by the dynamic buffer.
+	 * 
+	 * @param[out] destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 * @param position The position to begin copying from.
+	 */
+	void copy(void* destination, const size_type length, read_position& position) const {
+		auto dest = static_cast<value_type*>(destination);
+		size_type remaining = length;
+
+		while(remaining) {
+			normalise(position);
+			assert(position.node != &root_ && "Chained buffer copy too large!");
+			const auto data = buffer_from_node(position.node)->read_data();
+			assert(position.offset < data.size() && "Chained buffer copy too large!");
+			const auto copy_len = std::min(data.size() - position.offset, remaining);
+			std::memcpy(dest, data.data() + position.offset, copy_len);
+			dest += copy_len;
+			remaining -= copy_len;
+			position.offset += copy_len;
+		}
+	}
+
+	/**
+	 * @brief Advances a position by a number of bytes.
+	 * 
+	 * @param position The position to advance.
+	 * @param length The number of bytes to advance by.
+	 */
+	void advance(read_position& position, const size_type length) const {
+		position.offset += length;
+		normalise(position);
+	}
+
+#ifdef HEXI_BUFFER_DEBUG
+	/**
+	 * @brief Retrives underlying buffers owned by the dynamic buffer.
+	 *
+	 * @param length Limit returned buffers to those holding up to the requested amount
+	 * of data.
+	 * @param offset The offset to start at.
+	 * 
+	 * @return Container of pointers to the underlying buffers holding the range of data
+	 * requested by length and offset.
+	 */
+	std::vector<storage_type*> fetch_buffers(const size_type length, const size_type offset = 0) {
+		size_type total = length + offset;
+		assert(total <= size_ && "Chained buffer fetch too large!");
+		std::vector<storage_type*> buffers;
+		auto head = root_.next;
+
+		while(total) {
+			auto buffer = buffer_from_node(head);
+			size_type read_size = block_sz - buffer->read_offset;
+			
+			// guard against overflow - buffer may have more content than requested
+			if(read_size > total) {
+				read_size = total;
+			}
+
+			buffers.emplace_back(buffer);
+			total -= read_size;
+			head = head->next;
+		}
+
+		if(offset) {
+			offset_buffers(buffers, offset);
+		}
+
+		return buffers;
+	}
+#endif
+
+	/**
+	 * @brief Skip the requested number of bytes.
+	 *
+	 * Skips over a number of bytes from the container. This should be used
+	 * if the container holds data that you don't care about but don't want
+	 * to have to read it to another buffer to access data beyond it.
+	 * 
+	 * @param length The number of bytes to skip.
+	 */
+	void skip(const size_type length) override {
+		assert(length <= size_ && "Chained buffer skip too large!");
+		size_type remaining = length;
+
+		while(true) {
+			auto buffer = buffer_from_node(root_.next);
+			remaining -= buffer->skip(remaining, root_.next == root_.prev);
+
+			if(remaining) [[unlikely]] {
+				unlink_node(root_.next);
+				deallocate(buffer);
+			} else {
+				break;
+			}
+		}
+
+		size_ -= length;
+	}
+
+	/**
+	 * @brief Write data to the container.
+	 * 
+	 * @note The source buffer must not overlap with any of the underlying buffers
+	 * being used by the dynamic buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 */
+	void write(const auto& source) {
+		write(&source, sizeof(source));
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * @note The source buffer must not overlap with any of the underlying buffers
+	 * being used by the dynamic buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 */
+	void write(const void* source, const size_type length) override {
+		size_type remaining = length;
+		intrusive_node* tail = root_.prev;
+
+		do {
+			storage_type* buffer;
+
+			if(tail != &root_) [[likely]] {
+				buffer = buffer_from_node(tail);
+			} else {
+				buffer = allocate();
+				link_tail_node(&buffer->node);
+				tail = root_.prev;
+			}
+
+			remaining -= buffer->write(
+				static_cast<const value_type*>(source) + length - remaining, remaining
+			);
+
+			tail = tail->next;
+		} while(remaining);
+
+		size_ += length;
+	}
+
+	/**
+	 * @brief Reserves a number of bytes within the container for future use.
+	 * 
+	 * @param length The number of bytes that the container should reserve.
+	 */
+	void reserve(const size_type length) override {
+		size_type remaining = length;
+		intrusive_node* tail = root_.prev;
+
+		do {
+			storage_type* buffer;
+
+			if(tail == &root_) [[unlikely]] {
+				buffer = allocate();
+				link_tail_node(&buffer->node);
+				tail = root_.prev;
+			} else {
+				buffer = buffer_from_node(tail);
+			}
+
+			remaining -= buffer->advance_write(remaining);
+			tail = tail->next;
+		} while(remaining);
+
+		size_ += length;
+	}
+
+	/**
+	 * @brief Returns the size of the container.
+	 * 
+	 * @return The number of bytes of data available to read within the container.
+	 */
+	size_type size() const override {
+		return size_;
+	}
+
+	/**
+	 * @brief Retrieves the last buffer in the container's list.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 * @note The container retains ownership over the buffer, so it must not
+	 * be deallocated by the caller.
+	 */
+	storage_type* back() const {
+		if(root_.prev == &root_) {
+			return nullptr;
+		}
+
+		return buffer_from_node(root_.prev);
+	}
+
+	/**
+	 * @brief Retrieves the buffer's block sized.
+	 * 
+	 * @param index The index within the buffer.
+	 * @return A reference to the value at the specified index.
+	 */
+	storage_type* front() const {
+		if(root_.next == &root_) {
+			return nullptr;
+		}
+
+		return buffer_from_node(root_.next);
 	}
 
 	/**
-	 * @brief Serialises an std::string_view with a fixed-length prefix.
+	 * @brief Removes the first buffer from the container.
+	 * 
+	 * @return A pointer to the popped buffer.
+	 * 
+	 * @note Removing the buffer from the container also transfers ownership.
+	 * Therefore, the caller assumes responsibility for deallocating the buffer
+	 * when it is no longer required. Alternatively, it can be pushed back into
+	 * the container to transfer ownership back.
+	 */
+	auto pop_front() {
+		auto buffer = buffer_from_node(root_.next);
+		size_ -= buffer->size();
+		unlink_node(root_.next);
+		return unique_storage(buffer, [&](auto ptr) {
+			deallocate(ptr);
+		});
+	}
+
+	/**
+	 * @brief Attaches additional storage to the container.
+	 * 
+	 * @param buffer The block to add to the container.
+	 * 
+	 * @note Once pushed, the container is assumed to have ownership over the buffer.
+	 * The buffer storage must have been allocated by the same allocator as the container.
+	 */
+	void push_back(storage_type* buffer) {
+		link_tail_node(&buffer->node);
+		size_ += buffer->write_offset;
+	}
+
+	/**
+	 * @brief Advances the write cursor.
+	 * 
+	 * @param size The number of bytes by which the write cursor to advance the cursor.
+	 */
+	void advance_write(const size_type size) {
+		auto buffer = buffer_from_node(root_.prev);
+		const auto actual = buffer->advance_write(size);
+		assert(size <= block_sz && actual <= size &&
+		       "Attempted to advance write cursor out of bounds!");
+		size_ += size;
+	}
+
+	/**
+	 * @brief Determine whether the adaptor supports write seeking.
+	 * 
+	 * This is determined at compile-time and does not need to checked at
+	 * run-time.
+	 * 
+	 * @return True if write seeking is supported, otherwise false.
+	 */
+	bool can_write_seek() const override {
+		return std::is_same_v<seeking, supported>;
+	}
+
+	/**
+	 * @brief Performs write seeking within the container.
+	 * 
+	 * @param direction Specify whether to seek in a given direction or to absolute seek.
+	 * @param offset The offset relative to the seek direction or the absolute value
+	 * when using absolute seeking.
+	 */
+	void write_seek(const buffer_seek direction, size_type offset) override {
+		// nothing to do in this case
+		if(direction == buffer_seek::sk_absolute && offset == size_) {
+			return;
+		}
+
+		auto tail = root_.prev;
+
+		switch(direction) {
+			case buffer_seek::sk_backward:
+				size_ -= offset;
+				break;
+			case buffer_seek::sk_forward:
+				size_ += offset;
+				break;
+			case buffer_seek::sk_absolute:
+				size_ = offset;
+				offset = abs_seek_offset(offset);
+				break;
+		}
+
+		const bool rewind
+			= (direction == buffer_seek::sk_backward
+			   || (direction == buffer_seek::sk_absolute && offset < size_));
+
+		while(offset) {
+			auto buffer = buffer_from_node(tail);
+			const auto max_seek = rewind? buffer->size() : buffer->free();
+
+			if(max_seek >= offset) {
+				buffer->write_seek(direction, offset);
+				offset = 0;
+			} else {
+				buffer->write_seek(direction, max_seek);
+				offset -= max_seek;
+				tail = rewind? tail->prev : tail->next;
+			}
+		}
+
+		root_.prev = tail;
+	}
+
+	/**
+	 * @brief Clears the container.
+	 */
+	void clear() {
+		intrusive_node* head = root_.next;
+
+		while(head != &root_) {
+			auto next = head->next;
+			deallocate(buffer_from_node(head));
+			head = next;
+		}
+
+		root_.next = &root_;
+		root_.prev = &root_;
+		size_ = 0;
+	}
+
+	/**
+	 * @brief Whether the container is empty.
+	 * 
+	 * @return Returns true if the container is empty (has no data to be read).
+	 */
+	[[nodiscard]]
+	bool empty() const override {
+		return !size_;
+	}
+
+	/**
+	 * @brief Retrieves the container's block size.
+	 * 
+	 * @return The block size.
+	 */
+	constexpr static size_type block_size() {
+		return block_sz;
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	value_type& operator[](const size_type index) override {
+		return byte_at_index(index);
+	}
+
+	/**
+	 * @brief Retrieves a reference to the specified index within the container.
+	 * 
+	 * @param index The index within the container.
+	 * 
+	 * @return A reference to the value at the specified index.
+	 */
+	const value_type& operator[](const size_type index) const override {
+		return byte_at_index(index);
+	}
+
+	/**
+	 * @brief Retrieves the number of allocated blocks currently being used by the container.
+	 * 
+	 * @return The number of allocated blocks.
+	 */
+	size_type block_count() const {
+		auto node = &root_;
+		size_type count = 0;
+
+		// not calculating based on block size & size as it
+		// wouldn't play nice with seeking or manual push/pop
+		while(node->next != root_.prev->next) {
+			++count;
+			node = node->next;
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container.
+	 * 
+	 * @param value The value to locate.
+	 * 
+	 * @return The position of value or npos if not found.
+	 */
+	size_type find_first_of(value_type value) const override {
+		size_type index = 0;
+		auto head = root_.next;
+
+		while(head != &root_) {
+			const auto buffer = buffer_from_node(head);
+			const auto data = buffer->read_data();
+			
+			for(const auto& byte : data) {
+				if(byte == value) {
+					return index;
+				}
+
+				++index;
+			}
+
+			head = head->next;
+		}
+
+		return npos;
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container,
+	 * starting at an offset from the read cursor.
+	 * 
+	 * @param value The value to locate.
+	 * @param offset The offset from the read cursor to begin searching from.
+	 * 
+	 * @return The position of value relative to the read cursor, or npos if
+	 * not found.
+	 */
+	size_type find_first_of(value_type value, const size_type offset) const {
+		size_type index = 0;
+		auto head = root_.next;
+
+		while(head != &root_) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			if(index + data.size() <= offset) {
+				index += data.size();
+				continue;
+			}
+
+			const auto start = offset > index? offset - index : 0;
+
+			for(auto i = start; i < data.size(); ++i) {
+				if(data[i] == value) {
+					return index + i;
+				}
+			}
+
+			index += data.size();
+		}
+
+		return npos;
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container,
+	 * starting at a position.
+	 * 
+	 * @param value The value to locate.
+	 * @param position The position to begin searching from.
+	 * 
+	 * @return The distance of value from the position, or npos if not found.
+	 */
+	size_type find_first_of(value_type value, read_position position) const {
+		normalise(position);
+		size_type index = 0;
+		auto head = position.node;
+		auto start = position.offset;
+
+		while(head != &root_) {
+			const auto data = buffer_from_node(head)->read_data();
+			head = head->next;
+
+			for(auto i = start; i < data.size(); ++i) {
+				if(data[i] == value) {
+					return index + i - start;
+				}
+			}
+
+			index += data.size() > start? data.size() - start : 0;
+			start = 0;
+		}
+
+		return npos;
+	}
+
+	/**
+	 * @brief Retrieves the container's allocator.
 	 * 
-	 * @param string std::string_view to be serialised with a prefix.
+	 * @return The memory allocator.
+	 */
+	auto& get_allocator() {
+		return allocator_;
+	}
+
+	/**
+	 * @brief Retrieves the container's allocator.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return The memory allocator.
 	 */
-	binary_stream& operator<<(std::string_view string) requires writeable<buf_type> {
-		return *this << prefixed(string);
+	auto& get_allocator() const {
+		return allocator_;
+	}
+
+	template<typename buffer_type>
+	friend class buffer_sequence;
+};
+
+} // hexi
+
+// #include <hexi/dynamic_tls_buffer.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/dynamic_buffer.h>
+
+// #include <hexi/allocators/tls_block_allocator.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/allocators/block_allocator.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#include <array>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef NDEBUG
+#define HEXI_DEBUG_ALLOCATORS
+#endif
+
+namespace hexi {
+
+namespace detail {
+
+struct free_block {
+	free_block* next;
+};
+
+template<decltype(auto) size>
+concept gt_zero = size > 0;
+
+template<typename T, typename U>
+concept sizeof_gte = sizeof(T) >= sizeof(U);
+
+} // detail
+
+using namespace detail;
+
+struct no_validate_dealloc {};
+struct validate_dealloc : no_validate_dealloc {};
+
+/**
+ * Basic fixed-size block stack allocator that preallocates a slab of memory
+ * capable of holding a compile-time determined number of elements.
+ * When constructed, a linked list of chunks is built within the slab and
+ * each allocation request will take the head node. Since the allocations
+ * are fixed-size, the list does not need to be traversed for a suitable
+ * size. Deallocations place the chunk as the new head (LIFO).
+ *
+ * If the preallocated slab runs out of chunks, it will fall back to using the
+ * system allocator rather than allocating additional slabs. This means sizing
+ * the initial allocation correctly is important for maximum performance, so
+ * it's better to be pessimistic. This is a server application and RAM is cheap. :)
+ *
+ * PagePolicy: 'lock' requests that the OS does not page out the memory slab to disk.
+ *
+ * ThreadPolicy: 'same_thread' triggers an assert if an allocated object
+ * is deallocated from a different thread. Used by the TLS allocator, since
+ * implementing the functionality there is messier (and slower).
+ */
+template<typename _ty, 
+	std::size_t _elements,
+	std::derived_from<no_validate_dealloc> ValidatePolicy = no_validate_dealloc>
+requires gt_zero<_elements> && sizeof_gte<_ty, free_block>
+class block_allocator {
+	using tid_type = std::conditional_t<
+		std::is_same_v<ValidatePolicy, validate_dealloc>, std::thread::id, std::monostate
+	>;
+
+	struct mem_block {
+		_ty obj;
+
+		struct {
+			[[no_unique_address]] tid_type thread_id;
+			bool using_new;
+		} meta;
+	};
+
+	static constexpr auto block_size = sizeof(mem_block);
+
+	free_block* head_ = nullptr;
+	[[no_unique_address]] tid_type thread_id_;
+	std::array<char, block_size * _elements> storage_;
+
+	void initialise_free_list() {
+		auto storage = storage_.data();
+
+		for(std::size_t i = 0; i < _elements; ++i) {
+			auto block = reinterpret_cast<free_block*>(storage + (block_size * i));
+			push(block);
+		}
+	}
+
+	inline void push(free_block* block) {
+		assert(block);
+		block->next = head_;
+		head_ = block;
+	}
+
+	[[nodiscard]] inline free_block* pop() {
+		if(!head_) {
+			return nullptr;
+		}
+
+		auto block = head_;
+		head_ = block->next;
+		return block;
+	}
+
+public:
+#ifdef HEXI_DEBUG_ALLOCATORS
+	std::size_t storage_active_count = 0;
+	std::size_t new_active_count = 0;
+	std::size_t active_count = 0;
+	std::size_t total_allocs = 0;
+	std::size_t total_deallocs = 0;
+#endif
+
+	block_allocator() requires std::same_as<ValidatePolicy, validate_dealloc>
+		: thread_id_(std::this_thread::get_id()) {
+		initialise_free_list();
+	}
+
+	block_allocator() {
+		initialise_free_list();
+	}
+
+	template<typename ...Args>
+	[[nodiscard]] inline _ty* allocate(Args&&... args) {
+		auto block = reinterpret_cast<mem_block*>(pop());
+
+		if(block) [[likely]] {
+#ifdef HEXI_DEBUG_ALLOCATORS
+			++storage_active_count;
+#endif
+			block->meta.using_new = false;
+		} else {
+#ifdef HEXI_DEBUG_ALLOCATORS
+			++new_active_count;
+#endif
+			block = new mem_block;
+			block->meta.using_new = true;
+		}
+
+		if constexpr(std::is_same_v<ValidatePolicy, validate_dealloc>) {
+			block->meta.thread_id = thread_id_;
+		}
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+		++total_allocs;
+		++active_count;
+#endif
+		return new (&block->obj) _ty(std::forward<Args>(args)...);
+	}
+
+	inline void deallocate(_ty* t) {
+		assert(t);
+		auto block = reinterpret_cast<mem_block*>(t);
+
+		if constexpr(std::is_same_v<ValidatePolicy, validate_dealloc>) {
+			assert(block->meta.thread_id == thread_id_
+				&& "thread policy violation or clobbered block");
+		}
+
+		if(block->meta.using_new) [[unlikely]] {
+#ifdef HEXI_DEBUG_ALLOCATORS
+			--new_active_count;
+#endif
+			t->~_ty();
+			delete block;
+		} else {
+#ifdef HEXI_DEBUG_ALLOCATORS
+			--storage_active_count;
+#endif
+			t->~_ty();
+			push(reinterpret_cast<free_block*>(t));
+		}
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+		++total_deallocs;
+		--active_count;
+#endif
+	}
+
+	~block_allocator() {
+#ifdef HEXI_DEBUG_ALLOCATORS
+		assert(active_count == 0);
+#endif
+	}
+};
+
+} // hexi
+
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef NDEBUG
+#define HEXI_DEBUG_ALLOCATORS
+#endif
+
+namespace hexi {
+
+struct safe_entrant {};
+struct no_ref_counting {};
+
+struct unsafe_entrant : safe_entrant {};
+struct ref_counting : no_ref_counting {};
+
+template<typename _ty,
+	std::size_t _elements,
+	std::derived_from<no_ref_counting> ref_count_policy = no_ref_counting,
+	std::derived_from<safe_entrant> entrant_policy = safe_entrant
+>
+class tls_block_allocator final {
+	using allocator_type = block_allocator<_ty, _elements>;
+
+	using ref_count = std::conditional_t<
+		std::is_same_v<ref_count_policy, ref_counting>, int, std::monostate
+	>;
+
+	using tls_handle_cache = std::conditional_t<
+		std::is_same_v<entrant_policy, unsafe_entrant>, allocator_type*, std::monostate
+	>;
+
+	static inline thread_local std::unique_ptr<allocator_type> allocator_;
+	static inline thread_local ref_count ref_count_{};
+
+	[[no_unique_address]] tls_handle_cache cached_handle_{};
+
+	// Compiler will optimise calls to this out when using unsafe_entrant
+	inline void initialise() {
+		if constexpr(std::is_same_v<entrant_policy, safe_entrant>) {
+			if(!allocator_) {
+				allocator_ = std::make_unique<allocator_type>();
+			}
+		}
 	}
 
-	/**
-	 * @brief Serialises an std::string with a fixed-length prefix.
-	 * 
-	 * @param string std::string to be serialised with a prefix.
+	inline allocator_type* allocator_handle() {
+		if constexpr(std::is_same_v<entrant_policy, unsafe_entrant>) {
+			return cached_handle_;
+		} else {
+			return allocator_.get();
+		}
+	}
+
+public:
+#ifdef HEXI_DEBUG_ALLOCATORS
+	std::size_t total_allocs = 0;
+	std::size_t total_deallocs = 0;
+	std::size_t active_allocs = 0;
+#endif
+
+	tls_block_allocator() {
+		thread_enter();
+	}
+
+	/*
+	 * When used in conjunction with unsafe_entrant, allows the owning object
+	 * to be executed on another thread without paying for checks on every
+	 * allocation
 	 * 
-	 * @return Reference to the current stream.
+	 * @note If ref counting is enabled, the count will be incremented.
 	 */
-	binary_stream& operator<<(const std::string& string) requires writeable<buf_type> {
-		return *this << prefixed(string);
+	inline void thread_enter() {
+		if(!allocator_) {
+			allocator_ = std::make_unique<allocator_type>();
+		}
+
+		if constexpr(std::is_same_v<entrant_policy, unsafe_entrant>) {
+			cached_handle_ = allocator_.get();
+		}
+
+		if constexpr(std::is_same_v<ref_count_policy, ref_counting>) {
+			++ref_count_;
+		}
 	}
 
-	/**
-	 * @brief Serialises a C-style string.
-	 * 
-	 * @param data string to be serialised.
-	 * 
-	 * @note The null terminator for this string will also be written. It will
-	 * not be prefixed.
+	/*
+	 * When used in conjunction with unsafe_entrant, signals that the current
+	 * thread not make further calls into the allocator.
 	 * 
-	 * @return Reference to the current stream.
+	 * @note If ref counting is enabled, the count will be decremented.
 	 */
-	binary_stream& operator<<(const char* data) requires writeable<buf_type> {
-		assert(data);
-		const auto len = std::strlen(data);
-		write(data, len + 1); // include terminator
-		return *this;
-	}
+	inline void thread_exit() {
+		if constexpr(std::is_same_v<ref_count_policy, ref_counting>) {
+			assert(ref_count_);
 
-	binary_stream& operator<<(const is_iterable auto& data) requires writeable<buf_type> {
-		write_container(data);
-		return *this;
+			--ref_count_;
+
+			if(ref_count_ == 0) {
+				allocator_.reset();
+			}
+		}
 	}
 
-	/**
-	 * @brief Serialises an iterable container.
-	 * 
-	 * @tparam T The iterable container type.
-	 * @param adaptor The container to be serialised.
+	/*
+	 * @brief Allocates and constructs an object.
 	 * 
-	 * @note A fixed-length prefix representing the number of elements in the
-	 * container will be written before the elements.
+	 * @tparam Args Variadic arguments to be forwarded to the object's constructor.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return Pointer to the allocated object.
 	 */
-	template<is_iterable T>
-	binary_stream& operator<<(prefixed<T> adaptor) requires writeable<buf_type> {
-		const auto count = static_cast<std::uint32_t>(adaptor->size());
-		write(endian::native_to_little(count));
-		write_container(adaptor.str);
-		return *this;
+	template<typename ...Args>
+	[[nodiscard]] inline _ty* allocate(Args&&... args) {
+		/*
+		 * When safe_entrant is set, need to do this here & in ctor unless
+		 * we can be 100% sure that any object using the allocator is created
+		 * on the same thread that ends up using it.
+		 */
+		initialise();
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+		++total_allocs;
+		++active_allocs;
+#endif
+		return allocator_handle()->allocate(std::forward<Args>(args)...);
 	}
 
-	/**
-	 * @brief Serialises an iterable container.
-	 * 
-	 * @tparam T The iterable container type.
-	 * @param adaptor The container to be serialised.
-	 * 
-	 * @note A variable-length prefix representing the number of elements in the
-	 * container will be written before the elements.
+	/*
+	 * @brief Deallocates and destructs an object.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param t The object to be deallocated.
 	 */
-	template<is_iterable T>
-	binary_stream& operator<<(prefixed_varint<T> adaptor) requires writeable<buf_type> {
-		varint_encode(*this, adaptor->size());
-		write_container(adaptor.str);
-		return *this;
+	inline void deallocate(_ty* t) {
+		assert(t);
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+		++total_deallocs;
+		--active_allocs;
+#endif
+		allocator_handle()->deallocate(t);
+	}
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+	auto allocator() {
+		initialise();
+		return allocator_handle();
+	}
+#endif
+
+	~tls_block_allocator() {
+		thread_exit();
+
+#ifdef HEXI_DEBUG_ALLOCATORS
+		assert(active_allocs == 0);
+#endif
 	}
+};
+
+} // hexi
+
+#include <cstddef>
+
+namespace hexi {
+
+// dynamic_buffer backed by thread-local storage, meaning every
+// instance on the same thread shares the same underlying memory.
+// As a rule of thumb, an instance should never be touched by any thread
+// other than the one on which it was created, not even if synchronised
+// ... unless you're positive it won't result in the allocator being called.
+// 
+// Minimum memory usage is intrusive_storage<block_size> * count.
+// Additional blocks are not added if the original is exhausted ('colony' structure),
+// so the allocator will fall back to the system allocator instead.
+//
+// Pros: extremely fast allocation/deallocation for many instances per thread
+// Cons: everything else.
+// 
+// TL;DR Do not use unless you know what you're doing.
+template<decltype(auto) block_size,
+	std::size_t count,
+	typename ref_count_policy = no_ref_counting,
+	typename entrant_policy = safe_entrant,
+	typename storage_type = std::byte>
+using dynamic_tls_buffer = dynamic_buffer<block_size, storage_type,
+	tls_block_allocator<typename dynamic_buffer<block_size>::storage_type, count, no_ref_counting, entrant_policy>
+>;
+
+} // hexi
+
+// #include <hexi/exception.h>
+
+// #include <hexi/endian.h>
+
+// #include <hexi/file_buffer.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/exception.h>
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+#include <filesystem>
+#include <utility>
+#include <cstddef>
+#include <cstdio>
+
+namespace hexi {
+
+using namespace detail;
+
+class file_buffer final {
+public:
+	using size_type       = std::size_t;
+	using offset_type     = long;
+	using value_type      = char;
+	using contiguous      = is_non_contiguous;
+	using seeking         = unsupported;
+
+	static constexpr auto npos { static_cast<size_type>(-1) };
+
+private:
+	FILE* file_ = nullptr;
+	offset_type read_ = 0;
+	offset_type write_ = 0;
+	bool error_ = false;
 
 	/**
-	 * @brief Writes a contiguous range to the stream.
-	 * 
-	 * @param data The contiguous range to be written to the stream.
-	 */
-	template<std::ranges::contiguous_range range>
-	void put(const range& data) requires writeable<buf_type> {
-		const auto write_size = data.size() * sizeof(typename range::value_type);
-		write(data.data(), write_size);
+	* @brief Explicitly close the underlying file handle.
+	* 
+	* This function will be called by the object's destructor
+	* and does not need to be called explicitly.
+	* 
+	* @note Idempotent.
+	*/
+	void close() {
+		if(file_) {
+			std::fclose(file_);
+			file_ = nullptr;
+		}
 	}
 
-	/**
-	 * @brief Writes a the provided value to the stream.
-	 * 
-	 * @param data The value to be written to the stream.
-	 */
-	void put(const arithmetic auto& data) requires writeable<buf_type> {
-		write(&data, sizeof(data));
-	}
+public:
+	file_buffer(const std::filesystem::path& path)
+		: file_buffer(path.string().c_str()) { }
 
-	/**
-	 * @brief Writes data to the stream.
-	 * 
-	 * @param adaptor The element to be written to the stream.
-	 */
-	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	void put(const endian_func& adaptor) requires writeable<buf_type> {
-		const auto swapped = adaptor.to();
-		write(&swapped, sizeof(swapped));
+	file_buffer(const char* path) {
+		file_ = std::fopen(path, "a+b");
+		
+		if(!file_) {
+			error_ = true;
+			return;
+		}
+		
+		if(std::fseek(file_, 0, SEEK_END)) {
+			error_ = true;
+			return;
+		}
+
+		write_ = std::ftell(file_);
+
+		if(write_ == -1) {
+			error_ = true;
+		}
 	}
 
-	/**
-	 * @brief Writes count elements from the provided buffer to the stream.
-	 * 
-	 * @tparam T POD type.
-	 * @param data Pointer to the buffer from which data will be copied to the stream.
-	 * @param count The number of elements to write.
-	 */
-	template<pod T>
-	void put(const T* data, size_type count) requires writeable<buf_type> {
-		const auto write_size = count * sizeof(T);
-		write(data, write_size);
+	file_buffer(file_buffer&& rhs) noexcept
+		: file_(rhs.file_),
+		  read_(rhs.read_),
+		  write_(rhs.write_),
+		  error_(rhs.error_) {
+		rhs.file_ = nullptr;
 	}
 
-	/**
-	 * @brief Writes the data from the iterator range to the stream.
-	 * 
-	 * @tparam It The iterator type.
-	 * @param begin Iterator to the beginning of the data.
-	 * @param end Iterator to the end of the data.
-	 */
-	template<typename It>
-	void put(It begin, const It end) requires writeable<buf_type> {
-		for(auto it = begin; it != end; ++it) {
-			*this << *it;
-		}
+	file_buffer& operator=(file_buffer&& rhs) noexcept {
+		std::exchange(file_, rhs.file_);
+		read_ = rhs.read_;
+		write_ = rhs.write_;
+		error_ = rhs.error_;
+		return *this;
 	}
 
-	/**
-	 * @brief Allows for writing a provided byte value a specified number of times to
-	 * the stream.
-	 * 
-	 * @tparam size The number of bytes to generate.
-	 * @param value The byte value that will fill the specified number of bytes.
-	 */
-	template<size_type size>
-	constexpr void fill(const std::uint8_t value) requires writeable<buf_type> {
-		const auto filled = generate_filled<size>(value);
-		write(filled.data(), filled.size());
+	file_buffer& operator=(const file_buffer&) = delete;
+	file_buffer(const file_buffer&) = delete;
+
+	~file_buffer() {
+		close();
 	}
 
-	/*** Read ***/
 
 	/**
-	 * @brief Deserialises an object that provides a deserialise function:
-	 * void serialise(auto& stream);
-	 * 
-	 * @param[out] object The object to be deserialised.
+	 * @brief Flush unwritten data.
 	 */
-	void deserialise(auto& object) {
-		stream_read_adaptor adaptor(*this);
-		object.serialise(adaptor);
+	void flush() {
+		std::fflush(file_);
 	}
 
 	/**
-	 * @brief Deserialises an object that provides a deserialise function:
-	 * void serialise(auto& stream);
-	 * 
-	 * @param[out] data The object to be serialised.
+	 * @brief Reads a number of bytes to the provided buffer.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param destination The buffer to copy the data to.
 	 */
 	template<typename T>
-	requires has_deserialise<T, binary_stream>
-	binary_stream& operator>>(T& data) {
-		deserialise(data);
-		return *this;
+	void read(T* destination) {
+		read(destination, sizeof(T));
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
-	 * 
-	 * @param[out] adaptor std::string to hold the result.
+	 * @brief Reads a number of bytes to the provided buffer.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param destination The buffer to copy the data to.
+	 * @param length The number of bytes to read into the buffer.
 	 */
-	binary_stream& operator>>(prefixed<std::string> adaptor) {
-		std::uint32_t size = 0;
-		*this >> endian::le(size);
-
-		if(state_ != stream_state::ok) {
-			return *this;
+	void read(void* destination, size_type length) {
+		if(error_) {
+			return;
 		}
 
-		STREAM_READ_BOUNDS_ENFORCE(size, *this);
-
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
-			buffer_.read(strbuf, size);
-			return size;
-		});
-
-		return *this;
-	}
-
-	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
-	 * 
-	 * @param[out] adaptor std::string_view to hold the result.
-	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten or
-	 * relocated (std::vector).
-	 * 
-	 * @return Reference to the current stream.
-	 */
-	binary_stream& operator>>(prefixed<std::string_view> adaptor) {
-		std::uint32_t size = 0;
-		*this >> endian::le(size);
+		if(std::fseek(file_, read_, 0)) {
+			error_ = true;
+			return;
+		}
 
-		if(state_ != stream_state::ok) {
-			return *this;
+		if(std::fread(destination, length, 1, file_) != 1) {
+			error_ = true;
+			return;
 		}
 
-		adaptor.str = std::string_view { span<char>(size) };
-		return *this;
+		read_ += length;
 	}
-	
+
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * variable-length prefix.
-	 * 
-	 * @param[out] adaptor std::string to hold the result.
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the read cursor.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param destination The buffer to copy the data to.
 	 */
-	binary_stream& operator>>(prefixed_varint<std::string> adaptor) {
-		const auto size = varint_decode<size_type>(*this);
-
-		// if an error was triggered during decode
-		if(state_ != stream_state::ok) {
-			return *this;
-		}
-
-		STREAM_READ_BOUNDS_ENFORCE(size, *this);
-
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
-			buffer_.read(strbuf, size);
-			return size;
-		});
-
-		return *this;
+	template<typename T>
+	void copy(T* destination) {
+		copy(destination, sizeof(T));
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * variable-length prefix.
-	 * 
-	 * @param[out] adaptor std::string_view to hold the result.
-	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten or
-	 * relocated (std::vector).
+	 * @brief Copies a number of bytes to the provided buffer but without advancing
+	 * the read cursor.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
 	 */
-	binary_stream& operator>>(prefixed_varint<std::string_view> adaptor) {
-		const auto size = varint_decode<size_type>(*this);
+	void copy(void* destination, size_type length) {
+		if(error_) {
+			return;
+		} else if(length > size()) {
+			error_ = true;
+			HEXI_THROW(buffer_underrun(length, read_, size()));
+		}
 
-		// if an error was triggered during decode
-		if(state_ != stream_state::ok) {
-			return *this;
+		if(std::fseek(file_, read_, SEEK_SET)) {
+			error_ = true;
+			return;
 		}
 		
-		adaptor.str = std::string_view { span<char>(size) };
-		return *this;
+		if(std::fread(destination, length, 1, file_) != 1) {
+			error_ = true;
+			return;
+		}
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * null terminator.
+	 * @brief Attempts to locate the provided value within the container.
 	 * 
-	 * @param[out] adaptor std::string to hold the result.
+	 * @param value The value to locate.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return The position of value or npos if not found.
 	 */
-	binary_stream& operator>>(null_terminated<std::string> adaptor) {
-		auto pos = buffer_.find_first_of(value_type(0));
+	size_type find_first_of(value_type val) noexcept {
+		if(error_) {
+			return npos;
+		}
 
-		if(pos == buf_type::npos) {
-			adaptor->clear();
-			return *this;
+		if(std::fseek(file_, read_, SEEK_SET)) {
+			error_ = true;
+			return npos;
 		}
 
-		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+		value_type buffer{};
+
+		for(size_type i = 0, j = size(); i < j; ++i) {
+			if(std::fread(&buffer, sizeof(value_type), 1, file_) != 1) {
+				error_ = true;
+				return npos;
+			}
 
-		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t size) {
-			buffer_.read(strbuf, pos);
-			return size;
-		});
+			if(buffer == val) {
+				return i;
+			}
+		}
 
-		// no need to enforce bounds, we know there's enough data
-		buffer_.skip(1); // skip null terminator
-		return *this;
+		return npos;
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * null terminator.
-	 * 
-	 * @param[out] adaptor std::string_view to hold the result.
-	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten (i.e.
-	 * buffer adaptor with optimise disabled).
+	 * @brief Skip a requested number of bytes.
+	 *
+	 * Skips over a number of bytes from the file. This should be used
+	 * if the file holds data that you don't care about but don't want
+	 * to have to read it to another buffer to access data beyond it.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param length The number of bytes to skip.
 	 */
-	binary_stream& operator>>(null_terminated<std::string_view> adaptor) {
-		adaptor.str = view();
-		return *this;
+	void skip(const size_type length) {
+		read_ += length;
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
-	 * 
-	 * @param[out] data std::string_view to hold the result.
-	 * 
-	 * @note The string_view's lifetime is tied to that of the underlying
-	 * buffer. You should not make any further writes to the buffer
-	 * unless you know it will not cause the data to be overwritten or
-	 * relocated (std::vector).
+	 * @brief Whether the container is empty.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return Returns true if the container is empty (has no data to be read).
 	 */
-	binary_stream& operator>>(std::string_view& data) {
-		return *this >> prefixed(data);
+	[[nodiscard]]
+	bool empty() const {
+		return write_ == read_;
 	}
 
 	/**
-	 * @brief Deserialises a string that was previously written with a
-	 * fixed-length prefix.
+	 * @brief Determine whether the adaptor supports write seeking.
 	 * 
-	 * @param[out] data std::string to hold the result.
+	 * This is determined at compile-time and does not need to checked at
+	 * run-time.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return True if write seeking is supported, otherwise false.
 	 */
-	binary_stream& operator>>(std::string& data) {
-		return *this >> prefixed(data);
+	constexpr static bool can_write_seek() {
+		return std::is_same_v<seeking, supported>;
 	}
 
 	/**
-	 * @brief Deserialises an object that provides a deserialise function:
-	 * auto& operator>>(auto& stream);
-	 * 
-	 * @param[out] data The object to be deserialised.
+	 * @brief Write data to the container.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param source Pointer to the data to be written.
 	 */
-	binary_stream& operator>>(has_shr_override<binary_stream> auto&& data) {
-		return *this >> data;
+	void write(const auto& source) {
+		write(&source, sizeof(source));
 	}
 
 	/**
-	 * @brief Deserialises an arithmetic type with the requested byte order.
-	 * 
-	 * @param[out] endian_func The arithmetic type wrapped by the adaptor.
+	 * @brief Write provided data to the file.
 	 * 
-	 * @return Reference to the current stream.
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
 	 */
-	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	binary_stream& operator>>(endian_func adaptor) {
-		SAFE_READ(&adaptor.value, sizeof(adaptor.value), *this);
-		adaptor.value = adaptor.from();
-		return *this;
+	void write(const void* source, size_type length) {
+		if(error_) {
+			return;
+		}
+		
+		if(std::fseek(file_, write_, SEEK_SET)) {
+			error_ = true;
+			return;
+		}
+
+		if(std::fwrite(source, length, 1, file_) != 1) {
+			error_ = true;
+			return;
+		}
+
+		write_ += length;
 	}
 
+
 	/**
-	 * @brief Deserialises an arithmetic point type with the default byte order.
-	 * 
-	 * @param[out] data The arithmetic type.
+	 * @brief Returns the amount of data available in the file.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return The number of bytes of data available to read from the file.
 	 */
-	binary_stream& operator>>(arithmetic auto& data) {
-		SAFE_READ(&data, sizeof(data), *this);
-		endian::storage_out(data, byte_order);
-		return *this;
+	size_type size() const {
+		return static_cast<size_type>(write_) - read_;
 	}
 
-	/**
-	 * @brief Deserialises a POD type.
-	 * 
-	 * @tparam T The type of the POD object.
-	 * @param[out] data The object to hold the result.
-	 * 
-	 * @note Will not be used for types with user-defined serialisation
-	 * functions.
+	/** 
+	 * @brief Retrieve the file handle.
 	 * 
-	 * @return Reference to the current stream.
+	 * @return The file handle.
 	 */
-	template<pod T>
-	requires (!has_shr_override<T, binary_stream> && !arithmetic<T>)
-	binary_stream& operator>>(T& data) {
-		SAFE_READ(&data, sizeof(data), *this);
-		return *this;
+	FILE* handle() {
+		return file_;
 	}
 
-	/**
-	 * @brief Deserialises an iterable container that was previously written
-	 * with a fixed-length prefix.
+	/** 
+	 * @brief Retrieve the file handle.
 	 * 
-	 * @tparam T The iterable container type.
-	 * @param[out] adaptor The container to hold the result.
-	 *
-	 * @return Reference to the current stream.
+	 * @return The file handle.
 	 */
-	template<is_iterable T>
-	binary_stream& operator>>(prefixed<T> adaptor) {
-		std::uint32_t count = 0;
-		*this >> endian::le(count);
-		read_container(adaptor.str, count);
-		return *this;
+	const FILE* handle() const {
+		return file_;
 	}
 
-	/**
-	 * @brief Deserialises an iterable container that was previously written
-	 * with a variable-length prefix.
-	 * 
-	 * @tparam T The iterable container type.
-	 * @param[out] adaptor The container to hold the result.
-	 *  
-	 * @return Reference to the current stream.
+	/** 
+	 * @return True if an error has occurred during file operations.
 	 */
-	template<is_iterable T>
-	binary_stream& operator>>(prefixed_varint<T> adaptor) {
-		const auto count = varint_decode<size_type>(*this);
-		read_container(adaptor.str, count);
+	bool error() const {
+		return error_;
+	}
+
+	/** 
+	 * @return True if no error has occurred during file operations.
+	 */
+	operator bool() const {
+		return !error();
+	}
+};
+
+} // hexi
+
+// #include <hexi/fixed_string.h>
+
+// #include <hexi/fixed_vector.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/exception.h>
+
+// #include <hexi/shared.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Vector with inline storage for up to N elements, for fields with a hard
+ * maximum element count. Elements are only constructed as they're added.
+ *
+ * When deserialised, an element count greater than N puts the stream into
+ * an error state rather than being truncated.
+ *
+ * @tparam T The element type.
+ * @tparam N The maximum number of elements.
+ */
+template<typename T, std::size_t N>
+requires (N > 0)
+class fixed_vector final {
+	alignas(T) std::byte storage_[sizeof(T) * N];
+	std::size_t size_ = 0;
+
+	void check_capacity(const std::size_t size) const {
+		if(size > N) {
+			HEXI_THROW(capacity_exceeded(size, N));
+		}
+	}
+
+	T* ptr(const std::size_t index) {
+		return reinterpret_cast<T*>(storage_) + index;
+	}
+
+	const T* ptr(const std::size_t index) const {
+		return reinterpret_cast<const T*>(storage_) + index;
+	}
+
+public:
+	using value_type      = T;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = T&;
+	using const_reference = const T&;
+	using pointer         = T*;
+	using const_pointer   = const T*;
+	using iterator        = T*;
+	using const_iterator  = const T*;
+
+	fixed_vector() = default;
+
+	fixed_vector(std::initializer_list<T> values) {
+		check_capacity(values.size());
+
+		for(const auto& value : values) {
+			emplace_back(value);
+		}
+	}
+
+	fixed_vector(const fixed_vector& rhs) {
+		for(const auto& value : rhs) {
+			emplace_back(value);
+		}
+	}
+
+	fixed_vector(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		for(auto& value : rhs) {
+			emplace_back(std::move(value));
+		}
+
+		rhs.clear();
+	}
+
+	fixed_vector& operator=(const fixed_vector& rhs) {
+		if(this != &rhs) {
+			clear();
+
+			for(const auto& value : rhs) {
+				emplace_back(value);
+			}
+		}
+
+		return *this;
+	}
+
+	fixed_vector& operator=(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if(this != &rhs) {
+			clear();
+
+			for(auto& value : rhs) {
+				emplace_back(std::move(value));
+			}
+
+			rhs.clear();
+		}
+
 		return *this;
 	}
 
+	~fixed_vector() {
+		clear();
+	}
+
+	template<typename ...Args>
+	T& emplace_back(Args&&... args) {
+		check_capacity(size_ + 1);
+		auto element = std::construct_at(ptr(size_), std::forward<Args>(args)...);
+		++size_;
+		return *element;
+	}
+
+	void push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	void push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	void pop_back() {
+		assert(size_);
+		std::destroy_at(ptr(--size_));
+	}
+
+	void resize(const size_type size) {
+		check_capacity(size);
+
+		while(size_ > size) {
+			pop_back();
+		}
+
+		while(size_ < size) {
+			emplace_back();
+		}
+	}
+
 	/**
-	 * @brief Read an arithmetic type from the stream.
-	 * 
-	 * @param[out] dest The variable to hold the result.
+	 * @brief Removes the elements in the range [first, last), shifting
+	 * any subsequent elements down.
+	 *
+	 * @return Iterator following the last removed element.
 	 */
-	void get(arithmetic auto& dest) {
-		SAFE_READ(&dest, sizeof(dest), void());
+	iterator erase(const_iterator first, const_iterator last) {
+		auto dest = begin() + (first - begin());
+		auto src = begin() + (last - begin());
+		auto new_end = std::move(src, end(), dest);
+
+		while(end() != new_end) {
+			pop_back();
+		}
+
+		return dest;
 	}
 
-	/**
-	 * @brief Read an arithmetic type from the stream.
-	 * 
-	 * @return The arithmetic value.
-	 */
-	template<arithmetic T>
-	T get() {
-		T t{};
-		SAFE_READ(&t, sizeof(T), t);
-		return t;
+	iterator erase(const_iterator pos) {
+		return erase(pos, pos + 1);
 	}
 
-	/**
-	 * @brief Read an arithmetic type from the stream, allowing for endian
-	 * conversion.
-	 * 
-	 * @param[out] adaptor The destination for the read value.
-	 */
-	template<std::derived_from<endian::adaptor_tag_t> endian_func>
-	void get(endian_func& adaptor) {
-		SAFE_READ(&adaptor.value, sizeof(adaptor), void());
-		adaptor.value = adaptor.from();
+	void clear() {
+		std::destroy(begin(), end());
+		size_ = 0;
 	}
 
-	/**
-	 * @brief Read an arithmetic type from the stream, allowing for endian
-	 * conversion.
-	 * 
-	 * @return The arithmetic value.
-	 */
-	template<arithmetic T, endian::conversion conversion>
-	T get() {
-		T t{};
-		SAFE_READ(&t, sizeof(T), t);
-		return endian::convert<conversion>(t);
+	T& operator[](const size_type index) {
+		assert(index < size_);
+		return *ptr(index);
 	}
 
-	/**
-	 * @brief Reads a string from the stream.
-	 * 
-	 * @param[out] dest The std::string to hold the result.
-	 * 
-	 * @param dest The destination string.
-	 */
-	void get(std::string& dest) {
-		*this >> dest;
+	const T& operator[](const size_type index) const {
+		assert(index < size_);
+		return *ptr(index);
 	}
 
-	/**
-	 * @brief Reads a fixed-length string from the stream.
-	 * 
-	 * @param[out] dest The std::string to hold the result.
-	 * @param count The number of bytes to be read.
-	 */
-	void get(std::string& dest, size_type size) {
-		STREAM_READ_BOUNDS_ENFORCE(size, void());
+	T& front() {
+		assert(size_);
+		return *ptr(0);
+	}
 
-		dest.resize_and_overwrite(size, [&](char* strbuf, size_type len) {
-			buffer_.read(strbuf, len);
-			return len;
-		});
+	const T& front() const {
+		assert(size_);
+		return *ptr(0);
 	}
 
-	/**
-	 * @brief Read data from the stream into the provided destination argument.
-	 * 
-	 * @param[out] dest The destination buffer.
-	 * @param count The number of elements to be read to the destination.
-	 */
-	template<typename T>
-	void get(T* dest, size_type count) {
-		assert(dest);
-		const auto read_size = count * sizeof(T);
-		SAFE_READ(dest, read_size, void());
+	T& back() {
+		assert(size_);
+		return *ptr(size_ - 1);
 	}
 
-	/**
-	 * @brief Read data from the stream to the destination represented by the iterators.
-	 * 
-	 * @param[out] begin The beginning iterator.
-	 * @param end The end iterator.
-	 */
-	template<typename It>
-	void get(It begin, const It end) {
-		for(; begin != end; ++begin) {
-			*this >> *begin;
-		}
+	const T& back() const {
+		assert(size_);
+		return *ptr(size_ - 1);
 	}
 
-	/**
-	 * @brief Read data from the stream into the provided destination argument.
-	 * 
-	 * @param[out] dest A contiguous range into which the data should be read.
-	 */
-	template<std::ranges::contiguous_range range>
-	void get(range& dest) {
-		const auto read_size = dest.size() * sizeof(typename range::value_type);
-		SAFE_READ(dest.data(), read_size, void());
+	T* data() {
+		return ptr(0);
 	}
 
-	/**
-	 * @brief Skip over a number of bytes.
-	 *
-	 * Skips over a number of bytes from the stream. This should be used
-	 * if the stream holds data that you don't care about but don't want
-	 * to have to read it to another buffer to access data beyond it.
-	 * 
-	 * @param length The number of bytes to skip.
-	 */
-	void skip(const size_type length) {
-		STREAM_READ_BOUNDS_ENFORCE(length, void());
-		buffer_.skip(length);
+	const T* data() const {
+		return ptr(0);
 	}
 
-	/**
-	 * @brief Provides a string_view over the stream's data, up to the terminator value.
-	 * 
-	 * @param terminator An optional terminating/sentinel value.
-	 * 
-	 * @return A string view over data up to the provided terminator.
-	 * An empty string_view if a terminator is not found
-	 */
-	std::string_view view(value_type terminator = value_type(0)) requires contiguous<buf_type> {
-		const auto pos = buffer_.find_first_of(terminator);
+	size_type size() const {
+		return size_;
+	}
 
-		if(pos == buf_type::npos) {
-			return {};
-		}
+	static constexpr size_type capacity() {
+		return N;
+	}
 
-		std::string_view view { reinterpret_cast<char*>(buffer_.read_ptr()), pos };
+	static constexpr size_type max_size() {
+		return N;
+	}
 
-		// no need to enforce bounds, we know there's enough data
-		buffer_.skip(pos + 1);
-		total_read_ += (pos + 1);
-		return view;
+	bool empty() const {
+		return size_ == 0;
 	}
 
-	/**
-	 * @brief Provides a span over the specified number of elements in the stream.
-	 * 
-	 * @param count The number of elements the span will provide a view over.
-	 * 
-	 * @return A span representing a view over the requested number of elements
-	 * in the stream.
-	 * 
-	 * @note The stream will error if the stream does not contain the requested amount of data.
-	 */
-	template<typename out_type = value_type>
-	std::span<out_type> span(size_type count) requires contiguous<buf_type> {
-		std::span view { reinterpret_cast<out_type*>(buffer_.read_ptr()), count };
-		skip(sizeof(out_type) * count);
-		return (state_ == stream_state::ok? view : std::span<out_type>());
+	bool full() const {
+		return size_ == N;
 	}
 
-	/**  Misc functions **/
+	iterator begin() {
+		return ptr(0);
+	}
 
-	/**
-	 * @brief Determine whether the adaptor supports write seeking.
-	 * 
-	 * This is determined at compile-time and does not need to checked at
-	 * run-time.
-	 * 
-	 * @return True if write seeking is supported, otherwise false.
-	 */
-	constexpr static bool can_write_seek() requires writeable<buf_type> {
-		return std::is_same_v<seeking, supported>;
+	const_iterator begin() const {
+		return ptr(0);
 	}
 
-	/**
-	 * @brief Performs write seeking within the stream.
-	 * 
-	 * @param direction Specify whether to seek in a given direction or to absolute seek.
-	 * @param offset The offset relative to the seek direction or the absolute value
-	 * when using absolute seeking.
-	 */
-	void write_seek(const stream_seek direction, const offset_type offset)
-	requires(seekable<buf_type> && writeable<buf_type>) {
-		if(direction == stream_seek::sk_stream_absolute) {
-			if(offset >= total_write_) {
-				buffer_.write_seek(buffer_seek::sk_forward, offset - total_write_);
-			} else {
-				buffer_.write_seek(buffer_seek::sk_backward, total_write_ - offset);
+	iterator end() {
+		return ptr(size_);
+	}
+
+	const_iterator end() const {
+		return ptr(size_);
+	}
+
+	bool operator==(const fixed_vector& rhs) const {
+		return std::equal(begin(), end(), rhs.begin(), rhs.end());
+	}
+};
+
+} // hexi
+
+// #include <hexi/frames.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * A single-pass input range over the complete length-prefixed frames in a
+ * buffer. Each element is a span over a frame's payload, excluding its
+ * length prefix.
+ *
+ * Frames are viewed in place where possible, which is always the case for
+ * contiguous buffers, and for dynamic_buffer when a frame doesn't straddle
+ * two blocks. Otherwise the frame is copied into storage owned by the range.
+ *
+ * A frame is only consumed from the buffer once the iterator is advanced
+ * past it, so the span is valid until then. Iteration stops when the
+ * remaining data doesn't contain a complete frame, leaving any partial
+ * frame in the buffer for when more data arrives, or when a frame's length
+ * is invalid, in which case the range is put into an error state and the
+ * offending frame is left unconsumed.
+ *
+ * @tparam buf_type The buffer type.
+ * @tparam length_type The type of the length prefix.
+ * @tparam endianness The byte order of the length prefix.
+ */
+template<byte_oriented buf_type, std::unsigned_integral length_type,
+	std::derived_from<endian::storage_tag> endianness>
+class frame_range final
+	: public std::ranges::view_interface<frame_range<buf_type, length_type, endianness>> {
+public:
+	using size_type  = typename buf_type::size_type;
+	using value_type = typename buf_type::value_type;
+	using frame_type = std::span<const value_type>;
+
+private:
+	static constexpr size_type header_size = sizeof(length_type);
+
+	buf_type* buffer_ = nullptr;
+	size_type max_length_ = 0;
+	size_type consumed_ = 0;
+	stream_state state_ = stream_state::ok;
+	bool done_ = false;
+	frame_type frame_;
+	std::vector<value_type> scratch_;
+
+	bool valid_length(const size_type length) {
+		if(max_length_ && length > max_length_) [[unlikely]] {
+			state_ = stream_state::read_limit_err;
+			return false;
+		}
+
+		// a frame that could never fit into the buffer can't be completed
+		if constexpr(fixed_capacity<buf_type>) {
+			if(length > buf_type::capacity() - header_size) [[unlikely]] {
+				state_ = stream_state::capacity_err;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void next() {
+		if(consumed_) {
+			buffer_->skip(consumed_);
+			consumed_ = 0;
+		}
+
+		if(buffer_->size() < header_size) {
+			done_ = true;
+			return;
+		}
+
+		length_type prefix = 0;
+		buffer_->copy(&prefix, header_size);
+		endian::storage_out(prefix, endianness{});
+		const auto length = static_cast<size_type>(prefix);
+
+		if(!valid_length(length) || buffer_->size() - header_size < length) {
+			done_ = true;
+			return;
+		}
+
+		consumed_ = header_size + length;
+
+		if constexpr(std::is_same_v<typename buf_type::contiguous, is_contiguous>) {
+			frame_ = { reinterpret_cast<const value_type*>(buffer_->read_ptr()) + header_size, length };
+			return;
+		} else if constexpr(requires { buffer_->front()->read_ptr(); buffer_->front()->size(); }) {
+			const auto block = buffer_->front();
+
+			if(block->size() >= consumed_) {
+				frame_ = { block->read_ptr() + header_size, length };
+				return;
 			}
+		}
+
+		// the frame straddles multiple blocks, so it has to be copied
+		buffer_->skip(header_size);
+		consumed_ = length;
+		scratch_.resize(length);
+		buffer_->copy(scratch_.data(), length);
+		frame_ = scratch_;
+	}
+
+public:
+	class iterator {
+		frame_range* range_ = nullptr;
+
+	public:
+		using value_type      = frame_type;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(frame_range* range) : range_(range) {}
+
+		frame_type operator*() const {
+			return range_->frame_;
+		}
+
+		iterator& operator++() {
+			range_->next();
+			return *this;
+		}
+
+		void operator++(int) {
+			++*this;
+		}
 
-			total_write_ = offset;
-		} else {
-			buffer_.write_seek(static_cast<buffer_seek>(direction), offset);
+		bool operator==(std::default_sentinel_t) const {
+			return range_->done_;
 		}
-	}
+	};
+
+	frame_range() = default;
 
 	/**
-	 * @brief Returns the size of the underlying buffer.
-	 * 
-	 * @note The value returned may be higher than the total number of bytes
-	 * that can be read from this stream, if a read limit was set during
-	 * construction. Use read_max() to determine how many bytes can be
-	 * read from this stream.
-	 * 
-	 * @return The size of the underlying buffer.
+	 * @param buffer The buffer to read frames from.
+	 * @param max_length The maximum permitted frame length, excluding the
+	 * length prefix, or zero for no limit.
 	 */
-	size_type size() const {
-		return buffer_.size();
-	}
+	explicit frame_range(buf_type& buffer, const size_type max_length = 0)
+		: buffer_(&buffer), max_length_(max_length) {}
 
 	/**
-	 * @brief Whether the stream is empty.
-	 * 
-	 * @return Returns true if the stream is empty (has no data to be read).
+	 * @brief Finds the first complete frame and returns an iterator to it.
+	 *
+	 * @note As this is an input range, begin() must only be called once.
 	 */
-	[[nodiscard]]
-	bool empty() const {
-		return buffer_.empty();
+	iterator begin() {
+		next();
+		return iterator(this);
 	}
 
-	/**
-	 * @return The total number of bytes written to the stream.
-	 */
-	size_type total_write() const requires writeable<buf_type> {
-		return total_write_;
+	std::default_sentinel_t end() const {
+		return {};
 	}
 
-	/**
-	 * @return Pointer to stream's underlying buffer.
-	 */
-	const buf_type* buffer() const {
-		return &buffer_;
+	stream_state state() const {
+		return state_;
 	}
 
-	/**
-	 * @return Pointer to stream's underlying buffer.
-	 */
-	buf_type* buffer() {
-		return &buffer_;
+	bool good() const {
+		return state_ == stream_state::ok;
 	}
 
-	/**
-	 * @return The stream's state.
-	 */
-	stream_state state() const {
-		return state_;
+	operator bool() const {
+		return good();
 	}
+};
 
-	/**
-	 * @return The total number of bytes read from the stream.
-	 */
-	size_type total_read() const {
-		return total_read_;
+/**
+ * @brief Creates a range over the complete length-prefixed frames in the
+ * buffer, e.g:
+ *
+ * for(auto frame : hexi::frames<std::uint16_t, hexi::endian::as_big_t>(buffer)) { ... }
+ *
+ * @tparam length_type The type of the length prefix.
+ * @tparam endianness The byte order of the length prefix.
+ * @param buffer The buffer to read frames from.
+ * @param max_length The maximum permitted frame length, excluding the
+ * length prefix, or zero for no limit.
+ *
+ * @return The frame range.
+ */
+template<std::unsigned_integral length_type,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+	byte_oriented buf_type>
+auto frames(buf_type& buffer, const typename buf_type::size_type max_length = 0) {
+	return frame_range<buf_type, length_type, endianness>(buffer, max_length);
+}
+
+} // hexi
+
+// #include <hexi/intern_pool.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * Thread-safe pool of interned strings.
+ *
+ * Each distinct string is stored once and the views handed out remain valid
+ * for the lifetime of the pool, so repeated strings cost a hash lookup rather
+ * than an allocation. Strings are never removed.
+ *
+ * The pool is split into shards, each with its own lock, to reduce
+ * contention when interning from multiple threads.
+ */
+class intern_pool final {
+	static constexpr std::size_t shard_bits = 4;
+	static constexpr std::size_t shard_count = std::size_t(1) << shard_bits;
+
+	// a string along with its precomputed hash, so that picking the shard
+	// and searching its set only hashes the string once
+	struct hashed_key {
+		std::string_view string;
+		std::size_t hash;
+	};
+
+	struct string_hash {
+		using is_transparent = void;
+
+		std::size_t operator()(const std::string_view string) const {
+			return std::hash<std::string_view>{}(string);
+		}
+
+		std::size_t operator()(const hashed_key& key) const {
+			return key.hash;
+		}
+	};
+
+	struct string_equal {
+		using is_transparent = void;
+
+		bool operator()(const std::string_view lhs, const std::string_view rhs) const {
+			return lhs == rhs;
+		}
+
+		bool operator()(const hashed_key& lhs, const std::string_view rhs) const {
+			return lhs.string == rhs;
+		}
+
+		bool operator()(const std::string_view lhs, const hashed_key& rhs) const {
+			return lhs == rhs.string;
+		}
+	};
+
+	using set_type = std::unordered_set<std::string, string_hash, string_equal>;
+
+	struct shard {
+		mutable std::shared_mutex lock;
+		set_type strings;
+	};
+
+	std::array<shard, shard_count> shards_;
+
+	static hashed_key make_key(const std::string_view string) {
+		return { string, string_hash{}(string) };
 	}
 
-	/**
-	 * @return If provided to the constructor, the upper limit on how much data
-	 * can be read from this stream before an error is triggers.
+	/*
+	 * The sets pick their buckets from the low bits of the hash, so the
+	 * shard is chosen with the high bits to keep the two independent
 	 */
-	size_type read_limit() const {
-		return read_limit_;
+	static std::size_t shard_index(const hashed_key& key) {
+		return key.hash >> (std::numeric_limits<std::size_t>::digits - shard_bits);
 	}
 
-	/**
-	 * @brief Determine the maximum number of bytes that can be
-	 * safely read from this stream.
-	 * 
-	 * The value returned may be lower than the amount of data
-	 * available in the buffer if a read limit was set during
-	 * the stream's construction.
-	 * 
-	 * @return The number of bytes available for reading.
-	 */
-	size_type read_max() const {
-		if(read_limit_) {
-			assert(total_read_ < read_limit_);
-			return read_limit_ - total_read_;
-		} else {
-			return buffer_.size();
-		}
+	shard& shard_for(const hashed_key& key) {
+		return shards_[shard_index(key)];
+	}
+
+	const shard& shard_for(const hashed_key& key) const {
+		return shards_[shard_index(key)];
 	}
 
+public:
+	intern_pool() = default;
+	intern_pool(const intern_pool&) = delete;
+	intern_pool& operator=(const intern_pool&) = delete;
+
 	/**
-	 * @brief Determine whether the stream is in a usable state.
-	 * 
-	 * @return true if no errors have occurred.
+	 * @brief Retrieves the interned copy of a string, adding it to the pool
+	 * if it isn't already present.
+	 *
+	 * @param string The string to intern.
+	 *
+	 * @return A view of the interned string, valid for the lifetime of the pool.
 	 */
-	bool good() const {
-		return state_ == stream_state::ok;
+	std::string_view intern(const std::string_view string) {
+		const auto key = make_key(string);
+		auto& shard = shard_for(key);
+
+		{
+			std::shared_lock guard(shard.lock);
+
+			if(auto it = shard.strings.find(key); it != shard.strings.end()) {
+				return *it;
+			}
+		}
+
+		std::unique_lock guard(shard.lock);
+		return *shard.strings.emplace(string).first;
 	}
 
 	/**
-	 * @brief Resets the stream state back to a good state, allowing
-	 * it to be used for streaming operations again. Has no effect
-	 * if the stream has not errored.
+	 * @brief Looks up a string without adding it to the pool.
+	 *
+	 * @param string The string to find.
+	 *
+	 * @return A view of the interned string, if present.
 	 */
-	void clear_error_state() {
-		state_ = stream_state::ok;
-	}
+	std::optional<std::string_view> find(const std::string_view string) const {
+		const auto key = make_key(string);
+		const auto& shard = shard_for(key);
+		std::shared_lock guard(shard.lock);
 
-	operator bool() const {
-		return good();
+		if(auto it = shard.strings.find(key); it != shard.strings.end()) {
+			return *it;
+		}
+
+		return std::nullopt;
 	}
 
 	/**
-	 * @brief Set the stream to an error state.
+	 * @return The number of distinct strings in the pool.
 	 */
-	void set_error_state() {
-		state_ = stream_state::user_defined_err;
+	std::size_t size() const {
+		std::size_t count = 0;
+
+		for(const auto& shard : shards_) {
+			std::shared_lock guard(shard.lock);
+			count += shard.strings.size();
+		}
+
+		return count;
 	}
 };
 
-#undef SAFE_READ
-#undef STREAM_READ_BOUNDS_ENFORCE
-
 } // hexi
 
-// #include <hexi/buffer_adaptor.h>
+// #include <hexi/shared.h>
+
+// #include <hexi/static_buffer.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -1674,14 +8875,15 @@ public:
 
 
 
+// #include <hexi/exception.h>
+
 // #include <hexi/shared.h>
 
 // #include <hexi/concepts.h>
 
-// #include <hexi/exception.h>
-
-#include <ranges>
-#include <type_traits>
+#include <array>
+#include <bit>
+#include <span>
 #include <utility>
 #include <cassert>
 #include <cstddef>
@@ -1691,47 +8893,37 @@ namespace hexi {
 
 using namespace detail;
 
-template<byte_oriented buf_type, bool space_optimise = true>
-requires std::ranges::contiguous_range<buf_type>
-class buffer_adaptor final {
+template<byte_type storage_type, std::size_t buf_size>
+class static_buffer final {
+	std::array<storage_type, buf_size> buffer_ = {};
+	std::size_t read_ = 0;
+	std::size_t write_ = 0;
+
 public:
-	using value_type  = typename buf_type::value_type;
-	using size_type   = typename buf_type::size_type;
-	using offset_type = typename buf_type::size_type;
-	using contiguous  = is_contiguous;
-	using seeking     = supported;
+	using size_type       = typename decltype(buffer_)::size_type;
+	using offset_type     = size_type;
+	using value_type      = storage_type;
+	using contiguous      = is_contiguous;
+	using seeking         = supported;
 
 	static constexpr auto npos { static_cast<size_type>(-1) };
+	
+	constexpr static_buffer() = default;
 
-private:
-	buf_type& buffer_;
-	size_type read_;
-	size_type write_;
-
-public:
-	buffer_adaptor(buf_type& buffer)
-		: buffer_(buffer),
-		  read_(0),
-		  write_(buffer.size()) {}
-
-	buffer_adaptor(buf_type& buffer, init_empty_t)
-		: buffer_(buffer),
-		  read_(0),
-		  write_(0) {}
+	template<typename... T> 
+	constexpr static_buffer(T&&... vals) : buffer_{ std::forward<T>(vals)... } {
+		write_ = sizeof... (vals);
+	}
 
-	buffer_adaptor(buffer_adaptor&& rhs) = delete;
-	buffer_adaptor& operator=(buffer_adaptor&&) = delete;
-	buffer_adaptor& operator=(const buffer_adaptor&) = delete;
-	buffer_adaptor(const buffer_adaptor&) = delete;
+	constexpr static_buffer(static_buffer&& rhs) = default;
+	constexpr static_buffer& operator=(static_buffer&&) = default;
+	constexpr static_buffer& operator=(const static_buffer&) = default;
+	constexpr static_buffer(const static_buffer&) = default;
 
 	/**
 	 * @brief Reads a number of bytes to the provided buffer.
 	 * 
-	 * @note The destination buffer must not overlap with the underlying buffer
-	 * being used by the buffer_adaptor.
-	 * 
-	 * @tparam T The destination type.
-	 * @param[out] destination The buffer to copy the data to.
+	 * @param destination The buffer to copy the data to.
 	 */
 	template<typename T>
 	void read(T* destination) {
@@ -1741,21 +8933,15 @@ public:
 	/**
 	 * @brief Reads a number of bytes to the provided buffer.
 	 * 
-	 * @note The destination buffer must not overlap with the underlying buffer
-	 * being used by the buffer_adaptor.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
+	 * @param destination The buffer to copy the data to.
 	 * @param length The number of bytes to read into the buffer.
 	 */
 	void read(void* destination, size_type length) {
-		assert(destination);
 		copy(destination, length);
 		read_ += length;
 
-		if constexpr(space_optimise) {
-			if(read_ == write_) {
-				read_ = write_ = 0;
-			}
+		if(read_ == write_) {
+			read_ = write_ = 0;
 		}
 	}
 
@@ -1763,7 +8949,7 @@ public:
 	 * @brief Copies a number of bytes to the provided buffer but without advancing
 	 * the read cursor.
 	 * 
-	 * @param[out] destination The buffer to copy the data to.
+	 * @param destination The buffer to copy the data to.
 	 */
 	template<typename T>
 	void copy(T* destination) const {
@@ -1774,15 +8960,38 @@ public:
 	 * @brief Copies a number of bytes to the provided buffer but without advancing
 	 * the read cursor.
 	 * 
-	 * @note The destination buffer must not overlap with the underlying buffer
-	 * being used by the buffer_adaptor.
+	 * @note The destination buffer address must not belong to the static_buffer.
+	 * 
+	 * @param destination The buffer to copy the data to.
+	 * @param length The number of bytes to copy.
+	 */
+	void copy(void* destination, size_type length) const {
+		assert(!region_overlap(buffer_.data(), buffer_.size(), destination, length));
+
+		if(length > size()) {
+			HEXI_THROW(buffer_underrun(length, read_, size()));
+		}
+
+		std::memcpy(destination, read_ptr(), length);
+	}
+
+	/**
+	 * @brief Attempts to locate the provided value within the container.
 	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 * @param length The number of bytes to copy.
+	 * @param value The value to locate.
+	 * 
+	 * @return The position of value or npos if not found.
 	 */
-	void copy(void* destination, size_type length) const {
-		assert(destination && !region_overlap(buffer_.data(), buffer_.size(), destination, length));
-		std::memcpy(destination, read_ptr(), length);
+	constexpr size_type find_first_of(value_type val) const noexcept {
+		const auto data = read_ptr();
+
+		for(size_type i = 0, j = size(); i < j; ++i) {
+			if(data[i] == val) {
+				return i;
+			}
+		}
+
+		return npos;
 	}
 
 	/**
@@ -1794,107 +9003,62 @@ public:
 	 * 
 	 * @param length The number of bytes to skip.
 	 */
-	void skip(size_type length) {
+	constexpr void skip(const size_type length) {
 		read_ += length;
 
-		if constexpr(space_optimise) {
-			if(read_ == write_) {
-				read_ = write_ = 0;
-			}
+		if(read_ == write_) {
+			read_ = write_ = 0;
 		}
 	}
 
 	/**
-	 * @brief Write data to the container.
-	 * 
-	 * @note The source buffer must not overlap with the underlying buffer
-	 * being used by the buffer_adaptor.
+	 * @brief Advances the write cursor.
 	 * 
-	 * @param source Pointer to the data to be written.
+	 * @param size The number of bytes by which to advance the write cursor.
 	 */
-	void write(const auto& source) {
-		write(&source, sizeof(source));
+	constexpr void advance_write(size_type bytes) {
+		assert(free() >= bytes);
+		write_ += bytes;
 	}
 
 	/**
-	 * @brief Write provided data to the container.
+	 * @brief Resizes the buffer.
 	 * 
-	 * @note The source buffer must not overlap with the underlying buffer
-	 * being used by the buffer_adaptor.
+	 * @param size The new size of the buffer.
 	 * 
-	 * @param source Pointer to the data to be written.
-	 * @param length Number of bytes to write from the source.
 	 */
-	void write(const void* source, size_type length) {
-		assert(source && !region_overlap(source, length, buffer_.data(), buffer_.size()));
-		const auto min_req_size = write_ + length;
-
-		if(buffer_.size() < min_req_size) [[likely]] {
-			if constexpr(has_resize_overwrite<buf_type>) {
-				buffer_.resize_and_overwrite(min_req_size, [](char*, size_type size) {
-					return size;
-				});
-			} else if constexpr(has_resize<buf_type>) {
-				buffer_.resize(min_req_size);
-			} else {
-				HEXI_THROW(buffer_overflow(length, write_, free()));
-			}
+	constexpr void resize(size_type size) {
+		if(size > buffer_.size()) {
+			HEXI_THROW(exception("attempted to resize static_buffer to larger than capacity"));
 		}
 
-		std::memcpy(write_ptr(), source, length);
-		write_ += length;
+		write_ = size;
 	}
 
 	/**
-	 * @brief Reserves a number of bytes within the container for future use.
-	 * 
-	 * @note This is a non-binding request, meaning the buffer may not reserve
-	 * any additional space, such as in the case where it is not supported.
-	 *
-	 * @param length The number of bytes that the container should reserve.
+	 * @brief Clears the container.
 	 */
-	void reserve(const size_type length) {
-		if constexpr(has_reserve<buf_type>) {
-			buffer_.reserve(length);
-		}
+	constexpr void clear() {
+		read_ = write_ = 0;
 	}
 
 	/**
-	 * @brief Attempts to locate the provided value within the container.
+	 * @brief Moves any unread data to the front of the buffer, freeing space at the end.
+	 * If a move is performed, pointers obtained from read/write_ptr() will be invalidated.
 	 * 
-	 * @param value The value to locate.
+	 * If the buffer contains no data available for reading, this function will have no effect.
 	 * 
-	 * @return The position of value or npos if not found.
+	 * @return True if additional space was made available.
 	 */
-	size_type find_first_of(value_type val) const {
-		const auto data = read_ptr();
-
-		for(size_type i = 0, j = size(); i < j; ++i) {
-			if(data[i] == val) {
-				return i;
-			}
+	bool defragment() {
+		if(read_ == 0) {
+			return false;
 		}
 
-		return npos;
-	}
-	
-	/**
-	 * @brief Returns the size of the container.
-	 * 
-	 * @return The number of bytes of data available to read within the container.
-	 */
-	size_type size() const {
-		return write_ - read_;
-	}
-
-	/**
-	 * @brief Whether the container is empty.
-	 * 
-	 * @return Returns true if the container is empty (has no data to be read).
-	 */
-	[[nodiscard]]
-	bool empty() const {
-		return read_ == write_;
+		write_ = size();
+		std::memmove(buffer_.data(), read_ptr(), write_);
+		read_ = 0;
+		return true;
 	}
 
 	/**
@@ -1904,7 +9068,7 @@ public:
 	 * 
 	 * @return A reference to the value at the specified index.
 	 */
-	value_type& operator[](const size_type index) {
+	constexpr value_type& operator[](const size_type index) {
 		return read_ptr()[index];
 	}
 
@@ -1915,10 +9079,27 @@ public:
 	 * 
 	 * @return A reference to the value at the specified index.
 	 */
-	const value_type& operator[](const size_type index) const {
+	constexpr const value_type& operator[](const size_type index) const {
 		return read_ptr()[index];
 	}
 
+	/**
+	 * @brief Whether the container is empty.
+	 * 
+	 * @return Returns true if the container is empty (has no data to be read).
+	 */
+	[[nodiscard]]
+	constexpr bool empty() const {
+		return write_ == read_;
+	}
+
+	/**
+	 * @return Whether the container is full and cannot be further written to.
+	 */
+	constexpr bool full() const {
+		return write_ == capacity();
+	}
+
 	/**
 	 * @brief Determine whether the adaptor supports write seeking.
 	 * 
@@ -1931,6 +9112,67 @@ public:
 		return std::is_same_v<seeking, supported>;
 	}
 
+	/**
+	 * @brief Write data to the container.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 */
+	constexpr void write(const auto& source) {
+		if consteval {
+			const auto bytes = std::bit_cast<std::array<value_type, sizeof(source)>>(source);
+			write(bytes.data(), bytes.size());
+		} else {
+			write(&source, sizeof(source));
+		}
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * Equivalent to write(const void*, size_type) but also usable in a
+	 * constant expression.
+	 * 
+	 * @note The source buffer address must not belong to the static_buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 */
+	template<byte_type T>
+	constexpr void write(const T* source, size_type length) {
+		if consteval {
+			if(free() < length) {
+				HEXI_THROW(buffer_overflow(length, write_, free()));
+			}
+
+			for(size_type i = 0; i < length; ++i) {
+				buffer_[write_ + i] = static_cast<value_type>(source[i]);
+			}
+
+			write_ += length;
+		} else {
+			write(static_cast<const void*>(source), length);
+		}
+	}
+
+	/**
+	 * @brief Write provided data to the container.
+	 * 
+	 * @note The source buffer address must not belong to the static_buffer.
+	 * 
+	 * @param source Pointer to the data to be written.
+	 * @param length Number of bytes to write from the source.
+	 */
+	void write(const void* source, size_type length) {
+		assert(!region_overlap(source, length, buffer_.data(), buffer_.size()));
+
+		if(free() < length) {
+			HEXI_THROW(buffer_overflow(length, write_, free()));
+		}
+
+		std::memcpy(write_ptr(), source, length);
+		write_ += length;
+	}
+
 	/**
 	 * @brief Performs write seeking within the container.
 	 * 
@@ -1938,7 +9180,7 @@ public:
 	 * @param offset The offset relative to the seek direction or the absolute value
 	 * when using absolute seeking.
 	 */
-	void write_seek(const buffer_seek direction, const offset_type offset) {
+	constexpr void write_seek(const buffer_seek direction, const size_type offset) {
 		switch(direction) {
 			case buffer_seek::sk_backward:
 				write_ -= offset;
@@ -1952,221 +9194,186 @@ public:
 	}
 
 	/**
-	 * @return Pointer to the data available for reading.
+	 * @return An iterator to the beginning of data available for reading.
 	 */
-	auto read_ptr() const {
-		return buffer_.data() + read_;
+	constexpr auto begin() {
+		return buffer_.begin() + read_;
 	}
 
 	/**
-	 * @return Pointer to the data available for reading.
+	 * @return An iterator to the beginning of data available for reading.
 	 */
-	auto read_ptr() {
-		return buffer_.data() + read_;
+	constexpr auto begin() const {
+		return buffer_.begin() + read_;
 	}
 
 	/**
-	 * @return Pointer to the location within the buffer where the next write
-	 * will be made.
+	 * @return An iterator to the end of data available for reading.
 	 */
-	auto write_ptr() const {
-		return buffer_.data() + write_;
+	constexpr auto end() {
+		return buffer_.begin() + write_;
 	}
 
 	/**
-	 * @return Pointer to the location within the buffer where the next write
-	 * will be made.
+	 * @return An iterator to the end of data available for reading.
 	 */
-	auto write_ptr() {
-		return buffer_.data() + write_;
+	constexpr auto end() const {
+		return buffer_.begin() + write_;
+	}
+
+	/**
+	 * @brief Overall capacity of the container.
+	 * 
+	 * @return The container's total size in bytes.
+	 */
+	constexpr static size_type capacity() {
+		return buf_size;
+	}
+
+	/**
+	 * @brief Returns the size of the container.
+	 * 
+	 * @return The number of bytes of data available to read within the container.
+	 */
+	constexpr size_type size() const {
+		return write_ - read_;
+	}
+
+	/**
+	 * @brief The amount of free space.
+	 * 
+	 * @return The number of bytes of free space within the container.
+	 */
+	constexpr size_type free() const {
+		return buf_size - write_;
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	auto data() const {
+	constexpr const value_type* data() const {
+		return read_ptr();
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	constexpr value_type* data() {
+		return read_ptr();
+	}
+
+	/**
+	 * @return Pointer to the data available for reading.
+	 */
+	constexpr const value_type* read_ptr() const {
 		return buffer_.data() + read_;
 	}
 
 	/**
 	 * @return Pointer to the data available for reading.
 	 */
-	auto data() {
+	constexpr value_type* read_ptr() {
 		return buffer_.data() + read_;
 	}
 
 	/**
-	 * @return Pointer to the underlying storage.
+	 * @return Pointer to the location within the buffer where the next write
+	 * will be made.
 	 */
-	auto storage() const {
-		return buffer_.data();
+	constexpr const value_type* write_ptr() const {
+		return buffer_.data() + write_;
+	}
+
+	/**
+	 * @return Pointer to the location within the buffer where the next write
+	 * will be made.
+	 */
+	constexpr value_type* write_ptr() {
+		return buffer_.data() + write_;
 	}
 
 	/**
 	 * @return Pointer to the underlying storage.
 	 */
-	auto storage() {
+	constexpr value_type* storage() {
 		return buffer_.data();
 	}
 
 	/**
-	 * @brief Advances the write cursor.
-	 * 
-	 * @param size The number of bytes by which to advance the write cursor.
+	 * @return Pointer to the underlying storage.
 	 */
-	void advance_write(size_type bytes) {
-		assert(buffer_.size() >= (write_ + bytes));
-		write_ += bytes;
+	constexpr const value_type* storage() const {
+		return buffer_.data();
 	}
 
 	/**
-	 * @brief The amount of space left in the container.
+	 * @brief Retrieves a span representing the data available for reading contained within
+	 * underlying storage.
 	 * 
-	 * @return The number of free bytes.
+	 * @return A span over the data waiting to be read from the container.
 	 */
-	auto free() const {
-		return buffer_.size() - write_;
+	constexpr std::span<const value_type> read_span() const {
+		return { read_ptr(), size() };
 	}
-	
-	/*
-	 * @brief Resets both the read and write cursors back to the beginning
-	 * of the buffer.
+
+	/**
+	 * @brief Retrieves a span representing the free space within the underlying storage.
 	 * 
-	 * @note The underlying buffer will not be cleared but should be treated
-	 * as thought it has been.
+	 * @return A span over the container's free space.
 	 */
-	void clear() {
-		read_ = write_ = 0;
+	constexpr std::span<value_type> write_span() {
+		return { write_ptr(), free() };
 	}
 };
 
 } // hexi
 
-// #include <hexi/buffer_sequence.h>
+// #include <hexi/null_buffer.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
 // | | | |  __/>  <| | Version 1.0
 // |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-#if defined HEXI_WITH_ASIO || defined HEXI_WITH_BOOST_ASIO
-
-#ifdef HEXI_WITH_ASIO
-#include <asio/buffer.hpp>
-#elif defined HEXI_WITH_BOOST_ASIO
-#include <boost/asio/buffer.hpp>
-#endif
-
-#ifdef HEXI_BUFFER_DEBUG
-#include <span>
-#endif
-
-namespace hexi {
-
-#ifdef HEXI_WITH_BOOST_ASIO
-namespace asio = boost::asio;
-#endif
-
-template<typename buffer_type>
-class buffer_sequence {
-	const buffer_type& buffer_;
-
-public:
-	buffer_sequence(const buffer_type& buffer)
-		: buffer_(buffer) { }
-
-	class const_iterator {
-		using node = typename buffer_type::node_type;
 
-	public:
-		const_iterator(const buffer_type& buffer, const node* curr_node)
-			: buffer_(buffer),
-			  curr_node_(curr_node) {}
 
-		const_iterator& operator++() {
-			curr_node_ = curr_node_->next;
-			return *this;
-		}
+// #include <hexi/pmc/buffer_write.h>
 
-		const_iterator operator++(int) {
-			const_iterator current(*this);
-			curr_node_ = curr_node_->next;
-			return current;
-		}
+// #include <hexi/shared.h>
 
-		asio::const_buffer operator*() const {
-			const auto buffer = buffer_.buffer_from_node(curr_node_);
-			return buffer->read_data();
-		}
+// #include <hexi/exception.h>
 
-		bool operator==(const const_iterator& rhs) const {
-			return curr_node_ == rhs.curr_node_;
-		}
+#include <cstddef>
 
-		bool operator!=(const const_iterator& rhs) const {
-			return curr_node_ != rhs.curr_node_;
-		}
+namespace hexi {
 
-		const_iterator& operator=(const_iterator&) = delete;
+class null_buffer final : public pmc::buffer_write {
+public:
+	using size_type       = std::size_t;
+	using offset_type     = std::size_t;
+	using value_type      = std::byte;
+	using contiguous      = is_contiguous;
+	using seeking         = unsupported;
 
-	#ifdef HEXI_BUFFER_DEBUG
-		std::span<const char> get_buffer() {
-			auto buffer = buffer_.buffer_from_node(curr_node_);
-			return {
-				reinterpret_cast<const char*>(buffer->read_ptr()), buffer->size()
-			};
-		}
-	#endif
+	void write(const auto& /*elem*/) {}
+	void write(const void* /*source*/, size_type /*length*/) override {};
+	void read(auto* /*elem*/) {}
+	void read(void* /*destination*/, size_type /*length*/) {};
+	void copy(auto* /*elem*/) const {}
+	void copy(void* /*destination*/, size_type /*length*/) const {};
+	void reserve(const size_type /*length*/) override {};
+	size_type size() const override{ return 0; };
+	[[nodiscard]] bool empty() const override { return true; };
+	bool can_write_seek() const override { return false; }
 
-	private:
-		const buffer_type& buffer_;
-		const node* curr_node_;
+	void write_seek(const buffer_seek /*direction*/, const std::size_t /*offset*/) override {
+		HEXI_THROW(exception("Don't do this on a null_buffer")); 
 	};
-
-const_iterator begin() const {
-	return const_iterator(buffer_, buffer_.root_.next);
-}
-
-const_iterator end() const {
-	return const_iterator(buffer_, &buffer_.root_);
-}
-
-friend class const_iterator;
 };
 
 } // hexi
 
-#endif // #if defined HEXI_WITH_ASIO || defined HEXI_WITH_BOOST_ASIO
-// #include <hexi/concepts.h>
-
-// #include <hexi/dynamic_buffer.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
-
-
-
-// #include <hexi/pmc/buffer.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
-
-
-
-// #include <hexi/pmc/buffer_read.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
-
-
-
-// #include <hexi/pmc/buffer_base.h>
+// #include <hexi/object_pool.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -2175,118 +9382,179 @@ friend class const_iterator;
 
 
 
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cassert>
 #include <cstddef>
 
-namespace hexi::pmc {
-
-class buffer_base {
-protected:
-	std::size_t read_ = 0;
-	std::size_t write_ = 0;
+namespace hexi {
 
-public:
-	virtual std::size_t size() const = 0;
-	virtual bool empty() const = 0;
-	virtual ~buffer_base() = default;
-};
+/**
+ * Pool of reusable objects for the deserialisation path.
+ *
+ * Released objects are returned to the pool as they are, rather than being
+ * destroyed, so any storage they own (strings, vectors, etc) is kept for the
+ * next message. Combined with binary_stream::set_reuse_storage, this allows
+ * steady-state decoding to avoid allocations entirely once the pool has
+ * warmed up.
+ *
+ * Not thread-safe. The pool must outlive any handles it hands out.
+ *
+ * @tparam T The pooled type.
+ */
+template<std::default_initializable T>
+class object_pool final {
+	std::vector<std::unique_ptr<T>> free_;
+	std::size_t created_ = 0;
+
+	T* take() {
+		if(free_.empty()) {
+			auto object = std::make_unique<T>();
+
+			// ensure that returning objects never needs to allocate, only
+			// counting the object once nothing else can throw. Growth is
+			// geometric so that a burst of new objects is amortised
+			if(free_.capacity() <= created_) {
+				free_.reserve(std::max<std::size_t>(created_ * 2, 8));
+			}
 
-} // pmc, hexi
+			++created_;
+			return object.release();
+		}
 
-#include <cstddef>
+		auto object = std::move(free_.back());
+		free_.pop_back();
+		return object.release();
+	}
 
-namespace hexi::pmc {
+	void release(T* object) {
+		assert(free_.size() < free_.capacity());
+		free_.emplace_back(object);
+	}
 
-class buffer_read : virtual public buffer_base {
 public:
-	using value_type = std::byte;
-
-	static constexpr auto npos { static_cast<std::size_t>(-1) };
-
-	virtual ~buffer_read() = default;
-	virtual void read(void* destination, std::size_t length) = 0;
-	virtual void copy(void* destination, std::size_t length) const = 0;
-	virtual	void skip(std::size_t length) = 0;
-	virtual const std::byte& operator[](const std::size_t index) const = 0;
-	virtual std::size_t find_first_of(std::byte val) const = 0;
-};
-
-} // pmc, hexi
-
-// #include <hexi/pmc/buffer_write.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
-
+	using size_type = std::size_t;
 
+	/**
+	 * Owning handle to a pooled object. Returns the object to the pool
+	 * when destroyed.
+	 */
+	class handle final {
+		object_pool* pool_ = nullptr;
+		T* object_ = nullptr;
 
-// #include <hexi/pmc/buffer_base.h>
-
-// #include <hexi/shared.h>
+		friend class object_pool;
 
-#include <cstddef>
+		handle(object_pool* pool, T* object)
+			: pool_(pool), object_(object) {}
 
-namespace hexi::pmc {
+	public:
+		handle() = default;
 
-class buffer_write : virtual public buffer_base {
-public:
-	using value_type = std::byte;
+		handle(handle&& rhs) noexcept
+			: pool_(std::exchange(rhs.pool_, nullptr)),
+			  object_(std::exchange(rhs.object_, nullptr)) {}
 
-	virtual ~buffer_write() = default;
-	virtual void write(const void* source, std::size_t length) = 0;
-	virtual void reserve(std::size_t length) = 0;
-	virtual bool can_write_seek() const = 0;
-	virtual void write_seek(buffer_seek direction, std::size_t offset) = 0;
-};
+		handle& operator=(handle&& rhs) noexcept {
+			if(this != &rhs) {
+				reset();
+				pool_ = std::exchange(rhs.pool_, nullptr);
+				object_ = std::exchange(rhs.object_, nullptr);
+			}
 
-} // pmc, hexi
+			return *this;
+		}
 
+		handle(const handle&) = delete;
+		handle& operator=(const handle&) = delete;
 
-namespace hexi::pmc {
+		~handle() {
+			reset();
+		}
 
-class buffer : public buffer_read, public buffer_write {
-public:
-	using value_type = std::byte;
+		/**
+		 * @brief Returns the object to the pool early.
+		 */
+		void reset() {
+			if(object_) {
+				pool_->release(object_);
+				object_ = nullptr;
+			}
+		}
 
-	using buffer_read::operator[];
+		T* get() const {
+			return object_;
+		}
 
-	virtual std::byte& operator[](const std::size_t index) = 0;
-	virtual ~buffer() = default;
-};
+		T& operator*() const {
+			return *object_;
+		}
 
-} // pmc, hexi
+		T* operator->() const {
+			return object_;
+		}
 
-// #include <hexi/shared.h>
+		explicit operator bool() const {
+			return object_ != nullptr;
+		}
+	};
 
-// #include <hexi/allocators/default_allocator.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+	/**
+	 * @param count The number of objects to construct up-front.
+	 */
+	explicit object_pool(const size_type count = 0) {
+		free_.reserve(count);
 
+		for(size_type i = 0; i < count; ++i) {
+			free_.emplace_back(std::make_unique<T>());
+		}
 
+		created_ = count;
+	}
 
-#include <utility>
+	object_pool(object_pool&&) = delete;
+	object_pool& operator=(object_pool&&) = delete;
+	object_pool(const object_pool&) = delete;
+	object_pool& operator=(const object_pool&) = delete;
 
-namespace hexi {
+	~object_pool() {
+		assert(free_.size() == created_ && "Pool destroyed with outstanding handles");
+	}
 
-template<typename T>
-struct default_allocator final {
-	template<typename ...Args>
-	[[nodiscard]] inline T* allocate(Args&&... args) const {
-		return new T(std::forward<Args>(args)...);
+	/**
+	 * @brief Takes an object from the pool, constructing a new one if
+	 * none are available.
+	 *
+	 * @note The object retains whatever state it had when it was last
+	 * released.
+	 *
+	 * @return A handle to the object.
+	 */
+	[[nodiscard]] handle acquire() {
+		return { this, take() };
 	}
 
-	inline void deallocate(T* t) const {
-		delete t;
+	/**
+	 * @return The number of objects currently available in the pool.
+	 */
+	size_type available() const {
+		return free_.size();
+	}
+
+	/**
+	 * @return The total number of objects created by the pool.
+	 */
+	size_type created() const {
+		return created_;
 	}
 };
 
 } // hexi
 
-// #include <hexi/detail/intrusive_storage.h>
+// #include <hexi/packet_template.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -2295,992 +9563,802 @@ struct default_allocator final {
 
 
 
-#if _MSC_VER
-#pragma warning(disable : 4996)
-#endif
+// #include <hexi/binary_stream.h>
 
-// #include <hexi/shared.h>
+// #include <hexi/buffer_adaptor.h>
 
 // #include <hexi/concepts.h>
 
+// #include <hexi/endian.h>
+
+// #include <hexi/exception.h>
+
+// #include <hexi/shared.h>
+
+// #include <hexi/static_buffer.h>
+
 #include <array>
 #include <concepts>
 #include <span>
 #include <type_traits>
-#include <cassert>
-#include <cstring>
+#include <utility>
 #include <cstddef>
+#include <cstring>
 
-namespace hexi::detail {
-
-struct intrusive_node {
-	intrusive_node* next;
-	intrusive_node* prev;
-};
-
-template<std::size_t block_size, byte_type storage_type = std::byte>
-struct intrusive_storage final {
-	using value_type = storage_type;
-	using offset_type = std::remove_const_t<decltype(block_size)>;
-
-	offset_type read_offset = 0;
-	offset_type write_offset = 0;
-	intrusive_node node {};
-	std::array<value_type, block_size> storage;
-
-	/**
-	 * @brief Clear the container.
-	 * 
-	 * Resets the read and write offsets, does not explicitly
-	 * erase the data contained within the buffer but should
-	 * be treated as such.
-	 */
-	void clear() {
-		read_offset = 0;
-		write_offset = 0;
-	}
-
-	/**
-	 * @brief Write provided data to the container.
-	 * 
-	 * If the container size is lower than requested number of bytes,
-	 * the request will be capped at the number of bytes available.
-	 * 
-	 * @note The source buffer must not overlap with the underlying buffer.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 * @param length Number of bytes to write from the source.
-	 * 
-	 * @return The number of bytes copied, which may be less than requested.
-	 */
-	std::size_t write(const auto source, std::size_t length) {
-		assert(!region_overlap(source, length, storage.data(), storage.size()));
-		std::size_t write_len = block_size - write_offset;
-
-		if(write_len > length) {
-			write_len = length;
-		}
-
-		std::memcpy(storage.data() + write_offset, source, write_len);
-		write_offset += static_cast<offset_type>(write_len);
-		return write_len;
-	}
-
-	/**
-	 * @brief Copies a number of bytes to the provided buffer but without
-	 * advancing the read cursor.
-	 * 
-	 * If the container size is lower than requested number of bytes,
-	 * the request will be capped at the number of bytes available.
-	 * 
-	 * @note The destination buffer must not overlap with the underlying buffer.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 * @param length The number of bytes to copy.
-	 * 
-	 * @return The number of bytes copied, which may be less than requested.
-	 */
-	std::size_t copy(auto destination, const std::size_t length) const {
-		assert(!region_overlap(storage.data(), storage.size(), destination, length));
-		std::size_t read_len = block_size - read_offset;
+namespace hexi {
 
-		if(read_len > length) {
-			read_len = length;
-		}
+template<arithmetic T, std::derived_from<endian::storage_tag> endianness>
+struct patch_value {
+	std::size_t offset;
+	T value;
 
-		std::memcpy(destination, storage.data() + read_offset, read_len);
-		return read_len;
+	void apply(void* destination) const {
+		const auto converted = endian::storage_in(value, endianness{});
+		std::memcpy(static_cast<std::byte*>(destination) + offset, &converted, sizeof(converted));
 	}
+};
 
-	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * If the container size is lower than requested number of bytes,
-	 * the request will be capped at the number of bytes available.
-	 * 
-	 * @note The destination buffer must not overlap with the underlying buffer.
-	 * 
-	 * @param length The number of bytes to skip.
-	 * @param[out] destination The buffer to copy the data to.
-	 * @param allow_optimise Whether the buffer can reuse its space where possible.
-	 * 
-	 * @return The number of bytes read, which may be less than requested.
-	 */
-	std::size_t read(auto destination, const std::size_t length, const bool allow_optimise = false) {
-		std::size_t read_len = copy(destination, length);
-		read_offset += static_cast<offset_type>(read_len);
+namespace detail {
 
-		if(read_offset == write_offset && allow_optimise) {
-			clear();
-		}
+/*
+ * Whether writing to the buffer makes room for the data, rather than
+ * failing once the buffer's free space runs out.
+ */
+template<typename buf_type>
+struct growable : std::bool_constant<!fixed_capacity<buf_type>> {};
 
-		return read_len;
-	}
+template<typename container_type, bool space_optimise>
+struct growable<buffer_adaptor<container_type, space_optimise>>
+	: std::bool_constant<has_resize<container_type> || has_resize_overwrite<container_type>> {};
 
-	/**
-	 * @brief Skip over a number of bytes.
-	 *
-	 * Skips over a number of bytes in the container. This should be used
-	 * if the container holds data that you don't care about but don't want
-	 * to have to read it to another buffer to access data beyond it.
-	 * 
-	 * If the container size is lower than requested number of bytes,
-	 * the request will be capped at the number of bytes available.
-	 * 
-	 * @param length The number of bytes to skip.
-	 * @param allow_optimise Whether the buffer can reuse its space where possible.
-	 * 
-	 * @return The number of bytes skipped, which may be less than requested.
-	 */
-	std::size_t skip(const std::size_t length, const bool allow_optimise = false) {
-		std::size_t skip_len = block_size - read_offset;
+} // detail
 
-		if(skip_len > length) {
-			skip_len = length;
-		}
+/**
+ * Handle to a field within a packet_template. Calling it with a value
+ * produces a patch that can be passed to stamp(). Handles for fields that
+ * couldn't be added to the template are invalid and any patches made from
+ * them will be rejected by stamp().
+ */
+template<arithmetic T, std::derived_from<endian::storage_tag> endianness>
+struct patch_point {
+	using value_type = T;
 
-		read_offset += static_cast<offset_type>(skip_len);
+	static constexpr auto npos { static_cast<std::size_t>(-1) };
 
-		if(read_offset == write_offset && allow_optimise) {
-			clear();
-		}
+	std::size_t offset;
 
-		return skip_len;
+	constexpr patch_value<T, endianness> operator()(const T value) const {
+		return { offset, value };
 	}
 
-	/**
-	 * @brief Returns the size of the container.
-	 * 
-	 * @return The number of bytes available to read within the container.
-	 */
-	std::size_t size() const {
-		return write_offset - read_offset;
+	constexpr bool valid() const {
+		return offset != npos;
 	}
+};
 
-	/**
-	 * @brief The amount of free space.
-	 * 
-	 * @return The number of bytes of free space within the container.
-	 */
-	std::size_t free() const {
-		return block_size - write_offset;
-	}
+/**
+ * Serialise once, stamp many.
+ *
+ * Holds a pre-serialised packet along with the locations of any fields that
+ * need to change between sends (sequence numbers, timestamps, etc). Stamping
+ * out a copy is then a memcpy of the template plus a store for each patched
+ * field, rather than a full serialisation.
+ *
+ * @tparam capacity The maximum size of the serialised packet.
+ * @tparam endianness The default byte order for the packet's fields.
+ * @tparam storage_type The byte type used for the template's storage.
+ */
+template<std::size_t capacity,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t,
+	byte_type storage_type = std::byte,
+	std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG>
+class packet_template final {
+	using buffer_type = static_buffer<storage_type, capacity>;
+
+	buffer_type buffer_;
+	stream_state state_ = stream_state::ok;
 
-	/**
-	 * @brief Performs write seeking within the container.
-	 * 
-	 * @param direction Specify whether to seek in a given direction or to absolute seek.
-	 * @param offset The offset relative to the seek direction or the absolute value
-	 * when using absolute seeking.
-	 */
-	void write_seek(const buffer_seek direction, const std::size_t offset) {
-		switch(direction) {
-			case buffer_seek::sk_absolute:
-				write_offset = offset;
-				break;
-			case buffer_seek::sk_backward:
-				write_offset -= static_cast<offset_type>(offset);
-				break;
-			case buffer_seek::sk_forward:
-				write_offset += static_cast<offset_type>(offset);
-				break;
+	template<typename stream_type>
+	void update_state(const stream_type& stream) {
+		if(state_ == stream_state::ok) {
+			state_ = stream.state();
 		}
 	}
 
-	/**
-	 * @brief Advances the write cursor.
-	 * 
-	 * If the requested number of bytes exceeds the free space, the
-	 * request will be capped at the amount of free space.
-	 * 
-	 * @param size The number of bytes by which to advance the write cursor.
-	 * 
-	 * @return The number of bytes the write cursor was advanced by, which
-	 * may be less than requested.
-	 */
-	std::size_t advance_write(std::size_t size) {
-		const auto remaining = free();
+	template<typename patch_type>
+	bool in_bounds(const patch_type& patch) const {
+		const auto size = buffer_.size();
 
-		if(remaining < size) {
-			size = remaining;
+		if(patch.offset <= size && sizeof(patch.value) <= size - patch.offset) [[likely]] {
+			return true;
 		}
 
-		write_offset += static_cast<offset_type>(size);
-		return size;
-	}
-
-	/**
-	 * @brief Retrieve a pointer to the readable portion of the buffer.
-	 * 
-	 * @return Pointer to the readable portion of the buffer.
-	 */
-	const value_type* read_ptr() const {
-		return storage.data() + read_offset;
-	}
-
-	/**
-	 * @brief Retrieve a pointer to the readable portion of the buffer.
-	 * 
-	 * @return Pointer to the readable portion of the buffer.
-	 */
-	value_type* read_ptr() {
-		return storage.data() + read_offset;
-	}
-
-	/**
-	 * @brief Retrieve a pointer to the writeable portion of the buffer.
-	 * 
-	 * @return Pointer to the writeable portion of the buffer.
-	 */
-	const value_type* write_ptr () const {
-		return storage.data() + write_offset;
+		if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+			HEXI_THROW(buffer_overflow(sizeof(patch.value), patch.offset, size));
+		}
+
+		return false;
 	}
 
-	/**
-	 * @brief Retrieve a pointer to the writeable portion of the buffer.
-	 * 
-	 * @return Pointer to the writeable portion of the buffer.
-	 */
-	value_type* write_ptr() {
-		return storage.data() + write_offset;
+	template<typename ...patches>
+	bool check_patches(const patches&... values) const {
+		return (in_bounds(values) && ...);
 	}
 
-	/**
-	 * @brief Retrieve a span to the readable portion of the buffer.
-	 * 
-	 * @return Span to the readable portion of the buffer.
-	 */
-	std::span<const value_type> read_data() const {
-		return { storage.data() + read_offset, size() };
+	template<typename ...patches>
+	void stamp_into(void* destination, const patches&... values) const {
+		std::memcpy(destination, buffer_.read_ptr(), buffer_.size());
+		(values.apply(destination), ...);
 	}
 
+public:
+	using size_type  = typename buffer_type::size_type;
+	using value_type = storage_type;
+
 	/**
-	 * @brief Retrieve a span to the readable portion of the buffer.
-	 * 
-	 * @return Span to the readable portion of the buffer.
+	 * @brief Serialises data into the template, with the same semantics
+	 * as binary_stream.
+	 *
+	 * @param data The data to be written.
+	 *
+	 * @return Reference to the current template.
 	 */
-	std::span<value_type> read_data() {
-		return { storage.data() + read_offset, size() } ;
+	template<typename T>
+	packet_template& operator<<(T&& data) {
+		binary_stream<buffer_type, exceptions, endianness> stream(buffer_);
+		stream << data;
+		update_state(stream);
+		return *this;
 	}
 
 	/**
-	 * @brief Retrieve a span to the writeable portion of the buffer.
-	 * 
-	 * @return Span to the writeable portion of the buffer.
-	 */
-	std::span<const value_type> write_data() const {
-		return { storage.data() + write_offset, free() } ;
+	 * @brief Appends a field that can be patched when stamping.
+	 *
+	 * @tparam T The field type.
+	 * @tparam field_endianness The byte order of the field, defaulting to
+	 * that of the template.
+	 * @param initial The value the field will take when it isn't patched.
+	 *
+	 * @return A handle to the field, which will be invalid if the field
+	 * couldn't be written.
+	 */
+	template<arithmetic T,
+		std::derived_from<endian::storage_tag> field_endianness = endianness>
+	patch_point<T, field_endianness> placeholder(const T initial = {}) {
+		const auto offset = buffer_.size();
+		binary_stream<buffer_type, exceptions, field_endianness> stream(buffer_);
+		stream << initial;
+		update_state(stream);
+
+		if(!stream) [[unlikely]] {
+			return { patch_point<T, field_endianness>::npos };
+		}
+
+		return { offset };
 	}
 
 	/**
-	 * @brief Retrieve a span to the writeable portion of the buffer.
-	 * 
-	 * @return Span to the writeable portion of the buffer.
-	 */
-	std::span<value_type> write_data() {
-		return { storage.data() + write_offset, free() } ;
+	 * @brief Marks an existing field within the template as patchable, such
+	 * as a field within a previously serialised object.
+	 *
+	 * @tparam T The field type.
+	 * @tparam field_endianness The byte order of the field, defaulting to
+	 * that of the template.
+	 * @param offset The offset of the field from the start of the template.
+	 *
+	 * @return A handle to the field, which will be invalid if the field
+	 * isn't within the template.
+	 */
+	template<arithmetic T,
+		std::derived_from<endian::storage_tag> field_endianness = endianness>
+	patch_point<T, field_endianness> patch_at(const size_type offset) const {
+		if(offset > buffer_.size() || sizeof(T) > buffer_.size() - offset) [[unlikely]] {
+			return { patch_point<T, field_endianness>::npos };
+		}
+
+		return { offset };
 	}
 
 	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
-	 */
-	value_type& operator[](const std::size_t index) {
-		return *(storage.data() + index);
+	 * @brief Stamps a copy of the template into the provided memory,
+	 * applying the patches.
+	 *
+	 * @param destination The memory to write the packet to. Must be
+	 * at least size() bytes.
+	 * @param values The patches to apply.
+	 *
+	 * @return True if the packet was stamped. Nothing is written if the
+	 * destination is too small or any patch lies outside of the template,
+	 * e.g. one made from an invalid patch point, in which case
+	 * buffer_overflow is thrown if exceptions are enabled.
+	 */
+	template<byte_type T, std::size_t extent, typename ...patches>
+	bool stamp(std::span<T, extent> destination, const patches&... values) const {
+		if(destination.size() < buffer_.size()) [[unlikely]] {
+			if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+				HEXI_THROW(buffer_overflow(buffer_.size(), 0, destination.size()));
+			}
+
+			return false;
+		}
+
+		if(!check_patches(values...)) [[unlikely]] {
+			return false;
+		}
+
+		stamp_into(destination.data(), values...);
+		return true;
 	}
 
 	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
+	 * @brief Stamps a copy of the template into the provided buffer,
+	 * applying the patches.
+	 *
+	 * If the buffer has enough contiguous free space (including a
+	 * dynamic_buffer's tail block), the packet is stamped directly into
+	 * that space. Otherwise, it's stamped into temporary storage and written
+	 * to the buffer, provided that the buffer can grow to fit it.
+	 *
+	 * @param buffer The buffer to write the packet to.
+	 * @param values The patches to apply.
+	 *
+	 * @return True if the packet was stamped. Nothing is written if a
+	 * buffer that can't grow doesn't have enough free space or any patch
+	 * lies outside of the template, e.g. one made from an invalid patch
+	 * point, in which case buffer_overflow is thrown if exceptions are
+	 * enabled.
 	 */
-	const value_type& operator[](const std::size_t index) const {
-		return *(storage.data() + index);
-	}
-};
-
-} // detail, hexi
+	template<writeable buf_type, typename ...patches>
+	bool stamp(buf_type& buffer, const patches&... values) const {
+		const auto size = buffer_.size();
 
-#include <concepts>
-#include <functional>
-#include <memory>
-#include <utility>
-#ifdef HEXI_BUFFER_DEBUG
-#include <algorithm>
-#include <vector>
-#endif
-#include <cstddef>
-#include <cstdint>
-#include <cassert>
+		if(!check_patches(values...)) [[unlikely]] {
+			return false;
+		}
 
-namespace hexi {
+		if constexpr(!detail::growable<buf_type>::value) {
+			if(buffer.free() < size) [[unlikely]] {
+				if constexpr(std::is_same_v<exceptions, allow_throw_t>) {
+					HEXI_THROW(buffer_overflow(size, 0, buffer.free()));
+				}
 
-using namespace detail;
+				return false;
+			}
+		}
 
-template<typename buffer_type>
-class buffer_sequence;
+		if constexpr(direct_writeable<buf_type>) {
+			if(buffer.free() >= size) {
+				stamp_into(buffer.write_ptr(), values...);
+				buffer.advance_write(size);
+				return true;
+			}
+		} else if constexpr(tail_writeable<buf_type>) {
+			const auto tail = buffer.back();
 
-template<decltype(auto) block_sz>
-concept int_gt_zero = std::integral<decltype(block_sz)> && block_sz > 0;
+			if(tail && tail->free() >= size) {
+				stamp_into(tail->write_ptr(), values...);
+				buffer.advance_write(size);
+				return true;
+			}
+		}
 
-template<decltype(auto) block_sz,
-	byte_type storage_value_type = std::byte,
-	typename allocator = default_allocator<detail::intrusive_storage<block_sz, storage_value_type>>
->
-requires int_gt_zero<block_sz>
-class dynamic_buffer final : public pmc::buffer {
-public:
-	using storage_type = intrusive_storage<block_sz, storage_value_type>;
-	using value_type   = storage_value_type;
-	using node_type    = intrusive_node;
-	using size_type    = std::size_t;
-	using offset_type  = std::size_t;
-	using contiguous   = is_non_contiguous;
-	using seeking      = supported;
+		std::array<storage_type, capacity> packet;
+		stamp_into(packet.data(), values...);
+		buffer.write(packet.data(), size);
+		return true;
+	}
 
-	static constexpr auto npos { static_cast<size_type>(-1) };
+	/**
+	 * @return The size of the serialised packet.
+	 */
+	size_type size() const {
+		return buffer_.size();
+	}
 
-	using unique_storage = std::unique_ptr<storage_type, std::function<void(storage_type*)>>;
+	/**
+	 * @return The unpatched packet data.
+	 */
+	std::span<const storage_type> data() const {
+		return buffer_.read_span();
+	}
 
-private:
-	intrusive_node root_;
-	size_type size_;
-	[[no_unique_address]] allocator allocator_;
+	/**
+	 * @brief Clears the template, invalidating any existing patch points.
+	 */
+	void clear() {
+		buffer_.clear();
+		state_ = stream_state::ok;
+	}
 
-	void link_tail_node(intrusive_node* node) {
-		node->next = &root_;
-		node->prev = root_.prev;
-		root_.prev = root_.prev->next = node;
+	/**
+	 * @return The template's state. Will be in an error state if any
+	 * writes to the template have failed.
+	 */
+	stream_state state() const {
+		return state_;
 	}
 
-	void unlink_node(intrusive_node* node) {
-		node->next->prev = node->prev;
-		node->prev->next = node->next;
+	bool good() const {
+		return state_ == stream_state::ok;
 	}
 
-	inline storage_type* buffer_from_node(const intrusive_node* node) const {
-		return reinterpret_cast<storage_type*>(std::uintptr_t(node)
-			- offsetof(storage_type, node));
+	operator bool() const {
+		return good();
 	}
+};
 
-	void move(dynamic_buffer& rhs) noexcept {
-		if(this == &rhs) { // self-assignment
-			return;
-		}
+} // hexi
 
-		clear(); // clear our current blocks rather than swapping them
+// #include <hexi/precomputed.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-		size_ = rhs.size_;
-		root_ = rhs.root_;
-		root_.next->prev = &root_;
-		root_.prev->next = &root_;
-		rhs.size_ = 0;
-		rhs.root_.next = &rhs.root_;
-		rhs.root_.prev = &rhs.root_;
-	}
 
-	void copy(const dynamic_buffer& rhs) {
-		if(this == &rhs) { // self-assignment
-			return;
-		}
 
-		const intrusive_node* head = rhs.root_.next;
-		root_.next = &root_;
-		root_.prev = &root_;
-		size_ = 0;
+// #include <hexi/binary_stream.h>
 
-		while(head != &rhs.root_) {
-			auto buffer = allocate();
-			*buffer = *buffer_from_node(head);
-			link_tail_node(&buffer->node);
-			size_ += buffer->write_offset;
-			head = head->next;
-		}
-	}
-	
-#ifdef HEXI_BUFFER_DEBUG
-	void offset_buffers(std::vector<storage_type*>& buffers, size_type offset) {
-		std::erase_if(buffers, [&](auto block) {
-			if(block->size() > offset) {
-				block->read_offset += offset;
-				block->write_offset -= offset;
-				return false;
-			} else {
-				return true;
-			}
-		});
-	}
-#endif
+// #include <hexi/concepts.h>
 
-	value_type& byte_at_index(const size_type index) const {
-		assert(index < size_ && "buffer subscript index out of range");
+// #include <hexi/endian.h>
 
-		auto head = root_.next;
-		auto buffer = buffer_from_node(head);
-		const auto offset_index = index + buffer->read_offset;
-		const auto node_index = offset_index / block_sz;
+// #include <hexi/serialised_size.h>
 
-		for(size_type i = 0; i < node_index; ++i) {
-			head = head->next;
-		}
+// #include <hexi/static_buffer.h>
 
-		buffer = buffer_from_node(head);
-		return (*buffer)[offset_index % block_sz];
-	}
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
 
-	size_type abs_seek_offset(size_type offset) {
-		if(offset < size_) {
-			return size_ - offset;
-		} else if(offset > size_) {
-			return offset - size_;
-		} else {
-			return 0;
-		}
-	}
+namespace hexi {
 
-	[[nodiscard]] storage_type* allocate() {
-		return allocator_.allocate();
-	}
+/**
+ * @brief Serialises an object into an array of exactly the object's
+ * serialised size.
+ *
+ * Intended to be used in a constant expression, allowing packets that never
+ * change (handshake replies, keep-alives, etc) to be baked into the binary
+ * rather than being serialised on every send, e.g:
+ *
+ * constexpr auto keep_alive = hexi::precompute(KeepAlive{}, hexi::endian::big);
+ *
+ * @tparam storage_type The byte type of the resulting array.
+ * @param object The object to be serialised. Its serialise function must be
+ * constexpr.
+ * @param byte_order The byte order to serialise the object with.
+ *
+ * @return An array containing the serialised object.
+ */
+template<byte_type storage_type = std::byte,
+	fixed_serialised_size T,
+	std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+constexpr auto precompute(T object, endianness byte_order = {}) {
+	static_buffer<storage_type, serialised_size_v<T>> buffer;
+	binary_stream stream(buffer, byte_order);
+	stream << object;
+
+	std::array<storage_type, serialised_size_v<T>> packet{};
+	std::ranges::copy(buffer, packet.begin());
+	return packet;
+}
+
+} // hexi
+
+// #include <hexi/serialised_size.h>
 
-	void deallocate(storage_type* buffer) {
-		allocator_.deallocate(buffer);
-	}
+// #include <hexi/stream_adaptors.h>
 
-public:
-	dynamic_buffer()
-		: root_{ .next = &root_, .prev = &root_ },
-		  size_(0) {}
+// #include <hexi/stream_range.h>
 
-	~dynamic_buffer() {
-		clear();
-	}
+// #include <hexi/stream_slice.h>
 
-	dynamic_buffer& operator=(dynamic_buffer&& rhs) noexcept {
-		move(rhs);
-		return *this;
-	}
+// #include <hexi/stream_transaction.h>
 
-	dynamic_buffer(dynamic_buffer&& rhs) noexcept {
-		move(rhs);
-	}
+// #include <hexi/async_reader.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-	dynamic_buffer(const dynamic_buffer& rhs) {
-		copy(rhs);
-	}
 
-	dynamic_buffer& operator=(const dynamic_buffer& rhs) {
-		clear();
-		copy(rhs);
-		return *this;
-	}
 
-	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @note The destination buffer must not overlap with any of the underlying
-	 * buffers being used by the dynamic buffer.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 */
-	template<typename T>
-	void read(T* destination) {
-		read(destination, sizeof(T));
-	}
+// #include <hexi/binary_stream.h>
 
-	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @note The destination buffer must not overlap with any of the underlying
-	 * buffers being used by the dynamic buffer.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 * @param length The number of bytes to read into the buffer.
-	 */
-	void read(void* destination, size_type length) override {
-		assert(length <= size_ && "Chained buffer read too large!");
-		size_type remaining = length;
+// #include <hexi/shared.h>
 
-		while(true) {
-			auto buffer = buffer_from_node(root_.next);
-			remaining -= buffer->read(
-				static_cast<value_type*>(destination) + length - remaining, remaining,
-				                         root_.next == root_.prev
-			);
+// #include <hexi/stream_transaction.h>
 
-			if(remaining) [[unlikely]] {
-				unlink_node(root_.next);
-				deallocate(buffer);
-			} else {
-				break;
-			}
-		}
+// #include <hexi/allocators/tls_block_allocator.h>
 
-		size_ -= length;
-	}
+// #include <hexi/endian.h>
 
-	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the container's read cursor.
-	 * 
-	 * @note The source buffer must not overlap with any of the underlying
-	 * buffers being used by the dynamic buffer.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 */
-	template<typename T>
-	void copy(T* destination) const {
-		copy(destination, sizeof(T));
-	}
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
 
-	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the container's read cursor.
-	 * 
-	 * @note The destination buffer must not overlap with any of the underlying
-	 * buffers being used by the dynamic buffer.
-	 * 
-	 * @param[out] destination The buffer to copy the data to.
-	 * @param length The number of bytes to copy.
-	 */
-	void copy(void* destination, const size_type length) const override {
-		assert(length <= size_ && "Chained buffer copy too large!");
-		size_type remaining = length;
-		auto head = root_.next;
+namespace hexi {
 
-		while(true) {
-			const auto buffer = buffer_from_node(head);
-			remaining -= buffer->copy(
-				static_cast<value_type*>(destination) + length - remaining, remaining
-			);
+namespace detail {
 
-			if(remaining) [[unlikely]] {
-				head = head->next;
-			} else {
-				break;
-			}
-		}
-	}
+template<std::size_t size>
+struct coroutine_frame_block {
+	alignas(std::max_align_t) std::byte data[size];
+};
 
-#ifdef HEXI_BUFFER_DEBUG
-	/**
-	 * @brief Retrives underlying buffers owned by the dynamic buffer.
-	 *
-	 * @param length Limit returned buffers to those holding up to the requested amount
-	 * of data.
-	 * @param offset The offset to start at.
-	 * 
-	 * @return Container of pointers to the underlying buffers holding the range of data
-	 * requested by length and offset.
-	 */
-	std::vector<storage_type*> fetch_buffers(const size_type length, const size_type offset = 0) {
-		size_type total = length + offset;
-		assert(total <= size_ && "Chained buffer fetch too large!");
-		std::vector<storage_type*> buffers;
-		auto head = root_.next;
+struct pending_read {
+	std::coroutine_handle<> handle;
 
-		while(total) {
-			auto buffer = buffer_from_node(head);
-			size_type read_size = block_sz - buffer->read_offset;
-			
-			// guard against overflow - buffer may have more content than requested
-			if(read_size > total) {
-				read_size = total;
-			}
+	virtual bool try_read() = 0;
 
-			buffers.emplace_back(buffer);
-			total -= read_size;
-			head = head->next;
-		}
+protected:
+	~pending_read() = default;
+};
 
-		if(offset) {
-			offset_buffers(buffers, offset);
-		}
+} // detail
 
-		return buffers;
+/**
+ * Allocates coroutine frames from a thread-local block allocator. Frames
+ * larger than the block size fall back to the global allocator.
+ *
+ * @note Frames must be released on the thread that allocated them.
+ *
+ * @tparam block_size The size of each block in the pool.
+ * @tparam blocks The number of blocks preallocated for each thread.
+ */
+template<std::size_t block_size = 512, std::size_t blocks = 64>
+struct coroutine_frame_pool final {
+	using block_type = detail::coroutine_frame_block<block_size>;
+	using allocator_type = tls_block_allocator<block_type, blocks>;
+
+	static allocator_type& allocator() {
+		static thread_local allocator_type allocator;
+		return allocator;
 	}
-#endif
 
-	/**
-	 * @brief Skip the requested number of bytes.
-	 *
-	 * Skips over a number of bytes from the container. This should be used
-	 * if the container holds data that you don't care about but don't want
-	 * to have to read it to another buffer to access data beyond it.
-	 * 
-	 * @param length The number of bytes to skip.
-	 */
-	void skip(const size_type length) override {
-		assert(length <= size_ && "Chained buffer skip too large!");
-		size_type remaining = length;
+	static void* allocate(const std::size_t size) {
+		if(size > block_size) [[unlikely]] {
+			return ::operator new(size);
+		}
 
-		while(true) {
-			auto buffer = buffer_from_node(root_.next);
-			remaining -= buffer->skip(remaining, root_.next == root_.prev);
+		return allocator().allocate();
+	}
 
-			if(remaining) [[unlikely]] {
-				unlink_node(root_.next);
-				deallocate(buffer);
-			} else {
-				break;
-			}
+	static void deallocate(void* ptr, const std::size_t size) {
+		if(size > block_size) [[unlikely]] {
+			::operator delete(ptr, size);
+			return;
 		}
 
-		size_ -= length;
+		allocator().deallocate(static_cast<block_type*>(ptr));
 	}
+};
 
-	/**
-	 * @brief Write data to the container.
-	 * 
-	 * @note The source buffer must not overlap with any of the underlying buffers
-	 * being used by the dynamic buffer.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 */
-	void write(const auto& source) {
-		write(&source, sizeof(source));
+namespace detail {
+
+template<typename T>
+struct task_result {
+	std::optional<T> value;
+
+	template<typename U>
+	void return_value(U&& result) {
+		value.emplace(std::forward<U>(result));
 	}
+};
 
-	/**
-	 * @brief Write provided data to the container.
-	 * 
-	 * @note The source buffer must not overlap with any of the underlying buffers
-	 * being used by the dynamic buffer.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 * @param length Number of bytes to write from the source.
-	 */
-	void write(const void* source, const size_type length) override {
-		size_type remaining = length;
-		intrusive_node* tail = root_.prev;
+template<>
+struct task_result<void> {
+	void return_void() {}
+};
 
-		do {
-			storage_type* buffer;
+} // detail
 
-			if(tail != &root_) [[likely]] {
-				buffer = buffer_from_node(tail);
-			} else {
-				buffer = allocate();
-				link_tail_node(&buffer->node);
-				tail = root_.prev;
-			}
+/**
+ * Coroutine type for parsers written against async_reader. The coroutine
+ * starts running as soon as it's called and runs until it needs more data
+ * than has been buffered, at which point control returns to the caller.
+ *
+ * Coroutine frames are allocated from the pool given by frame_pool.
+ *
+ * @tparam T The coroutine's return type.
+ * @tparam frame_pool The allocator used for coroutine frames.
+ */
+template<typename T = void, typename frame_pool = coroutine_frame_pool<>>
+class async_task final {
+public:
+	struct promise_type : detail::task_result<T> {
+		std::exception_ptr exception;
 
-			remaining -= buffer->write(
-				static_cast<const value_type*>(source) + length - remaining, remaining
-			);
+		static void* operator new(const std::size_t size) {
+			return frame_pool::allocate(size);
+		}
 
-			tail = tail->next;
-		} while(remaining);
+		static void operator delete(void* ptr, const std::size_t size) {
+			frame_pool::deallocate(ptr, size);
+		}
 
-		size_ += length;
-	}
+		async_task get_return_object() {
+			return async_task(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
 
-	/**
-	 * @brief Reserves a number of bytes within the container for future use.
-	 * 
-	 * @param length The number of bytes that the container should reserve.
-	 */
-	void reserve(const size_type length) override {
-		size_type remaining = length;
-		intrusive_node* tail = root_.prev;
+		std::suspend_never initial_suspend() noexcept {
+			return {};
+		}
+
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+
+		void unhandled_exception() {
+			exception = std::current_exception();
+		}
+	};
 
-		do {
-			storage_type* buffer;
+private:
+	std::coroutine_handle<promise_type> handle_;
 
-			if(tail == &root_) [[unlikely]] {
-				buffer = allocate();
-				link_tail_node(&buffer->node);
-				tail = root_.prev;
-			} else {
-				buffer = buffer_from_node(tail);
+	explicit async_task(std::coroutine_handle<promise_type> handle)
+		: handle_(handle) {}
+
+public:
+	async_task(async_task&& rhs) noexcept
+		: handle_(std::exchange(rhs.handle_, nullptr)) {}
+
+	async_task& operator=(async_task&& rhs) noexcept {
+		if(this != &rhs) {
+			if(handle_) {
+				handle_.destroy();
 			}
 
-			remaining -= buffer->advance_write(remaining);
-			tail = tail->next;
-		} while(remaining);
+			handle_ = std::exchange(rhs.handle_, nullptr);
+		}
 
-		size_ += length;
+		return *this;
 	}
 
+	async_task(const async_task&) = delete;
+	async_task& operator=(const async_task&) = delete;
+
 	/**
-	 * @brief Returns the size of the container.
-	 * 
-	 * @return The number of bytes of data available to read within the container.
+	 * @return True if the coroutine has run to completion.
 	 */
-	size_type size() const override {
-		return size_;
+	bool done() const {
+		return handle_ && handle_.done();
 	}
 
 	/**
-	 * @brief Retrieves the last buffer in the container's list.
-	 * 
-	 * @return A reference to the value at the specified index.
-	 * @note The container retains ownership over the buffer, so it must not
-	 * be deallocated by the caller.
+	 * @brief Retrieves the result of a completed coroutine, rethrowing any
+	 * exception that escaped it.
+	 *
+	 * @return The coroutine's return value, if it has one.
 	 */
-	storage_type* back() const {
-		if(root_.prev == &root_) {
-			return nullptr;
+	decltype(auto) get() {
+		assert(done() && "Coroutine has not completed");
+
+		if(handle_.promise().exception) {
+			std::rethrow_exception(handle_.promise().exception);
 		}
 
-		return buffer_from_node(root_.prev);
+		if constexpr(!std::is_void_v<T>) {
+			return (*handle_.promise().value);
+		}
 	}
 
-	/**
-	 * @brief Retrieves the buffer's block sized.
-	 * 
-	 * @param index The index within the buffer.
-	 * @return A reference to the value at the specified index.
-	 */
-	storage_type* front() const {
-		if(root_.next == &root_) {
-			return nullptr;
+	~async_task() {
+		if(handle_) {
+			handle_.destroy();
 		}
-
-		return buffer_from_node(root_.next);
 	}
+};
 
-	/**
-	 * @brief Removes the first buffer from the container.
-	 * 
-	 * @return A pointer to the popped buffer.
-	 * 
-	 * @note Removing the buffer from the container also transfers ownership.
-	 * Therefore, the caller assumes responsibility for deallocating the buffer
-	 * when it is no longer required. Alternatively, it can be pushed back into
-	 * the container to transfer ownership back.
-	 */
-	auto pop_front() {
-		auto buffer = buffer_from_node(root_.next);
-		size_ -= buffer->size();
-		unlink_node(root_.next);
-		return unique_storage(buffer, [&](auto ptr) {
-			deallocate(ptr);
-		});
-	}
+/**
+ * Awaitable reader for messages that arrive in fragments. Each read is
+ * attempted through a transaction on the buffer, so a read that runs out
+ * of data consumes nothing and suspends the awaiting coroutine. Calling
+ * notify after appending data retries the pending read and, if it can
+ * now complete, resumes the coroutine, e.g:
+ *
+ * async_task<> parse(auto& reader) {
+ *     const auto id = co_await reader.template read<std::uint32_t>();
+ *     std::string name;
+ *     co_await reader.read(hexi::prefixed(name));
+ * }
+ *
+ * buffer.write(data, size);
+ * reader.notify();
+ *
+ * Only one coroutine may be waiting on a reader at a time. Errors other
+ * than running out of data are terminal. The reader is put into the
+ * error state, pending and subsequent reads complete immediately and
+ * the coroutine is expected to check the result before continuing.
+ *
+ * @tparam buf_type The buffer type, e.g. dynamic_buffer.
+ * @tparam endianness The byte order used for reads.
+ */
+template<transactional buf_type, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class async_reader final {
+	using stream_type = binary_stream<buf_type, no_throw_t, endianness>;
 
-	/**
-	 * @brief Attaches additional storage to the container.
-	 * 
-	 * @param buffer The block to add to the container.
-	 * 
-	 * @note Once pushed, the container is assumed to have ownership over the buffer.
-	 * The buffer storage must have been allocated by the same allocator as the container.
-	 */
-	void push_back(storage_type* buffer) {
-		link_tail_node(&buffer->node);
-		size_ += buffer->write_offset;
-	}
+	stream_type stream_;
+	stream_state state_ = stream_state::ok;
+	detail::pending_read* pending_ = nullptr;
 
-	/**
-	 * @brief Advances the write cursor.
-	 * 
-	 * @param size The number of bytes by which the write cursor to advance the cursor.
-	 */
-	void advance_write(const size_type size) {
-		auto buffer = buffer_from_node(root_.prev);
-		const auto actual = buffer->advance_write(size);
-		assert(size <= block_sz && actual <= size &&
-		       "Attempted to advance write cursor out of bounds!");
-		size_ += size;
+	template<typename T>
+	bool try_read(T&& data) {
+		if(state_ != stream_state::ok) {
+			return true;
+		}
+
+		auto tx = stream_.begin_transaction();
+		tx >> std::forward<T>(data);
+
+		if(tx) {
+			tx.commit();
+			return true;
+		}
+
+		if(tx->state() != stream_state::buff_limit_err) {
+			state_ = tx->state();
+			return true;
+		}
+
+		return false;
 	}
 
-	/**
-	 * @brief Determine whether the adaptor supports write seeking.
-	 * 
-	 * This is determined at compile-time and does not need to checked at
-	 * run-time.
-	 * 
-	 * @return True if write seeking is supported, otherwise false.
-	 */
-	bool can_write_seek() const override {
-		return std::is_same_v<seeking, supported>;
+	void suspend(detail::pending_read* pending, std::coroutine_handle<> handle) {
+		assert(!pending_ && "A coroutine is already waiting on this reader");
+		pending->handle = handle;
+		pending_ = pending;
 	}
 
-	/**
-	 * @brief Performs write seeking within the container.
-	 * 
-	 * @param direction Specify whether to seek in a given direction or to absolute seek.
-	 * @param offset The offset relative to the seek direction or the absolute value
-	 * when using absolute seeking.
-	 */
-	void write_seek(const buffer_seek direction, size_type offset) override {
-		// nothing to do in this case
-		if(direction == buffer_seek::sk_absolute && offset == size_) {
-			return;
+	template<typename T>
+	class read_awaiter final : detail::pending_read {
+		async_reader& reader_;
+		T data_;
+
+		bool try_read() override {
+			return reader_.try_read(data_);
 		}
 
-		auto tail = root_.prev;
+	public:
+		read_awaiter(async_reader& reader, T&& data)
+			: reader_(reader), data_(std::forward<T>(data)) {}
 
-		switch(direction) {
-			case buffer_seek::sk_backward:
-				size_ -= offset;
-				break;
-			case buffer_seek::sk_forward:
-				size_ += offset;
-				break;
-			case buffer_seek::sk_absolute:
-				size_ = offset;
-				offset = abs_seek_offset(offset);
-				break;
+		bool await_ready() {
+			return try_read();
 		}
 
-		const bool rewind
-			= (direction == buffer_seek::sk_backward
-			   || (direction == buffer_seek::sk_absolute && offset < size_));
+		void await_suspend(std::coroutine_handle<> handle) {
+			reader_.suspend(this, handle);
+		}
 
-		while(offset) {
-			auto buffer = buffer_from_node(tail);
-			const auto max_seek = rewind? buffer->size() : buffer->free();
+		bool await_resume() const {
+			return reader_.good();
+		}
+	};
 
-			if(max_seek >= offset) {
-				buffer->write_seek(direction, offset);
-				offset = 0;
-			} else {
-				buffer->write_seek(direction, max_seek);
-				offset -= max_seek;
-				tail = rewind? tail->prev : tail->next;
-			}
+	template<std::default_initializable T>
+	class value_awaiter final : detail::pending_read {
+		async_reader& reader_;
+		T value_{};
+
+		bool try_read() override {
+			return reader_.try_read(value_);
 		}
 
-		root_.prev = tail;
-	}
+	public:
+		explicit value_awaiter(async_reader& reader)
+			: reader_(reader) {}
 
-	/**
-	 * @brief Clears the container.
-	 */
-	void clear() {
-		intrusive_node* head = root_.next;
+		bool await_ready() {
+			return try_read();
+		}
 
-		while(head != &root_) {
-			auto next = head->next;
-			deallocate(buffer_from_node(head));
-			head = next;
+		void await_suspend(std::coroutine_handle<> handle) {
+			reader_.suspend(this, handle);
 		}
 
-		root_.next = &root_;
-		root_.prev = &root_;
-		size_ = 0;
-	}
+		T await_resume() {
+			return std::move(value_);
+		}
+	};
 
-	/**
-	 * @brief Whether the container is empty.
-	 * 
-	 * @return Returns true if the container is empty (has no data to be read).
-	 */
-	[[nodiscard]]
-	bool empty() const override {
-		return !size_;
-	}
+public:
+	using size_type = typename buf_type::size_type;
 
 	/**
-	 * @brief Retrieves the container's block size.
-	 * 
-	 * @return The block size.
+	 * @param buffer The buffer that the I/O layer appends data to.
+	 * @param read_limit The maximum number of bytes that can be read, or
+	 * zero for no limit.
 	 */
-	constexpr static size_type block_size() {
-		return block_sz;
-	}
+	explicit async_reader(buf_type& buffer, const size_type read_limit = 0)
+		: stream_(buffer, read_limit) {}
 
-	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
-	 */
-	value_type& operator[](const size_type index) override {
-		return byte_at_index(index);
-	}
+	async_reader(const async_reader&) = delete;
+	async_reader& operator=(const async_reader&) = delete;
 
 	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
+	 * @brief Reads into the provided object or stream adaptor, suspending
+	 * until enough data is available.
+	 *
+	 * @param data The object or adaptor to read into, e.g. prefixed(str).
+	 *
+	 * @return An awaitable that yields true if the read succeeded.
 	 */
-	const value_type& operator[](const size_type index) const override {
-		return byte_at_index(index);
+	template<typename T>
+	[[nodiscard]] auto read(T&& data) {
+		return read_awaiter<T>(*this, std::forward<T>(data));
 	}
 
 	/**
-	 * @brief Retrieves the number of allocated blocks currently being used by the container.
-	 * 
-	 * @return The number of allocated blocks.
+	 * @brief Reads a value of the provided type, suspending until enough
+	 * data is available.
+	 *
+	 * @tparam T The type to read.
+	 *
+	 * @return An awaitable that yields the value. The value is default
+	 * initialised if the read failed.
 	 */
-	size_type block_count() const {
-		auto node = &root_;
-		size_type count = 0;
-
-		// not calculating based on block size & size as it
-		// wouldn't play nice with seeking or manual push/pop
-		while(node->next != root_.prev->next) {
-			++count;
-			node = node->next;
-		}
-
-		return count;
+	template<std::default_initializable T>
+	[[nodiscard]] auto read() {
+		return value_awaiter<T>(*this);
 	}
 
 	/**
-	 * @brief Attempts to locate the provided value within the container.
-	 * 
-	 * @param value The value to locate.
-	 * 
-	 * @return The position of value or npos if not found.
+	 * @brief Retries the pending read, if there is one, and resumes the
+	 * waiting coroutine if it completes. Call this after appending data
+	 * to the buffer.
+	 *
+	 * @return True if a coroutine was resumed.
 	 */
-	size_type find_first_of(value_type value) const override {
-		size_type index = 0;
-		auto head = root_.next;
-
-		while(head != &root_) {
-			const auto buffer = buffer_from_node(head);
-			const auto data = buffer->read_data();
-			
-			for(const auto& byte : data) {
-				if(byte == value) {
-					return index;
-				}
-
-				++index;
-			}
-
-			head = head->next;
+	bool notify() {
+		if(!pending_ || !pending_->try_read()) {
+			return false;
 		}
 
-		return npos;
+		std::exchange(pending_, nullptr)->handle.resume();
+		return true;
 	}
 
 	/**
-	 * @brief Retrieves the container's allocator.
-	 * 
-	 * @return The memory allocator.
+	 * @return True if a coroutine is waiting for more data.
 	 */
-	auto& get_allocator() {
-		return allocator_;
+	bool waiting() const {
+		return pending_ != nullptr;
 	}
 
 	/**
-	 * @brief Retrieves the container's allocator.
-	 * 
-	 * @return The memory allocator.
+	 * @return The total number of bytes consumed by completed reads.
 	 */
-	auto& get_allocator() const {
-		return allocator_;
+	size_type total_read() const {
+		return stream_.total_read();
 	}
 
-	template<typename buffer_type>
-	friend class buffer_sequence;
+	stream_state state() const {
+		return state_;
+	}
+
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
+
+	operator bool() const {
+		return good();
+	}
 };
 
 } // hexi
 
-// #include <hexi/dynamic_tls_buffer.h>
+// #include <hexi/frame_decoder.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -3289,409 +10367,325 @@ public:
 
 
 
-// #include <hexi/dynamic_buffer.h>
-
-// #include <hexi/allocators/tls_block_allocator.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+// #include <hexi/binary_stream.h>
 
+// #include <hexi/buffer_adaptor.h>
 
+// #include <hexi/dynamic_buffer.h>
 
-// #include <hexi/allocators/block_allocator.h>
-//  _               _ 
-// | |__   _____  _(_)
-// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
-// | | | |  __/>  <| | Version 1.0
-// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+// #include <hexi/shared.h>
 
+// #include <hexi/concepts.h>
 
+// #include <hexi/endian.h>
 
-#include <array>
-#include <memory>
-#include <new>
-#include <thread>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <span>
 #include <type_traits>
 #include <utility>
-#include <cassert>
+#include <vector>
 #include <cstddef>
-#include <cstdint>
-
-#ifndef NDEBUG
-#define HEXI_DEBUG_ALLOCATORS
-#endif
 
 namespace hexi {
 
+/**
+ * Describes a frame header for frame_decoder. The header is deserialised
+ * from exactly header_size bytes and body_size returns the length of the
+ * body that follows it, e.g:
+ *
+ * struct codec {
+ *     using header_type = packet_header;
+ *     using endianness = hexi::endian::as_big_t; // optional
+ *     static constexpr std::size_t header_size = 6;
+ *
+ *     static std::size_t body_size(const packet_header& header) {
+ *         return header.size;
+ *     }
+ * };
+ */
+template<typename codec>
+concept header_codec = std::default_initializable<typename codec::header_type>
+	&& requires(const typename codec::header_type& header) {
+		{ codec::header_size } -> std::convertible_to<std::size_t>;
+		{ codec::body_size(header) } -> std::convertible_to<std::size_t>;
+	};
+
 namespace detail {
 
-struct free_block {
-	free_block* next;
+template<typename codec>
+struct codec_endianness {
+	using type = endian::as_native_t;
 };
 
-template<decltype(auto) size>
-concept gt_zero = size > 0;
-
-template<typename T, typename U>
-concept sizeof_gte = sizeof(T) >= sizeof(U);
+template<typename codec>
+requires requires { typename codec::endianness; }
+struct codec_endianness<codec> {
+	using type = typename codec::endianness;
+};
 
 } // detail
 
-using namespace detail;
-
-struct no_validate_dealloc {};
-struct validate_dealloc : no_validate_dealloc {};
+/**
+ * Counters for tuning a frame_decoder. The frame rate can be found by
+ * sampling frames at an interval and resetting the counters.
+ */
+struct frame_decoder_stats {
+	std::size_t frames = 0;             // complete frames passed to handlers
+	std::size_t bytes = 0;              // bytes consumed, including headers
+	std::size_t carryovers = 0;         // times processing stopped mid-frame
+	std::size_t carryover_bytes = 0;    // bytes of the current partial frame
+	std::size_t peak_carryover_bytes = 0;
+};
 
 /**
- * Basic fixed-size block stack allocator that preallocates a slab of memory
- * capable of holding a compile-time determined number of elements.
- * When constructed, a linked list of chunks is built within the slab and
- * each allocation request will take the head node. Since the allocations
- * are fixed-size, the list does not need to be traversed for a suitable
- * size. Deallocations place the chunk as the new head (LIFO).
+ * Incremental, callback-driven decoder for header and body frames arriving
+ * in arbitrarily sized chunks.
  *
- * If the preallocated slab runs out of chunks, it will fall back to using the
- * system allocator rather than allocating additional slabs. This means sizing
- * the initial allocation correctly is important for maximum performance, so
- * it's better to be pessimistic. This is a server application and RAM is cheap. :)
+ * Data is appended to a dynamic_buffer, either by the I/O layer directly
+ * or via feed. Headers are deserialised as soon as they're complete. If
+ * the whole body has already arrived and is contiguous in the buffer (the
+ * buffer is contiguous, or the body is within the front block of a
+ * dynamic_buffer), the handler reads it in place. Otherwise, body bytes
+ * are moved into separate storage as they arrive, which grows with the
+ * data received rather than the declared length, so a hostile header
+ * can't trigger a huge allocation. Either way, once the body is complete,
+ * the handler is invoked with the header and a stream that is bounded to
+ * the body. Bytes are never examined more than once, no matter how the
+ * frames are fragmented.
  *
- * PagePolicy: 'lock' requests that the OS does not page out the memory slab to disk.
+ * The decoder moves on to the next header before the handler is invoked.
+ * A body that's read in place stays in the buffer while the handler runs
+ * and is skipped over once it returns or throws, so a handler that throws
+ * won't be given the same frame again. Handlers must not hold onto views
+ * into the stream after returning, nor modify the buffer.
  *
- * ThreadPolicy: 'same_thread' triggers an assert if an allocated object
- * is deallocated from a different thread. Used by the TLS allocator, since
- * implementing the functionality there is messier (and slower).
+ * @tparam codec The header codec.
+ * @tparam buf_type The type of the buffer that data is appended to.
  */
-template<typename _ty, 
-	std::size_t _elements,
-	std::derived_from<no_validate_dealloc> ValidatePolicy = no_validate_dealloc>
-requires gt_zero<_elements> && sizeof_gte<_ty, free_block>
-class block_allocator {
-	using tid_type = std::conditional_t<
-		std::is_same_v<ValidatePolicy, validate_dealloc>, std::thread::id, std::monostate
-	>;
-
-	struct mem_block {
-		_ty obj;
-
-		struct {
-			[[no_unique_address]] tid_type thread_id;
-			bool using_new;
-		} meta;
-	};
-
-	static constexpr auto block_size = sizeof(mem_block);
-
-	free_block* head_ = nullptr;
-	[[no_unique_address]] tid_type thread_id_;
-	std::array<char, block_size * _elements> storage_;
-
-	void initialise_free_list() {
-		auto storage = storage_.data();
-
-		for(std::size_t i = 0; i < _elements; ++i) {
-			auto block = reinterpret_cast<free_block*>(storage + (block_size * i));
-			push(block);
-		}
-	}
-
-	inline void push(free_block* block) {
-		assert(block);
-		block->next = head_;
-		head_ = block;
-	}
-
-	[[nodiscard]] inline free_block* pop() {
-		if(!head_) {
-			return nullptr;
-		}
-
-		auto block = head_;
-		head_ = block->next;
-		return block;
-	}
-
+template<header_codec codec, typename buf_type = dynamic_buffer<1024>>
+class frame_decoder final {
 public:
-#ifdef HEXI_DEBUG_ALLOCATORS
-	std::size_t storage_active_count = 0;
-	std::size_t new_active_count = 0;
-	std::size_t active_count = 0;
-	std::size_t total_allocs = 0;
-	std::size_t total_deallocs = 0;
-#endif
-
-	block_allocator() requires std::same_as<ValidatePolicy, validate_dealloc>
-		: thread_id_(std::this_thread::get_id()) {
-		initialise_free_list();
-	}
-
-	block_allocator() {
-		initialise_free_list();
-	}
-
-	template<typename ...Args>
-	[[nodiscard]] inline _ty* allocate(Args&&... args) {
-		auto block = reinterpret_cast<mem_block*>(pop());
-
-		if(block) [[likely]] {
-#ifdef HEXI_DEBUG_ALLOCATORS
-			++storage_active_count;
-#endif
-			block->meta.using_new = false;
-		} else {
-#ifdef HEXI_DEBUG_ALLOCATORS
-			++new_active_count;
-#endif
-			block = new mem_block;
-			block->meta.using_new = true;
-		}
-
-		if constexpr(std::is_same_v<ValidatePolicy, validate_dealloc>) {
-			block->meta.thread_id = thread_id_;
-		}
-
-#ifdef HEXI_DEBUG_ALLOCATORS
-		++total_allocs;
-		++active_count;
-#endif
-		return new (&block->obj) _ty(std::forward<Args>(args)...);
-	}
-
-	inline void deallocate(_ty* t) {
-		assert(t);
-		auto block = reinterpret_cast<mem_block*>(t);
-
-		if constexpr(std::is_same_v<ValidatePolicy, validate_dealloc>) {
-			assert(block->meta.thread_id == thread_id_
-				&& "thread policy violation or clobbered block");
-		}
-
-		if(block->meta.using_new) [[unlikely]] {
-#ifdef HEXI_DEBUG_ALLOCATORS
-			--new_active_count;
-#endif
-			t->~_ty();
-			delete block;
-		} else {
-#ifdef HEXI_DEBUG_ALLOCATORS
-			--storage_active_count;
-#endif
-			t->~_ty();
-			push(reinterpret_cast<free_block*>(t));
-		}
-
-#ifdef HEXI_DEBUG_ALLOCATORS
-		++total_deallocs;
-		--active_count;
-#endif
-	}
-
-	~block_allocator() {
-#ifdef HEXI_DEBUG_ALLOCATORS
-		assert(active_count == 0);
-#endif
-	}
-};
-
-} // hexi
-
-#include <type_traits>
-#include <utility>
-#include <cassert>
-#include <cstddef>
-#include <cstdint>
-
-#ifndef NDEBUG
-#define HEXI_DEBUG_ALLOCATORS
-#endif
-
-namespace hexi {
-
-struct safe_entrant {};
-struct no_ref_counting {};
+	using header_type = typename codec::header_type;
+	using endianness  = typename detail::codec_endianness<codec>::type;
+	using value_type  = typename buf_type::value_type;
+	using size_type   = typename buf_type::size_type;
+	using body_type   = std::vector<value_type>;
+	using view_type   = std::span<value_type>;
+	using stream_type = binary_stream<buffer_adaptor<view_type>, no_throw_t, endianness>;
 
-struct unsafe_entrant : safe_entrant {};
-struct ref_counting : no_ref_counting {};
+private:
+	static constexpr size_type header_size = codec::header_size;
 
-template<typename _ty,
-	std::size_t _elements,
-	std::derived_from<no_ref_counting> ref_count_policy = no_ref_counting,
-	std::derived_from<safe_entrant> entrant_policy = safe_entrant
->
-class tls_block_allocator final {
-	using allocator_type = block_allocator<_ty, _elements>;
+	enum class decode_state {
+		header, body
+	};
 
-	using ref_count = std::conditional_t<
-		std::is_same_v<ref_count_policy, ref_counting>, int, std::monostate
-	>;
+	buf_type& buffer_;
+	size_type max_body_size_;
+	decode_state decode_state_ = decode_state::header;
+	stream_state state_ = stream_state::ok;
+	header_type header_{};
+	size_type body_size_ = 0;
+	body_type body_;
+	frame_decoder_stats stats_;
 
-	using tls_handle_cache = std::conditional_t<
-		std::is_same_v<entrant_policy, unsafe_entrant>, allocator_type*, std::monostate
-	>;
+	bool read_header() {
+		binary_stream<buf_type, no_throw_t, endianness> stream(buffer_, header_size);
+		stream >> header_;
 
-	static inline thread_local std::unique_ptr<allocator_type> allocator_;
-	static inline thread_local ref_count ref_count_{};
+		if(!stream || stream.total_read() != header_size) [[unlikely]] {
+			state_ = stream? stream_state::invalid_stream : stream.state();
+			return false;
+		}
 
-	[[no_unique_address]] tls_handle_cache cached_handle_{};
+		const auto body_size = static_cast<std::size_t>(codec::body_size(header_));
 
-	// Compiler will optimise calls to this out when using unsafe_entrant
-	inline void initialise() {
-		if constexpr(std::is_same_v<entrant_policy, safe_entrant>) {
-			if(!allocator_) {
-				allocator_ = std::make_unique<allocator_type>();
-			}
+		if(max_body_size_ && body_size > max_body_size_) [[unlikely]] {
+			state_ = stream_state::read_limit_err;
+			return false;
 		}
+
+		body_size_ = static_cast<size_type>(body_size);
+		body_.clear();
+		decode_state_ = decode_state::body;
+		stats_.bytes += header_size;
+		return true;
 	}
 
-	inline allocator_type* allocator_handle() {
-		if constexpr(std::is_same_v<entrant_policy, unsafe_entrant>) {
-			return cached_handle_;
+	void read_body() {
+		const auto offset = body_.size();
+		const auto length = std::min<size_type>(body_size_ - offset, buffer_.size());
+
+		if(!length) {
+			return;
+		}
+
+		body_.resize(offset + length);
+		buffer_.read(body_.data() + offset, length);
+		stats_.bytes += length;
+	}
+
+	/*
+	 * Returns the data at the front of the buffer that can be viewed
+	 * without copying, which may be less than the buffer holds.
+	 */
+	view_type buffered_data() {
+		if constexpr(std::is_same_v<typename buf_type::contiguous, is_contiguous>) {
+			return { buffer_.read_ptr(), buffer_.size() };
+		} else if constexpr(requires { buffer_.front()->read_data(); }) {
+			const auto block = buffer_.front();
+			return block? view_type(block->read_data()) : view_type();
 		} else {
-			return allocator_.get();
+			return {};
 		}
 	}
 
-public:
-#ifdef HEXI_DEBUG_ALLOCATORS
-	std::size_t total_allocs = 0;
-	std::size_t total_deallocs = 0;
-	std::size_t active_allocs = 0;
-#endif
+	template<typename handler_type>
+	void dispatch(handler_type& handler, view_type body) {
+		decode_state_ = decode_state::header;
+		++stats_.frames;
 
-	tls_block_allocator() {
-		thread_enter();
+		buffer_adaptor<view_type> adaptor(body);
+		stream_type stream(adaptor, body_size_);
+		std::invoke(handler, std::as_const(header_), stream);
 	}
 
 	/*
-	 * When used in conjunction with unsafe_entrant, allows the owning object
-	 * to be executed on another thread without paying for checks on every
-	 * allocation
-	 * 
-	 * @note If ref counting is enabled, the count will be incremented.
+	 * Invokes the handler with a view of a body that's already in the
+	 * buffer, skipping over it afterwards even if the handler throws.
 	 */
-	inline void thread_enter() {
-		if(!allocator_) {
-			allocator_ = std::make_unique<allocator_type>();
-		}
+	template<typename handler_type>
+	void dispatch_in_place(handler_type& handler, view_type body) {
+		struct skip_on_exit {
+			buf_type& buffer;
+			size_type length;
 
-		if constexpr(std::is_same_v<entrant_policy, unsafe_entrant>) {
-			cached_handle_ = allocator_.get();
+			~skip_on_exit() {
+				buffer.skip(length);
+			}
+		} skip { buffer_, body_size_ };
+
+		stats_.bytes += body_size_;
+		dispatch(handler, body.first(body_size_));
+	}
+
+	void update_carryover() {
+		if(decode_state_ == decode_state::body) {
+			stats_.carryover_bytes = body_.size();
+		} else {
+			stats_.carryover_bytes = buffer_.size();
 		}
 
-		if constexpr(std::is_same_v<ref_count_policy, ref_counting>) {
-			++ref_count_;
+		if(stats_.carryover_bytes) {
+			++stats_.carryovers;
+			stats_.peak_carryover_bytes = std::max(stats_.peak_carryover_bytes,
+			                                       stats_.carryover_bytes);
 		}
 	}
 
-	/*
-	 * When used in conjunction with unsafe_entrant, signals that the current
-	 * thread not make further calls into the allocator.
-	 * 
-	 * @note If ref counting is enabled, the count will be decremented.
+public:
+	/**
+	 * @param buffer The buffer that incoming data is appended to.
+	 * @param max_body_size The maximum permitted body length, or zero for
+	 * no limit.
 	 */
-	inline void thread_exit() {
-		if constexpr(std::is_same_v<ref_count_policy, ref_counting>) {
-			assert(ref_count_);
+	explicit frame_decoder(buf_type& buffer, const size_type max_body_size = 0)
+		: buffer_(buffer), max_body_size_(max_body_size) {}
 
-			--ref_count_;
+	frame_decoder(const frame_decoder&) = delete;
+	frame_decoder& operator=(const frame_decoder&) = delete;
 
-			if(ref_count_ == 0) {
-				allocator_.reset();
+	/**
+	 * @brief Decodes as many frames as possible from the data appended to
+	 * the buffer so far, invoking the handler for each complete frame.
+	 *
+	 * @param handler Invoked as handler(const header_type&, stream_type&).
+	 *
+	 * @return The number of frames decoded.
+	 */
+	template<std::invocable<const header_type&, stream_type&> handler_type>
+	std::size_t process(handler_type&& handler) {
+		const auto frames = stats_.frames;
+
+		while(state_ == stream_state::ok) {
+			if(decode_state_ == decode_state::header) {
+				if(buffer_.size() < header_size || !read_header()) {
+					break;
+				}
 			}
+
+			if(body_.empty()) {
+				if(const auto data = buffered_data(); data.size() >= body_size_) {
+					dispatch_in_place(handler, data);
+					continue;
+				}
+			}
+
+			read_body();
+
+			if(body_.size() != body_size_) {
+				break;
+			}
+
+			dispatch(handler, body_);
 		}
+
+		update_carryover();
+		return stats_.frames - frames;
 	}
 
-	/*
-	 * @brief Allocates and constructs an object.
-	 * 
-	 * @tparam Args Variadic arguments to be forwarded to the object's constructor.
-	 * 
-	 * @return Pointer to the allocated object.
+	/**
+	 * @brief Appends a chunk of data to the buffer and decodes any frames
+	 * that it completes.
+	 *
+	 * @param data The data to append.
+	 * @param length The number of bytes to append.
+	 * @param handler Invoked as handler(const header_type&, stream_type&).
+	 *
+	 * @return The number of frames decoded.
 	 */
-	template<typename ...Args>
-	[[nodiscard]] inline _ty* allocate(Args&&... args) {
-		/*
-		 * When safe_entrant is set, need to do this here & in ctor unless
-		 * we can be 100% sure that any object using the allocator is created
-		 * on the same thread that ends up using it.
-		 */
-		initialise();
-
-#ifdef HEXI_DEBUG_ALLOCATORS
-		++total_allocs;
-		++active_allocs;
-#endif
-		return allocator_handle()->allocate(std::forward<Args>(args)...);
+	template<std::invocable<const header_type&, stream_type&> handler_type>
+	std::size_t feed(const void* data, const size_type length, handler_type&& handler) {
+		buffer_.write(data, length);
+		return process(std::forward<handler_type>(handler));
 	}
 
-	/*
-	 * @brief Deallocates and destructs an object.
-	 * 
-	 * @param t The object to be deallocated.
+	/**
+	 * @return The number of body bytes still needed to complete the current
+	 * frame, or zero if waiting on a header.
 	 */
-	inline void deallocate(_ty* t) {
-		assert(t);
-
-#ifdef HEXI_DEBUG_ALLOCATORS
-		++total_deallocs;
-		--active_allocs;
-#endif
-		allocator_handle()->deallocate(t);
+	size_type body_remaining() const {
+		return decode_state_ == decode_state::body? body_size_ - body_.size() : 0;
 	}
 
-#ifdef HEXI_DEBUG_ALLOCATORS
-	auto allocator() {
-		initialise();
-		return allocator_handle();
+	const frame_decoder_stats& stats() const {
+		return stats_;
 	}
-#endif
-
-	~tls_block_allocator() {
-		thread_exit();
 
-#ifdef HEXI_DEBUG_ALLOCATORS
-		assert(active_allocs == 0);
-#endif
+	void reset_stats() {
+		const auto carryover = stats_.carryover_bytes;
+		stats_ = {};
+		stats_.carryover_bytes = carryover;
 	}
-};
-
-} // hexi
 
-#include <cstddef>
+	stream_state state() const {
+		return state_;
+	}
 
-namespace hexi {
+	bool good() const {
+		return state_ == stream_state::ok;
+	}
 
-// dynamic_buffer backed by thread-local storage, meaning every
-// instance on the same thread shares the same underlying memory.
-// As a rule of thumb, an instance should never be touched by any thread
-// other than the one on which it was created, not even if synchronised
-// ... unless you're positive it won't result in the allocator being called.
-// 
-// Minimum memory usage is intrusive_storage<block_size> * count.
-// Additional blocks are not added if the original is exhausted ('colony' structure),
-// so the allocator will fall back to the system allocator instead.
-//
-// Pros: extremely fast allocation/deallocation for many instances per thread
-// Cons: everything else.
-// 
-// TL;DR Do not use unless you know what you're doing.
-template<decltype(auto) block_size,
-	std::size_t count,
-	typename ref_count_policy = no_ref_counting,
-	typename entrant_policy = safe_entrant,
-	typename storage_type = std::byte>
-using dynamic_tls_buffer = dynamic_buffer<block_size, storage_type,
-	tls_block_allocator<typename dynamic_buffer<block_size>::storage_type, count, no_ref_counting, entrant_policy>
->;
+	operator bool() const {
+		return good();
+	}
+};
 
 } // hexi
 
-// #include <hexi/exception.h>
-
-// #include <hexi/endian.h>
-
-// #include <hexi/file_buffer.h>
+// #include <hexi/message_view.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -3700,327 +10694,500 @@ using dynamic_tls_buffer = dynamic_buffer<block_size, storage_type,
 
 
 
-// #include <hexi/exception.h>
+// #include <hexi/binary_stream.h>
 
 // #include <hexi/shared.h>
 
 // #include <hexi/concepts.h>
 
-#include <filesystem>
+// #include <hexi/endian.h>
+
+// #include <hexi/stream_transaction.h>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <cstddef>
-#include <cstdio>
+#include <cstdint>
+#include <cstring>
 
 namespace hexi {
 
-using namespace detail;
+namespace detail {
 
-class file_buffer final {
-public:
-	using size_type       = std::size_t;
-	using offset_type     = long;
-	using value_type      = char;
-	using contiguous      = is_non_contiguous;
-	using seeking         = unsupported;
+/*
+ * Location of a serialised field, keyed by the offset of the member that
+ * it was read into within the layout object, and the byte order it was
+ * written in if it's arithmetic.
+ */
+struct view_field {
+	std::size_t member;
+	std::size_t offset;
+	std::size_t length;
+	std::endian order;
+};
 
-	static constexpr auto npos { static_cast<size_type>(-1) };
+template<typename endianness>
+constexpr std::endian wire_order() {
+	if constexpr(std::is_same_v<endianness, endian::as_big_t>) {
+		return std::endian::big;
+	} else if constexpr(std::is_same_v<endianness, endian::as_little_t>) {
+		return std::endian::little;
+	} else {
+		return std::endian::native;
+	}
+}
 
-private:
-	FILE* file_ = nullptr;
-	offset_type read_ = 0;
-	offset_type write_ = 0;
-	bool error_ = false;
+struct serialise_probe {
+	void operator()(auto&&...) {}
+	void operator&(auto&&) {}
+	void forward(auto&&...) {}
+};
 
-	/**
-	* @brief Explicitly close the underlying file handle.
-	* 
-	* This function will be called by the object's destructor
-	* and does not need to be called explicitly.
-	* 
-	* @note Idempotent.
-	*/
-	void close() {
-		if(file_) {
-			std::fclose(file_);
-			file_ = nullptr;
+template<typename T>
+concept probe_serialisable = requires(T& object, serialise_probe& probe) {
+	object.serialise(probe);
+};
+
+template<typename T>
+concept viewable_array = std::ranges::contiguous_range<T> && pod<typename T::value_type>;
+
+template<typename T, template<typename> class adaptor>
+concept adapted_array = requires(T arg) {
+	requires viewable_array<std::remove_cvref_t<decltype(arg.str)>>;
+	requires std::same_as<T, adaptor<std::remove_cvref_t<decltype(arg.str)>>>;
+};
+
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * It validates each field against the stream and records where the
+ * field's data is. Arithmetic and other trivial fields are decoded into
+ * the object as well, so lengths and flags that later fields depend on
+ * hold the values from the message, but strings and arrays are skipped.
+ */
+template<typename stream_type, typename object_type>
+class view_indexer final {
+	using size_type = typename stream_type::size_type;
+
+	static constexpr auto stream_order
+		= wire_order<std::remove_cv_t<decltype(stream_type::byte_order)>>();
+
+	stream_type& stream_;
+	object_type& layout_;
+	std::vector<view_field>& fields_;
+
+	std::size_t member_offset(const auto& member) const {
+		return static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&member)
+			- reinterpret_cast<const std::byte*>(&layout_));
+	}
+
+	void add(const auto& member, const std::size_t offset, const std::size_t length,
+	         const std::endian order = stream_order) {
+		if(stream_) {
+			fields_.emplace_back(member_offset(member), offset, length, order);
 		}
 	}
 
-public:
-	file_buffer(const std::filesystem::path& path)
-		: file_buffer(path.string().c_str()) { }
+	template<typename string_type>
+	void index_string(std::string_view view, const string_type& member) {
+		const auto end = stream_.total_read();
 
-	file_buffer(const char* path) {
-		file_ = std::fopen(path, "a+b");
-		
-		if(!file_) {
-			error_ = true;
-			return;
+		if constexpr(std::is_same_v<string_type, null_terminated<std::string>>) {
+			add(member.str, end - view.size() - 1, view.size());
+		} else {
+			add(member.str, end - view.size(), view.size());
 		}
-		
-		if(std::fseek(file_, 0, SEEK_END)) {
-			error_ = true;
+	}
+
+	template<typename container_type>
+	void index_array(container_type& container, const size_type count) {
+		using element_type = typename container_type::value_type;
+
+		constexpr auto max_size = std::numeric_limits<size_type>::max();
+
+		if(!stream_) {
 			return;
 		}
 
-		write_ = std::ftell(file_);
+		const auto offset = stream_.total_read();
+		const auto length = count > max_size / sizeof(element_type)?
+			max_size : count * sizeof(element_type);
 
-		if(write_ == -1) {
-			error_ = true;
-		}
+		stream_.skip(length);
+		add(container, offset, length);
 	}
 
-	file_buffer(file_buffer&& rhs) noexcept
-		: file_(rhs.file_),
-		  read_(rhs.read_),
-		  write_(rhs.write_),
-		  error_(rhs.error_) {
-		rhs.file_ = nullptr;
+	template<typename T>
+	void index(T&& arg) {
+		using arg_type = std::remove_cvref_t<T>;
+		const auto offset = stream_.total_read();
+
+		if constexpr(arithmetic<arg_type>) {
+			stream_ >> arg;
+			add(arg, offset, sizeof(arg_type));
+		} else if constexpr(std::derived_from<arg_type, endian::adaptor_tag_t>) {
+			// the adaptor is a temporary, so the member is the one it refers to
+			using value_type = std::remove_cvref_t<decltype(arg.value)>;
+			constexpr auto order = std::is_same_v<arg_type, endian::be<value_type>>?
+				std::endian::big : std::endian::little;
+			stream_ >> arg;
+			add(arg.value, offset, sizeof(value_type), order);
+		} else if constexpr(std::is_same_v<arg_type, std::string>) {
+			index(prefixed(arg));
+		} else if constexpr(std::is_same_v<arg_type, prefixed<std::string>>) {
+			std::string_view view;
+			stream_ >> prefixed(view);
+			index_string(view, arg);
+		} else if constexpr(std::is_same_v<arg_type, prefixed_varint<std::string>>) {
+			std::string_view view;
+			stream_ >> prefixed_varint(view);
+			index_string(view, arg);
+		} else if constexpr(std::is_same_v<arg_type, null_terminated<std::string>>) {
+			std::string_view view;
+			stream_ >> null_terminated(view);
+			index_string(view, arg);
+		} else if constexpr(adapted_array<arg_type, prefixed>) {
+			std::uint32_t count = 0;
+			stream_ >> endian::le(count);
+			index_array(arg.str, count);
+		} else if constexpr(adapted_array<arg_type, prefixed_varint>) {
+			const auto count = varint_decode<size_type>(stream_);
+			index_array(arg.str, count);
+		} else if constexpr(requires(view_indexer& indexer) { arg.serialise(indexer); }) {
+			arg.serialise(*this);
+			add(arg, offset, stream_.total_read() - offset);
+		} else {
+			stream_ >> arg;
+			add(arg, offset, stream_.total_read() - offset);
+		}
 	}
 
-	file_buffer& operator=(file_buffer&& rhs) noexcept {
-		std::exchange(file_, rhs.file_);
-		read_ = rhs.read_;
-		write_ = rhs.write_;
-		error_ = rhs.error_;
-		return *this;
+public:
+	view_indexer(stream_type& stream, object_type& layout, std::vector<view_field>& fields)
+		: stream_(stream), layout_(layout), fields_(fields) {}
+
+	void operator&(auto&& arg) {
+		index(std::forward<decltype(arg)>(arg));
 	}
 
-	file_buffer& operator=(const file_buffer&) = delete;
-	file_buffer(const file_buffer&) = delete;
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		(index(std::forward<Ts>(args)), ...);
+	}
 
-	~file_buffer() {
-		close();
+	void forward(std::string& str, const size_type length) {
+		const auto offset = stream_.total_read();
+		stream_.skip(length);
+		add(str, offset, length);
 	}
+};
 
+} // detail
 
-	/**
-	 * @brief Flush unwritten data.
-	 */
-	void flush() {
-		std::fflush(file_);
-	}
+/**
+ * A lazily decoded view over a serialised message in a contiguous buffer.
+ *
+ * Constructing the view makes a single validation pass over the message,
+ * using the message type's serialise function, and records where each
+ * field's data is, without consuming anything from the buffer. Fields are
+ * then only decoded when they're accessed:
+ *
+ * hexi::message_view<Message> view(buffer);
+ *
+ * if(view) {
+ *     const auto id = view.get<&Message::id>();          // arithmetic, decoded
+ *     const auto name = view.get<&Message::name>();      // std::string_view
+ *     const auto values = view.get<&Message::values>();  // std::vector
+ *     buffer.skip(view.size());
+ * }
+ *
+ * This is useful where only a few fields of a large message are needed,
+ * e.g. to route or filter it. Strings are viewed in place, arithmetic
+ * types are decoded with the byte order they were written in and other
+ * trivial types are copied out, as are arrays of trivial types. Nested serialisable objects and other field types are validated but
+ * can't be accessed through the view. Conditional fields that the message
+ * doesn't contain can be detected with has.
+ *
+ * The view's lifetime is tied to that of the underlying buffer's data.
+ * The message type's serialise function is run against a default
+ * constructed instance that only has its arithmetic and trivial fields
+ * decoded, so serialise may depend on lengths and flags read earlier in
+ * the message, but not on the contents of strings or containers.
+ *
+ * @tparam T The message type. Must be default constructible.
+ * @tparam endianness The byte order of the message's arithmetic fields,
+ * other than those written through endian::be or endian::le.
+ */
+template<std::default_initializable T, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class message_view final {
+	const std::byte* data_ = nullptr;
+	std::size_t size_ = 0;
+	std::vector<detail::view_field> fields_;
+	stream_state state_ = stream_state::ok;
 
-	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @param destination The buffer to copy the data to.
-	 */
-	template<typename T>
-	void read(T* destination) {
-		read(destination, sizeof(T));
+	// only used to find the offsets of members
+	static const T& layout() {
+		static T instance{};
+		return instance;
 	}
 
-	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @param destination The buffer to copy the data to.
-	 * @param length The number of bytes to read into the buffer.
-	 */
-	void read(void* destination, size_type length) {
-		if(error_) {
-			return;
-		}
+	template<auto member>
+	static std::size_t member_offset() {
+		return static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&(layout().*member))
+			- reinterpret_cast<const std::byte*>(&layout()));
+	}
 
-		if(std::fseek(file_, read_, 0)) {
-			error_ = true;
-			return;
-		}
+	template<auto member>
+	const detail::view_field* field() const {
+		const auto offset = member_offset<member>();
 
-		if(std::fread(destination, length, 1, file_) != 1) {
-			error_ = true;
-			return;
-		}
+		const auto it = std::ranges::find_if(fields_, [&](const auto& field) {
+			return field.member == offset;
+		});
 
-		read_ += length;
+		return it == fields_.end()? nullptr : &*it;
 	}
 
+public:
 	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the read cursor.
-	 * 
-	 * @param destination The buffer to copy the data to.
+	 * @brief Validates the message at the buffer's read position and builds
+	 * the view. Nothing is consumed from the buffer.
+	 *
+	 * @param buffer The buffer containing the message.
 	 */
-	template<typename T>
-	void copy(T* destination) {
-		copy(destination, sizeof(T));
+	template<transactional buf_type>
+	requires std::is_same_v<typename buf_type::contiguous, is_contiguous>
+	explicit message_view(buf_type& buffer) {
+		binary_stream<buf_type, no_throw_t, endianness> stream(buffer);
+		auto tx = stream.begin_transaction();
+		data_ = reinterpret_cast<const std::byte*>(buffer.read_ptr());
+
+		T message{};
+		detail::view_indexer indexer(*tx, message, fields_);
+		message.serialise(indexer);
+
+		state_ = tx->state();
+		size_ = tx->total_read();
 	}
 
 	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the read cursor.
-	 * 
-	 * @param destination The buffer to copy the data to.
-	 * @param length The number of bytes to copy.
+	 * @brief Checks whether the message contains the field corresponding to
+	 * the member, which it may not if the field is conditional.
+	 *
+	 * @tparam member Pointer to the member, e.g. &Message::extra.
+	 *
+	 * @return True if the field can be accessed with get.
 	 */
-	void copy(void* destination, size_type length) {
-		if(error_) {
-			return;
-		} else if(length > size()) {
-			error_ = true;
-			HEXI_THROW(buffer_underrun(length, read_, size()));
-		}
-
-		if(std::fseek(file_, read_, SEEK_SET)) {
-			error_ = true;
-			return;
-		}
-		
-		if(std::fread(destination, length, 1, file_) != 1) {
-			error_ = true;
-			return;
-		}
+	template<auto member>
+	bool has() const {
+		return field<member>() != nullptr;
 	}
 
 	/**
-	 * @brief Attempts to locate the provided value within the container.
-	 * 
-	 * @param value The value to locate.
-	 * 
-	 * @return The position of value or npos if not found.
-	 */
-	size_type find_first_of(value_type val) noexcept {
-		if(error_) {
-			return npos;
-		}
+	 * @brief Decodes the field corresponding to the member.
+	 *
+	 * @tparam member Pointer to the member, e.g. &Message::name.
+	 *
+	 * @return The decoded value for arithmetic and other trivial types,
+	 * a std::string_view for strings or a copy of the elements for arrays.
+	 * If the message doesn't contain the field (see has), the result is
+	 * value-initialised.
+	 */
+	template<auto member>
+	auto get() const {
+		using member_type = std::remove_cvref_t<decltype(layout().*member)>;
+		const auto field = this->field<member>();
+
+		if constexpr(std::is_same_v<member_type, std::string>) {
+			if(!field) {
+				return std::string_view();
+			}
 
-		if(std::fseek(file_, read_, SEEK_SET)) {
-			error_ = true;
-			return npos;
-		}
+			return std::string_view(reinterpret_cast<const char*>(data_ + field->offset), field->length);
+		} else if constexpr(detail::viewable_array<member_type>) {
+			/*
+			 * The data may not be aligned for the element type, so it's
+			 * copied out. Streams write arrays of trivial types as stored,
+			 * without byte swapping, so the elements are copied as-is to
+			 * match what deserialising the message would give.
+			 */
+			using element_type = typename member_type::value_type;
+			std::conditional_t<pod<member_type>, member_type, std::vector<element_type>> values{};
+
+			if(field) {
+				if constexpr(!pod<member_type>) {
+					values.resize(field->length / sizeof(element_type));
+				}
 
-		value_type buffer{};
+				std::memcpy(values.data(), data_ + field->offset, values.size() * sizeof(element_type));
+			}
 
-		for(size_type i = 0, j = size(); i < j; ++i) {
-			if(std::fread(&buffer, sizeof(value_type), 1, file_) != 1) {
-				error_ = true;
-				return npos;
+			return values;
+		} else if constexpr(arithmetic<member_type>) {
+			member_type value{};
+
+			if(field) {
+				std::memcpy(&value, data_ + field->offset, sizeof(value));
+				endian::conditional_reverse_inplace(value, field->order, std::endian::native);
 			}
 
-			if(buffer == val) {
-				return i;
+			return value;
+		} else if constexpr(pod<member_type> && !detail::probe_serialisable<member_type>) {
+			member_type value{};
+
+			if(field) {
+				std::memcpy(&value, data_ + field->offset, sizeof(value));
 			}
-		}
 
-		return npos;
+			return value;
+		} else {
+			static_assert(sizeof(member_type) == 0, "This field type can't be accessed through a view");
+		}
 	}
 
 	/**
-	 * @brief Skip a requested number of bytes.
-	 *
-	 * Skips over a number of bytes from the file. This should be used
-	 * if the file holds data that you don't care about but don't want
-	 * to have to read it to another buffer to access data beyond it.
-	 * 
-	 * @param length The number of bytes to skip.
+	 * @return The number of bytes occupied by the serialised message.
 	 */
-	void skip(const size_type length) {
-		read_ += length;
+	std::size_t size() const {
+		return size_;
 	}
 
-	/**
-	 * @brief Whether the container is empty.
-	 * 
-	 * @return Returns true if the container is empty (has no data to be read).
-	 */
-	[[nodiscard]]
-	bool empty() const {
-		return write_ == read_;
+	stream_state state() const {
+		return state_;
 	}
 
-	/**
-	 * @brief Determine whether the adaptor supports write seeking.
-	 * 
-	 * This is determined at compile-time and does not need to checked at
-	 * run-time.
-	 * 
-	 * @return True if write seeking is supported, otherwise false.
-	 */
-	constexpr static bool can_write_seek() {
-		return std::is_same_v<seeking, supported>;
+	bool good() const {
+		return state_ == stream_state::ok;
 	}
 
-	/**
-	 * @brief Write data to the container.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 */
-	void write(const auto& source) {
-		write(&source, sizeof(source));
+	operator bool() const {
+		return good();
 	}
+};
 
-	/**
-	 * @brief Write provided data to the file.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 * @param length Number of bytes to write from the source.
-	 */
-	void write(const void* source, size_type length) {
-		if(error_) {
-			return;
-		}
-		
-		if(std::fseek(file_, write_, SEEK_SET)) {
-			error_ = true;
-			return;
-		}
+} // hexi
 
-		if(std::fwrite(source, length, 1, file_) != 1) {
-			error_ = true;
-			return;
-		}
+// #include <hexi/overlay.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
 
-		write_ += length;
-	}
 
 
-	/**
-	 * @brief Returns the amount of data available in the file.
-	 * 
-	 * @return The number of bytes of data available to read from the file.
-	 */
-	size_type size() const {
-		return static_cast<size_type>(write_) - read_;
-	}
+// #include <hexi/shared.h>
 
-	/** 
-	 * @brief Retrieve the file handle.
-	 * 
-	 * @return The file handle.
-	 */
-	FILE* handle() {
-		return file_;
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include <cstddef>
+
+namespace hexi {
+
+/**
+ * An arithmetic value stored in a fixed byte order with no alignment
+ * requirement, for use as a field in wire structs. Conversions to and from
+ * the native representation happen on access.
+ *
+ * @tparam T The arithmetic type.
+ * @tparam order The byte order the value is stored in.
+ */
+template<arithmetic T, std::endian order>
+class endian_value final {
+	std::array<std::byte, sizeof(T)> bytes_;
+
+public:
+	using value_type = T;
+
+	endian_value() = default;
+
+	constexpr endian_value(const T value) {
+		set(value);
 	}
 
-	/** 
-	 * @brief Retrieve the file handle.
-	 * 
-	 * @return The file handle.
-	 */
-	const FILE* handle() const {
-		return file_;
+	constexpr T get() const {
+		return endian::conditional_reverse<order, std::endian::native>(std::bit_cast<T>(bytes_));
+	}
+
+	constexpr void set(const T value) {
+		bytes_ = std::bit_cast<decltype(bytes_)>(
+			endian::conditional_reverse<std::endian::native, order>(value)
+		);
 	}
 
-	/** 
-	 * @return True if an error has occurred during file operations.
-	 */
-	bool error() const {
-		return error_;
+	constexpr endian_value& operator=(const T value) {
+		set(value);
+		return *this;
 	}
 
-	/** 
-	 * @return True if no error has occurred during file operations.
-	 */
-	operator bool() const {
-		return !error();
+	constexpr operator T() const {
+		return get();
 	}
 };
 
-} // hexi
+template<arithmetic T>
+using be = endian_value<T, std::endian::big>;
 
-// #include <hexi/shared.h>
+template<arithmetic T>
+using le = endian_value<T, std::endian::little>;
 
-// #include <hexi/static_buffer.h>
+/**
+ * Types that can be overlaid directly onto buffer memory. They must be
+ * trivially copyable, standard layout, contain no padding and have no
+ * alignment requirement, which is the case for structs made up of be/le
+ * fields, single byte types and arrays thereof.
+ */
+template<typename T>
+concept overlayable = std::is_trivially_copyable_v<T>
+	&& std::is_standard_layout_v<T>
+	&& std::has_unique_object_representations_v<T>
+	&& alignof(T) == 1;
+
+/**
+ * @brief Overlays a wire struct onto the stream's buffer without copying,
+ * after a single bounds check, and advances the stream past it, e.g:
+ *
+ * struct dns_header {
+ *     hexi::be<std::uint16_t> id;
+ *     hexi::be<std::uint16_t> flags;
+ *     ...
+ * };
+ *
+ * if(auto header = hexi::overlay<dns_header>(stream)) {
+ *     const std::uint16_t id = header->id;
+ * }
+ *
+ * The pointer's lifetime is tied to that of the underlying buffer's data.
+ * On other buffers, wire structs can be read by copy with operator>>.
+ *
+ * @tparam T The wire struct type.
+ * @param stream The stream to read from.
+ *
+ * @return A pointer to the struct within the buffer, or nullptr if the
+ * stream doesn't contain enough data.
+ */
+template<overlayable T, typename stream_type>
+requires std::is_same_v<typename stream_type::contiguous_type, is_contiguous>
+const T* overlay(stream_type& stream) {
+	const auto bytes = stream.template span<const std::byte>(sizeof(T));
+	return bytes.empty()? nullptr : reinterpret_cast<const T*>(bytes.data());
+}
+
+} // hexi
+
+// #include <hexi/bit_stream.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -4029,426 +11196,617 @@ public:
 
 
 
-// #include <hexi/exception.h>
+// #include <hexi/binary_stream.h>
 
 // #include <hexi/shared.h>
 
 // #include <hexi/concepts.h>
 
+// #include <hexi/endian.h>
+
 #include <array>
+#include <concepts>
 #include <span>
-#include <utility>
+#include <type_traits>
 #include <cassert>
 #include <cstddef>
-#include <cstring>
+#include <cstdint>
 
 namespace hexi {
 
-using namespace detail;
+namespace detail {
 
-template<byte_type storage_type, std::size_t buf_size>
-class static_buffer final {
-	std::array<storage_type, buf_size> buffer_ = {};
-	std::size_t read_ = 0;
-	std::size_t write_ = 0;
+template<std::size_t bits>
+using bits_type = std::conditional_t<bits <= 8, std::uint8_t,
+	std::conditional_t<bits <= 16, std::uint16_t,
+	std::conditional_t<bits <= 32, std::uint32_t, std::uint64_t>>>;
+
+} // detail
 
+/**
+ * Reads and writes values at bit granularity, on top of a binary_stream
+ * over the given buffer. Bits are packed least significant first, both
+ * within values and within each byte, as used by update masks.
+ *
+ * Writes are gathered in a 64-bit accumulator that's written to the buffer
+ * a word at a time. Call flush once the last bits have been written to pad
+ * the final byte with zeroes and write out anything that's left.
+ *
+ * Reads refill the accumulator with all of the bytes needed to satisfy a
+ * read in one go, but never more, so byte-oriented reads can follow on
+ * from the bit-packed data once align has been called.
+ *
+ * Errors are handled by the underlying stream, with the same bounds
+ * checking and error state model as binary_stream. A failed read returns
+ * zero.
+ *
+ * @tparam buf_type The buffer type.
+ * @tparam exceptions Whether the stream should throw on errors.
+ */
+template<byte_oriented buf_type, std::derived_from<except_tag> exceptions = HEXI_EXCEPTION_TAG>
+class bit_stream final {
 public:
-	using size_type       = typename decltype(buffer_)::size_type;
-	using offset_type     = size_type;
-	using value_type      = storage_type;
-	using contiguous      = is_contiguous;
-	using seeking         = supported;
+	using stream_type = binary_stream<buf_type, exceptions, endian::as_little_t>;
+	using size_type = typename buf_type::size_type;
 
-	static constexpr auto npos { static_cast<size_type>(-1) };
-	
-	static_buffer() = default;
+private:
+	static constexpr std::size_t word_bits = 64;
+	static constexpr std::size_t max_op_bits = 32;
 
-	template<typename... T> 
-	static_buffer(T&&... vals) : buffer_{ std::forward<T>(vals)... } {
-		write_ = sizeof... (vals);
+	stream_type stream_;
+	std::uint64_t write_acc_ = 0;
+	std::size_t write_bits_ = 0;
+	std::uint64_t read_acc_ = 0;
+	std::size_t read_bits_ = 0;
+	size_type total_bits_written_ = 0;
+	size_type total_bits_read_ = 0;
+
+	static constexpr std::uint64_t mask(const std::size_t bits) {
+		return bits >= word_bits? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+	}
+
+	void flush_word() {
+		stream_ << write_acc_;
+		write_acc_ = 0;
+		write_bits_ = 0;
+	}
+
+	void write_bits(std::uint64_t value, const std::size_t count) {
+		assert(count <= max_op_bits);
+		value &= mask(count);
+		write_acc_ |= value << write_bits_;
+
+		const auto free_bits = word_bits - write_bits_;
+
+		if(count < free_bits) {
+			write_bits_ += count;
+			return;
+		}
+
+		flush_word();
+
+		// carry over the bits that didn't fit into the previous word
+		if(count > free_bits) {
+			write_acc_ = value >> free_bits;
+			write_bits_ = count - free_bits;
+		}
+	}
+
+	std::uint64_t read_bits(const std::size_t count) {
+		assert(count <= max_op_bits);
+
+		if(read_bits_ < count) {
+			const auto needed = (count - read_bits_ + 7) / 8;
+			std::array<std::uint8_t, 8> bytes{};
+			stream_.get(bytes.data(), needed);
+
+			if(!stream_) [[unlikely]] {
+				return 0;
+			}
+
+			for(std::size_t i = 0; i < needed; ++i) {
+				read_acc_ |= std::uint64_t(bytes[i]) << read_bits_;
+				read_bits_ += 8;
+			}
+		}
+
+		const auto value = read_acc_ & mask(count);
+		read_acc_ >>= count;
+		read_bits_ -= count;
+		return value;
 	}
 
-	static_buffer(static_buffer&& rhs) = default;
-	static_buffer& operator=(static_buffer&&) = default;
-	static_buffer& operator=(const static_buffer&) = default;
-	static_buffer(const static_buffer&) = default;
+public:
+	explicit bit_stream(buf_type& buffer)
+		: stream_(buffer) {}
+
+	bit_stream(buf_type& buffer, exceptions)
+		: stream_(buffer) {}
+
+	bit_stream(const bit_stream&) = delete;
+	bit_stream& operator=(const bit_stream&) = delete;
+
+	~bit_stream() {
+		assert((!write_bits_ || !stream_) && "bit_stream destroyed without being flushed");
+	}
 
 	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @param destination The buffer to copy the data to.
+	 * @brief Writes the low bits of a value to the stream.
+	 *
+	 * @param value The value to write.
+	 * @param count The number of bits to write, up to 64.
 	 */
-	template<typename T>
-	void read(T* destination) {
-		read(destination, sizeof(T));
+	void put_bits(const std::uint64_t value, const std::size_t count) {
+		assert(count <= word_bits);
+
+		if(count > max_op_bits) {
+			write_bits(value, max_op_bits);
+			write_bits(value >> max_op_bits, count - max_op_bits);
+		} else {
+			write_bits(value, count);
+		}
+
+		total_bits_written_ += count;
 	}
 
 	/**
-	 * @brief Reads a number of bytes to the provided buffer.
-	 * 
-	 * @param destination The buffer to copy the data to.
-	 * @param length The number of bytes to read into the buffer.
+	 * @brief Writes each bool as a single bit.
+	 *
+	 * @param bits The bools to write.
 	 */
-	void read(void* destination, size_type length) {
-		copy(destination, length);
-		read_ += length;
-
-		if(read_ == write_) {
-			read_ = write_ = 0;
+	void put_bits(std::span<const bool> bits) {
+		for(const auto bit : bits) {
+			write_bits(bit, 1);
 		}
+
+		total_bits_written_ += bits.size();
+	}
+
+	void put_bit(const bool bit) {
+		write_bits(bit, 1);
+		++total_bits_written_;
 	}
 
 	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the read cursor.
-	 * 
-	 * @param destination The buffer to copy the data to.
+	 * @brief Reads a value of the given number of bits from the stream.
+	 *
+	 * @tparam count The number of bits to read, up to 64.
+	 *
+	 * @return The value, in the smallest unsigned type that can hold it.
 	 */
-	template<typename T>
-	void copy(T* destination) const {
-		copy(destination, sizeof(T));
+	template<std::size_t count>
+	requires (count > 0 && count <= word_bits)
+	detail::bits_type<count> get_bits() {
+		return static_cast<detail::bits_type<count>>(get_bits(count));
 	}
 
 	/**
-	 * @brief Copies a number of bytes to the provided buffer but without advancing
-	 * the read cursor.
-	 * 
-	 * @note The destination buffer address must not belong to the static_buffer.
-	 * 
-	 * @param destination The buffer to copy the data to.
-	 * @param length The number of bytes to copy.
+	 * @brief Reads a value of the given number of bits from the stream.
+	 *
+	 * @param count The number of bits to read, up to 64.
+	 *
+	 * @return The value.
 	 */
-	void copy(void* destination, size_type length) const {
-		assert(!region_overlap(buffer_.data(), buffer_.size(), destination, length));
+	std::uint64_t get_bits(const std::size_t count) {
+		assert(count <= word_bits);
+		std::uint64_t value = 0;
 
-		if(length > size()) {
-			HEXI_THROW(buffer_underrun(length, read_, size()));
+		if(count > max_op_bits) {
+			value = read_bits(max_op_bits);
+			value |= read_bits(count - max_op_bits) << max_op_bits;
+		} else {
+			value = read_bits(count);
 		}
 
-		std::memcpy(destination, read_ptr(), length);
+		if(stream_) [[likely]] {
+			total_bits_read_ += count;
+		}
+
+		return stream_? value : 0;
 	}
 
 	/**
-	 * @brief Attempts to locate the provided value within the container.
-	 * 
-	 * @param value The value to locate.
-	 * 
-	 * @return The position of value or npos if not found.
+	 * @brief Reads a single bit into each bool.
+	 *
+	 * @param[out] bits The bools to read into.
 	 */
-	size_type find_first_of(value_type val) const noexcept {
-		const auto data = read_ptr();
+	void get_bits(std::span<bool> bits) {
+		for(auto& bit : bits) {
+			bit = read_bits(1);
+		}
 
-		for(size_type i = 0, j = size(); i < j; ++i) {
-			if(data[i] == val) {
-				return i;
-			}
+		if(stream_) [[likely]] {
+			total_bits_read_ += bits.size();
 		}
+	}
 
-		return npos;
+	bool get_bit() {
+		return get_bits(1);
 	}
 
 	/**
-	 * @brief Skip over a number of bytes.
-	 * 
-	 * Skips over a number of bytes from the container. This should be used
-	 * if the container holds data that you don't care about but don't want
-	 * to have to read it to another buffer to access data beyond it.
-	 * 
-	 * @param length The number of bytes to skip.
+	 * @brief Pads the bits written so far to a byte boundary and writes
+	 * them out to the buffer. Must be called after the last write.
 	 */
-	void skip(const size_type length) {
-		read_ += length;
+	void flush() {
+		const auto bytes = (write_bits_ + 7) / 8;
 
-		if(read_ == write_) {
-			read_ = write_ = 0;
+		if(!bytes) {
+			return;
 		}
+
+		std::array<std::uint8_t, 8> out{};
+
+		for(std::size_t i = 0; i < bytes; ++i) {
+			out[i] = static_cast<std::uint8_t>(write_acc_ >> (i * 8));
+		}
+
+		stream_.put(out.data(), bytes);
+		total_bits_written_ += (bytes * 8) - write_bits_;
+		write_acc_ = 0;
+		write_bits_ = 0;
 	}
 
 	/**
-	 * @brief Advances the write cursor.
-	 * 
-	 * @param size The number of bytes by which to advance the write cursor.
+	 * @brief Skips any bits remaining in the current byte, so that the next
+	 * read starts on a byte boundary.
 	 */
-	void advance_write(size_type bytes) {
-		assert(free() >= bytes);
-		write_ += bytes;
+	void align() {
+		total_bits_read_ += read_bits_;
+		read_acc_ = 0;
+		read_bits_ = 0;
 	}
 
 	/**
-	 * @brief Resizes the buffer.
-	 * 
-	 * @param size The new size of the buffer.
-	 * 
+	 * @return The total number of bits written, including flush padding.
 	 */
-	void resize(size_type size) {
-		if(size > buffer_.size()) {
-			HEXI_THROW(exception("attempted to resize static_buffer to larger than capacity"));
-		}
-
-		write_ = size;
+	size_type total_bits_written() const {
+		return total_bits_written_;
 	}
 
 	/**
-	 * @brief Clears the container.
+	 * @return The total number of bits read, including skipped bits.
 	 */
-	void clear() {
-		read_ = write_ = 0;
+	size_type total_bits_read() const {
+		return total_bits_read_;
 	}
 
-	/**
-	 * @brief Moves any unread data to the front of the buffer, freeing space at the end.
-	 * If a move is performed, pointers obtained from read/write_ptr() will be invalidated.
-	 * 
-	 * If the buffer contains no data available for reading, this function will have no effect.
-	 * 
-	 * @return True if additional space was made available.
-	 */
-	bool defragment() {
-		if(read_ == 0) {
-			return false;
-		}
+	stream_type& stream() {
+		return stream_;
+	}
 
-		write_ = size();
-		std::memmove(buffer_.data(), read_ptr(), write_);
-		read_ = 0;
-		return true;
+	stream_state state() const {
+		return stream_.state();
 	}
 
-	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
-	 */
-	value_type& operator[](const size_type index) {
-		return read_ptr()[index];
+	bool good() const {
+		return stream_.good();
+	}
+
+	operator bool() const {
+		return good();
+	}
+};
+
+} // hexi
+
+// #include <hexi/quantise.h>
+
+// #include <hexi/delta.h>
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+
+
+// #include <hexi/binary_stream.h>
+
+// #include <hexi/buffer_adaptor.h>
+
+// #include <hexi/shared.h>
+
+// #include <hexi/concepts.h>
+
+// #include <hexi/endian.h>
+
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hexi {
+
+namespace detail {
+
+struct delta_field {
+	std::size_t offset;
+	std::size_t length;
+};
+
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * Serialises each field into a scratch stream and records where each
+ * field's bytes are, so that fields can be compared between snapshots.
+ */
+template<typename stream_type>
+class delta_recorder final {
+	stream_type& stream_;
+	std::vector<delta_field>& fields_;
+
+	void record(auto&& arg) {
+		const auto offset = stream_.total_write();
+		stream_ << arg;
+		fields_.emplace_back(offset, stream_.total_write() - offset);
 	}
 
-	/**
-	 * @brief Retrieves a reference to the specified index within the container.
-	 * 
-	 * @param index The index within the container.
-	 * 
-	 * @return A reference to the value at the specified index.
-	 */
-	const value_type& operator[](const size_type index) const {
-		return read_ptr()[index];
-	}
+public:
+	delta_recorder(stream_type& stream, std::vector<delta_field>& fields)
+		: stream_(stream), fields_(fields) {}
 
-	/**
-	 * @brief Whether the container is empty.
-	 * 
-	 * @return Returns true if the container is empty (has no data to be read).
-	 */
-	[[nodiscard]]
-	bool empty() const {
-		return write_ == read_;
+	void operator&(auto&& arg) {
+		record(std::forward<decltype(arg)>(arg));
 	}
 
-	/**
-	 * @return Whether the container is full and cannot be further written to.
-	 */
-	bool full() const {
-		return write_ == capacity();
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		(record(std::forward<Ts>(args)), ...);
 	}
 
-	/**
-	 * @brief Determine whether the adaptor supports write seeking.
-	 * 
-	 * This is determined at compile-time and does not need to checked at
-	 * run-time.
-	 * 
-	 * @return True if write seeking is supported, otherwise false.
-	 */
-	constexpr static bool can_write_seek() {
-		return std::is_same_v<seeking, supported>;
+	template<typename ...Ts>
+	void forward(Ts&&... args) {
+		const auto offset = stream_.total_write();
+		stream_.put(std::forward<Ts>(args)...);
+		fields_.emplace_back(offset, stream_.total_write() - offset);
 	}
+};
 
-	/**
-	 * @brief Write data to the container.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 */
-	void write(const auto& source) {
-		write(&source, sizeof(source));
-	}
+/*
+ * Passed to an object's serialise function in place of a stream adaptor.
+ * Only deserialises the fields that are flagged as present in the mask,
+ * leaving the others untouched. Fields beyond the end of the mask are
+ * never present, with the caller checking that the number of fields
+ * visited matches the mask.
+ */
+template<typename stream_type>
+class delta_applier final {
+	stream_type& stream_;
+	std::span<const std::uint8_t> mask_;
+	std::size_t index_ = 0;
+	std::size_t applied_ = 0;
 
-	/**
-	 * @brief Write provided data to the container.
-	 * 
-	 * @note The source buffer address must not belong to the static_buffer.
-	 * 
-	 * @param source Pointer to the data to be written.
-	 * @param length Number of bytes to write from the source.
-	 */
-	void write(const void* source, size_type length) {
-		assert(!region_overlap(source, length, buffer_.data(), buffer_.size()));
+	bool present() {
+		const auto index = index_++;
 
-		if(free() < length) {
-			HEXI_THROW(buffer_overflow(length, write_, free()));
+		if(index / 8 >= mask_.size()) [[unlikely]] {
+			return false;
 		}
 
-		std::memcpy(write_ptr(), source, length);
-		write_ += length;
+		if(mask_[index / 8] & (1u << (index % 8))) {
+			++applied_;
+			return true;
+		}
+
+		return false;
 	}
 
-	/**
-	 * @brief Performs write seeking within the container.
-	 * 
-	 * @param direction Specify whether to seek in a given direction or to absolute seek.
-	 * @param offset The offset relative to the seek direction or the absolute value
-	 * when using absolute seeking.
-	 */
-	void write_seek(const buffer_seek direction, const size_type offset) {
-		switch(direction) {
-			case buffer_seek::sk_backward:
-				write_ -= offset;
-				break;
-			case buffer_seek::sk_forward:
-				write_ += offset;
-				break;
-			case buffer_seek::sk_absolute:
-				write_ = offset;
+public:
+	delta_applier(stream_type& stream, std::span<const std::uint8_t> mask)
+		: stream_(stream), mask_(mask) {}
+
+	void operator&(auto&& arg) {
+		if(present()) {
+			stream_ >> arg;
 		}
 	}
 
-	/**
-	 * @return An iterator to the beginning of data available for reading.
-	 */
-	auto begin() {
-		return buffer_.begin() + read_;
+	template<typename ...Ts>
+	void operator()(Ts&&... args) {
+		((*this & std::forward<Ts>(args)), ...);
 	}
 
-	/**
-	 * @return An iterator to the beginning of data available for reading.
-	 */
-	auto begin() const {
-		return buffer_.begin() + read_;
+	template<typename ...Ts>
+	void forward(Ts&&... args) {
+		if(present()) {
+			stream_.get(std::forward<Ts>(args)...);
+		}
 	}
 
-	/**
-	 * @return An iterator to the end of data available for reading.
-	 */
-	auto end() {
-		return buffer_.begin() + write_;
+	std::size_t applied() const {
+		return applied_;
 	}
 
-	/**
-	 * @return An iterator to the end of data available for reading.
-	 */
-	auto end() const {
-		return buffer_.begin() + write_;
+	std::size_t visited() const {
+		return index_;
 	}
+};
 
-	/**
-	 * @brief Overall capacity of the container.
-	 * 
-	 * @return The container's total size in bytes.
-	 */
-	constexpr static size_type capacity() {
-		return buf_size;
-	}
+struct field_counter final {
+	std::size_t count = 0;
 
-	/**
-	 * @brief Returns the size of the container.
-	 * 
-	 * @return The number of bytes of data available to read within the container.
-	 */
-	size_type size() const {
-		return write_ - read_;
+	void operator&(auto&&) {
+		++count;
 	}
 
-	/**
-	 * @brief The amount of free space.
-	 * 
-	 * @return The number of bytes of free space within the container.
-	 */
-	size_type free() const {
-		return buf_size - write_;
+	template<typename ...Ts>
+	void operator()(Ts&&...) {
+		count += sizeof...(Ts);
 	}
 
-	/**
-	 * @return Pointer to the data available for reading.
-	 */
-	const value_type* data() const {
-		return read_ptr();
+	void forward(auto&&...) {
+		++count;
 	}
+};
 
-	/**
-	 * @return Pointer to the data available for reading.
-	 */
-	value_type* data() {
-		return read_ptr();
+} // detail
+
+/**
+ * The serialised fields of an object, to be used as the baseline that
+ * later states of the object are delta encoded against. Fields are split
+ * along the calls made by the object's serialise function, with a nested
+ * serialisable object being treated as a single field.
+ *
+ * Keeping a snapshot of the last state acknowledged by the peer avoids
+ * serialising the baseline again for each delta.
+ *
+ * @tparam T The object type, which must provide a serialise function that
+ * visits the same fields regardless of their values.
+ * @tparam endianness The byte order of the stream that deltas are written to.
+ */
+template<typename T, std::derived_from<endian::storage_tag> endianness = endian::as_native_t>
+class delta_snapshot final {
+	std::vector<std::uint8_t> data_;
+	std::vector<detail::delta_field> fields_;
+
+public:
+	explicit delta_snapshot(T& object) {
+		update(object);
 	}
 
 	/**
-	 * @return Pointer to the data available for reading.
+	 * @brief Replaces the snapshot with the object's current state.
+	 *
+	 * @param object The object to take a snapshot of.
 	 */
-	const value_type* read_ptr() const {
-		return buffer_.data() + read_;
+	void update(T& object) {
+		data_.clear();
+		fields_.clear();
+
+		buffer_adaptor adaptor(data_);
+		binary_stream<decltype(adaptor), no_throw_t, endianness> stream(adaptor);
+		detail::delta_recorder recorder(stream, fields_);
+		object.serialise(recorder);
 	}
 
 	/**
-	 * @return Pointer to the data available for reading.
+	 * @return The number of fields in the snapshot.
 	 */
-	value_type* read_ptr() {
-		return buffer_.data() + read_;
+	std::size_t fields() const {
+		return fields_.size();
 	}
 
 	/**
-	 * @return Pointer to the location within the buffer where the next write
-	 * will be made.
+	 * @return The serialised bytes of the given field.
 	 */
-	const value_type* write_ptr() const {
-		return buffer_.data() + write_;
+	std::span<const std::uint8_t> field(const std::size_t index) const {
+		assert(index < fields_.size());
+		const auto& field = fields_[index];
+		return { data_.data() + field.offset, field.length };
 	}
+};
 
-	/**
-	 * @return Pointer to the location within the buffer where the next write
-	 * will be made.
-	 */
-	value_type* write_ptr() {
-		return buffer_.data() + write_;
+/**
+ * @brief Writes the changes from a baseline to the object's current state,
+ * as a field presence bitmask followed by only the fields that changed.
+ * The mask has a bit per field, least significant first, rounded up to
+ * a whole number of bytes.
+ *
+ * If the object's serialise function visits a different number of fields
+ * than it did for the baseline, nothing is written and the stream is put
+ * into an error state.
+ *
+ * @param stream The stream to write the delta to.
+ * @param baseline A snapshot of the state that the delta is against.
+ * @param object The object's current state.
+ *
+ * @return The number of fields written.
+ */
+template<typename buf_type, typename exceptions, typename endianness, typename T>
+std::size_t write_delta(binary_stream<buf_type, exceptions, endianness>& stream,
+                        const delta_snapshot<T, endianness>& baseline, T& object) {
+	const delta_snapshot<T, endianness> current(object);
+
+	if(current.fields() != baseline.fields()) [[unlikely]] {
+		stream.set_error_state();
+		return 0;
 	}
 
-	/**
-	 * @return Pointer to the underlying storage.
-	 */
-	value_type* storage() {
-		return buffer_.data();
+	std::vector<std::uint8_t> mask((current.fields() + 7) / 8);
+	std::size_t changed = 0;
+
+	for(std::size_t i = 0; i < current.fields(); ++i) {
+		if(!std::ranges::equal(current.field(i), baseline.field(i))) {
+			mask[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+			++changed;
+		}
 	}
 
-	/**
-	 * @return Pointer to the underlying storage.
-	 */
-	const value_type* storage() const {
-		return buffer_.data();
+	stream.put(mask.data(), mask.size());
+
+	for(std::size_t i = 0; i < current.fields(); ++i) {
+		if(mask[i / 8] & (1u << (i % 8))) {
+			const auto field = current.field(i);
+			stream.put(field.data(), field.size());
+		}
 	}
 
-	/**
-	 * @brief Retrieves a span representing the data available for reading contained within
-	 * underlying storage.
-	 * 
-	 * @return A span over the data waiting to be read from the container.
-	 */
-	std::span<const value_type> read_span() const {
-		return { read_ptr(), size() };
+	return changed;
+}
+
+/**
+ * @brief Writes the changes from the baseline to the object's current
+ * state. See the overload taking a snapshot for the format.
+ *
+ * @param stream The stream to write the delta to.
+ * @param baseline The state that the delta is against.
+ * @param object The object's current state.
+ *
+ * @return The number of fields written.
+ */
+template<typename buf_type, typename exceptions, typename endianness, typename T>
+std::size_t write_delta(binary_stream<buf_type, exceptions, endianness>& stream,
+                        T& baseline, T& object) {
+	return write_delta(stream, delta_snapshot<T, endianness>(baseline), object);
+}
+
+/**
+ * @brief Reads a delta written by write_delta and applies it to the object,
+ * which must hold the same baseline state that the delta was written
+ * against. Fields that didn't change are left untouched.
+ *
+ * If the object's serialise function visits a different number of fields
+ * while the delta is applied than it did when the mask was sized, e.g.
+ * because a field it depends on changed, the stream is put into an error
+ * state.
+ *
+ * @param stream The stream to read the delta from.
+ * @param[in, out] object The baseline to apply the delta to.
+ *
+ * @return The number of fields read.
+ */
+template<typename stream_type, typename T>
+std::size_t read_delta(stream_type& stream, T& object) {
+	detail::field_counter counter;
+	object.serialise(counter);
+
+	std::vector<std::uint8_t> mask((counter.count + 7) / 8);
+	stream.get(mask.data(), mask.size());
+
+	if(!stream) [[unlikely]] {
+		return 0;
 	}
 
-	/**
-	 * @brief Retrieves a span representing the free space within the underlying storage.
-	 * 
-	 * @return A span over the container's free space.
-	 */
-	std::span<value_type> write_span() {
-		return { write_ptr(), free() };
+	detail::delta_applier applier(stream, mask);
+	object.serialise(applier);
+
+	if(applier.visited() != counter.count) [[unlikely]] {
+		stream.set_error_state();
 	}
-};
+
+	return applier.applied();
+}
 
 } // hexi
 
-// #include <hexi/null_buffer.h>
+// #include <hexi/delta_packed.h>
+
+// #include <hexi/string_table.h>
 //  _               _ 
 // | |__   _____  _(_)
 // | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
@@ -4457,43 +11815,106 @@ public:
 
 
 
-// #include <hexi/pmc/buffer_write.h>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cassert>
+#include <cstddef>
 
-// #include <hexi/shared.h>
+namespace hexi {
 
-// #include <hexi/exception.h>
+/**
+ * Message-scoped table of the strings written or read with the deduplicated
+ * adaptor. Use one table per message and clear it, or use a new one,
+ * before the next.
+ *
+ * When writing, the table holds views of the strings that have been
+ * written, so they must outlive the table's use. When reading, the table
+ * holds views into the buffer for contiguous buffers, which are therefore
+ * tied to the lifetime of the buffer's data. Strings read from other
+ * buffers are copied into the table.
+ */
+class string_table final {
+	std::unordered_map<std::string_view, std::size_t> indices_;
+	std::vector<std::string_view> entries_;
+	std::deque<std::string> storage_;
 
-#include <cstddef>
+public:
+	string_table() = default;
+	string_table(const string_table&) = delete;
+	string_table& operator=(const string_table&) = delete;
 
-namespace hexi {
+	/**
+	 * @brief Looks up a string that's about to be written, adding it to the
+	 * table if it hasn't been written before.
+	 *
+	 * @param string The string to look up.
+	 *
+	 * @return The index of the earlier occurrence, if there is one.
+	 */
+	std::optional<std::size_t> find_or_insert(const std::string_view string) {
+		const auto [it, inserted] = indices_.try_emplace(string, entries_.size());
+
+		if(!inserted) {
+			return it->second;
+		}
+
+		entries_.emplace_back(string);
+		return std::nullopt;
+	}
+
+	/**
+	 * @brief Adds a string that has been read. The view must remain valid
+	 * for as long as the table is used.
+	 *
+	 * @param string The string to add.
+	 *
+	 * @return The string.
+	 */
+	std::string_view add(const std::string_view string) {
+		entries_.emplace_back(string);
+		return string;
+	}
+
+	/**
+	 * @brief Adds a string that has been read, taking ownership of it.
+	 *
+	 * @param string The string to add.
+	 *
+	 * @return A view of the string, valid until the table is cleared.
+	 */
+	std::string_view add(std::string&& string) {
+		return add(std::string_view(storage_.emplace_back(std::move(string))));
+	}
 
-class null_buffer final : public pmc::buffer_write {
-public:
-	using size_type       = std::size_t;
-	using offset_type     = std::size_t;
-	using value_type      = std::byte;
-	using contiguous      = is_contiguous;
-	using seeking         = unsupported;
+	/**
+	 * @return The string with the given index.
+	 */
+	std::string_view operator[](const std::size_t index) const {
+		assert(index < entries_.size());
+		return entries_[index];
+	}
 
-	void write(const auto& /*elem*/) {}
-	void write(const void* /*source*/, size_type /*length*/) override {};
-	void read(auto* /*elem*/) {}
-	void read(void* /*destination*/, size_type /*length*/) {};
-	void copy(auto* /*elem*/) const {}
-	void copy(void* /*destination*/, size_type /*length*/) const {};
-	void reserve(const size_type /*length*/) override {};
-	size_type size() const override{ return 0; };
-	[[nodiscard]] bool empty() const override { return true; };
-	bool can_write_seek() const override { return false; }
+	/**
+	 * @return The number of strings in the table.
+	 */
+	std::size_t size() const {
+		return entries_.size();
+	}
 
-	void write_seek(const buffer_seek /*direction*/, const std::size_t /*offset*/) override {
-		HEXI_THROW(exception("Don't do this on a null_buffer")); 
-	};
+	void clear() {
+		indices_.clear();
+		entries_.clear();
+		storage_.clear();
+	}
 };
 
 } // hexi
 
-// #include <hexi/stream_adaptors.h>
+// #include <hexi/utf8.h>
 
 // #include <hexi/allocators/block_allocator.h>
 
@@ -4503,6 +11924,10 @@ public:
 
 // #include <hexi/detail/intrusive_storage.h>
 
+// #include <hexi/detail/non_temporal_copy.h>
+
+// #include <hexi/detail/simd.h>
+
 // #include <hexi/pmc/binary_stream.h>
 //  _               _ 
 // | |__   _____  _(_)
@@ -4604,12 +12029,23 @@ public:
 
 // #include <hexi/exception.h>
 
+// #include <hexi/fixed_string.h>
+
+// #include <hexi/serialised_size.h>
+
 // #include <hexi/shared.h>
 
 // #include <hexi/stream_adaptors.h>
 
+// #include <hexi/utf8.h>
+
+#include <algorithm>
+#include <limits>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -4638,7 +12074,10 @@ using namespace detail;
 class binary_stream_reader : virtual public stream_base {
 	buffer_read& buffer_;
 	std::size_t total_read_;
+	std::size_t allocated_ = 0;
+	std::size_t alloc_limit_ = 0;
 	const std::size_t read_limit_;
+	bool reuse_storage_ = false;
 
 	inline void enforce_read_bounds(const std::size_t read_size) {
 		if(read_size > buffer_.size()) [[unlikely]] {
@@ -4668,12 +12107,94 @@ class binary_stream_reader : virtual public stream_base {
 		total_read_ += read_size;
 	}
 
+	/*
+	 * Rejects element counts that the remaining data couldn't possibly
+	 * satisfy, given the minimum serialised size of each element, before
+	 * anything is allocated for them.
+	 */
+	template<typename count_type>
+	bool check_element_count(const count_type count, const std::size_t min_size) {
+		if(!min_size || !std::cmp_greater(count, read_max() / min_size)) [[likely]] {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<std::size_t>::max();
+
+		const auto required = std::cmp_greater(count, max_size / min_size)?
+			max_size : static_cast<std::size_t>(count * min_size);
+
+		enforce_read_bounds(required);
+		return state() == stream_state::ok;
+	}
+
+	/*
+	 * Accounts for an allocation of count elements against the stream's
+	 * allocation limit, if one was set. Charged before the read's bounds
+	 * are enforced, so that a rejected allocation doesn't count towards
+	 * the read limit.
+	 */
+	template<typename count_type>
+	bool charge_allocation(const count_type count, const std::size_t element_size) {
+		if(state() != stream_state::ok) [[unlikely]] {
+			return false;
+		}
+
+		if(!alloc_limit_) {
+			return true;
+		}
+
+		constexpr auto max_size = std::numeric_limits<std::size_t>::max();
+
+		const auto bytes = std::cmp_greater(count, max_size / element_size)?
+			max_size : static_cast<std::size_t>(count * element_size);
+
+		if(allocated_ > alloc_limit_ || bytes > alloc_limit_ - allocated_) [[unlikely]] {
+			set_state(stream_state::alloc_limit_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(allocation_limit_exceeded(bytes, allocated_, alloc_limit_));
+			}
+
+			return false;
+		}
+
+		allocated_ += bytes;
+		return true;
+	}
+
 	template<typename container_type, typename count_type>
 	void read_container(container_type& container, const count_type count) {
 		using cvalue_type = typename container_type::value_type;
+		count_type reused = 0;
+
+		if constexpr(fixed_capacity<container_type>) {
+			if(count > container_type::capacity()) [[unlikely]] {
+				set_state(stream_state::capacity_err);
+
+				if(allow_throw()) {
+					HEXI_THROW(capacity_exceeded(count, container_type::capacity()));
+				}
+
+				return;
+			}
+		}
+
+		if(!check_element_count(count, bounds_of<cvalue_type>().min)) [[unlikely]] {
+			return;
+		}
+
+		if constexpr(!fixed_capacity<container_type>) {
+			if(!charge_allocation(count, sizeof(cvalue_type))) [[unlikely]] {
+				return;
+			}
+		}
 
 		if constexpr(!memcpy_read<container_type, binary_stream_reader>) {
-			container.clear();
+			if(reuse_storage_) {
+				reused = overwrite_elements(container, count);
+			} else {
+				container.clear();
+			}
 		}
 
 		if constexpr(has_reserve<container_type>) {
@@ -4686,7 +12207,7 @@ class binary_stream_reader : virtual public stream_base {
 			const auto bytes = count * sizeof(cvalue_type);
 			SAFE_READ(container.data(), bytes, void());
 		} else {
-			for(count_type i = 0; i < count; ++i) {
+			for(count_type i = reused; i < count; ++i) {
 				cvalue_type value;
 				*this >> value;
 				container.emplace_back(std::move(value));
@@ -4694,6 +12215,27 @@ class binary_stream_reader : virtual public stream_base {
 		}
 	}
 
+	template<typename container_type, typename count_type>
+	count_type overwrite_elements(container_type& container, const count_type count) {
+		using reference = std::ranges::range_reference_t<container_type>;
+
+		if constexpr(std::is_lvalue_reference_v<reference>) {
+			count_type reused = 0;
+			auto it = container.begin();
+
+			for(; it != container.end() && reused < count && state() == stream_state::ok; ++it) {
+				*this >> *it;
+				++reused;
+			}
+
+			container.erase(it, container.end());
+			return reused;
+		} else {
+			container.clear();
+			return 0;
+		}
+	}
+
 public:
 	explicit binary_stream_reader(buffer_read& source, std::size_t read_limit = 0)
 		: stream_base(source),
@@ -4711,7 +12253,10 @@ public:
 		: stream_base(rhs),
 		  buffer_(rhs.buffer_),
 		  total_read_(rhs.total_read_),
-		  read_limit_(rhs.read_limit_) {
+		  allocated_(rhs.allocated_),
+		  alloc_limit_(rhs.alloc_limit_),
+		  read_limit_(rhs.read_limit_),
+		  reuse_storage_(rhs.reuse_storage_) {
 		rhs.total_read_ = static_cast<std::size_t>(-1);
 		rhs.set_state(stream_state::invalid_stream);
 	}
@@ -4762,9 +12307,13 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -4788,9 +12337,13 @@ public:
 			std::unreachable();
 		}
 
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, *this);
 
-		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, size);
 			return size;
 		});
@@ -4798,6 +12351,87 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Deserialises a string with the wrapped adaptor and validates
+	 * that it's well-formed UTF-8.
+	 * 
+	 * @param[out] adaptor utf8 adaptor wrapping the string or string adaptor.
+	 * 
+	 * @note Invalid strings result in stream_state::invalid_utf8_err. The
+	 * string is left holding the invalid data.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	binary_stream_reader& operator>>(utf8_validated<T> adaptor) {
+		*this >> adaptor.value;
+
+		if(state() != stream_state::ok) {
+			return *this;
+		}
+
+		const auto string = utf8_view(adaptor.value);
+
+		if(!is_valid_utf8(string)) [[unlikely]] {
+			set_state(stream_state::invalid_utf8_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(invalid_utf8(utf8_error_offset(string), string.size()));
+			}
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @brief Deserialises a string that was serialised through a string
+	 * table, resolving references to earlier occurrences. Strings are
+	 * copied into the table, so string_views remain valid until it's
+	 * cleared.
+	 * 
+	 * @param[out] adaptor deduplicated adaptor referencing the std::string
+	 * or std::string_view to hold the result and the message's string table.
+	 * 
+	 * @note A reference to a string that isn't in the table results in
+	 * stream_state::invalid_tag_err.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	requires std::same_as<T, std::string> || std::same_as<T, std::string_view>
+	binary_stream_reader& operator>>(deduplicated_string<T, table_type> adaptor) {
+		const auto tag = varint_decode<std::size_t>(*this);
+
+		if(state() != stream_state::ok) {
+			return *this;
+		}
+
+		const auto value = tag >> 1;
+
+		if(tag & 1) {
+			if(value >= adaptor.table.size()) [[unlikely]] {
+				set_state(stream_state::invalid_tag_err);
+
+				if(allow_throw()) {
+					HEXI_THROW(invalid_string_reference(value, adaptor.table.size()));
+				}
+
+				return *this;
+			}
+
+			adaptor.str = adaptor.table[value];
+		} else {
+			std::string string;
+			get(string, value);
+
+			if(state() == stream_state::ok) {
+				adaptor.str = adaptor.table.add(std::move(string));
+			}
+		}
+
+		return *this;
+	}
+
 	/**
 	 * @brief Deserialises a string that was previously written with a
 	 * null terminator.
@@ -4814,11 +12448,15 @@ public:
 			return *this;
 		}
 
+		if(!charge_allocation(pos, sizeof(char))) [[unlikely]] {
+			return *this;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
 
-		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t size) {
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
 			buffer_.read(strbuf, pos);
-			return size;
+			return pos;
 		});
 
 		buffer_.skip(1); // skip null terminator
@@ -4842,6 +12480,62 @@ public:
 		return *this >> prefixed(data);
 	}
 
+	/**
+	 * @brief Deserialises a fixed_string that was previously written with a
+	 * fixed-length prefix.
+	 * 
+	 * @param[out] data fixed_string to hold the result.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_reader& operator>>(fixed_string<N>& data) {
+		return *this >> prefixed(data);
+	}
+
+	/**
+	 * @brief Deserialises a string that was previously written with a
+	 * null terminator.
+	 * 
+	 * @param[out] adaptor fixed_string to hold the result.
+	 * 
+	 * @note If the terminator is beyond the fixed_string's capacity, the
+	 * stream will be put into the capacity_err state. If no terminator is
+	 * found at all, the string is cleared and nothing is consumed, as with
+	 * std::string.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_reader& operator>>(null_terminated<fixed_string<N>> adaptor) {
+		auto pos = buffer_.find_first_of(std::byte{0});
+
+		if(pos == buffer_.npos) {
+			adaptor->clear();
+			return *this;
+		}
+
+		if(pos > N) [[unlikely]] {
+			set_state(stream_state::capacity_err);
+
+			if(allow_throw()) {
+				HEXI_THROW(capacity_exceeded(pos, N));
+			}
+
+			return *this;
+		}
+
+		STREAM_READ_BOUNDS_ENFORCE(pos + 1, *this); // include null terminator
+
+		adaptor->resize_and_overwrite(pos, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, pos);
+			return pos;
+		});
+
+		buffer_.skip(1); // skip null terminator
+		return *this;
+	}
+
 	/**
 	 * @brief Deserialises an object that provides a deserialise function:
 	 * auto& operator>>(auto& stream);
@@ -4952,11 +12646,15 @@ public:
 	 * @param count The number of bytes to be read.
 	 */
 	void get(std::string& dest, std::size_t size) {
+		if(!charge_allocation(size, sizeof(char))) [[unlikely]] {
+			return;
+		}
+
 		STREAM_READ_BOUNDS_ENFORCE(size, void());
 
-		dest.resize_and_overwrite(size, [&](char* strbuf, std::size_t len) {
-			buffer_.read(strbuf, len);
-			return len;
+		dest.resize_and_overwrite(size, [&](char* strbuf, std::size_t) {
+			buffer_.read(strbuf, size);
+			return size;
 		});
 	}
 
@@ -5075,6 +12773,53 @@ public:
 		return read_limit_;
 	}
 
+	/**
+	 * @brief Controls whether deserialising into a non-empty container
+	 * overwrites its existing elements in place, rather than clearing it
+	 * and constructing new elements.
+	 * 
+	 * @param enable Whether existing elements should be reused.
+	 */
+	void set_reuse_storage(const bool enable) {
+		reuse_storage_ = enable;
+	}
+
+	/**
+	 * @return Whether existing container elements are reused when
+	 * deserialising.
+	 */
+	bool reuse_storage() const {
+		return reuse_storage_;
+	}
+
+	/**
+	 * @brief Sets an upper limit on the number of bytes that container and
+	 * string reads may allocate over the lifetime of the stream, guarding
+	 * against untrusted length prefixes.
+	 * 
+	 * Exceeding the limit puts the stream into an error state.
+	 * 
+	 * @param limit The allocation limit in bytes, or zero for no limit.
+	 */
+	void set_allocation_limit(const std::size_t limit) {
+		alloc_limit_ = limit;
+	}
+
+	/**
+	 * @return The allocation limit, or zero if no limit was set.
+	 */
+	std::size_t allocation_limit() const {
+		return alloc_limit_;
+	}
+
+	/**
+	 * @return The total number of bytes allocated by container and string
+	 * reads while an allocation limit was set.
+	 */
+	std::size_t allocated() const {
+		return allocated_;
+	}
+
 	/**
 	 * @brief Determine the maximum number of bytes that can be
 	 * safely read from this stream.
@@ -5087,8 +12832,8 @@ public:
 	 */
 	std::size_t read_max() const {
 		if(read_limit_) {
-			assert(total_read_ < read_limit_);
-			return read_limit_ - total_read_;
+			assert(total_read_ <= read_limit_);
+			return std::min<std::size_t>(read_limit_ - total_read_, buffer_.size());
 		} else {
 			return buffer_.size();
 		}
@@ -5135,6 +12880,8 @@ public:
 
 // #include <hexi/endian.h>
 
+// #include <hexi/fixed_string.h>
+
 // #include <hexi/shared.h>
 
 // #include <hexi/stream_adaptors.h>
@@ -5304,6 +13051,23 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a fixed_string as a null terminated string.
+	 * 
+	 * @tparam T The fixed_string type.
+	 * @param adaptor null_terminated adaptor that will instruct the stream to write
+	 * a null terminated string with no prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T>
+	requires is_fixed_string_v<std::remove_const_t<T>>
+	binary_stream_writer& operator<<(null_terminated<T> adaptor) {
+		assert(adaptor->view().find_first_of('\0') == std::string_view::npos);
+		write(adaptor->data(), adaptor->size() + 1); // always null terminated
+		return *this;
+	}
+
 	/**
 	 * @brief Serialises a string, string_view or any type providing data()
 	 * and a size() member functions.
@@ -5341,6 +13105,18 @@ public:
 		return *this << prefixed(string);
 	}
 
+	/**
+	 * @brief Serialises a fixed_string with a fixed-length prefix.
+	 * 
+	 * @param string fixed_string to be serialised with a prefix.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<std::size_t N>
+	binary_stream_writer& operator<<(const fixed_string<N>& string) {
+		return *this << prefixed(string);
+	}
+
 	/**
 	 * @brief Serialises a C-style string.
 	 * 
@@ -5400,6 +13176,21 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Serialises a string through a string table, as a reference to
+	 * an earlier occurrence where there is one.
+	 * 
+	 * @param adaptor deduplicated adaptor referencing the string and the
+	 * message's string table.
+	 * 
+	 * @return Reference to the current stream.
+	 */
+	template<typename T, typename table_type>
+	binary_stream_writer& operator<<(deduplicated_string<T, table_type> adaptor) {
+		deduplicated_encode(*this, std::string_view(adaptor.str), adaptor.table);
+		return *this;
+	}
+
 	/**
 	 * @brief Writes a contiguous range to the stream.
 	 * 
@@ -5567,7 +13358,7 @@ public:
 		  binary_stream_writer(source) {}
 
 	explicit binary_stream(hexi::pmc::buffer& source, hexi::no_throw_t, std::size_t read_limit = 0)
-		: stream_base(source),
+		: stream_base(source, false),
 		  binary_stream_reader(source, no_throw, read_limit),
 		  binary_stream_writer(source, no_throw) {}
 
@@ -0,0 +1,155 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/async_reader.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct Header {
+	std::uint16_t opcode;
+	std::uint32_t size;
+
+	void serialise(auto& stream) {
+		stream(opcode, size);
+	}
+};
+
+using buffer_type = hexi::dynamic_buffer<8>;
+using reader_type = hexi::async_reader<buffer_type>;
+
+hexi::async_task<std::vector<std::string>> read_messages(reader_type& reader, std::size_t count) {
+	std::vector<std::string> messages;
+
+	for(std::size_t i = 0; i < count; ++i) {
+		Header header{};
+		co_await reader.read(header);
+
+		std::string message;
+
+		if(!co_await reader.read(hexi::prefixed(message))) {
+			break;
+		}
+
+		messages.emplace_back(std::move(message));
+	}
+
+	co_return messages;
+}
+
+// feeds the serialised data to the reader a few bytes at a time
+void feed(buffer_type& buffer, reader_type& reader, const std::vector<char>& data, std::size_t chunk) {
+	for(std::size_t i = 0; i < data.size(); i += chunk) {
+		buffer.write(data.data() + i, std::min(chunk, data.size() - i));
+		reader.notify();
+	}
+}
+
+std::vector<char> serialise_messages(const std::vector<std::string>& messages) {
+	std::vector<char> data;
+	hexi::buffer_adaptor adaptor(data);
+	hexi::binary_stream stream(adaptor);
+
+	for(const auto& message : messages) {
+		Header header { 1, static_cast<std::uint32_t>(message.size()) };
+		stream << header << hexi::prefixed(message);
+	}
+
+	return data;
+}
+
+} // namespace
+
+TEST(async_reader, fragmented) {
+	const std::vector<std::string> input { "first", "a longer second message", "" };
+	const auto data = serialise_messages(input);
+
+	for(std::size_t chunk = 1; chunk <= data.size(); ++chunk) {
+		buffer_type buffer;
+		reader_type reader(buffer);
+		auto task = read_messages(reader, input.size());
+		ASSERT_FALSE(task.done());
+		ASSERT_TRUE(reader.waiting());
+
+		feed(buffer, reader, data, chunk);
+		ASSERT_TRUE(task.done());
+		ASSERT_FALSE(reader.waiting());
+		ASSERT_EQ(task.get(), input);
+		ASSERT_TRUE(buffer.empty());
+		ASSERT_EQ(reader.total_read(), data.size());
+	}
+}
+
+TEST(async_reader, already_buffered) {
+	const auto data = serialise_messages({ "buffered" });
+	buffer_type buffer;
+	buffer.write(data.data(), data.size());
+
+	reader_type reader(buffer);
+	auto task = read_messages(reader, 1);
+	ASSERT_TRUE(task.done());
+	ASSERT_EQ(task.get(), std::vector<std::string> { "buffered" });
+}
+
+TEST(async_reader, values) {
+	buffer_type buffer;
+	reader_type reader(buffer);
+
+	auto task = [](reader_type& reader) -> hexi::async_task<std::uint64_t> {
+		const auto first = co_await reader.read<std::uint32_t>();
+		const auto second = co_await reader.read<std::uint32_t>();
+		co_return std::uint64_t(first) + second;
+	}(reader);
+
+	const std::uint32_t values[] { 40, 2 };
+	const auto bytes = reinterpret_cast<const char*>(values);
+	buffer.write(bytes, 3);
+	ASSERT_FALSE(reader.notify());
+	buffer.write(bytes + 3, 5);
+	ASSERT_TRUE(reader.notify());
+	ASSERT_TRUE(task.done());
+	ASSERT_EQ(task.get(), 42);
+}
+
+TEST(async_reader, read_limit) {
+	const auto data = serialise_messages({ "exceeds the limit" });
+	buffer_type buffer;
+	reader_type reader(buffer, 10);
+
+	auto task = read_messages(reader, 1);
+	feed(buffer, reader, data, 4);
+	ASSERT_TRUE(task.done());
+	ASSERT_TRUE(task.get().empty());
+	ASSERT_EQ(reader.state(), hexi::stream_state::read_limit_err);
+}
+
+TEST(async_reader, frame_pool) {
+	using pool = hexi::coroutine_frame_pool<>;
+	const auto before = pool::allocator().allocator()->storage_active_count;
+
+	{
+		buffer_type buffer;
+		reader_type reader(buffer);
+
+		auto task = [](reader_type& reader) -> hexi::async_task<> {
+			co_await reader.read<std::uint8_t>();
+		}(reader);
+
+		ASSERT_EQ(pool::allocator().allocator()->storage_active_count, before + 1);
+		buffer.write("\x01", 1);
+		reader.notify();
+		ASSERT_TRUE(task.done());
+	}
+
+	ASSERT_EQ(pool::allocator().allocator()->storage_active_count, before);
+}
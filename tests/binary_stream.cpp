@@ -21,6 +21,7 @@
 #include <numeric>
 #include <random>
 #include <set>
+#include <string>
 #include <vector>
 #include <cstdint>
 #include <cstdlib>
@@ -1111,6 +1112,90 @@ TEST(binary_stream, prefixed_containers) {
 	ASSERT_EQ(objects, output_objs);
 }
 
+TEST(binary_stream, reuse_storage) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	ASSERT_FALSE(stream.reuse_storage());
+	stream.set_reuse_storage(true);
+
+	const std::vector<std::string> input { "one", "two" };
+	stream << hexi::prefixed(input) << hexi::prefixed(input);
+
+	std::vector<std::string> output(3, std::string(64, 'x'));
+	const auto data = output[0].data();
+	const auto capacity = output[0].capacity();
+	stream >> hexi::prefixed(output);
+	ASSERT_EQ(output, input);
+	ASSERT_EQ(output[0].data(), data);
+	ASSERT_EQ(output[0].capacity(), capacity);
+
+	// fewer existing elements than the count
+	output.resize(1);
+	stream >> hexi::prefixed(output);
+	ASSERT_EQ(output, input);
+	ASSERT_EQ(output[0].data(), data);
+}
+
+TEST(binary_stream, hostile_container_count) {
+	std::vector<char> buffer { '\xff', '\xff', '\xff', '\xff', 0x01, 0x02 };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	std::vector<std::uint64_t> output;
+	stream >> hexi::prefixed(output);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_limit_err);
+	ASSERT_TRUE(output.empty());
+	ASSERT_EQ(output.capacity(), 0);
+
+	// same again with exceptions enabled
+	buffer = { '\xff', '\xff', '\xff', '\x0f' };
+	hexi::binary_stream throwing(adaptor);
+	ASSERT_THROW(throwing >> hexi::prefixed_varint(output), hexi::buffer_underrun);
+	ASSERT_EQ(output.capacity(), 0);
+}
+
+TEST(binary_stream, allocation_limit) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	ASSERT_EQ(stream.allocation_limit(), 0);
+	stream.set_allocation_limit(32);
+	ASSERT_EQ(stream.allocation_limit(), 32);
+
+	const std::vector<std::uint32_t> values { 1, 2, 3, 4 };
+	const std::string str(32, 'x');
+	stream << hexi::prefixed(values) << str;
+
+	std::vector<std::uint32_t> output_values;
+	std::string output_str;
+	stream >> hexi::prefixed(output_values);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output_values, values);
+	ASSERT_EQ(stream.allocated(), 16);
+
+	// the string fits in the buffer but not in what's left of the limit
+	stream >> output_str;
+	ASSERT_EQ(stream.state(), hexi::stream_state::alloc_limit_err);
+	ASSERT_TRUE(output_str.empty());
+	ASSERT_EQ(stream.allocated(), 16);
+	ASSERT_EQ(stream.total_read(), 24) << "A rejected string shouldn't count as read";
+}
+
+TEST(binary_stream, allocation_limit_exception) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream.set_allocation_limit(8);
+
+	const std::vector<std::uint32_t> values { 1, 2, 3 };
+	stream << hexi::prefixed(values);
+
+	std::vector<std::uint32_t> output;
+	ASSERT_THROW(stream >> hexi::prefixed(output), hexi::allocation_limit_exceeded);
+	ASSERT_EQ(stream.state(), hexi::stream_state::alloc_limit_err);
+}
+
 TEST(binary_stream, std_array_size) {
 	std::array<char, 16> buffer;
 	hexi::buffer_adaptor adaptor(buffer, hexi::init_empty);
@@ -0,0 +1,115 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/bit_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+TEST(bit_stream, bit_order) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::bit_stream stream(adaptor);
+	stream.put_bit(true);
+	stream.put_bits(0b101, 3);
+	stream.put_bits(0xabc, 12);
+	stream.flush();
+
+	ASSERT_EQ(buffer.size(), 2);
+	ASSERT_EQ(buffer[0], 0b1100'1011);
+	ASSERT_EQ(buffer[1], 0xab);
+	ASSERT_EQ(stream.total_bits_written(), 16);
+
+	ASSERT_TRUE(stream.get_bit());
+	ASSERT_EQ(stream.get_bits<3>(), 0b101);
+	const auto value = stream.get_bits<12>();
+	static_assert(std::is_same_v<decltype(value), const std::uint16_t>);
+	ASSERT_EQ(value, 0xabc);
+	ASSERT_TRUE(adaptor.empty());
+}
+
+TEST(bit_stream, round_trip) {
+	std::mt19937_64 rng(42);
+	std::vector<std::pair<std::uint64_t, std::size_t>> values;
+
+	for(int i = 0; i < 1000; ++i) {
+		const std::size_t bits = rng() % 64 + 1;
+		const auto mask = bits == 64? ~0ull : (1ull << bits) - 1;
+		values.emplace_back(rng() & mask, bits);
+	}
+
+	hexi::dynamic_buffer<32> buffer;
+	hexi::bit_stream stream(buffer);
+	std::size_t total = 0;
+
+	for(const auto& [value, bits] : values) {
+		stream.put_bits(value, bits);
+		total += bits;
+	}
+
+	stream.flush();
+	ASSERT_EQ(buffer.size(), (total + 7) / 8);
+
+	for(const auto& [value, bits] : values) {
+		ASSERT_EQ(stream.get_bits(bits), value);
+	}
+
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(bit_stream, bools_and_alignment) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::bit_stream stream(adaptor);
+
+	const std::array<bool, 11> mask { true, false, false, true, true, false, true, false, false, false, true };
+	stream.put_bits(mask);
+	stream.flush();
+	stream.stream() << std::uint16_t(0x1234);
+	ASSERT_EQ(buffer.size(), 4);
+
+	std::array<bool, 11> output{};
+	stream.get_bits(output);
+	ASSERT_EQ(output, mask);
+	stream.align();
+	ASSERT_EQ(stream.total_bits_read(), 16);
+
+	// byte-oriented reads pick up where the bits ended
+	std::uint16_t value = 0;
+	stream.stream() >> value;
+	ASSERT_EQ(value, 0x1234);
+}
+
+TEST(bit_stream, underrun) {
+	std::vector<char> buffer { 0x0f };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::bit_stream stream(adaptor, hexi::no_throw);
+	ASSERT_EQ(stream.get_bits<4>(), 0xf);
+	ASSERT_EQ(stream.get_bits<8>(), 0);
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_limit_err);
+
+	hexi::buffer_adaptor throw_adaptor(buffer);
+	hexi::bit_stream throws(throw_adaptor);
+	ASSERT_THROW(throws.get_bits<16>(), hexi::buffer_underrun);
+}
+
+TEST(bit_stream, overflow) {
+	hexi::static_buffer<char, 2> buffer;
+	hexi::bit_stream stream(buffer, hexi::no_throw);
+	stream.put_bits(0x1ffff, 17);
+	stream.flush();
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_write_err);
+}
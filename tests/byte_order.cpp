@@ -0,0 +1,94 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/byte_order.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <bit>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Header {
+	std::uint16_t magic;
+	std::uint32_t length;
+	std::string name;
+
+	void serialise(auto& stream) {
+		stream(magic, length, name);
+	}
+
+	bool operator==(const Header&) const = default;
+};
+
+} // namespace
+
+TEST(byte_order, read_runtime_order) {
+	Header input { 0xFEFF, 0x01020304, "header" };
+
+	for(const auto order : { std::endian::big, std::endian::little }) {
+		std::vector<char> buffer;
+		hexi::buffer_adaptor adaptor(buffer);
+
+		hexi::with_byte_order(order, adaptor, [&](auto& stream) {
+			stream << input;
+		});
+
+		if(order == std::endian::big) {
+			ASSERT_EQ(buffer[0], '\xfe');
+			ASSERT_EQ(buffer[2], '\x01');
+		} else {
+			ASSERT_EQ(buffer[0], '\xff');
+			ASSERT_EQ(buffer[2], '\x04');
+		}
+
+		const auto output = hexi::with_byte_order(order, adaptor, [](auto& stream) {
+			Header header{};
+			stream >> header;
+			return header;
+		});
+
+		ASSERT_EQ(input, output);
+		ASSERT_TRUE(adaptor.empty());
+	}
+}
+
+TEST(byte_order, byte_order_marker) {
+	std::vector<char> buffer { '\xfe', '\xff', 0x00, 0x00, 0x00, 0x2a };
+	hexi::buffer_adaptor adaptor(buffer);
+
+	std::uint16_t marker = 0;
+	adaptor.read(&marker, sizeof(marker));
+	const auto order = std::bit_cast<std::array<char, 2>>(marker)[0] == '\xfe'?
+		std::endian::big : std::endian::little;
+
+	const auto value = hexi::with_byte_order(order, adaptor, [](auto& stream) {
+		std::uint32_t value = 0;
+		stream >> value;
+		return value;
+	});
+
+	ASSERT_EQ(value, 42);
+}
+
+TEST(byte_order, read_limit) {
+	std::vector<char> buffer { 0x01, 0x02, 0x03, 0x04 };
+	hexi::buffer_adaptor adaptor(buffer);
+
+	const auto state = hexi::with_byte_order<hexi::no_throw_t>(std::endian::little, adaptor, 2,
+		[](auto& stream) {
+			std::uint32_t value = 0;
+			stream >> value;
+			return stream.state();
+		}
+	);
+
+	ASSERT_EQ(state, hexi::stream_state::read_limit_err);
+}
@@ -0,0 +1,215 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/delta.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct position {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+
+	void serialise(auto& stream) {
+		stream(x, y, z);
+	}
+
+	bool operator==(const position&) const = default;
+};
+
+struct entity {
+	std::uint32_t id = 0;
+	std::string name;
+	position pos;
+	std::uint16_t health = 0;
+	std::vector<std::uint32_t> items;
+	std::uint8_t flags = 0;
+
+	void serialise(auto& stream) {
+		stream(id, hexi::prefixed(name), pos, health);
+		stream & hexi::prefixed(items);
+		stream & flags;
+	}
+
+	bool operator==(const entity&) const = default;
+};
+
+// breaks the requirement that the same fields are always visited
+struct optional_field {
+	bool has_extra = false;
+	std::uint32_t extra = 0;
+
+	void serialise(auto& stream) {
+		stream & has_extra;
+
+		if(has_extra) {
+			stream & extra;
+		}
+	}
+};
+
+entity make_entity() {
+	entity value;
+	value.id = 42;
+	value.name = "Kobold Vermin";
+	value.pos = { 1.0f, 2.0f, 3.0f };
+	value.health = 100;
+	value.items = { 1, 2, 3 };
+	value.flags = 0x04;
+	return value;
+}
+
+} // namespace
+
+TEST(delta, unchanged) {
+	auto baseline = make_entity();
+	auto current = baseline;
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	ASSERT_EQ(hexi::write_delta(stream, baseline, current), 0);
+	ASSERT_EQ(buffer.size(), 1); // mask only, six fields
+
+	auto result = baseline;
+	ASSERT_EQ(hexi::read_delta(stream, result), 0);
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(adaptor.empty());
+	ASSERT_EQ(result, baseline);
+}
+
+TEST(delta, changed_fields) {
+	auto baseline = make_entity();
+	auto current = baseline;
+	current.health = 75;
+	current.pos.y = 2.5f;
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	ASSERT_EQ(hexi::write_delta(stream, baseline, current), 2);
+	ASSERT_EQ(buffer.size(), 1 + (sizeof(float) * 3) + sizeof(std::uint16_t));
+	ASSERT_EQ(buffer[0], 0b0000'1100);
+
+	auto result = baseline;
+	ASSERT_EQ(hexi::read_delta(stream, result), 2);
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(adaptor.empty());
+	ASSERT_EQ(result, current);
+}
+
+TEST(delta, variable_length_fields) {
+	auto baseline = make_entity();
+	auto current = baseline;
+	current.name = "Kobold";
+	current.items.push_back(4);
+	current.flags = 0;
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	ASSERT_EQ(hexi::write_delta(stream, baseline, current), 3);
+
+	auto result = baseline;
+	ASSERT_EQ(hexi::read_delta(stream, result), 3);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, current);
+}
+
+TEST(delta, snapshot_reuse) {
+	auto state = make_entity();
+	auto peer = state;
+	hexi::delta_snapshot snapshot(state);
+	ASSERT_EQ(snapshot.fields(), 6);
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	for(std::uint16_t tick = 1; tick <= 10; ++tick) {
+		state.health = 100 - tick;
+
+		if(tick % 3 == 0) {
+			state.pos.x += 1.0f;
+		}
+
+		hexi::write_delta(stream, snapshot, state);
+		hexi::read_delta(stream, peer);
+		ASSERT_TRUE(stream);
+		ASSERT_EQ(peer, state);
+
+		// the peer acknowledged the new state
+		snapshot.update(state);
+	}
+}
+
+TEST(delta, byte_order) {
+	auto baseline = make_entity();
+	auto current = baseline;
+	current.id = 0x01020304;
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+	ASSERT_EQ(hexi::write_delta(stream, baseline, current), 1);
+	ASSERT_EQ(buffer.size(), 5);
+	ASSERT_EQ(buffer[1], 0x01);
+	ASSERT_EQ(buffer[4], 0x04);
+
+	auto result = baseline;
+	hexi::read_delta(stream, result);
+	ASSERT_EQ(result.id, 0x01020304);
+}
+
+TEST(delta, truncated) {
+	auto baseline = make_entity();
+	auto current = baseline;
+	current.health = 1;
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	hexi::write_delta(stream, baseline, current);
+	buffer.pop_back();
+
+	std::vector<std::uint8_t> truncated(buffer);
+	hexi::buffer_adaptor truncated_adaptor(truncated);
+	hexi::binary_stream read_stream(truncated_adaptor, hexi::no_throw);
+
+	auto result = baseline;
+	hexi::read_delta(read_stream, result);
+	ASSERT_EQ(read_stream.state(), hexi::stream_state::buff_limit_err);
+	ASSERT_EQ(result.health, baseline.health);
+}
+
+TEST(delta, field_count_mismatch) {
+	optional_field baseline, current { true, 7 };
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	ASSERT_EQ(hexi::write_delta(stream, baseline, current), 0);
+	ASSERT_FALSE(stream);
+	ASSERT_TRUE(buffer.empty());
+
+	// the mask is sized for one field, but applying it enables a second
+	stream.clear_error_state();
+	const std::uint8_t mask = 0x01;
+	const bool has_extra = true;
+	stream << mask << has_extra;
+
+	optional_field object;
+	hexi::read_delta(stream, object);
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::user_defined_err);
+}
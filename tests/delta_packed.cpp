@@ -0,0 +1,193 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/delta_packed.h>
+#include <hexi/exception.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+template<typename T>
+std::vector<T> sorted_values(const std::size_t count, const std::uint64_t max_step, const T start = 0) {
+	std::mt19937_64 rng(count);
+	std::vector<T> values(count);
+	T value = start;
+
+	for(auto& element : values) {
+		value = static_cast<T>(value + (rng() % (max_step + 1)));
+		element = value;
+	}
+
+	return values;
+}
+
+template<typename T>
+std::vector<T> round_trip(const std::vector<T>& values, std::size_t* size = nullptr) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << hexi::delta_packed(values);
+
+	if(size) {
+		*size = buffer.size();
+	}
+
+	std::vector<T> result { 1, 2, 3 };
+	stream >> hexi::delta_packed(result);
+	EXPECT_TRUE(stream);
+	EXPECT_TRUE(adaptor.empty());
+	return result;
+}
+
+} // namespace
+
+TEST(delta_packed, empty) {
+	std::vector<std::uint32_t> values;
+	std::size_t size = 0;
+	ASSERT_EQ(round_trip(values, &size), values);
+	ASSERT_EQ(size, sizeof(std::uint32_t));
+}
+
+TEST(delta_packed, tail_only) {
+	const std::vector<std::uint32_t> values { 1000, 1001, 1003, 1200 };
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::little);
+	stream << hexi::delta_packed(values);
+
+	const std::vector<std::uint8_t> expected {
+		0x04, 0x00, 0x00, 0x00, // count
+		0xe8, 0x03, 0x00, 0x00, // base
+		0x00, 0x01, 0x02, 0xc5, 0x01 // varint deltas
+	};
+
+	ASSERT_EQ(buffer, expected);
+}
+
+TEST(delta_packed, block_size) {
+	// steps of 0-15 give deltas over four elements of up to 60, six bits
+	const auto values = sorted_values<std::uint32_t>(256, 15, 1'000'000);
+	std::size_t size = 0;
+	ASSERT_EQ(round_trip(values, &size), values);
+	ASSERT_LE(size, 4 + 4 + ((1 + (6 * 4 * 4)) * 2));
+}
+
+TEST(delta_packed, constant) {
+	const std::vector<std::uint32_t> values(1000, 12345);
+	std::size_t size = 0;
+	ASSERT_EQ(round_trip(values, &size), values);
+	ASSERT_EQ(size, 4 + 4 + 7 + (1000 % 128));
+}
+
+TEST(delta_packed, widths) {
+	for(std::uint64_t step : { 0ull, 1ull, 2ull, 100ull, 65535ull, 1ull << 24, 0xffffffffull }) {
+		const auto values = sorted_values<std::uint32_t>(128 * 3 + 17, step);
+		ASSERT_EQ(round_trip(values), values) << step;
+	}
+}
+
+TEST(delta_packed, unsorted) {
+	std::mt19937 rng(3);
+	std::vector<std::uint32_t> values(500);
+	std::ranges::generate(values, rng);
+	ASSERT_EQ(round_trip(values), values);
+}
+
+TEST(delta_packed, element_types) {
+	const auto u64 = sorted_values<std::uint64_t>(600, 1ull << 40, 1ull << 60);
+	ASSERT_EQ(round_trip(u64), u64);
+
+	std::mt19937_64 rng(5);
+	std::vector<std::uint64_t> random(300);
+	std::ranges::generate(random, rng);
+	ASSERT_EQ(round_trip(random), random);
+
+	const auto u16 = sorted_values<std::uint16_t>(300, 100);
+	ASSERT_EQ(round_trip(u16), u16);
+
+	const auto u8 = sorted_values<std::uint8_t>(300, 3);
+	ASSERT_EQ(round_trip(u8), u8);
+
+	auto i32 = sorted_values<std::int32_t>(300, 1000, -100000);
+	ASSERT_EQ(round_trip(i32), i32);
+}
+
+TEST(delta_packed, byte_order) {
+	const auto values = sorted_values<std::uint32_t>(300, 1000);
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+	stream << hexi::delta_packed(values);
+
+	std::vector<std::uint32_t> result;
+	stream >> hexi::delta_packed(result);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, values);
+}
+
+TEST(delta_packed, invalid_width) {
+	std::vector<std::uint8_t> buffer {
+		0x80, 0x00, 0x00, 0x00, // count
+		0x00, 0x00,             // base
+		0x11                    // width of 17
+	};
+
+	buffer.resize(buffer.size() + (17 * 16));
+
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	std::vector<std::uint16_t> result;
+	stream >> hexi::delta_packed(result);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_bit_width_err);
+
+	hexi::buffer_adaptor throw_adaptor(buffer);
+	hexi::binary_stream throw_stream(throw_adaptor);
+	ASSERT_THROW(throw_stream >> hexi::delta_packed(result), hexi::invalid_bit_width);
+}
+
+TEST(delta_packed, truncated) {
+	const auto values = sorted_values<std::uint32_t>(300, 1000);
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	stream << hexi::delta_packed(values);
+	buffer.resize(buffer.size() / 2);
+
+	hexi::buffer_adaptor read_adaptor(buffer);
+	hexi::binary_stream read_stream(read_adaptor, hexi::no_throw);
+	std::vector<std::uint32_t> result;
+	read_stream >> hexi::delta_packed(result);
+	ASSERT_EQ(read_stream.state(), hexi::stream_state::buff_limit_err);
+}
+
+TEST(delta_packed, scalar_matches_sse2) {
+	for(std::uint64_t step : { 0ull, 7ull, 5000ull, 0xffffffffull }) {
+		const auto values = sorted_values<std::uint32_t>(128, step);
+		hexi::detail::bp128_seed<std::uint32_t> seed_a { 5, 5, 5, 5 }, seed_b = seed_a;
+		std::array<std::uint32_t, hexi::detail::bp128_max_words> words_a{}, words_b{};
+
+		const auto width = hexi::detail::bp128_encode(values.data(), seed_a, words_a.data());
+		ASSERT_EQ(hexi::detail::bp128_encode_scalar(values.data(), seed_b, words_b.data()), width);
+		ASSERT_EQ(words_a, words_b);
+
+		std::vector<std::uint32_t> decoded(128);
+		hexi::detail::bp128_seed<std::uint32_t> seed { 5, 5, 5, 5 };
+		hexi::detail::bp128_decode_scalar(words_a.data(), width, seed, decoded.data());
+		ASSERT_EQ(decoded, values);
+	}
+}
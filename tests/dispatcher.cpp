@@ -0,0 +1,227 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/dispatcher.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace {
+
+enum class Opcode : std::uint16_t {
+	login = 1, ping = 2, logout = 5
+};
+
+struct Login {
+	std::uint32_t id;
+	std::string username;
+
+	void serialise(auto& stream) {
+		stream(id, username);
+	}
+};
+
+struct Ping {
+	std::uint64_t timestamp;
+
+	void serialise(auto& stream) {
+		stream(timestamp);
+	}
+};
+
+struct Session {
+	std::uint32_t id = 0;
+	std::string username;
+	std::uint64_t last_ping = 0;
+	int calls = 0;
+};
+
+void on_login(Login& msg, Session& session) {
+	session.id = msg.id;
+	session.username = msg.username;
+	++session.calls;
+}
+
+void on_ping(Ping& msg, Session& session) {
+	session.last_ping = msg.timestamp;
+	++session.calls;
+}
+
+struct Names {
+	std::vector<std::string> names;
+
+	void serialise(auto& stream) {
+		stream(hexi::prefixed(names));
+	}
+};
+
+using names_dispatcher = hexi::dispatcher<
+	std::uint8_t,
+	hexi::route<1, Names, [](Names& msg, std::size_t& capacity) {
+		capacity = msg.names.empty()? 0 : msg.names[0].capacity();
+	}>
+>;
+
+using enum_dispatcher = hexi::dispatcher<
+	Opcode,
+	hexi::route<Opcode::login, Login, &on_login>,
+	hexi::route<Opcode::ping, Ping, &on_ping>
+>;
+
+using sparse_dispatcher = hexi::dispatcher<
+	std::uint32_t,
+	hexi::route<0x10u, Ping, &on_ping>,
+	hexi::route<0x4000u, Login, &on_login>,
+	hexi::route<0xDEAD0000u, Ping, [](Ping& msg, Session& session) {
+		session.last_ping = msg.timestamp * 2;
+		++session.calls;
+	}>
+>;
+
+using limited_dispatcher = hexi::dispatcher<
+	std::uint8_t,
+	hexi::route<1, Login, &on_login, 12>
+>;
+
+} // namespace
+
+static_assert(enum_dispatcher::is_dense());
+static_assert(!sparse_dispatcher::is_dense());
+static_assert(enum_dispatcher::contains(Opcode::ping));
+static_assert(!enum_dispatcher::contains(Opcode::logout));
+
+TEST(dispatcher, dense) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+	Login login { 42, "Chaos" };
+	Ping ping { 1234 };
+	stream << std::to_underlying(Opcode::login) << login;
+	stream << std::to_underlying(Opcode::ping) << ping;
+
+	enum_dispatcher dispatcher;
+	Session session;
+	auto result = dispatcher.dispatch<hexi::endian::as_big_t>(adaptor, session);
+	ASSERT_EQ(result, hexi::dispatch_result::ok);
+	ASSERT_EQ(session.id, 42);
+	ASSERT_EQ(session.username, "Chaos");
+
+	result = dispatcher.dispatch<hexi::endian::as_big_t>(adaptor, session);
+	ASSERT_EQ(result, hexi::dispatch_result::ok);
+	ASSERT_EQ(session.last_ping, 1234);
+	ASSERT_EQ(session.calls, 2);
+	ASSERT_TRUE(adaptor.empty());
+}
+
+TEST(dispatcher, sparse) {
+	hexi::static_buffer<char, 64> buffer;
+	hexi::binary_stream stream(buffer);
+	Ping ping { 50 };
+	Login login { 7, "Ember" };
+	stream << std::uint32_t(0xDEAD0000) << ping;
+	stream << std::uint32_t(0x4000) << login;
+	stream << std::uint32_t(0x10) << ping;
+
+	sparse_dispatcher dispatcher;
+	Session session;
+	ASSERT_EQ(dispatcher.dispatch(buffer, session), hexi::dispatch_result::ok);
+	ASSERT_EQ(session.last_ping, 100);
+	ASSERT_EQ(dispatcher.dispatch(buffer, session), hexi::dispatch_result::ok);
+	ASSERT_EQ(session.username, "Ember");
+	ASSERT_EQ(dispatcher.dispatch(buffer, session), hexi::dispatch_result::ok);
+	ASSERT_EQ(session.last_ping, 50);
+	ASSERT_EQ(session.calls, 3);
+}
+
+TEST(dispatcher, unknown_opcode) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::uint32_t(0x11) << std::uint64_t(0);
+
+	sparse_dispatcher dispatcher;
+	Session session;
+	ASSERT_EQ(dispatcher.dispatch(buffer, session), hexi::dispatch_result::unknown_opcode);
+	ASSERT_EQ(buffer.size(), sizeof(std::uint64_t)) << "Opcode should be consumed";
+	ASSERT_EQ(session.calls, 0);
+}
+
+TEST(dispatcher, preread_opcode) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::uint64_t(99);
+
+	enum_dispatcher dispatcher;
+	Session session;
+	ASSERT_EQ(dispatcher.dispatch(Opcode::ping, buffer, session), hexi::dispatch_result::ok);
+	ASSERT_EQ(session.last_ping, 99);
+	ASSERT_EQ(dispatcher.dispatch(Opcode::logout, buffer, session),
+	          hexi::dispatch_result::unknown_opcode);
+}
+
+TEST(dispatcher, size_limit) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	Login login { 1, "a rather long username" };
+	stream << std::uint8_t(1) << login;
+
+	limited_dispatcher dispatcher;
+	Session session;
+	ASSERT_THROW(dispatcher.dispatch(adaptor, session), hexi::stream_read_limit);
+	ASSERT_EQ(session.calls, 0);
+}
+
+TEST(dispatcher, size_limit_noexcept) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	Login login { 1, "a rather long username" };
+	stream << std::uint8_t(1) << login;
+
+	limited_dispatcher dispatcher;
+	Session session;
+	const auto result = dispatcher.dispatch<hexi::endian::as_native_t, hexi::no_throw_t>(adaptor, session);
+	ASSERT_EQ(result, hexi::dispatch_result::read_error);
+	ASSERT_EQ(session.calls, 0);
+
+	// within the limit
+	buffer.clear();
+	adaptor.clear();
+	login.username = "abc";
+	stream << std::uint8_t(1) << login;
+	ASSERT_EQ(dispatcher.dispatch(adaptor, session), hexi::dispatch_result::ok);
+	ASSERT_EQ(session.username, "abc");
+}
+
+TEST(dispatcher, reuse_storage) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	Names long_names { { std::string(64, 'x') } };
+	Names short_names { { "a" } };
+	std::size_t capacity = 0;
+
+	// elements are reconstructed by default
+	names_dispatcher dispatcher;
+	ASSERT_FALSE(dispatcher.reuse_storage());
+	stream << std::uint8_t(1) << long_names << std::uint8_t(1) << short_names;
+	ASSERT_EQ(dispatcher.dispatch(adaptor, capacity), hexi::dispatch_result::ok);
+	ASSERT_GE(capacity, 64);
+	ASSERT_EQ(dispatcher.dispatch(adaptor, capacity), hexi::dispatch_result::ok);
+	ASSERT_LT(capacity, 64);
+
+	// existing elements keep their capacity when opted in
+	dispatcher.set_reuse_storage(true);
+	stream << std::uint8_t(1) << long_names << std::uint8_t(1) << short_names;
+	ASSERT_EQ(dispatcher.dispatch(adaptor, capacity), hexi::dispatch_result::ok);
+	ASSERT_EQ(dispatcher.dispatch(adaptor, capacity), hexi::dispatch_result::ok);
+	ASSERT_GE(capacity, 64);
+}
@@ -9,11 +9,13 @@
 #include <hexi/buffer_sequence.h>
 #undef HEXI_BUFFER_DEBUG
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
+#include <cstdint>
 #include <cstring>
 
 using namespace std::literals;
@@ -205,6 +207,21 @@ TEST(dynamic_buffer, copy_chain) {
 	ASSERT_EQ(foo, output) << "Chain output is incorrect";
 }
 
+TEST(dynamic_buffer, copy_offset) {
+	hexi::dynamic_buffer<4> chain;
+	const auto str = "The quick brown fox"sv;
+	chain.write(str.data(), str.size());
+	chain.skip(2);
+
+	std::string output(9, '\0');
+	chain.copy(output.data(), output.size(), 2);
+	ASSERT_EQ(output, "quick bro");
+	ASSERT_EQ(chain.size(), str.size() - 2) << "Chain size is incorrect";
+
+	chain.copy(output.data(), 1, 16);
+	ASSERT_EQ(output[0], 'x');
+}
+
 TEST(dynamic_buffer, move_chain) {
 	hexi::dynamic_buffer<32> chain, chain2;
 	int foo = 23113;
@@ -377,4 +394,41 @@ TEST(dynamic_buffer, find_first_of) {
 	ASSERT_EQ(pos, 0);
 	pos = buffer.find_first_of(std::byte('t'));
 	ASSERT_EQ(pos, 32);
-}
\ No newline at end of file
+}
+
+TEST(dynamic_buffer, find_first_of_offset) {
+	hexi::dynamic_buffer<8> buffer;
+	const auto str = "The quick brown fox jumped over the lazy dog"sv;
+	buffer.write(str.data(), str.size());
+	auto pos = buffer.find_first_of(std::byte('T'), 1);
+	ASSERT_EQ(pos, buffer.npos);
+	pos = buffer.find_first_of(std::byte('o'), 0);
+	ASSERT_EQ(pos, 12);
+	pos = buffer.find_first_of(std::byte('o'), 13);
+	ASSERT_EQ(pos, 17);
+	pos = buffer.find_first_of(std::byte('g'), 43);
+	ASSERT_EQ(pos, 43);
+}
+
+TEST(dynamic_buffer, read_write_non_temporal) {
+	hexi::dynamic_buffer<4096> buffer;
+	std::vector<std::uint8_t> in(3 * 1024 * 1024 + 123);
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<std::uint8_t>(i * 7);
+	}
+
+	buffer.write(in.data(), 5);
+	buffer.write(in.data() + 5, in.size() - 5);
+	ASSERT_EQ(buffer.size(), in.size());
+
+	std::vector<std::uint8_t> out(in.size());
+	buffer.copy(out.data(), out.size());
+	ASSERT_EQ(in, out);
+
+	std::ranges::fill(out, 0);
+	buffer.read(out.data(), 3);
+	buffer.read(out.data() + 3, out.size() - 3);
+	ASSERT_EQ(in, out);
+	ASSERT_TRUE(buffer.empty());
+}
@@ -0,0 +1,183 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/fixed_string.h>
+#include <hexi/fixed_vector.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/serialised_size.h>
+#include <hexi/static_buffer.h>
+#include <hexi/pmc/binary_stream.h>
+#include <hexi/pmc/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Login {
+	hexi::fixed_string<32> username;
+	hexi::fixed_vector<std::uint32_t, 16> items;
+
+	void serialise(auto& stream) {
+		stream(username, hexi::prefixed_varint(items));
+	}
+};
+
+struct Named {
+	hexi::fixed_string<8> name;
+
+	constexpr void serialise(auto& stream) {
+		stream(name);
+	}
+};
+
+} // namespace
+
+static_assert(hexi::serialised_size_bounds_v<Named> == hexi::size_bounds{ 4, 12 });
+
+TEST(fixed_string, basic) {
+	hexi::fixed_string<8> str("hello");
+	ASSERT_EQ(str.size(), 5);
+	ASSERT_EQ(str.capacity(), 8);
+	ASSERT_EQ(str, "hello");
+	ASSERT_EQ(str.c_str()[5], '\0');
+
+	str.append("abc");
+	ASSERT_TRUE(str.full());
+	ASSERT_THROW(str.push_back('x'), hexi::capacity_exceeded);
+	ASSERT_THROW(str.assign("too long string"), hexi::capacity_exceeded);
+
+	str.resize(2);
+	ASSERT_EQ(str, "he");
+	ASSERT_EQ(str.c_str()[2], '\0');
+	str.clear();
+	ASSERT_TRUE(str.empty());
+}
+
+TEST(fixed_vector, basic) {
+	hexi::fixed_vector<std::string, 4> vec { "a", "b" };
+	ASSERT_EQ(vec.size(), 2);
+	vec.emplace_back("c");
+	vec.push_back("d");
+	ASSERT_TRUE(vec.full());
+	ASSERT_THROW(vec.push_back("e"), hexi::capacity_exceeded);
+
+	vec.erase(vec.begin() + 1);
+	ASSERT_EQ(vec.size(), 3);
+	ASSERT_EQ(vec[1], "c");
+	ASSERT_EQ(vec.back(), "d");
+
+	auto copy = vec;
+	ASSERT_EQ(copy, vec);
+
+	auto moved = std::move(copy);
+	ASSERT_EQ(moved, vec);
+	ASSERT_TRUE(copy.empty());
+
+	vec.resize(1);
+	ASSERT_EQ(vec.size(), 1);
+	ASSERT_EQ(vec.front(), "a");
+	vec.clear();
+	ASSERT_TRUE(vec.empty());
+}
+
+TEST(fixed_containers, round_trip) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	Login input { "Chaosvex", { 1, 2, 3 } };
+	stream << input;
+
+	Login output{};
+	stream >> output;
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output.username, "Chaosvex");
+	ASSERT_EQ(output.items, input.items);
+}
+
+TEST(fixed_containers, adaptors) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	hexi::fixed_string<16> input("adaptors");
+	stream << hexi::prefixed(input) << hexi::prefixed_varint(input) << hexi::null_terminated(input);
+	ASSERT_EQ(buffer.size(), (4 + 8) + (1 + 8) + (8 + 1));
+
+	hexi::fixed_string<16> prefixed, varint, terminated;
+	stream >> hexi::prefixed(prefixed) >> hexi::prefixed_varint(varint)
+		>> hexi::null_terminated(terminated);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(prefixed, input);
+	ASSERT_EQ(varint, input);
+	ASSERT_EQ(terminated, input);
+	ASSERT_TRUE(stream.empty());
+}
+
+TEST(fixed_containers, overlong_prefix) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << std::string("this is longer than eight characters");
+
+	hexi::fixed_string<8> output;
+	ASSERT_THROW(stream >> output, hexi::capacity_exceeded);
+	ASSERT_EQ(stream.state(), hexi::stream_state::capacity_err);
+	ASSERT_TRUE(output.empty());
+}
+
+TEST(fixed_containers, overlong_prefix_noexcept) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	// claims a huge element count
+	stream << std::uint32_t(0xFFFFFFFF);
+
+	hexi::fixed_vector<std::uint64_t, 4> output;
+	stream >> hexi::prefixed(output);
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::capacity_err);
+	ASSERT_TRUE(output.empty());
+}
+
+TEST(fixed_containers, overlong_null_terminated) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	std::string_view input("longer than four");
+	stream << hexi::null_terminated(input);
+
+	hexi::fixed_string<4> output;
+	stream >> hexi::null_terminated(output);
+	ASSERT_EQ(stream.state(), hexi::stream_state::capacity_err);
+}
+
+TEST(fixed_containers, pmc_round_trip) {
+	std::vector<char> buffer;
+	hexi::pmc::buffer_adaptor adaptor(buffer);
+	hexi::pmc::binary_stream stream(adaptor);
+
+	hexi::fixed_string<16> input("pmc");
+	hexi::fixed_vector<std::uint16_t, 4> values { 7, 8, 9 };
+	stream << input << hexi::null_terminated(input) << hexi::prefixed(values);
+
+	hexi::fixed_string<16> output, terminated;
+	hexi::fixed_vector<std::uint16_t, 4> output_values;
+	stream >> output >> hexi::null_terminated(terminated) >> hexi::prefixed(output_values);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output, input);
+	ASSERT_EQ(terminated, input);
+	ASSERT_EQ(output_values, values);
+
+	stream << std::uint32_t(5);
+	hexi::fixed_vector<std::uint16_t, 4> too_small;
+	ASSERT_THROW(stream >> hexi::prefixed(too_small), hexi::capacity_exceeded);
+}
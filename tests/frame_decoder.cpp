@@ -0,0 +1,226 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/frame_decoder.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct Header {
+	std::uint16_t opcode;
+	std::uint32_t size;
+
+	void serialise(auto& stream) {
+		stream(opcode, size);
+	}
+};
+
+struct codec {
+	using header_type = Header;
+	using endianness = hexi::endian::as_big_t;
+	static constexpr std::size_t header_size = 6;
+
+	static std::size_t body_size(const Header& header) {
+		return header.size;
+	}
+};
+
+std::vector<char> serialise_frames(const std::vector<std::string>& bodies) {
+	std::vector<char> data;
+	hexi::buffer_adaptor adaptor(data);
+	hexi::binary_stream<decltype(adaptor), hexi::allow_throw_t, hexi::endian::as_big_t> stream(adaptor);
+	std::uint16_t opcode = 0;
+
+	for(const auto& body : bodies) {
+		Header header { opcode++, static_cast<std::uint32_t>(body.size()) };
+		stream << header;
+		stream.put(body.data(), body.size());
+	}
+
+	return data;
+}
+
+} // namespace
+
+TEST(frame_decoder, fragmented) {
+	const std::vector<std::string> input { "first", "", "a longer body that spans several blocks" };
+	const auto data = serialise_frames(input);
+
+	for(std::size_t chunk = 1; chunk <= data.size(); ++chunk) {
+		hexi::dynamic_buffer<16> buffer;
+		hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer);
+		std::vector<std::string> output;
+		std::vector<std::uint16_t> opcodes;
+
+		auto handler = [&](const Header& header, auto& stream) {
+			std::string body;
+			stream.get(body, header.size);
+			ASSERT_TRUE(stream);
+			ASSERT_TRUE(stream.empty());
+			opcodes.emplace_back(header.opcode);
+			output.emplace_back(std::move(body));
+		};
+
+		for(std::size_t i = 0; i < data.size(); i += chunk) {
+			decoder.feed(data.data() + i, std::min(chunk, data.size() - i), handler);
+		}
+
+		ASSERT_TRUE(decoder);
+		ASSERT_EQ(output, input);
+		ASSERT_EQ(opcodes, (std::vector<std::uint16_t> { 0, 1, 2 }));
+		ASSERT_TRUE(buffer.empty());
+		ASSERT_EQ(decoder.stats().frames, 3);
+		ASSERT_EQ(decoder.stats().bytes, data.size());
+		ASSERT_EQ(decoder.stats().carryover_bytes, 0);
+	}
+}
+
+TEST(frame_decoder, carryover) {
+	const auto data = serialise_frames({ "0123456789" });
+	hexi::dynamic_buffer<16> buffer;
+	hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer);
+	std::string first_bytes;
+
+	auto handler = [&](const Header&, auto& stream) {
+		char value = 0;
+		stream >> value; // leaves the rest of the body unread
+		first_bytes.push_back(value);
+	};
+
+	// partial header
+	ASSERT_EQ(decoder.feed(data.data(), 4, handler), 0);
+	ASSERT_EQ(decoder.stats().carryover_bytes, 4);
+	ASSERT_EQ(decoder.body_remaining(), 0);
+
+	// complete header, partial body
+	ASSERT_EQ(decoder.feed(data.data() + 4, 5, handler), 0);
+	ASSERT_EQ(decoder.stats().carryover_bytes, 3);
+	ASSERT_EQ(decoder.body_remaining(), 7);
+	ASSERT_TRUE(buffer.empty());
+
+	// remainder of the body, plus the next header
+	const auto next = serialise_frames({ "x" });
+	ASSERT_EQ(decoder.feed(data.data() + 9, data.size() - 9, handler), 1);
+	ASSERT_EQ(decoder.feed(next.data(), next.size(), handler), 1);
+	ASSERT_EQ(first_bytes, "0x");
+	ASSERT_EQ(decoder.stats().carryovers, 2);
+	ASSERT_EQ(decoder.stats().peak_carryover_bytes, 4);
+
+	decoder.reset_stats();
+	ASSERT_EQ(decoder.stats().frames, 0);
+}
+
+TEST(frame_decoder, bounded_body) {
+	auto data = serialise_frames({ "ab" });
+	hexi::dynamic_buffer<16> buffer;
+	hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer);
+
+	decoder.feed(data.data(), data.size(), [&](const Header&, auto& stream) {
+		std::uint32_t value = 0;
+		stream >> value;
+		ASSERT_FALSE(stream);
+	});
+
+	ASSERT_TRUE(decoder);
+	ASSERT_EQ(decoder.stats().frames, 1);
+}
+
+TEST(frame_decoder, max_body_size) {
+	const auto data = serialise_frames({ "ok", "too long" });
+	hexi::dynamic_buffer<16> buffer;
+	hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer, 4);
+	std::size_t calls = 0;
+
+	decoder.feed(data.data(), data.size(), [&](const Header&, auto&) {
+		++calls;
+	});
+
+	ASSERT_EQ(calls, 1);
+	ASSERT_FALSE(decoder);
+	ASSERT_EQ(decoder.state(), hexi::stream_state::read_limit_err);
+}
+
+TEST(frame_decoder, in_place_body) {
+	auto data = serialise_frames({ "in place", "also in place" });
+	hexi::buffer_adaptor adaptor(data);
+	hexi::frame_decoder<codec, decltype(adaptor)> decoder(adaptor);
+	const auto begin = data.data(), end = data.data() + data.size();
+	std::vector<std::string> output;
+
+	decoder.process([&](const Header& header, auto& stream) {
+		const auto body = stream.buffer()->read_ptr();
+		ASSERT_TRUE(body >= begin && body < end);
+		std::string value;
+		stream.get(value, header.size);
+		output.emplace_back(std::move(value));
+	});
+
+	ASSERT_TRUE(decoder);
+	ASSERT_EQ(output, (std::vector<std::string> { "in place", "also in place" }));
+	ASSERT_TRUE(adaptor.empty());
+	ASSERT_EQ(decoder.stats().bytes, 33);
+}
+
+TEST(frame_decoder, throwing_handler) {
+	const auto data = serialise_frames({ "first", "second" });
+	std::vector<std::string> output;
+
+	auto handler = [&](const Header& header, auto& stream) {
+		std::string body;
+		stream.get(body, header.size);
+
+		if(body == "first" && output.empty()) {
+			output.emplace_back("threw");
+			throw std::runtime_error("handler failed");
+		}
+
+		output.emplace_back(std::move(body));
+	};
+
+	// whole frames in place and frames gathered from fragments
+	for(const std::size_t chunk : { data.size(), std::size_t(8) }) {
+		hexi::dynamic_buffer<16> buffer;
+		hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer);
+		output.clear();
+
+		for(std::size_t i = 0; i < data.size(); i += chunk) {
+			const auto length = std::min(chunk, data.size() - i);
+
+			try {
+				decoder.feed(data.data() + i, length, handler);
+			} catch(const std::runtime_error&) {}
+		}
+
+		decoder.process(handler);
+		ASSERT_TRUE(decoder);
+		ASSERT_EQ(output, (std::vector<std::string> { "threw", "second" }));
+		ASSERT_TRUE(buffer.empty());
+	}
+}
+
+TEST(frame_decoder, declared_size_not_reserved) {
+	std::vector<char> data;
+	hexi::buffer_adaptor adaptor(data);
+	hexi::binary_stream<decltype(adaptor), hexi::allow_throw_t, hexi::endian::as_big_t> stream(adaptor);
+	Header header { 1, 0xffffffff };
+	stream << header << std::uint32_t(0);
+
+	hexi::dynamic_buffer<16> buffer;
+	hexi::frame_decoder<codec, decltype(buffer)> decoder(buffer);
+	ASSERT_EQ(decoder.feed(data.data(), data.size(), [](const Header&, auto&) {}), 0);
+	ASSERT_TRUE(decoder);
+	ASSERT_EQ(decoder.body_remaining(), 0xffffffff - 4);
+}
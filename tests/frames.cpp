@@ -0,0 +1,124 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/frames.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+template<typename T>
+std::string_view as_string(std::span<const T> frame) {
+	return { reinterpret_cast<const char*>(frame.data()), frame.size() };
+}
+
+void write_frame(auto& stream, std::string_view payload) {
+	stream << hexi::endian::be(static_cast<std::uint16_t>(payload.size()));
+	stream.put(payload.data(), payload.size());
+}
+
+} // namespace
+
+TEST(frames, contiguous) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	write_frame(stream, "first");
+	write_frame(stream, "");
+	write_frame(stream, "third");
+	stream << hexi::endian::be(std::uint16_t(8)) << std::uint8_t(0xff); // partial
+
+	std::vector<std::string_view> payloads;
+	auto range = hexi::frames<std::uint16_t, hexi::endian::as_big_t>(adaptor);
+
+	for(auto frame : range) {
+		// zero-copy
+		ASSERT_TRUE(frame.empty() || (frame.data() >= buffer.data()
+			&& frame.data() < buffer.data() + buffer.size()));
+		payloads.emplace_back(as_string(frame));
+	}
+
+	ASSERT_TRUE(range);
+	ASSERT_EQ(payloads, (std::vector<std::string_view> { "first", "", "third" }));
+
+	// the partial frame should be left in the buffer
+	ASSERT_EQ(adaptor.size(), 3);
+
+	stream.put("\x01\x02\x03\x04\x05\x06\x07", 7);
+	payloads.clear();
+
+	for(auto frame : hexi::frames<std::uint16_t, hexi::endian::as_big_t>(adaptor)) {
+		ASSERT_EQ(frame.size(), 8);
+		ASSERT_EQ(static_cast<std::uint8_t>(frame[0]), 0xff);
+		ASSERT_EQ(frame[7], 0x07);
+	}
+
+	ASSERT_TRUE(adaptor.empty());
+}
+
+TEST(frames, dynamic_buffer) {
+	hexi::dynamic_buffer<16> buffer;
+	hexi::binary_stream stream(buffer);
+	write_frame(stream, "in block");         // 10 bytes, fits in the first block
+	write_frame(stream, "straddles blocks"); // 18 bytes, crosses into the next
+
+	auto range = hexi::frames<std::uint16_t, hexi::endian::as_big_t>(buffer);
+	auto it = range.begin();
+	ASSERT_NE(it, std::default_sentinel);
+
+	auto frame = *it;
+	ASSERT_EQ(as_string(frame), "in block");
+	ASSERT_EQ(reinterpret_cast<const std::byte*>(frame.data()),
+		reinterpret_cast<const std::byte*>(buffer.front()->read_ptr()) + 2);
+
+	++it;
+	ASSERT_NE(it, std::default_sentinel);
+	ASSERT_EQ(as_string(*it), "straddles blocks");
+	++it;
+	ASSERT_EQ(it, std::default_sentinel);
+	ASSERT_TRUE(range);
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(frames, oversize) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	write_frame(stream, "ok");
+	write_frame(stream, "far too long");
+	write_frame(stream, "ok");
+
+	std::size_t count = 0;
+	auto range = hexi::frames<std::uint16_t, hexi::endian::as_big_t>(adaptor, 8);
+
+	for(auto frame : range) {
+		ASSERT_EQ(as_string(frame), "ok");
+		++count;
+	}
+
+	ASSERT_EQ(count, 1);
+	ASSERT_FALSE(range);
+	ASSERT_EQ(range.state(), hexi::stream_state::read_limit_err);
+	ASSERT_EQ(adaptor.size(), 18); // offending frame is left unconsumed
+}
+
+TEST(frames, exceeds_capacity) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::uint8_t(32) << std::uint8_t(0);
+
+	auto range = hexi::frames<std::uint8_t>(buffer);
+	ASSERT_EQ(range.begin(), std::default_sentinel);
+	ASSERT_EQ(range.state(), hexi::stream_state::capacity_err);
+}
@@ -0,0 +1,138 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/intern_pool.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+TEST(intern_pool, intern) {
+	hexi::intern_pool pool;
+	std::string first = "hello";
+	std::string second = "hello";
+
+	const auto a = pool.intern(first);
+	const auto b = pool.intern(second);
+	ASSERT_EQ(a, "hello");
+	ASSERT_EQ(a.data(), b.data());
+	ASSERT_NE(a.data(), first.data());
+	ASSERT_EQ(pool.size(), 1);
+
+	const auto c = pool.intern("world");
+	ASSERT_NE(a.data(), c.data());
+	ASSERT_EQ(pool.size(), 2);
+
+	ASSERT_EQ(pool.find("hello")->data(), a.data());
+	ASSERT_FALSE(pool.find("missing"));
+	ASSERT_EQ(pool.size(), 2);
+}
+
+TEST(intern_pool, many_strings) {
+	hexi::intern_pool pool;
+	std::vector<std::string_view> interned;
+
+	// enough to force the shards' sets to rehash
+	for(std::size_t i = 0; i < 2000; ++i) {
+		interned.emplace_back(pool.intern(std::to_string(i)));
+	}
+
+	ASSERT_EQ(pool.size(), 2000);
+
+	for(std::size_t i = 0; i < 2000; ++i) {
+		const auto string = std::to_string(i);
+		ASSERT_EQ(pool.intern(string).data(), interned[i].data());
+		ASSERT_EQ(pool.find(string)->data(), interned[i].data());
+	}
+
+	ASSERT_EQ(pool.size(), 2000);
+}
+
+TEST(intern_pool, stream_read) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	std::string_view alpha = "alpha", beta = "beta";
+	stream << alpha << beta << alpha << hexi::null_terminated(beta);
+
+	hexi::intern_pool pool;
+	std::string_view first, second, third, fourth;
+	stream >> hexi::interned(first, pool) >> hexi::interned(second, pool)
+		>> hexi::interned(third, pool)
+		>> hexi::interned<hexi::null_terminated>(fourth, pool);
+
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(stream.empty());
+	ASSERT_EQ(first, "alpha");
+	ASSERT_EQ(second, "beta");
+	ASSERT_EQ(first.data(), third.data());
+	ASSERT_EQ(second.data(), fourth.data());
+	ASSERT_EQ(pool.size(), 2);
+
+	// views must not point into the buffer
+	const auto begin = buffer.data();
+	const auto end = buffer.data() + buffer.size();
+	ASSERT_TRUE(first.data() < begin || first.data() >= end);
+}
+
+TEST(intern_pool, stream_read_non_contiguous) {
+	hexi::dynamic_buffer<8> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::string_view("a string spanning several blocks");
+
+	hexi::intern_pool pool;
+	std::string_view value;
+	stream >> hexi::interned(value, pool);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(value, "a string spanning several blocks");
+	ASSERT_EQ(pool.size(), 1);
+}
+
+TEST(intern_pool, stream_read_error) {
+	std::vector<char> buffer { 0x10, 0x00, 0x00, 0x00, 'a' };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	hexi::intern_pool pool;
+	std::string_view value = "unchanged";
+	stream >> hexi::interned(value, pool);
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(value, "unchanged");
+	ASSERT_EQ(pool.size(), 0);
+}
+
+TEST(intern_pool, concurrent) {
+	hexi::intern_pool pool;
+	constexpr std::size_t thread_count = 4;
+	constexpr std::size_t iterations = 1000;
+	std::vector<std::vector<std::string_view>> results(thread_count);
+	std::vector<std::thread> threads;
+
+	for(std::size_t i = 0; i < thread_count; ++i) {
+		threads.emplace_back([&, i] {
+			for(std::size_t j = 0; j < iterations; ++j) {
+				results[i].emplace_back(pool.intern(std::to_string(j % 100)));
+			}
+		});
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	ASSERT_EQ(pool.size(), 100);
+
+	for(std::size_t i = 1; i < thread_count; ++i) {
+		for(std::size_t j = 0; j < iterations; ++j) {
+			ASSERT_EQ(results[0][j].data(), results[i][j].data());
+		}
+	}
+}
@@ -6,8 +6,14 @@
 
 #include <hexi/detail/intrusive_storage.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <array>
+#include <memory>
+#include <numeric>
 #include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 
 
@@ -113,3 +119,39 @@ TEST(intrusive_storage, advance_write) {
 	buffer.read(out.data(), str.size() + 1);
 	ASSERT_STREQ(str.data(), out.data());
 }
+
+TEST(intrusive_storage, non_temporal_copy) {
+	std::vector<std::uint8_t> source(1024);
+	std::iota(source.begin(), source.end(), std::uint8_t(0));
+
+	// covers unaligned heads, partial cache lines and copies shorter than the alignment
+	for(std::size_t src_offset = 0; src_offset < 16; src_offset += 3) {
+		for(std::size_t dest_offset = 0; dest_offset < 16; ++dest_offset) {
+			for(std::size_t length : { 0, 1, 15, 16, 63, 64, 65, 200, 640 }) {
+				std::vector<std::uint8_t> dest(length + 32, 0xff);
+				hexi::detail::non_temporal_copy(dest.data() + dest_offset, source.data() + src_offset, length);
+				ASSERT_TRUE(std::equal(source.begin() + src_offset, source.begin() + src_offset + length,
+				                       dest.begin() + dest_offset));
+				ASSERT_EQ(dest[dest_offset + length], 0xff);
+
+				if(dest_offset) {
+					ASSERT_EQ(dest[dest_offset - 1], 0xff);
+				}
+			}
+		}
+	}
+}
+
+TEST(intrusive_storage, read_write_non_temporal) {
+	constexpr std::size_t size = 1024 * 1024 + 100;
+	auto buffer = std::make_unique<hexi::detail::intrusive_storage<size, std::uint8_t>>();
+	std::vector<std::uint8_t> in(size);
+	std::iota(in.begin(), in.end(), std::uint8_t(0));
+
+	ASSERT_EQ(buffer->write(in.data() + 1, size - 1), size - 1);
+	ASSERT_EQ(buffer->size(), size - 1);
+
+	std::vector<std::uint8_t> out(size);
+	ASSERT_EQ(buffer->read(out.data(), size - 1), size - 1);
+	ASSERT_TRUE(std::equal(in.begin() + 1, in.end(), out.begin()));
+}
@@ -0,0 +1,262 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/message_view.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/fixed_string.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+enum class priority : std::uint8_t {
+	low, high
+};
+
+struct Route {
+	std::uint16_t region;
+	std::uint16_t shard;
+
+	void serialise(auto& stream) {
+		stream(region, shard);
+	}
+};
+
+struct Message {
+	std::uint32_t id;
+	std::string sender;
+	Route route;
+	std::vector<std::uint8_t> payload;
+	std::string tag;
+	priority level;
+	std::array<char, 4> magic;
+	hexi::fixed_string<8> label;
+	double score;
+
+	void serialise(auto& stream) {
+		stream(id, sender, route, hexi::prefixed(payload), hexi::null_terminated(tag),
+		       level, magic, label, score);
+	}
+};
+
+Message make_message() {
+	return {
+		.id = 0xdeadbeef,
+		.sender = "a sender",
+		.route = { 3, 7 },
+		.payload = { 1, 2, 3, 4, 5 },
+		.tag = "tagged",
+		.level = priority::high,
+		.magic = { 'H', 'E', 'X', 'I' },
+		.label = "label",
+		.score = 0.5
+	};
+}
+
+} // namespace
+
+TEST(message_view, fields) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream<decltype(adaptor), hexi::allow_throw_t, hexi::endian::as_big_t> stream(adaptor);
+	auto message = make_message();
+	stream << message;
+	const auto size = buffer.size();
+
+	hexi::message_view<Message, hexi::endian::as_big_t> view(adaptor);
+	ASSERT_TRUE(view);
+	ASSERT_EQ(view.size(), size);
+	ASSERT_EQ(adaptor.size(), size); // nothing consumed
+
+	ASSERT_EQ(view.get<&Message::id>(), 0xdeadbeef);
+	ASSERT_EQ(view.get<&Message::score>(), 0.5);
+	ASSERT_EQ(view.get<&Message::level>(), priority::high);
+	ASSERT_EQ(view.get<&Message::magic>()[3], 'I');
+
+	const auto sender = view.get<&Message::sender>();
+	ASSERT_EQ(sender, "a sender");
+	ASSERT_TRUE(sender.data() > buffer.data() && sender.data() < buffer.data() + size);
+
+	ASSERT_EQ(view.get<&Message::tag>(), "tagged");
+
+	const auto payload = view.get<&Message::payload>();
+	ASSERT_EQ(payload.size(), 5);
+	ASSERT_EQ(payload[4], 5);
+}
+
+TEST(message_view, truncated) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	auto message = make_message();
+	stream << message;
+	const auto size = buffer.size();
+
+	for(std::size_t i = 0; i < size; ++i) {
+		std::vector<char> truncated(buffer.begin(), buffer.begin() + i);
+		hexi::buffer_adaptor truncated_adaptor(truncated);
+		hexi::message_view<Message> view(truncated_adaptor);
+		ASSERT_FALSE(view);
+		ASSERT_EQ(truncated_adaptor.size(), i);
+	}
+}
+
+TEST(message_view, hostile_count) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	auto message = make_message();
+	stream << message;
+
+	// corrupt the payload's element count
+	const auto count_offset = sizeof(std::uint32_t) * 2 + message.sender.size() + sizeof(std::uint16_t) * 2;
+	buffer[count_offset + 3] = static_cast<char>(0xff);
+
+	hexi::message_view<Message> view(adaptor);
+	ASSERT_FALSE(view);
+	ASSERT_EQ(view.state(), hexi::stream_state::buff_limit_err);
+}
+
+namespace {
+
+struct Named {
+	std::uint32_t length;
+	std::string name;
+	std::uint32_t id;
+
+	void serialise(auto& stream) {
+		stream(length);
+		stream.forward(name, length);
+		stream(id);
+	}
+};
+
+struct Optional {
+	bool has_extra;
+	std::uint16_t extra;
+	std::uint32_t id;
+
+	void serialise(auto& stream) {
+		stream(has_extra);
+
+		if(has_extra) {
+			stream(extra);
+		}
+
+		stream(id);
+	}
+};
+
+struct Mixed {
+	std::uint32_t id;
+	std::uint16_t port;
+	std::uint32_t native;
+
+	void serialise(auto& stream) {
+		stream(hexi::endian::be(id), hexi::endian::le(port), native);
+	}
+};
+
+struct Samples {
+	std::uint8_t pad;
+	std::vector<std::uint32_t> values;
+	std::array<std::uint16_t, 2> pair;
+
+	void serialise(auto& stream) {
+		stream(pad, hexi::prefixed(values), pair);
+	}
+};
+
+} // namespace
+
+TEST(message_view, forwarded_length) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	std::uint32_t length = 5, id = 42;
+	stream << length;
+	stream.put("hello", length);
+	stream << id;
+
+	hexi::message_view<Named> view(adaptor);
+	ASSERT_TRUE(view);
+	ASSERT_EQ(view.size(), buffer.size());
+	ASSERT_EQ(view.get<&Named::name>(), "hello");
+	ASSERT_EQ(view.get<&Named::id>(), 42);
+}
+
+TEST(message_view, conditional_field) {
+	for(const bool has_extra : { false, true }) {
+		std::vector<char> buffer;
+		hexi::buffer_adaptor adaptor(buffer);
+		hexi::binary_stream stream(adaptor);
+		Optional message { has_extra, 7, 42 };
+		stream << message;
+
+		hexi::message_view<Optional> view(adaptor);
+		ASSERT_TRUE(view);
+		ASSERT_EQ(view.size(), buffer.size());
+		ASSERT_EQ(view.get<&Optional::id>(), 42);
+
+		if(has_extra) {
+			ASSERT_EQ(view.get<&Optional::extra>(), 7);
+		}
+	}
+}
+
+TEST(message_view, unaligned_arrays) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream<decltype(adaptor), hexi::allow_throw_t, hexi::endian::as_big_t> stream(adaptor);
+	Samples message { 1, { 0x01020304, 0xa0b0c0d0 }, { 0x1234, 0xabcd } };
+	stream << message;
+
+	hexi::message_view<Samples, hexi::endian::as_big_t> view(adaptor);
+	ASSERT_TRUE(view);
+
+	// values start after the one byte pad and four byte count, so are misaligned
+	Samples decoded{};
+	stream >> decoded;
+	ASSERT_EQ(view.get<&Samples::values>(), decoded.values);
+	ASSERT_EQ(view.get<&Samples::values>(), message.values);
+	ASSERT_EQ(view.get<&Samples::pair>(), decoded.pair);
+}
+
+TEST(message_view, endian_adaptors) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	Mixed message { 0x01020304, 0x0506, 0x0708090a };
+	stream << message;
+	ASSERT_EQ(buffer[0], 0x01);
+
+	hexi::message_view<Mixed> view(adaptor);
+	ASSERT_TRUE(view);
+	ASSERT_EQ(view.size(), 10);
+	ASSERT_EQ(view.get<&Mixed::id>(), 0x01020304);
+	ASSERT_EQ(view.get<&Mixed::port>(), 0x0506);
+	ASSERT_EQ(view.get<&Mixed::native>(), 0x0708090a);
+}
+
+TEST(message_view, absent_field) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	Optional message { false, 7, 42 };
+	stream << message;
+
+	hexi::message_view<Optional> view(adaptor);
+	ASSERT_TRUE(view);
+	ASSERT_TRUE(view.has<&Optional::id>());
+	ASSERT_FALSE(view.has<&Optional::extra>());
+	ASSERT_EQ(view.get<&Optional::extra>(), 0);
+	ASSERT_EQ(view.get<&Optional::id>(), 42);
+}
@@ -0,0 +1,108 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/object_pool.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Message {
+	std::uint32_t id;
+	std::vector<std::string> names;
+
+	void serialise(auto& stream) {
+		stream(id, hexi::prefixed(names));
+	}
+};
+
+} // namespace
+
+TEST(object_pool, acquire_release) {
+	hexi::object_pool<Message> pool(2);
+	ASSERT_EQ(pool.available(), 2);
+	ASSERT_EQ(pool.created(), 2);
+
+	{
+		auto first = pool.acquire();
+		auto second = pool.acquire();
+		auto third = pool.acquire();
+		ASSERT_TRUE(first && second && third);
+		ASSERT_EQ(pool.available(), 0);
+		ASSERT_EQ(pool.created(), 3);
+
+		third.reset();
+		ASSERT_FALSE(third);
+		ASSERT_EQ(pool.available(), 1);
+
+		auto moved = std::move(second);
+		ASSERT_FALSE(second);
+		ASSERT_EQ(pool.available(), 1);
+	}
+
+	ASSERT_EQ(pool.available(), 3);
+	ASSERT_EQ(pool.created(), 3);
+}
+
+TEST(object_pool, burst) {
+	hexi::object_pool<Message> pool;
+	std::vector<hexi::object_pool<Message>::handle> handles;
+
+	for(std::size_t i = 0; i < 1000; ++i) {
+		handles.emplace_back(pool.acquire());
+	}
+
+	ASSERT_EQ(pool.available(), 0);
+	ASSERT_EQ(pool.created(), 1000);
+	handles.clear();
+	ASSERT_EQ(pool.available(), 1000);
+}
+
+TEST(object_pool, reuses_objects) {
+	hexi::object_pool<Message> pool;
+	Message* address = nullptr;
+
+	{
+		auto message = pool.acquire();
+		message->names.emplace_back(64, 'x');
+		address = message.get();
+	}
+
+	auto message = pool.acquire();
+	ASSERT_EQ(message.get(), address);
+	ASSERT_EQ(message->names.size(), 1) << "State should be retained";
+}
+
+TEST(object_pool, steady_state_decode) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream.set_reuse_storage(true);
+
+	Message input { 1, { "alpha", "beta", "gamma" } };
+	hexi::object_pool<Message> pool;
+	const char* data = nullptr;
+
+	for(int i = 0; i < 3; ++i) {
+		stream << input;
+		auto message = pool.acquire();
+		stream >> *message;
+		ASSERT_EQ(message->names, input.names);
+
+		if(data) {
+			ASSERT_EQ(message->names[2].data(), data);
+		}
+
+		data = message->names[2].data();
+	}
+
+	ASSERT_EQ(pool.created(), 1);
+}
@@ -0,0 +1,116 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/overlay.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+struct dns_header {
+	hexi::be<std::uint16_t> id;
+	hexi::be<std::uint16_t> flags;
+	hexi::be<std::uint16_t> questions;
+	hexi::be<std::uint16_t> answers;
+	hexi::be<std::uint16_t> authorities;
+	hexi::be<std::uint16_t> additional;
+};
+
+struct mixed {
+	std::uint8_t version;
+	hexi::le<std::uint32_t> length;
+	hexi::be<double> value;
+	std::array<std::byte, 3> reserved;
+};
+
+struct padded {
+	std::uint8_t a;
+	std::uint32_t b;
+};
+
+static_assert(sizeof(dns_header) == 12);
+static_assert(sizeof(mixed) == 16);
+static_assert(hexi::overlayable<dns_header>);
+static_assert(hexi::overlayable<mixed>);
+static_assert(!hexi::overlayable<padded>);
+static_assert(!hexi::overlayable<std::uint32_t>); // alignment
+static_assert(hexi::be<std::uint32_t>(0x01020304).get() == 0x01020304);
+
+} // namespace
+
+TEST(overlay, endian_value) {
+	hexi::be<std::uint32_t> big = 0x01020304;
+	hexi::le<std::uint32_t> little = 0x01020304;
+	std::array<std::uint8_t, 4> bytes{};
+
+	std::memcpy(bytes.data(), &big, sizeof(big));
+	ASSERT_EQ(bytes, (std::array<std::uint8_t, 4> { 1, 2, 3, 4 }));
+
+	std::memcpy(bytes.data(), &little, sizeof(little));
+	ASSERT_EQ(bytes, (std::array<std::uint8_t, 4> { 4, 3, 2, 1 }));
+
+	little = big;
+	ASSERT_EQ(little, 0x01020304);
+}
+
+TEST(overlay, zero_copy) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << std::uint8_t(0xff); // misalign the header
+	stream << hexi::endian::be(std::uint16_t(0x1234)) << hexi::endian::be(std::uint16_t(0x0100));
+	stream << hexi::endian::be(std::uint16_t(1)) << hexi::endian::be(std::uint16_t(2));
+	stream << hexi::endian::be(std::uint16_t(0)) << hexi::endian::be(std::uint16_t(0));
+	stream << std::uint8_t(0xaa);
+
+	std::uint8_t skip = 0;
+	stream >> skip;
+
+	const auto header = hexi::overlay<dns_header>(stream);
+	ASSERT_NE(header, nullptr);
+	ASSERT_EQ(reinterpret_cast<const char*>(header), buffer.data() + 1);
+	ASSERT_EQ(header->id, 0x1234);
+	ASSERT_EQ(header->flags, 0x0100);
+	ASSERT_EQ(header->questions, 1);
+	ASSERT_EQ(header->answers, 2);
+	ASSERT_EQ(stream.total_read(), 13);
+
+	std::uint8_t trailer = 0;
+	stream >> trailer;
+	ASSERT_EQ(trailer, 0xaa);
+}
+
+TEST(overlay, underrun) {
+	std::vector<char> buffer(11);
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	ASSERT_EQ(hexi::overlay<dns_header>(stream), nullptr);
+	ASSERT_FALSE(stream);
+
+	hexi::binary_stream throws(adaptor);
+	ASSERT_THROW(hexi::overlay<dns_header>(throws), hexi::buffer_underrun);
+}
+
+TEST(overlay, copy_non_contiguous) {
+	hexi::dynamic_buffer<8> buffer;
+	hexi::binary_stream stream(buffer);
+	mixed input { 7, 0xdeadbeef, 1.5, {} };
+	stream << input;
+	ASSERT_EQ(buffer.size(), sizeof(mixed));
+
+	mixed output{};
+	stream >> output;
+	ASSERT_EQ(output.version, 7);
+	ASSERT_EQ(output.length, 0xdeadbeef);
+	ASSERT_EQ(output.value, 1.5);
+}
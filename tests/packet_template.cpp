@@ -0,0 +1,189 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/packet_template.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <hexi/static_buffer.h>
+#include <hexi/exception.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Header {
+	std::uint16_t opcode;
+	std::uint32_t sequence;
+
+	void serialise(auto& stream) {
+		stream(opcode, sequence);
+	}
+};
+
+} // namespace
+
+TEST(packet_template, stamp_patches) {
+	hexi::packet_template<64, hexi::endian::as_big_t> tmpl;
+	tmpl << std::uint16_t(0x1234);
+	const auto seq = tmpl.placeholder<std::uint32_t>();
+	tmpl << std::string("entity");
+	const auto ts = tmpl.placeholder<std::uint64_t, hexi::endian::as_little_t>(99);
+	ASSERT_TRUE(tmpl);
+
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	tmpl.stamp(adaptor, seq(1), ts(1000));
+	tmpl.stamp(adaptor, seq(2));
+	ASSERT_EQ(buffer.size(), tmpl.size() * 2);
+
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+
+	for(std::uint32_t i = 1; i <= 2; ++i) {
+		std::uint16_t opcode = 0;
+		std::uint32_t sequence = 0;
+		std::string name;
+		std::uint64_t timestamp = 0;
+		stream >> opcode >> sequence >> name >> hexi::endian::le(timestamp);
+		ASSERT_EQ(opcode, 0x1234);
+		ASSERT_EQ(sequence, i);
+		ASSERT_EQ(name, "entity");
+		ASSERT_EQ(timestamp, i == 1? 1000 : 99);
+	}
+
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(stream.empty());
+}
+
+TEST(packet_template, patch_at) {
+	hexi::packet_template<32> tmpl;
+	Header header { 7, 0 };
+	tmpl << header;
+	const auto seq = tmpl.patch_at<std::uint32_t>(sizeof(std::uint16_t));
+
+	std::array<std::byte, 32> output{};
+	tmpl.stamp(std::span(output), seq(0xDEADBEEF));
+
+	hexi::buffer_adaptor adaptor(output);
+	hexi::binary_stream stream(adaptor);
+	Header result{};
+	stream >> result;
+	ASSERT_EQ(result.opcode, 7);
+	ASSERT_EQ(result.sequence, 0xDEADBEEF);
+}
+
+TEST(packet_template, stamp_unpatched) {
+	hexi::packet_template<16> tmpl;
+	tmpl << std::uint32_t(5);
+	tmpl.placeholder<std::uint8_t>(3);
+
+	hexi::static_buffer<std::byte, 16> buffer;
+	tmpl.stamp(buffer);
+	ASSERT_EQ(buffer.size(), tmpl.size());
+	ASSERT_TRUE(std::equal(tmpl.data().begin(), tmpl.data().end(), buffer.begin()));
+}
+
+TEST(packet_template, stamp_dynamic_buffer) {
+	hexi::packet_template<16, hexi::endian::as_big_t> tmpl;
+	const auto value = tmpl.placeholder<std::uint32_t>();
+	tmpl << std::uint32_t(0xAABBCCDD);
+
+	// small blocks so that stamps have to span blocks once the tail fills up
+	hexi::dynamic_buffer<12> buffer;
+	hexi::binary_stream stream(buffer, hexi::endian::big);
+
+	for(std::uint32_t i = 0; i < 10; ++i) {
+		tmpl.stamp(buffer, value(i));
+	}
+
+	ASSERT_EQ(buffer.size(), tmpl.size() * 10);
+
+	for(std::uint32_t i = 0; i < 10; ++i) {
+		std::uint32_t patched = 0, fixed = 0;
+		stream >> patched >> fixed;
+		ASSERT_EQ(patched, i);
+		ASSERT_EQ(fixed, 0xAABBCCDD);
+	}
+
+	ASSERT_TRUE(stream);
+}
+
+TEST(packet_template, overflow) {
+	hexi::packet_template<4, hexi::endian::as_native_t, std::byte, hexi::no_throw_t> tmpl;
+	tmpl << std::uint32_t(1);
+	ASSERT_TRUE(tmpl);
+	const auto point = tmpl.placeholder<std::uint8_t>();
+	ASSERT_FALSE(point.valid());
+	ASSERT_FALSE(tmpl);
+	ASSERT_EQ(tmpl.state(), hexi::stream_state::buff_write_err);
+	tmpl.clear();
+	ASSERT_TRUE(tmpl);
+	ASSERT_EQ(tmpl.size(), 0);
+}
+
+TEST(packet_template, invalid_patches_rejected) {
+	hexi::packet_template<4, hexi::endian::as_native_t, std::byte, hexi::no_throw_t> tmpl;
+	tmpl << std::uint16_t(1);
+	const auto valid = tmpl.placeholder<std::uint16_t>();
+	const auto invalid = tmpl.placeholder<std::uint32_t>();
+	const auto outside = tmpl.patch_at<std::uint32_t>(2);
+	ASSERT_TRUE(valid.valid());
+	ASSERT_FALSE(invalid.valid());
+	ASSERT_FALSE(outside.valid());
+
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	ASSERT_FALSE(tmpl.stamp(adaptor, valid(5), invalid(6)));
+	ASSERT_FALSE(tmpl.stamp(adaptor, outside(6)));
+	ASSERT_TRUE(buffer.empty()) << "Nothing should be written for a rejected stamp";
+	ASSERT_TRUE(tmpl.stamp(adaptor, valid(5)));
+	ASSERT_EQ(buffer.size(), 4);
+
+	std::array<std::byte, 3> small{};
+	ASSERT_FALSE(tmpl.stamp(std::span(small)));
+}
+
+TEST(packet_template, invalid_patch_throws) {
+	hexi::packet_template<4> tmpl;
+	tmpl << std::uint32_t(1);
+	const auto outside = tmpl.patch_at<std::uint8_t>(4);
+	ASSERT_FALSE(outside.valid());
+
+	std::array<std::byte, 4> output{};
+	ASSERT_THROW(tmpl.stamp(std::span(output), outside(1)), hexi::buffer_overflow);
+
+	std::array<std::byte, 2> small{};
+	ASSERT_THROW(tmpl.stamp(std::span(small)), hexi::buffer_overflow);
+}
+
+TEST(packet_template, stamp_buffer_overflow) {
+	hexi::packet_template<32, hexi::endian::as_big_t, std::byte, hexi::no_throw_t> tmpl;
+	tmpl << std::uint64_t(1);
+	const auto seq = tmpl.placeholder<std::uint32_t>();
+
+	hexi::static_buffer<std::byte, 4> small;
+	ASSERT_FALSE(tmpl.stamp(small, seq(2)));
+	ASSERT_TRUE(small.empty());
+
+	std::array<std::byte, 8> storage{};
+	hexi::buffer_adaptor fixed(storage, hexi::init_empty);
+	ASSERT_FALSE(tmpl.stamp(fixed, seq(2)));
+	ASSERT_TRUE(fixed.empty());
+
+	// growable buffers are still written to
+	std::vector<std::byte> output;
+	hexi::buffer_adaptor growable(output);
+	ASSERT_TRUE(tmpl.stamp(growable, seq(2)));
+	ASSERT_EQ(output.size(), tmpl.size());
+
+	hexi::packet_template<32> throwing;
+	throwing << std::uint64_t(1);
+	ASSERT_THROW(throwing.stamp(small), hexi::buffer_overflow);
+	ASSERT_TRUE(small.empty());
+}
@@ -0,0 +1,106 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/precomputed.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct KeepAlive {
+	std::uint16_t opcode = 0x1234;
+	std::uint32_t interval = 30000;
+	std::array<std::uint8_t, 4> magic { 'H', 'E', 'X', 'I' };
+
+	constexpr void serialise(auto& stream) {
+		stream(opcode, hexi::endian::le(interval), magic);
+	}
+};
+
+struct ErrorPacket {
+	std::uint8_t code;
+	std::uint64_t session;
+	float retry;
+
+	constexpr void serialise(auto& stream) {
+		stream(code, session, retry);
+	}
+};
+
+constexpr auto constexpr_string_packet() {
+	hexi::static_buffer<char, 32> buffer;
+	hexi::binary_stream stream(buffer, hexi::endian::big);
+	std::string_view world { "world" };
+	stream << std::string_view("hello") << hexi::null_terminated(world);
+	stream << std::uint16_t(0xAABB);
+	stream.fill<2>(0xFF);
+	return buffer;
+}
+
+} // namespace
+
+TEST(precomputed, matches_runtime_serialisation) {
+	constexpr auto packet = hexi::precompute(KeepAlive{}, hexi::endian::big);
+	static_assert(packet.size() == 10);
+	static_assert(packet[0] == std::byte(0x12) && packet[1] == std::byte(0x34));
+	static_assert(packet[2] == std::byte(0x30) && packet[3] == std::byte(0x75));
+
+	std::vector<std::byte> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+	KeepAlive keep_alive;
+	stream << keep_alive;
+
+	ASSERT_EQ(buffer.size(), packet.size());
+	ASSERT_TRUE(std::ranges::equal(buffer, packet));
+}
+
+TEST(precomputed, native_order) {
+	constexpr ErrorPacket error { .code = 7, .session = 0x0102030405060708, .retry = 1.5f };
+	constexpr auto packet = hexi::precompute<char>(error);
+	static_assert(packet.size() == 13);
+
+	hexi::static_buffer<char, 13> buffer;
+	hexi::binary_stream stream(buffer);
+	auto copy = error;
+	stream << copy;
+	ASSERT_TRUE(std::ranges::equal(buffer, packet));
+
+	// read back to make sure the values are intact
+	hexi::buffer_adaptor adaptor(packet);
+	hexi::binary_stream reader(adaptor);
+	ErrorPacket output{};
+	reader >> output;
+	ASSERT_TRUE(reader);
+	ASSERT_EQ(output.code, error.code);
+	ASSERT_EQ(output.session, error.session);
+	ASSERT_EQ(output.retry, error.retry);
+}
+
+TEST(precomputed, constexpr_static_buffer) {
+	constexpr auto packet = constexpr_string_packet();
+	static_assert(packet.size() == 4 + 5 + 6 + 2 + 2);
+	static_assert(packet[0] == 5 && packet[1] == 0 && packet[2] == 0 && packet[3] == 0);
+	static_assert(packet[4] == 'h' && packet[9] == 'w' && packet[14] == '\0');
+	static_assert(packet[15] == char(0xAA) && packet[16] == char(0xBB));
+	static_assert(packet[17] == char(0xFF) && packet[18] == char(0xFF));
+
+	hexi::static_buffer<char, 32> buffer;
+	hexi::binary_stream stream(buffer, hexi::endian::big);
+	std::string_view world { "world" };
+	stream << std::string_view("hello") << hexi::null_terminated(world);
+	stream << std::uint16_t(0xAABB);
+	stream.fill<2>(0xFF);
+	ASSERT_TRUE(std::ranges::equal(buffer, packet));
+}
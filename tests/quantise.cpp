@@ -0,0 +1,312 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/exception.h>
+#include <hexi/quantise.h>
+#include <gtest/gtest.h>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+struct quat {
+	float x, y, z, w;
+};
+
+} // namespace
+
+TEST(quantise, half_values) {
+	ASSERT_EQ(hexi::to_half(0.0f), 0x0000);
+	ASSERT_EQ(hexi::to_half(-0.0f), 0x8000);
+	ASSERT_EQ(hexi::to_half(1.0f), 0x3c00);
+	ASSERT_EQ(hexi::to_half(-2.0f), 0xc000);
+	ASSERT_EQ(hexi::to_half(65504.0f), 0x7bff);
+	ASSERT_EQ(hexi::to_half(65520.0f), 0x7c00);
+	ASSERT_EQ(hexi::to_half(1e10f), 0x7c00);
+	ASSERT_EQ(hexi::to_half(-std::numeric_limits<float>::infinity()), 0xfc00);
+	ASSERT_EQ(hexi::to_half(0x1p-24f), 0x0001);  // smallest subnormal
+	ASSERT_EQ(hexi::to_half(0x1p-25f), 0x0000);  // tie, rounds to even
+	ASSERT_EQ(hexi::to_half(0x1.8p-25f), 0x0001);
+	ASSERT_EQ(hexi::to_half(0x1p-14f), 0x0400);  // smallest normal
+	ASSERT_EQ(hexi::to_half(1.0f + 0x1p-11f), 0x3c00); // tie, rounds to even
+	ASSERT_EQ(hexi::to_half(1.0f + 0x1.8p-11f), 0x3c01);
+
+	const auto nan = hexi::to_half(std::numeric_limits<float>::quiet_NaN());
+	ASSERT_EQ(nan & 0x7c00, 0x7c00);
+	ASSERT_NE(nan & 0x3ff, 0);
+	ASSERT_TRUE(std::isnan(hexi::from_half(nan)));
+}
+
+TEST(quantise, half_exhaustive_round_trip) {
+	for(std::uint32_t i = 0; i <= 0xffff; ++i) {
+		const auto value = static_cast<std::uint16_t>(i);
+
+		// skip NaNs, which don't have a unique representation
+		if((value & 0x7c00) == 0x7c00 && (value & 0x3ff)) {
+			continue;
+		}
+
+		ASSERT_EQ(hexi::to_half(hexi::from_half(value)), value);
+	}
+}
+
+TEST(quantise, half_bulk_matches_scalar) {
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> dist(-70000.0f, 70000.0f);
+	std::vector<float> values(1000);
+
+	for(auto& value : values) {
+		value = dist(rng);
+	}
+
+	std::vector<std::uint16_t> halves(values.size());
+	std::vector<float> decoded(values.size());
+	hexi::to_half(values, halves);
+	hexi::from_half(halves, decoded);
+
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		ASSERT_EQ(halves[i], hexi::to_half(values[i]));
+		ASSERT_EQ(std::bit_cast<std::uint32_t>(decoded[i]),
+		          std::bit_cast<std::uint32_t>(hexi::from_half(halves[i])));
+	}
+}
+
+TEST(quantise, half_stream) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream<decltype(adaptor), hexi::no_throw_t, hexi::endian::as_big_t> stream(adaptor);
+
+	float value = 1.0f;
+	stream << hexi::half(value) << hexi::half(-2.0f);
+	ASSERT_EQ(buffer.size(), 4);
+	ASSERT_EQ(buffer[0], 0x3c);
+	ASSERT_EQ(buffer[1], 0x00);
+	ASSERT_EQ(buffer[2], 0xc0);
+
+	float a = 0.0f, b = 0.0f;
+	stream >> hexi::half(a) >> hexi::half(b);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(a, 1.0f);
+	ASSERT_EQ(b, -2.0f);
+}
+
+TEST(quantise, half_stream_array) {
+	std::vector<float> values(150);
+
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		values[i] = static_cast<float>(i) * 1.37f - 100.0f;
+	}
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << hexi::half(values);
+	ASSERT_EQ(buffer.size(), values.size() * 2);
+
+	std::vector<float> result(values.size());
+	stream >> hexi::half(result);
+	ASSERT_TRUE(stream);
+
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		ASSERT_NEAR(result[i], values[i], std::abs(values[i]) * 0x1p-11f);
+	}
+}
+
+TEST(quantise, quantise_error_bound) {
+	constexpr float min = -512.0f, max = 512.0f;
+
+	for(unsigned int bits : { 4u, 8u, 12u, 16u, 20u }) {
+		// plus the rounding error of the float arithmetic
+		const auto bound = ((max - min) / (2.0f * static_cast<float>((1u << bits) - 1)))
+			+ (max * std::numeric_limits<float>::epsilon() * 2.0f);
+
+		for(float value = min; value <= max; value += 0.731f) {
+			const auto encoded = hexi::quantise(value, min, max, bits);
+			ASSERT_LT(encoded, 1u << bits);
+			const auto decoded = hexi::dequantise<float>(encoded, min, max, bits);
+			ASSERT_LE(std::abs(decoded - value), bound);
+		}
+	}
+}
+
+TEST(quantise, quantise_clamps) {
+	ASSERT_EQ(hexi::quantise(-10.0f, 0.0f, 1.0f, 8), 0);
+	ASSERT_EQ(hexi::quantise(10.0f, 0.0f, 1.0f, 8), 255);
+	ASSERT_EQ(hexi::quantise(std::numeric_limits<float>::quiet_NaN(), 0.0f, 1.0f, 8), 0);
+	ASSERT_EQ(hexi::dequantise<float>(255, 0.0f, 1.0f, 8), 1.0f);
+	ASSERT_EQ(hexi::dequantise<float>(0, 0.0f, 1.0f, 8), 0.0f);
+}
+
+TEST(quantise, quantise_max_boundary) {
+	for(unsigned int bits = 1; bits <= 24; ++bits) {
+		const auto max_code = (std::uint32_t(1) << bits) - 1;
+		ASSERT_EQ(hexi::quantise(1.0f, -1.0f, 1.0f, bits), max_code) << bits;
+		ASSERT_EQ(hexi::quantise(512.0f, -512.0f, 512.0f, bits), max_code) << bits;
+		ASSERT_EQ(hexi::quantise(-1.0f, -1.0f, 1.0f, bits), 0) << bits;
+	}
+
+	for(unsigned int bits = 1; bits <= 32; ++bits) {
+		const auto max_code = static_cast<std::uint32_t>((std::uint64_t(1) << bits) - 1);
+		ASSERT_EQ(hexi::quantise(1.0, -1.0, 1.0, bits), max_code) << bits;
+		ASSERT_EQ(hexi::quantise(512.0, -512.0, 512.0, bits), max_code) << bits;
+		ASSERT_EQ(hexi::quantise(-1.0, -1.0, 1.0, bits), 0) << bits;
+	}
+}
+
+TEST(quantise, invalid_bits) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	float value = 0.5f;
+	stream << hexi::quantised(value, 0.0f, 1.0f, 25);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_bit_width_err);
+	ASSERT_TRUE(buffer.empty());
+
+	stream.clear_error_state();
+	stream << hexi::quantised(value, 0.0f, 1.0f, 0);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_bit_width_err);
+
+	stream.clear_error_state();
+	quat rotation { 0.0f, 0.0f, 0.0f, 1.0f };
+	stream << hexi::smallest_three(rotation, 21);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_bit_width_err);
+	ASSERT_TRUE(buffer.empty());
+
+	buffer = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+	hexi::buffer_adaptor read_adaptor(buffer);
+	hexi::binary_stream read_stream(read_adaptor, hexi::no_throw);
+	double result = 0.0;
+	read_stream >> hexi::quantised(result, 0.0, 1.0, 33);
+	ASSERT_EQ(read_stream.state(), hexi::stream_state::invalid_bit_width_err);
+	ASSERT_EQ(read_adaptor.size(), 8);
+
+	hexi::binary_stream throwing(adaptor);
+	ASSERT_THROW(throwing << hexi::quantised(value, 0.0f, 1.0f, 32), hexi::invalid_bit_width);
+	ASSERT_THROW(throwing >> hexi::smallest_three(rotation, 1), hexi::invalid_bit_width);
+}
+
+TEST(quantise, quantised_stream_widths) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	float x = 0.5f;
+	double y = 100.0;
+	stream << hexi::quantised(x, 0.0f, 1.0f, 8);
+	ASSERT_EQ(buffer.size(), 1);
+	stream << hexi::quantised(y, 0.0, 1000.0, 12);
+	ASSERT_EQ(buffer.size(), 3);
+	stream << hexi::quantised<float>(-1.0f, -1.0f, 1.0f, 24);
+	ASSERT_EQ(buffer.size(), 7);
+
+	float rx = 0.0f, rz = 1.0f;
+	double ry = 0.0;
+	stream >> hexi::quantised(rx, 0.0f, 1.0f, 8)
+	       >> hexi::quantised(ry, 0.0, 1000.0, 12)
+	       >> hexi::quantised(rz, -1.0f, 1.0f, 24);
+
+	ASSERT_TRUE(stream);
+	ASSERT_NEAR(rx, 0.5f, 1.0f / 510.0f * 1.001f);
+	ASSERT_NEAR(ry, 100.0, 1000.0 / 8190.0);
+	ASSERT_EQ(rz, -1.0f);
+}
+
+TEST(quantise, quantised_stream_array) {
+	std::vector<float> values(200);
+
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		values[i] = std::sin(static_cast<float>(i)) * 1000.0f;
+	}
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << hexi::quantised(values, -1000.0f, 1000.0f, 16);
+	ASSERT_EQ(buffer.size(), values.size() * 2);
+
+	std::vector<float> result(values.size());
+	stream >> hexi::quantised(result, -1000.0f, 1000.0f, 16);
+	ASSERT_TRUE(stream);
+
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		ASSERT_NEAR(result[i], values[i], 2000.0f / (2.0f * 65535.0f) * 1.001f);
+	}
+}
+
+TEST(quantise, quantised_stream_underrun) {
+	std::vector<std::uint8_t> buffer { 0x01, 0x02, 0x03 };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	std::vector<float> result(2);
+	stream >> hexi::quantised(result, 0.0f, 1.0f, 16);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_limit_err);
+}
+
+TEST(quantise, smallest_three) {
+	std::mt19937 rng(11);
+	std::normal_distribution<float> dist;
+
+	for(int i = 0; i < 1000; ++i) {
+		quat value { dist(rng), dist(rng), dist(rng), dist(rng) };
+		const auto length = std::sqrt(value.x * value.x + value.y * value.y
+			+ value.z * value.z + value.w * value.w);
+		value = { value.x / length, value.y / length, value.z / length, value.w / length };
+
+		const auto encoded = hexi::encode_smallest_three(value, 10);
+		ASSERT_LT(encoded, 1ull << 32);
+
+		quat decoded{};
+		hexi::decode_smallest_three(encoded, decoded, 10);
+
+		// q and -q are the same rotation
+		const auto dot = value.x * decoded.x + value.y * decoded.y
+			+ value.z * decoded.z + value.w * decoded.w;
+		const auto sign = dot < 0? -1.0f : 1.0f;
+
+		ASSERT_NEAR(decoded.x * sign, value.x, 0.003f);
+		ASSERT_NEAR(decoded.y * sign, value.y, 0.003f);
+		ASSERT_NEAR(decoded.z * sign, value.z, 0.003f);
+		ASSERT_NEAR(decoded.w * sign, value.w, 0.003f);
+	}
+}
+
+TEST(quantise, smallest_three_stream) {
+	std::vector<quat> values {
+		{ 0.0f, 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, 0.0f, -1.0f },
+		{ 0.5f, 0.5f, 0.5f, 0.5f },
+		{ 0.0f, 0.70710678f, 0.0f, 0.70710678f }
+	};
+
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	stream << hexi::smallest_three(values);
+	ASSERT_EQ(buffer.size(), values.size() * sizeof(std::uint32_t));
+	stream << hexi::smallest_three(values[2], 16);
+	ASSERT_EQ(buffer.size(), (values.size() * sizeof(std::uint32_t)) + sizeof(std::uint64_t));
+
+	std::vector<quat> result(values.size());
+	quat precise{};
+	stream >> hexi::smallest_three(result) >> hexi::smallest_three(precise, 16);
+	ASSERT_TRUE(stream);
+
+	ASSERT_NEAR(result[0].w, 1.0f, 0.001f);
+	ASSERT_NEAR(result[1].w, 1.0f, 0.001f); // negated
+	ASSERT_NEAR(result[2].x, 0.5f, 0.001f);
+	ASSERT_NEAR(result[3].y, 0.70710678f, 0.001f);
+	ASSERT_NEAR(result[3].w, 0.70710678f, 0.001f);
+	ASSERT_NEAR(precise.z, 0.5f, 0.0001f);
+}
@@ -0,0 +1,271 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/serialised_size.h>
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Header {
+	std::uint16_t opcode;
+	std::uint32_t length;
+
+	constexpr void serialise(auto& stream) {
+		stream(opcode, hexi::endian::be(length));
+	}
+};
+
+struct Movement {
+	Header header;
+	std::array<float, 3> position;
+	std::uint64_t timestamp;
+
+	constexpr void serialise(auto& stream) {
+		stream(header, position);
+		stream & timestamp;
+	}
+};
+
+struct Login {
+	std::uint32_t id;
+	std::string username;
+	std::vector<std::uint8_t> flags;
+
+	constexpr void serialise(auto& stream) {
+		stream(id, username, hexi::prefixed_varint(flags));
+	}
+};
+
+struct Runtime {
+	std::uint32_t id;
+
+	void serialise(auto& stream) {
+		stream(id);
+	}
+};
+
+struct Overridden {
+	std::uint8_t len;
+	std::array<char, 32> data;
+};
+
+struct Conditional {
+	std::uint8_t has_extra;
+	std::uint32_t extra;
+
+	constexpr void serialise(auto& stream) {
+		stream(has_extra);
+
+		if(has_extra) {
+			stream(extra);
+		}
+	}
+};
+
+enum class Kind : std::uint8_t {
+	plain, extended = 3
+};
+
+struct FlagBits {
+	std::uint16_t flags;
+	Kind kind;
+	std::uint64_t extra;
+
+	constexpr void serialise(auto& stream) {
+		stream(flags, kind);
+
+		if((flags & 0x100) || kind == Kind::extended) {
+			stream(extra);
+		}
+	}
+};
+
+struct Counted {
+	std::uint32_t count;
+	std::array<std::uint16_t, 4> values;
+
+	constexpr void serialise(auto& stream) {
+		stream(count);
+
+		for(std::uint32_t i = 0; i < count && i < values.size(); ++i) {
+			stream(values[i]);
+		}
+	}
+};
+
+} // namespace
+
+template<>
+struct hexi::serialised_size_bounds<Overridden> {
+	static constexpr hexi::size_bounds value { 1, 33 };
+};
+
+static_assert(hexi::serialised_size_v<std::uint32_t> == 4);
+static_assert(hexi::serialised_size_v<Header> == 6);
+static_assert(hexi::serialised_size_v<Movement> == 6 + 12 + 8);
+static_assert(hexi::fixed_serialised_size<Movement>);
+static_assert(!hexi::fixed_serialised_size<Login>);
+static_assert(!hexi::bounded_serialised_size<Login>);
+static_assert(hexi::serialised_size_bounds_v<Login>.min == 4 + 4 + 1);
+static_assert(!hexi::has_size_bounds<Runtime>);
+static_assert(hexi::serialised_size_bounds_v<Overridden> == hexi::size_bounds{ 1, 33 });
+static_assert(hexi::bounded_serialised_size<Overridden>);
+
+TEST(serialised_size, static_buffer_sizing) {
+	hexi::static_buffer<char, hexi::serialised_size_v<Movement>> buffer;
+	hexi::binary_stream stream(buffer);
+
+	Movement input {
+		.header = { .opcode = 1, .length = 20 },
+		.position = { 1.0f, 2.0f, 3.0f },
+		.timestamp = 12345
+	};
+
+	stream << input;
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(buffer.full());
+	ASSERT_EQ(stream.total_write(), hexi::serialised_size_v<Movement>);
+
+	Movement output{};
+	stream >> output;
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output.header.opcode, input.header.opcode);
+	ASSERT_EQ(output.header.length, input.header.length);
+	ASSERT_EQ(output.position, input.position);
+	ASSERT_EQ(output.timestamp, input.timestamp);
+	ASSERT_EQ(stream.total_read(), hexi::serialised_size_v<Movement>);
+}
+
+TEST(serialised_size, direct_write_matches_checked_write) {
+	Movement input {
+		.header = { .opcode = 0xBEEF, .length = 0x01020304 },
+		.position = { 4.0f, 5.0f, 6.0f },
+		.timestamp = 0xCAFE
+	};
+
+	// has enough free space for the direct path
+	std::array<char, 64> direct_buf{};
+	hexi::buffer_adaptor direct_adaptor(direct_buf, hexi::init_empty);
+	hexi::binary_stream direct_stream(direct_adaptor, hexi::endian::big);
+	direct_stream << input;
+
+	// has no free space, so takes the normal path
+	std::vector<char> checked_buf;
+	hexi::buffer_adaptor checked_adaptor(checked_buf);
+	hexi::binary_stream checked_stream(checked_adaptor, hexi::endian::big);
+	checked_stream << input;
+
+	ASSERT_EQ(direct_stream.total_write(), checked_stream.total_write());
+	ASSERT_EQ(direct_adaptor.size(), checked_buf.size());
+	ASSERT_TRUE(std::equal(checked_buf.begin(), checked_buf.end(), direct_adaptor.read_ptr()));
+}
+
+TEST(serialised_size, upfront_write_check) {
+	hexi::static_buffer<char, 10> buffer;
+	hexi::binary_stream stream(buffer);
+	Movement input{};
+	ASSERT_THROW(stream << input, hexi::buffer_overflow);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_write_err);
+	ASSERT_TRUE(buffer.empty()) << "Partial write should not have taken place";
+}
+
+TEST(serialised_size, upfront_write_check_noexcept) {
+	hexi::static_buffer<char, 10> buffer;
+	hexi::binary_stream stream(buffer, hexi::no_throw);
+	Movement input{};
+	stream << input;
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_write_err);
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(serialised_size, upfront_read_check) {
+	hexi::static_buffer<char, 32> buffer;
+	hexi::binary_stream stream(buffer, hexi::no_throw);
+	Header header { 1, 2 };
+	stream << header << std::uint64_t(3);
+	ASSERT_LT(buffer.size(), hexi::serialised_size_v<Movement>);
+
+	Movement output{};
+	stream >> output;
+	ASSERT_EQ(stream.state(), hexi::stream_state::buff_limit_err);
+	ASSERT_EQ(stream.total_read(), 0);
+	ASSERT_EQ(buffer.size(), 14) << "No data should have been consumed";
+}
+
+TEST(serialised_size, upfront_read_limit_check) {
+	hexi::static_buffer<char, 64> buffer;
+	hexi::binary_stream writer(buffer);
+	Movement input{};
+	writer << input;
+
+	hexi::binary_stream stream(buffer, 8, hexi::no_throw);
+	Movement output{};
+	stream >> output;
+	ASSERT_EQ(stream.state(), hexi::stream_state::read_limit_err);
+	ASSERT_EQ(stream.total_read(), 0);
+}
+
+TEST(serialised_size, conditional_fields_unbounded) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer);
+
+	// the conditional field makes the size depend on the values read,
+	// so no bounds are provided and nothing is checked up front
+	static_assert(!hexi::has_size_bounds<Conditional>);
+
+	Conditional input { .has_extra = 1, .extra = 42 };
+	stream << input;
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(stream.total_write(), 5);
+	ASSERT_EQ(buffer.size(), 5);
+
+	Conditional output{};
+	stream >> output;
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output.extra, 42);
+}
+
+TEST(serialised_size, runtime_serialise_unaffected) {
+	hexi::static_buffer<char, 4> buffer;
+	hexi::binary_stream stream(buffer);
+	Runtime input { 7 };
+	stream << input;
+	Runtime output{};
+	stream >> output;
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output.id, 7);
+}
+
+TEST(serialised_size, value_dependent_layouts) {
+	static_assert(!hexi::has_size_bounds<FlagBits>);
+	static_assert(!hexi::has_size_bounds<Counted>);
+	static_assert(hexi::serialised_size_v<Movement> == 26);
+}
+
+TEST(serialised_size, conditional_element_count_check) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	// five bytes per element when written, so a minimum size derived from
+	// the default object would reject the count as too large
+	std::vector<Conditional> input(3, Conditional { .has_extra = 1, .extra = 7 });
+	stream << hexi::prefixed(input);
+
+	std::vector<Conditional> output;
+	stream >> hexi::prefixed(output);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(output.size(), 3);
+	ASSERT_EQ(output[2].extra, 7);
+}
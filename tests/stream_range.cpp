@@ -0,0 +1,136 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/stream_range.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Item {
+	std::uint32_t id;
+	std::string name;
+
+	void serialise(auto& stream) {
+		stream(id, name);
+	}
+};
+
+} // namespace
+
+static_assert(std::ranges::input_range<hexi::stream_range<
+	hexi::binary_stream<hexi::buffer_adaptor<std::vector<char>>>, int>
+>);
+
+TEST(stream_range, fold) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	for(std::uint32_t i = 1; i <= 100; ++i) {
+		stream << i;
+	}
+
+	stream << std::uint8_t(0xff);
+
+	std::uint32_t sum = 0;
+
+	for(auto value : stream.read_range<std::uint32_t>(100)) {
+		sum += value;
+	}
+
+	ASSERT_EQ(sum, 5050);
+	ASSERT_EQ(stream.total_read(), 400);
+	ASSERT_EQ(stream.get<std::uint8_t>(), 0xff);
+}
+
+TEST(stream_range, views) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	for(std::uint16_t i = 0; i < 10; ++i) {
+		stream << i;
+	}
+
+	auto evens = stream.read_range<std::uint16_t>(10)
+		| std::views::filter([](auto value) { return value % 2 == 0; });
+
+	std::vector<std::uint16_t> output;
+	std::ranges::copy(evens, std::back_inserter(output));
+	ASSERT_EQ(output, (std::vector<std::uint16_t>{ 0, 2, 4, 6, 8 }));
+	ASSERT_TRUE(stream.empty());
+}
+
+TEST(stream_range, serialisable_elements) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	std::vector<Item> input { { 1, "one" }, { 2, "two" }, { 3, "three" } };
+
+	for(auto& item : input) {
+		stream << item;
+	}
+
+	std::vector<std::string> names;
+
+	for(auto& item : stream.read_range<Item>(input.size())) {
+		names.emplace_back(std::move(item.name));
+	}
+
+	ASSERT_EQ(names, (std::vector<std::string>{ "one", "two", "three" }));
+}
+
+TEST(stream_range, stops_on_error) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	stream << std::uint32_t(1) << std::uint32_t(2);
+
+	std::vector<std::uint32_t> output;
+	std::ranges::copy(stream.read_range<std::uint32_t>(5), std::back_inserter(output));
+	ASSERT_EQ(output, (std::vector<std::uint32_t>{ 1, 2 }));
+	ASSERT_FALSE(stream);
+}
+
+TEST(stream_range, empty) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	auto range = stream.read_range<std::uint32_t>(0);
+	ASSERT_EQ(range.begin(), range.end());
+	ASSERT_TRUE(stream);
+}
+
+TEST(stream_range, write_views) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	auto squares = std::views::iota(std::uint32_t(0), std::uint32_t(5))
+		| std::views::transform([](auto value) { return value * value; });
+
+	stream << squares;
+	stream << hexi::prefixed(squares);
+	stream << hexi::prefixed_varint(squares);
+	ASSERT_EQ(buffer.size(), 20 + (4 + 20) + (1 + 20));
+
+	const std::vector<std::uint32_t> expected { 0, 1, 4, 9, 16 };
+	std::vector<std::uint32_t> raw, prefixed, varint;
+	std::ranges::copy(stream.read_range<std::uint32_t>(5), std::back_inserter(raw));
+	stream >> hexi::prefixed(prefixed) >> hexi::prefixed_varint(varint);
+	ASSERT_EQ(raw, expected);
+	ASSERT_EQ(prefixed, expected);
+	ASSERT_EQ(varint, expected);
+	ASSERT_TRUE(stream.empty());
+}
@@ -0,0 +1,180 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+enum class tag : std::uint8_t {
+	name, value, container
+};
+
+void write_tlv(auto& stream, tag type, const std::vector<char>& value) {
+	stream << type << static_cast<std::uint16_t>(value.size());
+	stream.put(value.data(), value.size());
+}
+
+// counts the leaf elements in a nested TLV structure
+std::size_t count_leaves(auto& stream) {
+	std::size_t leaves = 0;
+
+	while(stream.read_max()) {
+		tag type{};
+		std::uint16_t length = 0;
+		stream >> type >> length;
+
+		if(!stream) {
+			break;
+		}
+
+		auto slice = stream.slice(length);
+
+		if(type == tag::container) {
+			leaves += count_leaves(*slice);
+		} else {
+			++leaves;
+		}
+	}
+
+	return leaves;
+}
+
+} // namespace
+
+TEST(stream_slice, skip_unread) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	write_tlv(stream, tag::value, { 1, 2, 3, 4, 5, 6 });
+	write_tlv(stream, tag::name, { 'h', 'e', 'x', 'i' });
+
+	tag type{};
+	std::uint16_t length = 0;
+	stream >> type >> length;
+	ASSERT_EQ(type, tag::value);
+
+	{
+		auto slice = stream.slice(length);
+		std::uint8_t value = 0;
+		slice >> value;
+		ASSERT_EQ(value, 1);
+		ASSERT_EQ(slice.remaining(), 5);
+	}
+
+	ASSERT_EQ(stream.total_read(), 9);
+	stream >> type >> length;
+	ASSERT_EQ(type, tag::name);
+
+	auto slice = stream.slice(length);
+	const auto name = slice->span<char>(length);
+	ASSERT_EQ(std::string_view(name.data(), name.size()), "hexi");
+	ASSERT_EQ(name.data(), buffer.data() + 12); // zero-copy
+}
+
+TEST(stream_slice, bounded) {
+	std::vector<char> buffer { 1, 2, 3, 4, 5, 6, 7, 8 };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	{
+		auto slice = stream.slice(2);
+		ASSERT_EQ(slice->read_max(), 2);
+
+		std::uint32_t value = 0;
+		slice >> value;
+		ASSERT_FALSE(slice);
+		ASSERT_EQ(slice->state(), hexi::stream_state::buff_limit_err);
+	}
+
+	// child errors don't affect the parent
+	ASSERT_TRUE(stream);
+	std::uint8_t value = 0;
+	stream >> value;
+	ASSERT_EQ(value, 3);
+
+	auto outer = stream.slice(4);
+
+	{
+		auto empty = outer->slice(0);
+		ASSERT_TRUE(empty);
+		ASSERT_TRUE(empty->empty());
+	}
+
+	// nested slices are bounded by their parent
+	auto inner = outer->slice(8);
+	ASSERT_FALSE(inner);
+	ASSERT_FALSE(*outer);
+	ASSERT_EQ(inner.remaining(), 0);
+}
+
+TEST(stream_slice, out_of_bounds) {
+	std::vector<char> buffer { 1, 2 };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	ASSERT_THROW(stream.slice(3), hexi::buffer_underrun);
+
+	hexi::binary_stream no_throw(adaptor, hexi::no_throw);
+	auto slice = no_throw.slice(3);
+	ASSERT_FALSE(no_throw);
+	ASSERT_EQ(slice->state(), hexi::stream_state::buff_limit_err);
+	ASSERT_EQ(adaptor.size(), 2);
+}
+
+TEST(stream_slice, nested_tlv) {
+	std::vector<char> inner_buffer;
+	hexi::buffer_adaptor inner_adaptor(inner_buffer);
+	hexi::binary_stream inner(inner_adaptor);
+	write_tlv(inner, tag::name, { 'a', 'b' });
+	write_tlv(inner, tag::value, { 1, 2, 3, 4 });
+
+	std::vector<char> outer_buffer;
+	hexi::buffer_adaptor outer_adaptor(outer_buffer);
+	hexi::binary_stream outer(outer_adaptor);
+	write_tlv(outer, tag::container, inner_buffer);
+	write_tlv(outer, tag::value, { 1 });
+
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	write_tlv(stream, tag::container, outer_buffer);
+	write_tlv(stream, tag::name, { 'x' });
+	const auto total = buffer.size();
+
+	ASSERT_EQ(count_leaves(stream), 4);
+	ASSERT_EQ(stream.total_read(), total);
+	ASSERT_TRUE(stream);
+}
+
+TEST(stream_slice, non_contiguous) {
+	hexi::dynamic_buffer<4> buffer;
+	hexi::binary_stream stream(buffer);
+	write_tlv(stream, tag::name, { 'n', 'o', 'n', ' ', 'c', 'o', 'n', 't' });
+	stream << std::uint32_t(42);
+
+	tag type{};
+	std::uint16_t length = 0;
+	stream >> type >> length;
+
+	{
+		auto slice = stream.slice(length);
+		std::string value;
+		slice->get(value, 3);
+		ASSERT_EQ(value, "non");
+	}
+
+	std::uint32_t value = 0;
+	stream >> value;
+	ASSERT_EQ(value, 42);
+	ASSERT_TRUE(stream.empty());
+}
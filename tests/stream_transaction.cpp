@@ -0,0 +1,197 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Message {
+	std::uint32_t id;
+	std::string name;
+	std::vector<std::uint16_t> values;
+
+	void serialise(auto& stream) {
+		stream(id, name, hexi::prefixed(values));
+	}
+
+	bool operator==(const Message&) const = default;
+};
+
+} // namespace
+
+TEST(stream_transaction, partial_message) {
+	Message input { 42, "a name long enough to span several blocks", { 1, 2, 3, 4 } };
+
+	std::vector<char> serialised;
+	hexi::buffer_adaptor adaptor(serialised);
+	hexi::binary_stream writer(adaptor);
+	writer << input;
+
+	hexi::dynamic_buffer<16> buffer;
+	hexi::binary_stream stream(buffer, hexi::no_throw);
+	const auto split = serialised.size() - 5;
+	buffer.write(serialised.data(), split);
+
+	{
+		auto tx = stream.begin_transaction();
+		Message output{};
+		tx >> output;
+		ASSERT_FALSE(tx);
+		ASSERT_EQ(tx->state(), hexi::stream_state::buff_limit_err);
+	}
+
+	// nothing should have been consumed
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(buffer.size(), split);
+	ASSERT_EQ(stream.total_read(), 0);
+
+	buffer.write(serialised.data() + split, serialised.size() - split);
+
+	{
+		auto tx = stream.begin_transaction();
+		Message output{};
+		tx >> output;
+		ASSERT_TRUE(tx);
+		ASSERT_EQ(output, input);
+		ASSERT_EQ(buffer.size(), serialised.size());
+		tx.commit();
+	}
+
+	ASSERT_TRUE(buffer.empty());
+	ASSERT_EQ(stream.total_read(), serialised.size());
+}
+
+TEST(stream_transaction, commit_rollback) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer, hexi::init_empty);
+	hexi::binary_stream stream(adaptor);
+	const std::string terminated("terminated");
+	stream << std::uint8_t(1) << std::uint8_t(2) << hexi::null_terminated(terminated);
+
+	auto tx = stream.begin_transaction();
+	std::uint8_t value = 0;
+	tx >> value;
+	ASSERT_EQ(value, 1);
+	tx.commit();
+	ASSERT_EQ(adaptor.size(), 12);
+	ASSERT_EQ(tx.pending(), 0);
+
+	tx >> value;
+	ASSERT_EQ(value, 2);
+	ASSERT_EQ(tx.pending(), 1);
+	tx.rollback();
+	ASSERT_EQ(tx.pending(), 0);
+	ASSERT_EQ(tx->total_read(), 1);
+
+	tx >> value;
+	ASSERT_EQ(value, 2);
+
+	// zero-copy views still work through a transaction
+	const auto view = tx->view();
+	ASSERT_EQ(view, "terminated");
+	ASSERT_EQ(view.data(), buffer.data() + 2);
+	ASSERT_TRUE(tx->empty());
+	ASSERT_EQ(adaptor.size(), 12);
+	tx.commit();
+	ASSERT_TRUE(adaptor.empty());
+	ASSERT_EQ(stream.total_read(), 13);
+}
+
+TEST(stream_transaction, read_limit) {
+	std::vector<char> buffer { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, 6, hexi::no_throw);
+
+	std::uint8_t value = 0;
+	stream >> value;
+
+	auto tx = stream.begin_transaction();
+	std::uint32_t first = 0, second = 0;
+	tx >> first >> second;
+	ASSERT_NE(first, 0);
+	ASSERT_EQ(tx->state(), hexi::stream_state::read_limit_err);
+	ASSERT_EQ(adaptor.size(), 11);
+}
+
+TEST(stream_transaction, dynamic_buffer_strings) {
+	hexi::dynamic_buffer<4> buffer;
+	hexi::binary_stream stream(buffer);
+	const std::string input_first("first"), input_second("second");
+	stream << hexi::null_terminated(input_first) << hexi::null_terminated(input_second);
+
+	auto tx = stream.begin_transaction();
+	std::string first, second;
+	tx >> hexi::null_terminated(first) >> hexi::null_terminated(second);
+	ASSERT_EQ(first, "first");
+	ASSERT_EQ(second, "second");
+	ASSERT_EQ(buffer.size(), 13);
+	tx.commit();
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(stream_transaction, dynamic_buffer_append_while_open) {
+	hexi::dynamic_buffer<4> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::uint16_t(1) << std::uint32_t(2);
+
+	auto tx = stream.begin_transaction();
+	std::uint16_t first = 0;
+	std::uint32_t second = 0, third = 0;
+	tx >> first >> second;
+	ASSERT_TRUE(tx);
+
+	// lands partly in the tail block that the cursor stopped in
+	const std::string appended("tail string");
+	stream << std::uint32_t(3) << hexi::null_terminated(appended);
+	tx >> third;
+	tx->skip(5);
+	std::string str;
+	tx >> hexi::null_terminated(str);
+
+	ASSERT_TRUE(tx);
+	ASSERT_EQ(first, 1);
+	ASSERT_EQ(second, 2);
+	ASSERT_EQ(third, 3);
+	ASSERT_EQ(str, "string");
+	tx.commit();
+	ASSERT_TRUE(buffer.empty());
+}
+
+TEST(stream_transaction, dynamic_buffer_many_blocks) {
+	static_assert(hexi::positionable<hexi::dynamic_buffer<16>>);
+	hexi::dynamic_buffer<16> buffer;
+	hexi::binary_stream stream(buffer);
+
+	for(std::uint32_t i = 0; i < 1000; ++i) {
+		const auto str = std::to_string(i);
+		stream << i << hexi::null_terminated(str);
+	}
+
+	auto tx = stream.begin_transaction();
+
+	for(std::uint32_t i = 0; i < 1000; ++i) {
+		std::uint32_t value = 0;
+		std::string str;
+		tx >> value >> hexi::null_terminated(str);
+		ASSERT_EQ(value, i);
+		ASSERT_EQ(str, std::to_string(i));
+	}
+
+	ASSERT_TRUE(tx);
+	ASSERT_TRUE(tx->empty());
+	tx.rollback();
+
+	std::uint32_t value = 1;
+	tx >> value;
+	ASSERT_EQ(value, 0) << "Rollback should return the cursor to the start";
+}
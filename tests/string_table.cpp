@@ -0,0 +1,184 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/dynamic_buffer.h>
+#include <hexi/exception.h>
+#include <hexi/string_table.h>
+#include <hexi/pmc/binary_stream.h>
+#include <hexi/pmc/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct item {
+	std::string name;
+	std::string owner;
+	std::uint32_t count = 0;
+
+	bool operator==(const item&) const = default;
+};
+
+const std::vector<item> items {
+	{ "Linen Cloth", "Kobold", 20 },
+	{ "Copper Ore", "Kobold", 5 },
+	{ "Linen Cloth", "Murloc", 3 },
+	{ "Linen Cloth", "Kobold", 1 },
+};
+
+void write_items(auto& stream, hexi::string_table& table) {
+	for(auto& item : items) {
+		stream << hexi::deduplicated(item.name, table)
+		       << hexi::deduplicated(item.owner, table)
+		       << item.count;
+	}
+}
+
+template<typename string_type>
+void read_items(auto& stream, hexi::string_table& table, std::vector<item>& result) {
+	for(std::size_t i = 0; i < items.size(); ++i) {
+		string_type name, owner;
+		std::uint32_t count = 0;
+		stream >> hexi::deduplicated(name, table)
+		       >> hexi::deduplicated(owner, table)
+		       >> count;
+		result.emplace_back(std::string(name), std::string(owner), count);
+	}
+}
+
+} // namespace
+
+TEST(string_table, format) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	hexi::string_table table;
+
+	const std::string first = "abc", second = "de";
+	stream << hexi::deduplicated(first, table)
+	       << hexi::deduplicated(second, table)
+	       << hexi::deduplicated(first, table)
+	       << hexi::deduplicated(second, table);
+
+	const std::vector<std::uint8_t> expected {
+		0x06, 'a', 'b', 'c',
+		0x04, 'd', 'e',
+		0x01, // reference to entry 0
+		0x03  // reference to entry 1
+	};
+
+	ASSERT_EQ(buffer, expected);
+	ASSERT_EQ(table.size(), 2);
+}
+
+TEST(string_table, zero_copy_round_trip) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	hexi::string_table write_table;
+	write_items(stream, write_table);
+	ASSERT_EQ(write_table.size(), 4);
+
+	hexi::string_table read_table;
+	std::vector<item> result;
+	std::vector<std::string_view> names;
+
+	for(std::size_t i = 0; i < items.size(); ++i) {
+		std::string_view name, owner;
+		std::uint32_t count = 0;
+		stream >> hexi::deduplicated(name, read_table)
+		       >> hexi::deduplicated(owner, read_table)
+		       >> count;
+		names.emplace_back(name);
+		result.emplace_back(std::string(name), std::string(owner), count);
+	}
+
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, items);
+
+	// repeated strings refer to the first occurrence within the buffer
+	const auto begin = reinterpret_cast<const char*>(buffer.data());
+	ASSERT_GE(names[0].data(), begin);
+	ASSERT_LT(names[0].data(), begin + buffer.size());
+	ASSERT_EQ(names[2].data(), names[0].data());
+	ASSERT_EQ(names[3].data(), names[0].data());
+}
+
+TEST(string_table, non_contiguous) {
+	hexi::dynamic_buffer<8> buffer;
+	hexi::binary_stream stream(buffer);
+
+	hexi::string_table write_table;
+	write_items(stream, write_table);
+
+	hexi::string_table read_table;
+	std::vector<item> result;
+	read_items<std::string_view>(stream, read_table, result);
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(buffer.empty());
+	ASSERT_EQ(result, items);
+}
+
+TEST(string_table, pmc_round_trip) {
+	std::vector<std::uint8_t> buffer;
+	hexi::pmc::buffer_adaptor adaptor(buffer);
+	hexi::pmc::binary_stream stream(adaptor);
+
+	hexi::string_table write_table;
+	write_items(stream, write_table);
+
+	std::vector<std::uint8_t> expected;
+	hexi::buffer_adaptor expected_adaptor(expected);
+	hexi::binary_stream expected_stream(expected_adaptor);
+	hexi::string_table expected_table;
+	write_items(expected_stream, expected_table);
+	ASSERT_EQ(buffer, expected);
+
+	hexi::string_table read_table;
+	std::vector<item> result;
+	read_items<std::string>(stream, read_table, result);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, items);
+}
+
+TEST(string_table, invalid_reference) {
+	std::vector<std::uint8_t> buffer { 0x04, 'a', 'b', 0x03 };
+
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+	hexi::string_table table;
+	std::string_view first, second;
+	stream >> hexi::deduplicated(first, table) >> hexi::deduplicated(second, table);
+	ASSERT_EQ(first, "ab");
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_tag_err);
+
+	hexi::pmc::buffer_adaptor pmc_adaptor(buffer);
+	hexi::pmc::binary_stream pmc_stream(pmc_adaptor);
+	hexi::string_table pmc_table;
+	pmc_stream >> hexi::deduplicated(first, pmc_table);
+	ASSERT_THROW(pmc_stream >> hexi::deduplicated(second, pmc_table), hexi::invalid_string_reference);
+	ASSERT_EQ(pmc_stream.state(), hexi::stream_state::invalid_tag_err);
+}
+
+TEST(string_table, clear) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+	hexi::string_table table;
+
+	const std::string value = "repeated";
+	stream << hexi::deduplicated(value, table);
+	table.clear();
+	stream << hexi::deduplicated(value, table);
+	ASSERT_EQ(buffer.size(), (value.size() + 1) * 2);
+}
@@ -0,0 +1,200 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/exception.h>
+#include <hexi/utf8.h>
+#include <hexi/pmc/binary_stream.h>
+#include <hexi/pmc/buffer_adaptor.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std::literals;
+
+namespace {
+
+// reference implementation, decoding code points the long way
+bool reference_valid(const std::string_view string) {
+	std::size_t i = 0;
+
+	while(i < string.size()) {
+		const auto lead = static_cast<std::uint8_t>(string[i]);
+		std::size_t length = 0;
+		std::uint32_t code_point = 0;
+
+		if(lead < 0x80) {
+			length = 1;
+			code_point = lead;
+		} else if((lead & 0xe0) == 0xc0) {
+			length = 2;
+			code_point = lead & 0x1f;
+		} else if((lead & 0xf0) == 0xe0) {
+			length = 3;
+			code_point = lead & 0x0f;
+		} else if((lead & 0xf8) == 0xf0) {
+			length = 4;
+			code_point = lead & 0x07;
+		} else {
+			return false;
+		}
+
+		if(i + length > string.size()) {
+			return false;
+		}
+
+		for(std::size_t k = 1; k < length; ++k) {
+			const auto byte = static_cast<std::uint8_t>(string[i + k]);
+
+			if((byte & 0xc0) != 0x80) {
+				return false;
+			}
+
+			code_point = (code_point << 6) | (byte & 0x3f);
+		}
+
+		constexpr std::uint32_t min_values[] { 0, 0, 0x80, 0x800, 0x10000 };
+
+		if(code_point < min_values[length] || code_point > 0x10ffff
+			|| (code_point >= 0xd800 && code_point <= 0xdfff)) {
+			return false;
+		}
+
+		i += length;
+	}
+
+	return true;
+}
+
+} // namespace
+
+TEST(utf8, valid) {
+	ASSERT_TRUE(hexi::is_valid_utf8(""));
+	ASSERT_TRUE(hexi::is_valid_utf8("plain ascii"));
+	ASSERT_TRUE(hexi::is_valid_utf8("\xc2\xa3"));                 // U+00A3
+	ASSERT_TRUE(hexi::is_valid_utf8("\xe2\x82\xac"));             // U+20AC
+	ASSERT_TRUE(hexi::is_valid_utf8("\xed\x9f\xbf"));             // U+D7FF
+	ASSERT_TRUE(hexi::is_valid_utf8("\xf0\x9f\x90\x89"));         // U+1F409
+	ASSERT_TRUE(hexi::is_valid_utf8("\xf4\x8f\xbf\xbf"));         // U+10FFFF
+	ASSERT_TRUE(hexi::is_valid_utf8("Ünïcödé ßtrîñg with some extra ascii padding 日本語"));
+}
+
+TEST(utf8, invalid) {
+	ASSERT_FALSE(hexi::is_valid_utf8("\x80"));                    // lone continuation
+	ASSERT_FALSE(hexi::is_valid_utf8("\xc2"));                    // truncated
+	ASSERT_FALSE(hexi::is_valid_utf8("\xc0\xaf"));                // overlong
+	ASSERT_FALSE(hexi::is_valid_utf8("\xe0\x80\xaf"));            // overlong
+	ASSERT_FALSE(hexi::is_valid_utf8("\xf0\x80\x80\xaf"));        // overlong
+	ASSERT_FALSE(hexi::is_valid_utf8("\xed\xa0\x80"));            // surrogate
+	ASSERT_FALSE(hexi::is_valid_utf8("\xf4\x90\x80\x80"));        // above U+10FFFF
+	ASSERT_FALSE(hexi::is_valid_utf8("\xf8\x88\x80\x80\x80"));    // five bytes
+	ASSERT_FALSE(hexi::is_valid_utf8("\xff"));
+	ASSERT_FALSE(hexi::is_valid_utf8("\xe2\x82"));
+	ASSERT_FALSE(hexi::is_valid_utf8("\xe2\x82\xac\xac"));
+
+	// errors at and across 16 byte block boundaries
+	ASSERT_FALSE(hexi::is_valid_utf8("0123456789abcde\xe2"));
+	ASSERT_FALSE(hexi::is_valid_utf8("0123456789abcde\xe2\x82"));
+	ASSERT_TRUE(hexi::is_valid_utf8("0123456789abcde\xe2\x82\xac"));
+	ASSERT_FALSE(hexi::is_valid_utf8("0123456789abcde\xe2" "0123456789abcdef"));
+	ASSERT_FALSE(hexi::is_valid_utf8("0123456789abcdef0123456789abcdef\x80"));
+}
+
+TEST(utf8, matches_reference) {
+	std::mt19937 rng(19);
+	const std::string_view samples[] {
+		"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x90\x89", "\xed\x9f\xbf", "\xef\xbf\xbf"
+	};
+
+	for(int i = 0; i < 20000; ++i) {
+		std::string string;
+		const auto pieces = rng() % 40;
+
+		for(std::size_t k = 0; k < pieces; ++k) {
+			string += samples[rng() % std::size(samples)];
+		}
+
+		// corrupt a byte some of the time
+		if(!string.empty() && rng() % 2) {
+			string[rng() % string.size()] = static_cast<char>(rng());
+		}
+
+		ASSERT_EQ(hexi::is_valid_utf8(string), reference_valid(string)) << i;
+		ASSERT_EQ(hexi::detail::utf8_error_offset(string) == string.size(), reference_valid(string)) << i;
+	}
+}
+
+TEST(utf8, two_byte_exhaustive) {
+	for(std::uint32_t value = 0; value <= 0xffff; ++value) {
+		const char bytes[] { static_cast<char>(value >> 8), static_cast<char>(value) };
+		const std::string_view string(bytes, 2);
+		ASSERT_EQ(hexi::is_valid_utf8(string), reference_valid(string)) << value;
+	}
+}
+
+TEST(utf8, stream) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::no_throw);
+
+	const std::string valid = "Grüße";
+	const std::string invalid = "bad \xc0\xaf";
+	stream << hexi::prefixed(valid) << hexi::prefixed(invalid);
+
+	std::string result;
+	stream >> hexi::utf8(hexi::prefixed(result));
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, valid);
+
+	std::string_view view;
+	stream >> hexi::utf8(hexi::prefixed(view));
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_utf8_err);
+	ASSERT_EQ(view, invalid);
+}
+
+TEST(utf8, stream_throws) {
+	std::vector<std::uint8_t> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	const std::string invalid = "bad \xed\xa0\x80";
+	stream << invalid;
+
+	std::string result;
+
+	try {
+		stream >> hexi::utf8(result);
+		FAIL() << "Expected invalid_utf8";
+	} catch(const hexi::invalid_utf8& e) {
+		ASSERT_EQ(e.offset, 4);
+		ASSERT_EQ(e.size, invalid.size());
+	}
+
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_utf8_err);
+}
+
+TEST(utf8, pmc_stream) {
+	std::vector<std::uint8_t> buffer;
+	hexi::pmc::buffer_adaptor adaptor(buffer);
+	hexi::pmc::binary_stream stream(adaptor, hexi::no_throw);
+
+	const std::string valid = "日本語";
+	const std::string invalid = "\xf4\x90\x80\x80";
+	stream << hexi::prefixed_varint(valid) << hexi::prefixed_varint(invalid);
+
+	std::string result;
+	stream >> hexi::utf8(hexi::prefixed_varint(result));
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(result, valid);
+
+	stream >> hexi::utf8(hexi::prefixed_varint(result));
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_utf8_err);
+}
@@ -0,0 +1,119 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+#include <hexi/binary_stream.h>
+#include <hexi/buffer_adaptor.h>
+#include <hexi/serialised_size.h>
+#include <hexi/static_buffer.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <variant>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+struct Move {
+	float x, y;
+
+	void serialise(auto& stream) {
+		stream(x, y);
+	}
+};
+
+struct Chat {
+	std::string text;
+
+	void serialise(auto& stream) {
+		stream(text);
+	}
+};
+
+using Action = std::variant<std::uint32_t, Move, Chat>;
+
+} // namespace
+
+static_assert(hexi::serialised_size_bounds_v<std::variant<std::uint8_t, std::uint64_t>>
+	== hexi::size_bounds{ 2, 9 });
+
+TEST(variant, round_trip) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	Action first = Move { 1.5f, 2.5f };
+	Action second = Chat { "hello" };
+	Action third = std::uint32_t(42);
+	stream << first << second << third;
+	ASSERT_EQ(buffer.size(), (1 + 8) + (1 + 4 + 5) + (1 + 4));
+
+	Action output;
+	stream >> output;
+	ASSERT_EQ(output.index(), 1);
+	ASSERT_EQ(std::get<Move>(output).x, 1.5f);
+	ASSERT_EQ(std::get<Move>(output).y, 2.5f);
+	stream >> output;
+	ASSERT_EQ(std::get<Chat>(output).text, "hello");
+	stream >> output;
+	ASSERT_EQ(std::get<std::uint32_t>(output), 42);
+	ASSERT_TRUE(stream);
+	ASSERT_TRUE(stream.empty());
+}
+
+TEST(variant, custom_tag) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor, hexi::endian::big);
+
+	Action input = Chat { "tag" };
+	stream << hexi::tagged<std::uint16_t>(input);
+	ASSERT_EQ(buffer.size(), 2 + 4 + 3);
+	ASSERT_EQ(buffer[0], 0);
+	ASSERT_EQ(buffer[1], 2);
+
+	Action output;
+	stream >> hexi::tagged<std::uint16_t>(output);
+	ASSERT_TRUE(stream);
+	ASSERT_EQ(std::get<Chat>(output).text, "tag");
+}
+
+TEST(variant, reuse_active_alternative) {
+	std::vector<char> buffer;
+	hexi::buffer_adaptor adaptor(buffer);
+	hexi::binary_stream stream(adaptor);
+
+	Action input = Chat { "a" };
+	stream << input;
+
+	Action output = Chat { std::string(64, 'x') };
+	const auto capacity = std::get<Chat>(output).text.capacity();
+	stream >> output;
+	ASSERT_EQ(std::get<Chat>(output).text, "a");
+	ASSERT_EQ(std::get<Chat>(output).text.capacity(), capacity);
+}
+
+TEST(variant, invalid_tag) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer);
+	stream << std::uint8_t(3) << std::uint32_t(0);
+
+	Action output = std::uint32_t(7);
+	ASSERT_THROW(stream >> output, hexi::invalid_variant_tag);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_tag_err);
+	ASSERT_EQ(std::get<std::uint32_t>(output), 7);
+}
+
+TEST(variant, invalid_tag_noexcept) {
+	hexi::static_buffer<char, 16> buffer;
+	hexi::binary_stream stream(buffer, hexi::no_throw);
+	stream << std::int8_t(-1);
+
+	Action output;
+	stream >> hexi::tagged<std::int8_t>(output);
+	ASSERT_FALSE(stream);
+	ASSERT_EQ(stream.state(), hexi::stream_state::invalid_tag_err);
+	ASSERT_EQ(output.index(), 0);
+}
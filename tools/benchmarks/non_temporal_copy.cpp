@@ -0,0 +1,103 @@
+//  _               _ 
+// | |__   _____  _(_)
+// | '_ \ / _ \ \/ / | MIT & Apache 2.0 dual licensed
+// | | | |  __/>  <| | Version 1.0
+// |_| |_|\___/_/\_\_| https://github.com/EmberEmu/hexi
+
+/*
+ * Measures whether non-temporal copies help on a given host. After each
+ * blob is written to and read back from a dynamic_buffer, it walks a
+ * 1 MiB working set that fits in L2 (standing in for other connections'
+ * state) in a random order, and reports how long each line takes to
+ * access compared to when the working set is warm.
+ *
+ * Build it with and without a threshold and compare the results, e.g:
+ *
+ * g++ -std=c++23 -O2 -march=native -Iinclude tools/benchmarks/non_temporal_copy.cpp -o memcpy
+ * g++ -std=c++23 -O2 -march=native -Iinclude -DHEXI_NON_TEMPORAL_THRESHOLD="(1024 * 1024)" \
+ *     tools/benchmarks/non_temporal_copy.cpp -o non_temporal
+ *
+ * ./memcpy 8 && ./non_temporal 8
+ *
+ * The optional argument is the blob size in MiB, three by default.
+ */
+
+#include <hexi/dynamic_buffer.h>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+constexpr std::size_t line_size = 64;
+constexpr std::size_t working_set_lines = (1024 * 1024) / line_size;
+constexpr int rounds = 200;
+
+struct alignas(line_size) line {
+	std::uint32_t next;
+};
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ns(const clock_type::time_point start, const clock_type::time_point end) {
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const std::size_t blob_size = (argc > 1? std::stoul(argv[1]) : 3) * 1024 * 1024;
+
+	// a single random cycle through every line, so the walk can't be prefetched
+	std::vector<line> working_set(working_set_lines);
+	std::vector<std::uint32_t> order(working_set_lines);
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::shuffle(order, std::mt19937(1));
+
+	for(std::size_t i = 0; i < working_set_lines; ++i) {
+		working_set[order[i]].next = order[(i + 1) % working_set_lines];
+	}
+
+	auto walk = [&, position = std::uint32_t(0)]() mutable {
+		for(std::size_t i = 0; i < working_set_lines; ++i) {
+			position = working_set[position].next;
+		}
+
+		return position;
+	};
+
+	std::vector<std::uint8_t> blob(blob_size, 1), blob_out(blob_size);
+	hexi::dynamic_buffer<65536> buffer;
+	double warm_ns = 0, blob_ns = 0, after_ns = 0;
+	std::uint32_t sink = 0;
+
+	for(int i = 0; i < rounds; ++i) {
+		// walk twice with nothing in between, timing the second
+		sink += walk();
+		const auto warm_start = clock_type::now();
+		sink += walk();
+		const auto blob_start = clock_type::now();
+
+		buffer.write(blob.data(), blob.size());
+		buffer.read(blob_out.data(), blob_out.size());
+
+		const auto after_start = clock_type::now();
+		sink += walk();
+		const auto after_end = clock_type::now();
+
+		warm_ns += elapsed_ns(warm_start, blob_start);
+		blob_ns += elapsed_ns(blob_start, after_start);
+		after_ns += elapsed_ns(after_start, after_end);
+	}
+
+	std::printf("threshold %zu, blob %zu bytes: %.2f ms per round trip\n",
+	            hexi::detail::non_temporal_threshold, blob_size, blob_ns / rounds / 1e6);
+	std::printf("state access: %.2f ns per line warm, %.2f ns per line after the blob (%u)\n",
+	            warm_ns / rounds / working_set_lines, after_ns / rounds / working_set_lines, sink);
+}